@@ -114,6 +114,20 @@ assert_aligned_shapes(const shape_t<Rank1> &shape1, const shape_t<N> axes1,
   return size;
 }
 
+/**
+ * @brief Asserts whether the last 2 dimensions of a shape are equal. Throws a
+ * std::invalid_argument exception if assertion fails.
+ */
+template <size_t Rank> void assert_square(const shape_t<Rank> &shape) {
+  static_assert(Rank >= 2, "Expected at least 2 dimensions");
+  if (shape[Rank - 2] != shape[Rank - 1]) {
+    std::ostringstream error;
+    error << "last 2 dimensions of the tensor must be square, got shape "
+          << shape;
+    throw std::invalid_argument(error.str());
+  }
+}
+
 /**
  * @brief Asserts whether the shape of the boolean mask matches the shape of the
  * indexed tensor. Throws a std::invalid_argument exception if assertion fails.
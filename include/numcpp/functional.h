@@ -176,7 +176,9 @@ T reduce(Function &&f, const expression<Container1, T, Rank> &a,
 
 /**
  * @brief Reduce the tensor's dimension by cumulatively applying a function over
- * multiple axes.
+ * multiple axes. Unless a mask is given, the elements are visited in the order
+ * they are stored in memory, so the result of a non-commutative function may
+ * depend on the memory layout of @a a.
  *
  * @param f The function to apply. A binary function taking the current
  *          accumulated value as first argument and an element in the tensor as
@@ -194,6 +196,8 @@ T reduce(Function &&f, const expression<Container1, T, Rank> &a,
  * @return A new tensor with the result of performing the reduction over the
  *         given axes.
  *
+ * @throw std::invalid_argument Thrown if the reduction is performed over an
+ *                              empty axis and @a init is not provided.
  * @throw std::bad_alloc If the function fails to allocate storage it may throw
  *                       an exception.
  */
@@ -250,6 +254,11 @@ reduce(Function &&f, const expression<Container1, T, Rank> &a,
 /**
  * @brief Accumulate the result of applying a function along an axis.
  *
+ * @details If @a f is an associative operator (plus, multiplies, bit_and,
+ * bit_or, bit_xor, logical_and or logical_or), long lanes are split into
+ * fixed blocks which are scanned independently and then combined. For
+ * floating-point types, this might round differently than a sequential scan.
+ *
  * @param f The function to apply. A binary function taking the current
  *          accumulated value as first argument and an element in the tensor as
  *          second argument, and returning a value.
@@ -267,6 +276,67 @@ tensor<T, Rank> accumulate(Function &&f,
                            const expression<Container, T, Rank> &a,
                            size_t axis = 0);
 
+/**
+ * @brief Reduce consecutive segments of a tensor along an axis.
+ *
+ * @details For i in range(len(indices)), reduceat computes
+ * @code
+ * reduce(f, a(..., slice(indices[i], indices[i + 1]), ...), axis)
+ * @endcode
+ * The segment for the last index extends to the end of the axis. If
+ * @a indices[i] >= @a indices[i + 1], the i-th result is just
+ * @a a(..., indices[i], ...). Segments are reduced in parallel.
+ *
+ * @param f The function to apply. A binary function taking two elements as
+ *          arguments and returning a value.
+ * @param a A tensor-like object with the values to reduce.
+ * @param indices A 1-dimensional tensor-like object with the first index of
+ *                each segment.
+ * @param axis Axis along which to apply the reduction. Default is zero.
+ *
+ * @return A new tensor with the same shape as @a a, except along @a axis,
+ *         whose length is the number of indices.
+ *
+ * @throw std::out_of_range Thrown if any index is out of bounds.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Function, class Container1, class T, size_t Rank,
+          class Container2, class IntegralType>
+tensor<T, Rank> reduceat(Function &&f, const expression<Container1, T, Rank> &a,
+                         const expression<Container2, IntegralType, 1> &indices,
+                         size_t axis = 0);
+
+/**
+ * @brief Group values by key and reduce the values of each group.
+ *
+ * @details If the keys are sorted, each group is a run of consecutive elements
+ * and the runs are reduced in parallel. Otherwise, the elements are split into
+ * fixed blocks, each block is reduced into its own hash table in parallel and
+ * the tables are merged in block order at the end. The result does not depend
+ * on the number of threads.
+ *
+ * @param f The function to apply. It must be associative, since the values of
+ *          a group might be reduced in several parts.
+ * @param keys A 1-dimensional tensor-like object with the key of each element.
+ *             The keys must be hashable and totally ordered.
+ * @param values A 1-dimensional tensor-like object with the values to reduce.
+ *
+ * @return A pair of tensors. The first one contains the distinct keys in
+ *         ascending order and the second one the reduction of the values of
+ *         each group.
+ *
+ * @throw std::invalid_argument Thrown if @a keys and @a values have different
+ *                              sizes.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Function, class Container1, class Key, class Container2,
+          class T>
+std::pair<tensor<Key, 1>, tensor<T, 1>>
+groupby_reduce(Function &&f, const expression<Container1, Key, 1> &keys,
+               const expression<Container2, T, 1> &values);
+
 /**
  * @brief Apply a function to all pairs @a (ai,bj) with @a ai in @a a and
  * @a bj in @a b.
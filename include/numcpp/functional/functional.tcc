@@ -25,6 +25,9 @@
 #define NUMCPP_FUNCTIONAL_TCC_INCLUDED
 
 #include "numcpp/broadcasting/assert.h"
+#include "numcpp/functional/reduction.h"
+#include "numcpp/functional/scan.h"
+#include "numcpp/functional/segmented.h"
 #include "numcpp/iterators/index_sequence.h"
 #include "numcpp/iterators/nested_index_sequence.h"
 
@@ -142,40 +145,16 @@ reduce(Function &&f, const expression<Container1, T, Rank> &a,
 template <class Function, class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> reduce(Function &&f, const expression<Container, T, Rank> &a,
                        const shape_t<N> &axes, keepdims_t) {
-  shape_t<Rank> shape = a.shape();
-  for (size_t i = 0; i < N; ++i) {
-    shape[axes[i]] = 1;
-  }
-  tensor<T, Rank> out(shape);
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    T val;
-    bool is_null = true;
-    for (index_t<Rank> i : make_nested_index_sequence_for(a, index, axes)) {
-      val = is_null ? a[i] : std::forward<Function>(f)(std::move(val), a[i]);
-      is_null = false;
-    }
-    out[index] = val;
-  }
-  return out;
+  return detail::reduce_over_axes<T>(std::forward<Function>(f), a, axes,
+                                     keepdims);
 }
 
 template <class Function, class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> reduce(Function &&f, const expression<Container, T, Rank> &a,
                        const shape_t<N> &axes, keepdims_t,
                        typename Container::value_type init) {
-  shape_t<Rank> shape = a.shape();
-  for (size_t i = 0; i < N; ++i) {
-    shape[axes[i]] = 1;
-  }
-  tensor<T, Rank> out(shape);
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    T val = init;
-    for (index_t<Rank> i : make_nested_index_sequence_for(a, index, axes)) {
-      val = std::forward<Function>(f)(std::move(val), a[i]);
-    }
-    out[index] = val;
-  }
-  return out;
+  return detail::reduce_over_axes<T>(std::forward<Function>(f), a, axes,
+                                     keepdims, init);
 }
 
 template <class Function, class Container1, class T, size_t Rank, size_t N,
@@ -206,21 +185,8 @@ template <class Function, class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> reduce(Function &&f,
                            const expression<Container, T, Rank> &a,
                            const shape_t<N> &axes, dropdims_t) {
-  shape_t<Rank> shape = a.shape();
-  for (size_t i = 0; i < N; ++i) {
-    shape[axes[i]] = 1;
-  }
-  tensor<T, Rank - N> out(detail::remove_axes(a.shape(), axes));
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    T val;
-    bool is_null = true;
-    for (index_t<Rank> i : make_nested_index_sequence_for(a, index, axes)) {
-      val = is_null ? a[i] : std::forward<Function>(f)(std::move(val), a[i]);
-      is_null = false;
-    }
-    out[detail::remove_axes(index, axes)] = val;
-  }
-  return out;
+  return detail::reduce_over_axes<T>(std::forward<Function>(f), a, axes,
+                                     dropdims);
 }
 
 template <class Function, class Container, class T, size_t Rank, size_t N>
@@ -228,19 +194,8 @@ tensor<T, Rank - N> reduce(Function &&f,
                            const expression<Container, T, Rank> &a,
                            const shape_t<N> &axes, dropdims_t,
                            typename Container::value_type init) {
-  shape_t<Rank> shape = a.shape();
-  for (size_t i = 0; i < N; ++i) {
-    shape[axes[i]] = 1;
-  }
-  tensor<T, Rank - N> out(detail::remove_axes(a.shape(), axes));
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    T val = init;
-    for (index_t<Rank> i : make_nested_index_sequence_for(a, index, axes)) {
-      val = std::forward<Function>(f)(std::move(val), a[i]);
-    }
-    out[detail::remove_axes(index, axes)] = val;
-  }
-  return out;
+  return detail::reduce_over_axes<T>(std::forward<Function>(f), a, axes,
+                                     dropdims, init);
 }
 
 template <class Function, class Container1, class T, size_t Rank, size_t N,
@@ -270,21 +225,57 @@ reduce(Function &&f, const expression<Container1, T, Rank> &a,
 template <class Function, class Container, class T, size_t Rank>
 tensor<T, Rank>
 accumulate(Function &&f, const expression<Container, T, Rank> &a, size_t axis) {
+  return detail::scan_over_axis(std::forward<Function>(f), a, axis);
+}
+
+template <class Function, class Container1, class T, size_t Rank,
+          class Container2, class IntegralType>
+tensor<T, Rank> reduceat(Function &&f, const expression<Container1, T, Rank> &a,
+                         const expression<Container2, IntegralType, 1> &indices,
+                         size_t axis) {
+  size_t size = a.shape(axis);
+  std::vector<size_t> offsets(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    detail::assert_within_bounds(size, indices[i], axis);
+    offsets[i] = indices[i];
+  }
+  tensor<T, Rank> buffer;
+  const T *data = detail::make_row_major(a.self(), buffer);
   shape_t<Rank> shape = a.shape();
+  size_t outer = 1, inner = 1;
+  for (size_t i = 0; i < axis; ++i) {
+    outer *= shape[i];
+  }
+  for (size_t i = axis + 1; i < Rank; ++i) {
+    inner *= shape[i];
+  }
+  shape[axis] = offsets.size();
   tensor<T, Rank> out(shape);
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    T val;
-    bool is_null = true;
-    for (index_t<Rank> i : make_nested_index_sequence_for(a, index, axis)) {
-      val = is_null ? a[i] : std::forward<Function>(f)(std::move(val), a[i]);
-      is_null = false;
-      out[i] = val;
-    }
+  if (out.size() > 0) {
+    detail::reduceat_strided(std::forward<Function>(f), data, outer, size,
+                             inner, offsets.data(), offsets.size(),
+                             out.data());
   }
   return out;
 }
 
+template <class Function, class Container1, class Key, class Container2,
+          class T>
+std::pair<tensor<Key, 1>, tensor<T, 1>>
+groupby_reduce(Function &&f, const expression<Container1, Key, 1> &keys,
+               const expression<Container2, T, 1> &values) {
+  detail::assert_aligned_shapes(keys.shape(), 0, values.shape(), 0);
+  tensor<Key, 1> key_buffer;
+  tensor<T, 1> value_buffer;
+  const Key *key_data = detail::make_row_major(keys.self(), key_buffer);
+  const T *value_data = detail::make_row_major(values.self(), value_buffer);
+  std::pair<tensor<Key, 1>, tensor<T, 1>> out;
+  tensor<size_t, 1> counts;
+  detail::groupby_strided(std::forward<Function>(f), key_data, value_data,
+                          keys.size(), out.first, out.second, counts);
+  return out;
+}
+
 template <class OutContainer, class R, class Function, class Container1,
           class T, size_t Rank1, class Container2, class U, size_t Rank2>
 void outer(dense_tensor<OutContainer, R, Rank1 + Rank2> &out, Function &&f,
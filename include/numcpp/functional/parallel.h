@@ -0,0 +1,111 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/functional/parallel.h
+ *  This header defines helper functions to split work among threads. When the
+ *  library is compiled with OpenMP support (for example, with the -fopenmp
+ *  flag), the work is distributed among the OpenMP threads. Otherwise, all the
+ *  work is done sequentially in the calling thread.
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_PARALLEL_H_INCLUDED
+#define NUMCPP_PARALLEL_H_INCLUDED
+
+#include <algorithm>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Minimum number of elements a task should process to be worth running
+ * in its own thread.
+ */
+const size_t parallel_grain_size = 32768;
+
+/**
+ * @brief Return the number of threads available to run parallel tasks. It is
+ * always 1 if OpenMP is not enabled or if called from inside a parallel region.
+ */
+inline size_t max_threads() {
+#ifdef _OPENMP
+  if (!omp_in_parallel()) {
+    return omp_get_max_threads();
+  }
+#endif
+  return 1;
+}
+
+/**
+ * @brief Return the number of tasks in which to split @a size elements of
+ * work, provided the work can be split at most @a max_tasks times. The
+ * result is at least 1 and at most the number of available threads.
+ */
+inline size_t num_tasks(size_t size, size_t max_tasks) {
+  size_t tasks = std::min(max_threads(), size / parallel_grain_size);
+  return std::max<size_t>(1, std::min(tasks, max_tasks));
+}
+
+/**
+ * @brief Return the first element of the @a i-th of @a n blocks in which
+ * @a size elements are evenly split.
+ */
+inline size_t block_begin(size_t i, size_t n, size_t size) {
+  return i * (size / n) + std::min(i, size % n);
+}
+
+/**
+ * @brief Call @a f(i) for each @a i in [0, n). The calls are distributed among
+ * the available threads. Exceptions thrown by @a f are caught and the first
+ * one is rethrown in the calling thread once all the calls have finished.
+ *
+ * @param n Number of tasks.
+ * @param f The function to call. Calls must be independent of each other.
+ */
+template <class Function> void parallel_for(size_t n, Function &&f) {
+#ifdef _OPENMP
+  if (n > 1 && max_threads() > 1) {
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (ptrdiff_t i = 0; i < (ptrdiff_t)n; ++i) {
+      try {
+        f(i);
+      } catch (...) {
+#pragma omp critical(numcpp_parallel_for)
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return;
+  }
+#endif
+  for (size_t i = 0; i < n; ++i) {
+    f(i);
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_PARALLEL_H_INCLUDED
@@ -0,0 +1,395 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/functional/reduction.h
+ *  This header defines the engine used for reductions over axes on strided
+ *  memory arrays.
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_REDUCTION_H_INCLUDED
+#define NUMCPP_REDUCTION_H_INCLUDED
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "numcpp/functional/parallel.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Return a view over the elements of a tensor as a strided memory
+ * array. Tensors and tensor views are referenced directly. Any other
+ * expression is evaluated first into @a buffer.
+ */
+template <class T, size_t Rank>
+inline tensor_view<const T, Rank> make_strided_view(const tensor<T, Rank> &a,
+                                                    tensor<T, Rank> &) {
+  return a.view();
+}
+
+template <class T, size_t Rank>
+inline tensor_view<const T, Rank>
+make_strided_view(const tensor_view<T, Rank> &a,
+                  tensor<typename std::remove_cv<T>::type, Rank> &) {
+  return tensor_view<const T, Rank>(a.data(), a.shape(), 0, a.strides(),
+                                    a.layout());
+}
+
+template <class Container, class T, size_t Rank>
+inline tensor_view<const T, Rank>
+make_strided_view(const expression<Container, T, Rank> &a,
+                  tensor<T, Rank> &buffer) {
+  buffer = a;
+  return tensor_view<const T, Rank>(buffer.data(), buffer.shape(),
+                                    buffer.layout());
+}
+
+/**
+ * @brief Permute the axes of a strided array in memory order, i.e., in
+ * decreasing order of stride, so that the last axis is the one with the
+ * smallest stride. Axes with a single element are discarded and adjacent axes
+ * that can be traversed as a single axis are merged together.
+ *
+ * @param ndim Number of axes.
+ * @param shape Number of elements along each axis. On output, the number of
+ *              elements along each axis after permuting and merging.
+ * @param strides Span of the input array along each axis.
+ * @param out_strides Span of the output array along each axis.
+ *
+ * @return The number of axes after merging.
+ */
+inline size_t sort_axes_by_stride(size_t ndim, size_t *shape, size_t *strides,
+                                  size_t *out_strides) {
+  size_t n = 0;
+  for (size_t i = 0; i < ndim; ++i) {
+    if (shape[i] != 1) {
+      shape[n] = shape[i];
+      strides[n] = strides[i];
+      out_strides[n] = out_strides[i];
+      ++n;
+    }
+  }
+  for (size_t i = 1; i < n; ++i) {
+    for (size_t j = i; j > 0; --j) {
+      bool swap = strides[j - 1] < strides[j] ||
+                  (strides[j - 1] == strides[j] &&
+                   out_strides[j - 1] < out_strides[j]);
+      if (!swap) {
+        break;
+      }
+      std::swap(shape[j - 1], shape[j]);
+      std::swap(strides[j - 1], strides[j]);
+      std::swap(out_strides[j - 1], out_strides[j]);
+    }
+  }
+  size_t m = 0;
+  for (size_t i = 1; i < n; ++i) {
+    if (strides[m] == strides[i] * shape[i] &&
+        out_strides[m] == out_strides[i] * shape[i]) {
+      shape[m] *= shape[i];
+      strides[m] = strides[i];
+      out_strides[m] = out_strides[i];
+    } else {
+      ++m;
+      shape[m] = shape[i];
+      strides[m] = strides[i];
+      out_strides[m] = out_strides[i];
+    }
+  }
+  if (n == 0) {
+    shape[0] = 1;
+    strides[0] = out_strides[0] = 0;
+  }
+  return m + 1;
+}
+
+/**
+ * @brief Assign the first element of a reduction to the partial result. A
+ * reduction with no initial value requires the partial results to be
+ * assignable from the elements; otherwise, this function is never called.
+ */
+template <class R, class T>
+inline void assign_first(R &out, const T &val, std::true_type) {
+  out = val;
+}
+
+template <class R, class T>
+inline void assign_first(R &, const T &, std::false_type) {}
+
+template <class R, class T> inline void assign_first(R &out, const T &val) {
+  assign_first(out, val, typename std::is_assignable<R &, const T &>::type());
+}
+
+/**
+ * @brief Accumulate a lane of the input array into a single output element.
+ */
+template <class R, class Function, class T>
+inline void reduce_lane(Function &f, const T *data, size_t size, size_t stride,
+                        R *out, bool first) {
+  size_t i = 0;
+  if (first) {
+    assign_first(*out, data[i++]);
+  }
+  R val = std::move(*out);
+  if (stride == 1) {
+    for (; i < size; ++i) {
+      val = f(std::move(val), data[i]);
+    }
+  } else {
+    for (; i < size; ++i) {
+      val = f(std::move(val), data[i * stride]);
+    }
+  }
+  *out = std::move(val);
+}
+
+/**
+ * @brief Accumulate a lane of the input array elementwise into a lane of
+ * partial results.
+ */
+template <class R, class Function, class T>
+inline void accumulate_lane(Function &f, const T *data, size_t size,
+                            size_t stride, R *out, size_t out_stride,
+                            bool first) {
+  if (first) {
+    for (size_t i = 0; i < size; ++i) {
+      assign_first(out[i * out_stride], data[i * stride]);
+    }
+  } else if (stride == 1 && out_stride == 1) {
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = f(std::move(out[i]), data[i]);
+    }
+  } else {
+    for (size_t i = 0; i < size; ++i) {
+      out[i * out_stride] = f(std::move(out[i * out_stride]), data[i * stride]);
+    }
+  }
+}
+
+/**
+ * @brief Reduce a block of a strided memory array sequentially. See
+ * reduce_strided.
+ */
+template <class R, class Function, class T, size_t Rank>
+void reduce_strided_block(Function f, const T *data,
+                          const shape_t<Rank> &shape,
+                          const shape_t<Rank> &strides, R *out,
+                          const shape_t<Rank> &out_strides, bool initialized) {
+  size_t ndim = Rank;
+  size_t dims[Rank], in_step[Rank], out_step[Rank];
+  for (size_t i = 0; i < Rank; ++i) {
+    dims[i] = shape[i];
+    in_step[i] = strides[i];
+    out_step[i] = out_strides[i];
+  }
+  ndim = sort_axes_by_stride(ndim, dims, in_step, out_step);
+
+  // The last axis is traversed in the innermost loop. The remaining axes are
+  // traversed in memory order with an odometer.
+  size_t inner = ndim - 1;
+  size_t outer_size = 1;
+  for (size_t i = 0; i < inner; ++i) {
+    outer_size *= dims[i];
+  }
+  size_t index[Rank] = {};
+  size_t nonzero = 0;
+  for (size_t n = 0; n < outer_size; ++n) {
+    bool first = !initialized && nonzero == 0;
+    if (out_step[inner] == 0) {
+      reduce_lane(f, data, dims[inner], in_step[inner], out, first);
+    } else {
+      accumulate_lane(f, data, dims[inner], in_step[inner], out,
+                      out_step[inner], first);
+    }
+    for (size_t i = inner; i-- > 0;) {
+      data += in_step[i];
+      out += out_step[i];
+      if (out_step[i] == 0 && index[i] == 0) {
+        ++nonzero;
+      }
+      if (++index[i] < dims[i]) {
+        break;
+      }
+      data -= dims[i] * in_step[i];
+      out -= dims[i] * out_step[i];
+      if (out_step[i] == 0) {
+        --nonzero;
+      }
+      index[i] = 0;
+    }
+  }
+}
+
+/**
+ * @brief Reduce a strided memory array over some of its axes. The elements
+ * are visited in the order they are stored in memory: when the axis with the
+ * smallest stride is reduced, each lane along that axis is accumulated into a
+ * single output element; otherwise, whole lanes are accumulated elementwise
+ * into a lane of partial results. In both cases, the innermost loop runs over
+ * contiguous memory whenever the input array is contiguous. Lanes reduced
+ * into a single element are processed by @c reduce_lane, which may be
+ * overloaded for a specific function object to provide a faster kernel.
+ *
+ * Large reductions are split along the largest non-reduced axis and the blocks
+ * are processed in parallel. Since each output element is computed by a single
+ * thread, the result does not depend on the number of threads.
+ *
+ * @param f The function to apply. It must accept two arguments, the partial
+ *          result and an element of the input array, and return the updated
+ *          partial result.
+ * @param data Pointer to the first element of the input array.
+ * @param shape Number of elements along each axis. It must not contain any
+ *              zero.
+ * @param strides Span of the input array along each axis.
+ * @param out Pointer to the first element of the output array.
+ * @param out_strides Span of the output array along each axis. It must be zero
+ *                    along the reduced axes.
+ * @param initialized If true, each output element holds an initial value to
+ *                    start the reduction with. Otherwise, each output element
+ *                    is initialized to the first element of its reduction.
+ */
+template <class R, class Function, class T, size_t Rank>
+void reduce_strided(Function f, const T *data, const shape_t<Rank> &shape,
+                    const shape_t<Rank> &strides, R *out,
+                    const shape_t<Rank> &out_strides, bool initialized) {
+  size_t axis = 0;
+  for (size_t i = 1; i < Rank; ++i) {
+    if (out_strides[i] != 0 &&
+        (out_strides[axis] == 0 || shape[axis] < shape[i])) {
+      axis = i;
+    }
+  }
+  size_t tasks = 1;
+  if (out_strides[axis] != 0) {
+    tasks = num_tasks(shape.prod(), shape[axis]);
+  }
+  if (tasks == 1) {
+    reduce_strided_block(f, data, shape, strides, out, out_strides,
+                         initialized);
+    return;
+  }
+  parallel_for(tasks, [&](size_t i) {
+    size_t first = block_begin(i, tasks, shape[axis]);
+    size_t last = block_begin(i + 1, tasks, shape[axis]);
+    shape_t<Rank> block = shape;
+    block[axis] = last - first;
+    reduce_strided_block(f, data + first * strides[axis], block, strides,
+                         out + first * out_strides[axis], out_strides,
+                         initialized);
+  });
+}
+
+/**
+ * @brief Reduce an expression over multiple axes into a memory array.
+ *
+ * @param f The function to apply.
+ * @param a A tensor-like object.
+ * @param axes Axes along which the reduction is performed.
+ * @param out Pointer to the memory array where the result is stored. It must
+ *            have as many elements as the reduced shape and be stored in
+ *            @a order.
+ * @param order Memory layout of the output array.
+ * @param initialized If true, the output array holds the initial values to
+ *                    start the reduction with.
+ *
+ * @throw std::invalid_argument Thrown if @a initialized is false and a
+ *                              non-empty output is reduced from an empty
+ *                              sequence.
+ */
+template <class R, class Function, class Container, class T, size_t Rank,
+          size_t N>
+void reduce_over_axes(Function f, const expression<Container, T, Rank> &a,
+                      const shape_t<N> &axes, R *out, layout_t order,
+                      bool initialized) {
+  shape_t<Rank> shape = a.shape();
+  for (size_t i = 0; i < N; ++i) {
+    shape[axes[i]] = 1;
+  }
+  if (shape.prod() == 0) {
+    return;
+  }
+  if (a.size() == 0) {
+    if (!initialized) {
+      throw std::invalid_argument(
+          "attempt to reduce on an empty sequence with no initial value");
+    }
+    return;
+  }
+  shape_t<Rank> out_strides = make_strides(shape, order);
+  for (size_t i = 0; i < N; ++i) {
+    out_strides[axes[i]] = 0;
+  }
+  tensor<T, Rank> buffer;
+  tensor_view<const T, Rank> view = make_strided_view(a.self(), buffer);
+  reduce_strided(f, view.data(), view.shape(), view.strides(), out,
+                 out_strides, initialized);
+}
+
+template <class R, class Function, class Container, class T, size_t Rank,
+          size_t N>
+tensor<R, Rank> reduce_over_axes(Function f,
+                                 const expression<Container, T, Rank> &a,
+                                 const shape_t<N> &axes, keepdims_t) {
+  shape_t<Rank> shape = a.shape();
+  for (size_t i = 0; i < N; ++i) {
+    shape[axes[i]] = 1;
+  }
+  tensor<R, Rank> out(shape);
+  reduce_over_axes(f, a, axes, out.data(), out.layout(), false);
+  return out;
+}
+
+template <class R, class Function, class Container, class T, size_t Rank,
+          size_t N>
+tensor<R, Rank> reduce_over_axes(Function f,
+                                 const expression<Container, T, Rank> &a,
+                                 const shape_t<N> &axes, keepdims_t,
+                                 const R &init) {
+  shape_t<Rank> shape = a.shape();
+  for (size_t i = 0; i < N; ++i) {
+    shape[axes[i]] = 1;
+  }
+  tensor<R, Rank> out(shape, init);
+  reduce_over_axes(f, a, axes, out.data(), out.layout(), true);
+  return out;
+}
+
+template <class R, class Function, class Container, class T, size_t Rank,
+          size_t N>
+tensor<R, Rank - N> reduce_over_axes(Function f,
+                                     const expression<Container, T, Rank> &a,
+                                     const shape_t<N> &axes, dropdims_t) {
+  tensor<R, Rank - N> out(remove_axes(a.shape(), axes));
+  reduce_over_axes(f, a, axes, out.data(), out.layout(), false);
+  return out;
+}
+
+template <class R, class Function, class Container, class T, size_t Rank,
+          size_t N>
+tensor<R, Rank - N> reduce_over_axes(Function f,
+                                     const expression<Container, T, Rank> &a,
+                                     const shape_t<N> &axes, dropdims_t,
+                                     const R &init) {
+  tensor<R, Rank - N> out(remove_axes(a.shape(), axes), init);
+  reduce_over_axes(f, a, axes, out.data(), out.layout(), true);
+  return out;
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_REDUCTION_H_INCLUDED
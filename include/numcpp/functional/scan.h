@@ -0,0 +1,315 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/functional/scan.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/functional.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SCAN_H_INCLUDED
+#define NUMCPP_SCAN_H_INCLUDED
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include "numcpp/functional/operators.h"
+#include "numcpp/functional/parallel.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Whether a function object is associative, so that a scan can be split
+ * into blocks which are scanned independently and then combined. Floating-point
+ * addition and multiplication are treated as associative.
+ */
+template <class Function> struct is_associative : std::false_type {};
+
+template <> struct is_associative<plus> : std::true_type {};
+template <> struct is_associative<multiplies> : std::true_type {};
+template <> struct is_associative<bit_and> : std::true_type {};
+template <> struct is_associative<bit_or> : std::true_type {};
+template <> struct is_associative<bit_xor> : std::true_type {};
+template <> struct is_associative<logical_and> : std::true_type {};
+template <> struct is_associative<logical_or> : std::true_type {};
+
+/**
+ * @brief Number of elements in each block of a blocked scan. The blocks are
+ * fixed, so the result doesn't depend on the number of threads.
+ */
+const size_t scan_block_size = 8192;
+
+/**
+ * @brief Inclusive scan of a contiguous sequence.
+ */
+template <class Function, class T>
+inline void scan_block(Function &f, const T *data, size_t size, T *out) {
+  T val = data[0];
+  out[0] = val;
+  for (size_t i = 1; i < size; ++i) {
+    val = f(val, data[i]);
+    out[i] = val;
+  }
+}
+
+/**
+ * @brief Return the result of folding a contiguous sequence.
+ */
+template <class Function, class T>
+inline T fold_block(Function &f, const T *data, size_t size) {
+  T val = data[0];
+  for (size_t i = 1; i < size; ++i) {
+    val = f(val, data[i]);
+  }
+  return val;
+}
+
+/**
+ * @brief Inclusive scan of a block of a blocked scan, given the result of
+ * folding all the previous blocks. The block is scanned on its own first and
+ * then combined with @a carry.
+ */
+template <class Function, class T>
+inline void scan_block(Function &f, const T *data, size_t size, T *out,
+                       const T *carry) {
+  scan_block(f, data, size, out);
+  if (carry != NULL) {
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = f(*carry, out[i]);
+    }
+  }
+}
+
+/**
+ * @brief Blocked scan of a contiguous lane in the calling thread.
+ */
+template <class Function, class T>
+void scan_lane(Function &f, const T *data, size_t size, T *out,
+               std::true_type) {
+  T carry;
+  for (size_t first = 0; first < size; first += scan_block_size) {
+    size_t n = std::min(scan_block_size, size - first);
+    scan_block(f, data + first, n, out + first, (first > 0) ? &carry : NULL);
+    carry = out[first + n - 1];
+  }
+}
+
+/**
+ * @brief Sequential scan of a contiguous lane in the calling thread.
+ */
+template <class Function, class T>
+void scan_lane(Function &f, const T *data, size_t size, T *out,
+               std::false_type) {
+  scan_block(f, data, size, out);
+}
+
+/**
+ * @brief Blocked scan of a contiguous lane split among the available threads.
+ * First, each block is folded. Then, the fold of the preceding blocks is
+ * computed for each block. Finally, each block is scanned and combined with
+ * the fold of its preceding blocks. The result is the same as the one from
+ * scan_lane.
+ */
+template <class Function, class T>
+void parallel_scan_lane(Function &f, const T *data, size_t size, T *out) {
+  size_t nblocks = (size + scan_block_size - 1) / scan_block_size;
+  size_t tasks = num_tasks(size, nblocks);
+  if (tasks == 1) {
+    scan_lane(f, data, size, out, std::true_type());
+    return;
+  }
+  std::vector<T> carry(nblocks);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, nblocks);
+    size_t last = block_begin(task + 1, tasks, nblocks);
+    for (size_t b = first; b < last; ++b) {
+      size_t offset = b * scan_block_size;
+      size_t n = std::min(scan_block_size, size - offset);
+      carry[b] = fold_block(f, data + offset, n);
+    }
+  });
+  for (size_t b = 1; b + 1 < nblocks; ++b) {
+    carry[b] = f(carry[b - 1], carry[b]);
+  }
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, nblocks);
+    size_t last = block_begin(task + 1, tasks, nblocks);
+    for (size_t b = first; b < last; ++b) {
+      size_t offset = b * scan_block_size;
+      size_t n = std::min(scan_block_size, size - offset);
+      scan_block(f, data + offset, n, out + offset,
+                 (b > 0) ? &carry[b - 1] : NULL);
+    }
+  });
+}
+
+/**
+ * @brief Scan a contiguous row-major array along its middle axis, i.e., the
+ * array is viewed as having shape (outer, size, inner), and each of the
+ * outer*inner lanes of length size is scanned.
+ *
+ * @details If inner is 1, each lane is contiguous. Lanes are distributed among
+ * the threads and, if there are not enough lanes and the function is
+ * associative, each lane is split into blocks. Otherwise, the lanes are
+ * scanned side by side one row at a time, so that the innermost loop runs over
+ * contiguous memory, and the columns are distributed among the threads.
+ *
+ * @param f The function to apply.
+ * @param data Pointer to the input array.
+ * @param outer Number of elements before the scanned axis.
+ * @param size Number of elements along the scanned axis.
+ * @param inner Number of elements after the scanned axis.
+ * @param out Pointer to the output array. It may be the same as @a data.
+ */
+template <class Function, class T>
+void scan_strided(Function f, const T *data, size_t outer, size_t size,
+                  size_t inner, T *out) {
+  typedef is_associative<typename std::decay<Function>::type> associative;
+  size_t total = outer * size * inner;
+  if (total == 0) {
+    return;
+  }
+  if (inner == 1) {
+    size_t tasks = num_tasks(total, outer);
+    if (associative::value && tasks < max_threads() &&
+        size > scan_block_size) {
+      for (size_t i = 0; i < outer; ++i) {
+        parallel_scan_lane(f, data + i * size, size, out + i * size);
+      }
+      return;
+    }
+    parallel_for(tasks, [&](size_t task) {
+      size_t first = block_begin(task, tasks, outer);
+      size_t last = block_begin(task + 1, tasks, outer);
+      for (size_t i = first; i < last; ++i) {
+        scan_lane(f, data + i * size, size, out + i * size, associative());
+      }
+    });
+    return;
+  }
+
+  size_t columns = outer * inner;
+  size_t tasks = num_tasks(total, columns);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, columns);
+    size_t last = block_begin(task + 1, tasks, columns);
+    while (first < last) {
+      size_t i = first / inner;
+      size_t j0 = first % inner;
+      size_t j1 = std::min(inner, j0 + (last - first));
+      const T *in_row = data + i * size * inner;
+      T *out_row = out + i * size * inner;
+      std::copy(in_row + j0, in_row + j1, out_row + j0);
+      for (size_t k = 1; k < size; ++k) {
+        in_row += inner;
+        for (size_t j = j0; j < j1; ++j) {
+          out_row[inner + j] = f(out_row[j], in_row[j]);
+        }
+        out_row += inner;
+      }
+      first += j1 - j0;
+    }
+  });
+}
+
+/**
+ * @brief Return a pointer to the elements of a tensor in row-major order.
+ * Tensors and tensor views which are already stored in row-major order are
+ * referenced directly. Otherwise, the elements are copied into @a out.
+ */
+template <class T, size_t Rank>
+inline const T *make_row_major(const tensor<T, Rank> &a, tensor<T, Rank> &out) {
+  if (a.layout() == row_major) {
+    return a.data();
+  }
+  out = a;
+  return out.data();
+}
+
+template <class T, size_t Rank>
+inline const T *
+make_row_major(const tensor_view<T, Rank> &a,
+               tensor<typename std::remove_cv<T>::type, Rank> &out) {
+  size_t stride = 1;
+  bool contiguous = true;
+  for (size_t i = Rank; i-- > 0;) {
+    if (a.shape(i) != 1 && a.strides(i) != stride) {
+      contiguous = false;
+    }
+    stride *= a.shape(i);
+  }
+  if (contiguous) {
+    return a.data();
+  }
+  out = a;
+  return out.data();
+}
+
+template <class Container, class T, size_t Rank>
+inline const T *make_row_major(const expression<Container, T, Rank> &a,
+                               tensor<T, Rank> &out) {
+  out = a;
+  return out.data();
+}
+
+/**
+ * @brief Return a pointer to the elements of a tensor in the order given by
+ * its layout. Tensors are referenced directly. Otherwise, the elements are
+ * copied into @a out.
+ */
+template <class T, size_t Rank>
+inline const T *make_contiguous(const tensor<T, Rank> &a, tensor<T, 1> &) {
+  return a.data();
+}
+
+template <class Container, class T, size_t Rank>
+inline const T *make_contiguous(const expression<Container, T, Rank> &a,
+                                tensor<T, 1> &out) {
+  out = tensor<T, 1>(a.self().begin(), a.size());
+  return out.data();
+}
+
+/**
+ * @brief Accumulate the result of applying a function along an axis.
+ *
+ * @param f The function to apply.
+ * @param a A tensor-like object.
+ * @param axis Axis along which to apply the accumulation.
+ *
+ * @return A new tensor in row-major order with the accumulated values.
+ */
+template <class Function, class Container, class T, size_t Rank>
+tensor<T, Rank> scan_over_axis(Function &&f,
+                               const expression<Container, T, Rank> &a,
+                               size_t axis) {
+  tensor<T, Rank> out(a.shape());
+  const T *data = make_row_major(a.self(), out);
+  size_t outer = 1, inner = 1;
+  for (size_t i = 0; i < axis; ++i) {
+    outer *= out.shape(i);
+  }
+  for (size_t i = axis + 1; i < Rank; ++i) {
+    inner *= out.shape(i);
+  }
+  scan_strided(std::forward<Function>(f), data, outer, out.shape(axis), inner,
+               out.data());
+  return out;
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_SCAN_H_INCLUDED
@@ -0,0 +1,241 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/functional/segmented.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/functional.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SEGMENTED_H_INCLUDED
+#define NUMCPP_SEGMENTED_H_INCLUDED
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/functional/scan.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Reduce consecutive segments of a contiguous row-major array along its
+ * middle axis, i.e., the array is viewed as having shape (outer, size, inner).
+ * The i-th segment starts at indices[i] and ends at indices[i + 1], or at the
+ * end of the axis for the last segment. If indices[i] >= indices[i + 1], the
+ * segment contains only the element at indices[i].
+ *
+ * @param f The function to apply.
+ * @param data Pointer to the input array.
+ * @param outer Number of elements before the reduced axis.
+ * @param size Number of elements along the reduced axis.
+ * @param inner Number of elements after the reduced axis.
+ * @param indices Pointer to the first index of each segment.
+ * @param nidx Number of segments.
+ * @param out Pointer to the output array, with shape (outer, nidx, inner).
+ */
+template <class Function, class T>
+void reduceat_strided(Function f, const T *data, size_t outer, size_t size,
+                      size_t inner, const size_t *indices, size_t nidx,
+                      T *out) {
+  size_t segments = outer * nidx;
+  size_t tasks = num_tasks(outer * size * inner, segments);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, segments);
+    size_t last = block_begin(task + 1, tasks, segments);
+    for (size_t n = first; n < last; ++n) {
+      size_t i = n / nidx, j = n % nidx;
+      size_t begin = indices[j], end = size;
+      if (j + 1 < nidx) {
+        end = (indices[j] < indices[j + 1]) ? indices[j + 1] : begin + 1;
+      }
+      const T *in = data + (i * size + begin) * inner;
+      T *row = out + n * inner;
+      if (inner == 1) {
+        *row = fold_block(f, in, end - begin);
+        continue;
+      }
+      std::copy(in, in + inner, row);
+      for (size_t k = begin + 1; k < end; ++k) {
+        in += inner;
+        for (size_t l = 0; l < inner; ++l) {
+          row[l] = f(row[l], in[l]);
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Maximum number of blocks in which a group-by with unsorted keys is
+ * split. Each block builds its own table of partial results. The blocks don't
+ * depend on the number of threads, so neither does the result.
+ */
+const size_t groupby_max_blocks = 64;
+
+/**
+ * @brief Table with the partial result of each group in a block of rows.
+ */
+template <class Key, class T> struct groupby_table {
+  std::unordered_map<Key, size_t> index;
+  std::vector<Key> keys;
+  std::vector<T> values;
+  std::vector<size_t> counts;
+
+  /**
+   * @brief Return the position of a key in the table, inserting it if it is
+   * not present yet.
+   */
+  size_t find(const Key &key, bool &inserted) {
+    auto it = index.insert(std::make_pair(key, keys.size()));
+    inserted = it.second;
+    if (inserted) {
+      keys.push_back(key);
+      counts.push_back(0);
+    }
+    return it.first->second;
+  }
+};
+
+/**
+ * @brief Group values by key and reduce each group. The resulting keys are
+ * sorted in ascending order.
+ *
+ * @details If the keys are already sorted, the groups are consecutive runs of
+ * rows, which are found and reduced in parallel. Otherwise, the rows are split
+ * into blocks, each block is reduced into a hash table in parallel and the
+ * tables are merged in block order.
+ *
+ * @param f The function to apply. It must be associative.
+ * @param keys Pointer to the keys.
+ * @param values Pointer to the values. If NULL, only the groups are counted.
+ * @param n Number of rows.
+ * @param out_keys On output, the distinct keys.
+ * @param out_values On output, the reduction of each group.
+ * @param out_counts On output, the number of rows in each group.
+ */
+template <class Function, class Key, class T>
+void groupby_strided(Function f, const Key *keys, const T *values, size_t n,
+                     tensor<Key, 1> &out_keys, tensor<T, 1> &out_values,
+                     tensor<size_t, 1> &out_counts) {
+  bool sorted = true;
+  for (size_t i = 1; i < n && sorted; ++i) {
+    sorted = !(keys[i] < keys[i - 1]);
+  }
+
+  if (sorted) {
+    // Find the first row of each group.
+    size_t tasks = num_tasks(n, n);
+    std::vector<std::vector<size_t>> starts(tasks);
+    parallel_for(tasks, [&](size_t task) {
+      size_t first = block_begin(task, tasks, n);
+      size_t last = block_begin(task + 1, tasks, n);
+      for (size_t i = first; i < last; ++i) {
+        if (i == 0 || keys[i - 1] < keys[i]) {
+          starts[task].push_back(i);
+        }
+      }
+    });
+    std::vector<size_t> offsets;
+    for (size_t task = 0; task < tasks; ++task) {
+      offsets.insert(offsets.end(), starts[task].begin(), starts[task].end());
+    }
+    size_t groups = offsets.size();
+    offsets.push_back(n);
+    out_keys.resize(groups);
+    out_counts.resize(groups);
+    out_values.resize((values != NULL) ? groups : 0);
+    tasks = num_tasks(n, groups);
+    parallel_for(tasks, [&](size_t task) {
+      size_t first = block_begin(task, tasks, groups);
+      size_t last = block_begin(task + 1, tasks, groups);
+      for (size_t g = first; g < last; ++g) {
+        size_t begin = offsets[g], end = offsets[g + 1];
+        out_keys[g] = keys[begin];
+        out_counts[g] = end - begin;
+        if (values != NULL) {
+          out_values[g] = fold_block(f, values + begin, end - begin);
+        }
+      }
+    });
+    return;
+  }
+
+  // Reduce each block of rows into its own table.
+  size_t nblocks = std::min(groupby_max_blocks, n / parallel_grain_size + 1);
+  std::vector<groupby_table<Key, T>> tables(nblocks);
+  parallel_for(nblocks, [&](size_t b) {
+    size_t first = block_begin(b, nblocks, n);
+    size_t last = block_begin(b + 1, nblocks, n);
+    groupby_table<Key, T> &table = tables[b];
+    for (size_t i = first; i < last; ++i) {
+      bool inserted;
+      size_t g = table.find(keys[i], inserted);
+      ++table.counts[g];
+      if (values != NULL) {
+        if (inserted) {
+          table.values.push_back(values[i]);
+        } else {
+          table.values[g] = f(table.values[g], values[i]);
+        }
+      }
+    }
+  });
+
+  // Merge the tables in block order.
+  groupby_table<Key, T> &total = tables[0];
+  for (size_t b = 1; b < nblocks; ++b) {
+    groupby_table<Key, T> &table = tables[b];
+    for (size_t g = 0; g < table.keys.size(); ++g) {
+      bool inserted;
+      size_t h = total.find(table.keys[g], inserted);
+      total.counts[h] += table.counts[g];
+      if (values != NULL) {
+        if (inserted) {
+          total.values.push_back(table.values[g]);
+        } else {
+          total.values[h] = f(total.values[h], table.values[g]);
+        }
+      }
+    }
+    table = groupby_table<Key, T>();
+  }
+
+  // Sort the groups by key.
+  size_t groups = total.keys.size();
+  std::vector<size_t> order(groups);
+  for (size_t g = 0; g < groups; ++g) {
+    order[g] = g;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+    return total.keys[i] < total.keys[j];
+  });
+  out_keys.resize(groups);
+  out_counts.resize(groups);
+  out_values.resize((values != NULL) ? groups : 0);
+  for (size_t g = 0; g < groups; ++g) {
+    out_keys[g] = total.keys[order[g]];
+    out_counts[g] = total.counts[order[g]];
+    if (values != NULL) {
+      out_values[g] = total.values[order[g]];
+    }
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_SEGMENTED_H_INCLUDED
@@ -130,6 +130,47 @@ void save(const std::string &filename,
 template <class Container, class T, size_t Rank>
 void save(std::ostream &file, const expression<Container, T, Rank> &data);
 
+template <class T> class quantile_sketch;
+
+/**
+ * @brief Load a quantile sketch from a binary file. The sketch is stored as two
+ * consecutive arrays in NumPy @c .npy format: an array of unsigned integers with
+ * the parameters of the sketch and the size of each level, followed by an array
+ * with the minimum, the maximum and the retained values.
+ *
+ * @param filename A string representing the name of the file to load.
+ * @param file File object to read.
+ * @param sketch Sketch to overwrite with the contents of the file.
+ *
+ * @throw std::ios_base::failure Thrown if the input file doesn't exist, cannot
+ *                               be read or does not contain a valid sketch.
+ * @throw std::invalid_argument Thrown if T doesn't match the data type stored in
+ *                              the input file.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class T>
+void load(const std::string &filename, quantile_sketch<T> &sketch);
+
+template <class T> void load(std::istream &file, quantile_sketch<T> &sketch);
+
+/**
+ * @brief Save a quantile sketch to a binary file. The format is described in
+ * @c load.
+ *
+ * @param filename A string representing the name of the file destination.
+ * @param file File object to write.
+ * @param sketch Sketch to be saved. Only arithmetic types (either integer or
+ *               floating-point) are supported.
+ *
+ * @throw std::ios_base::failure Thrown if the output file cannot be written.
+ */
+template <class T>
+void save(const std::string &filename, const quantile_sketch<T> &sketch);
+
+template <class T>
+void save(std::ostream &file, const quantile_sketch<T> &sketch);
+
 /// Text files.
 
 /**
@@ -343,7 +343,7 @@ template <class T> void read_array(std::istream &file, T *data, size_t n) {
   if (bytesize < n * sizeof(T)) {
     throw std::ios_base::failure("File is corrupted or malformed");
   }
-  file.read(reinterpret_cast<char *>(data), bytesize);
+  file.read(reinterpret_cast<char *>(data), n * sizeof(T));
 }
 } // namespace detail
 
@@ -432,6 +432,90 @@ void save(std::ostream &file, const expression<Container, T, Rank> &data) {
   detail::write_array<T>(file, data.self().begin(), data.self().end());
 }
 
+template <class T>
+void load(const std::string &filename, quantile_sketch<T> &sketch) {
+  std::ifstream file(filename, std::ifstream::binary);
+  if (!file) {
+    std::ostringstream error;
+    error << "Input file " << filename << " does not exist or cannot be read";
+    throw std::ios_base::failure(error.str());
+  }
+  load(file, sketch);
+}
+
+template <class T> void load(std::istream &file, quantile_sketch<T> &sketch) {
+  tensor<std::uint64_t, 1> header = load<std::uint64_t, 1>(file);
+  tensor<T, 1> items = load<T, 1>(file);
+  // The header holds k, the number of values in the stream, the state of the
+  // generator, the number of levels and the size of each level.
+  if (header.size() < 4 || header[3] == 0 || header.size() != 4 + header[3] ||
+      header[0] < quantile_sketch<T>::min_level_capacity) {
+    throw std::ios_base::failure("File is corrupted or malformed");
+  }
+  size_t size = 0;
+  for (size_t h = 0; h < header[3]; ++h) {
+    size += header[4 + h];
+  }
+  if ((header[1] == 0) ? (items.size() != 0 || size != 0)
+                       : (items.size() != size + 2 || size == 0)) {
+    throw std::ios_base::failure("File is corrupted or malformed");
+  }
+  quantile_sketch<T> out(header[0]);
+  out.m_count = header[1];
+  out.m_state = header[2];
+  out.m_levels.resize(header[3]);
+  const T *data = items.data();
+  if (out.m_count > 0) {
+    out.m_min = *data++;
+    out.m_max = *data++;
+  }
+  for (size_t h = 0; h < out.m_levels.size(); ++h) {
+    out.m_levels[h].assign(data, data + header[4 + h]);
+    data += header[4 + h];
+  }
+  out.m_size = size;
+  out.update_capacity();
+  out.compress();
+  sketch = std::move(out);
+}
+
+template <class T>
+void save(const std::string &filename, const quantile_sketch<T> &sketch) {
+  std::ofstream file(filename, std::ofstream::binary);
+  if (!file) {
+    std::ostringstream error;
+    error << "Ouput file " << filename << " cannot be written";
+    throw std::ios_base::failure(error.str());
+  }
+  save(file, sketch);
+  file.close();
+}
+
+template <class T>
+void save(std::ostream &file, const quantile_sketch<T> &sketch) {
+  size_t nlevels = sketch.m_levels.size();
+  tensor<std::uint64_t, 1> header(4 + nlevels);
+  header[0] = sketch.m_k;
+  header[1] = sketch.m_count;
+  header[2] = sketch.m_state;
+  header[3] = nlevels;
+  for (size_t h = 0; h < nlevels; ++h) {
+    header[4 + h] = sketch.m_levels[h].size();
+  }
+  tensor<T, 1> items((sketch.m_count > 0) ? sketch.m_size + 2 : 0);
+  T *data = items.data();
+  if (sketch.m_count > 0) {
+    *data++ = sketch.m_min;
+    *data++ = sketch.m_max;
+  }
+  for (size_t h = 0; h < nlevels; ++h) {
+    data = std::copy(sketch.m_levels[h].begin(), sketch.m_levels[h].end(),
+                     data);
+  }
+  save(file, header);
+  save(file, items);
+}
+
 /// Text files.
 
 namespace detail {
@@ -23,8 +23,16 @@
 #ifndef NUMCPP_LINALG_H_INCLUDED
 #define NUMCPP_LINALG_H_INCLUDED
 
+#include <string>
+#include <tuple>
+#include <utility>
 #include "numcpp/config.h"
+#include "numcpp/random.h"
+#include "numcpp/routines/new.h"
 #include "numcpp/linalg/transpose_view.h"
+#include "numcpp/linalg/contraction.h"
+#include "numcpp/linalg/decomposition.h"
+#include "numcpp/linalg/iterative.h"
 
 namespace numcpp {
 /// Basic linear algebra.
@@ -114,6 +122,13 @@ tensor<T, Rank> cross(const expression<Container1, T, Rank> &a,
  * - If both arguments are n-dimensional, n > 2, it is treated as a stack of
  *   matrices residing in the last 2 dimensions and broadcast accordingly.
  *
+ * The product of two matrices is computed by blocks, which are split among
+ * the available threads. Matrices with a known structure are multiplied
+ * without being materialized: the identity matrix and diagonal matrices (as
+ * returned by @c eye and @c diag) just copy and scale the rows or columns of
+ * the other operand, and triangular matrices (as returned by @c tril and
+ * @c triu) skip the multiplications with their zero triangle.
+ *
  * The matrix multiplication of a @f$m \times p@f$ matrix @f$A = (a_{ij})@f$ and
  * a @f$p \times n@f$ matrix @f$B = (b_{ij})@f$ is the @f$m \times n@f$ matrix
  * @f$C = (c_{ij})@f$ such that
@@ -166,6 +181,12 @@ tensor<T, Rank> matmul(const expression<Container1, T, 2> &a,
  * and @a b_axes, sum the products of @a a 's and @a b 's elements over the axes
  * specified by @a a_axes and @a b_axes.
  *
+ * The axes of each tensor are permuted and reshaped into a matrix, with the
+ * non-contracted axes as rows (or columns) and the contracted axes as
+ * columns (or rows), and the contraction is computed as a single matrix
+ * multiplication. Tensors and tensor views are not copied if their strides
+ * allow the reshape.
+ *
  * @param a First tensor-like argument.
  * @param b Second tensor-like argument.
  * @param a_axes List of axes to sum over @a a.
@@ -176,7 +197,8 @@ tensor<T, Rank> matmul(const expression<Container1, T, 2> &a,
  *         non-contracted axes of the second.
  *
  * @throw std::invalid_argument Thrown if the shape of @a a is not equal to the
- *                              shape of @a b over the contracted axes.
+ *                              shape of @a b over the contracted axes, or if
+ *                              an axis is out of bounds or repeated.
  * @throw std::bad_alloc If the function fails to allocate storage it may throw
  *                       an exception.
  */
@@ -206,6 +228,49 @@ T tensordot(const expression<Container1, T, Rank> &a,
             const expression<Container2, T, Rank> &b,
             const shape_t<Rank> &a_axes, const shape_t<Rank> &b_axes);
 
+/**
+ * @brief Evaluate the Einstein summation convention on the operands.
+ *
+ * @details The subscripts are a comma-separated list of labels, one letter for
+ * each axis of each operand, optionally followed by "->" and the labels of
+ * the output. Repeated labels in an operand take its diagonal. Labels which
+ * appear in more than one operand, but not in the output, are summed. If the
+ * output is not given, it consists of the labels which appear exactly once,
+ * in alphabetical order. For example,
+ * - "ij,jk->ik" is the matrix multiplication,
+ * - "ii->" is the trace and "ii->i" is the diagonal,
+ * - "ij->ji" is the transpose,
+ * - "bij,bjk->bik" is a batched matrix multiplication,
+ * - "i,j->ij" is the outer product.
+ *
+ * The operands are contracted two at a time, following a greedy path which,
+ * at each step, contracts the pair of operands which reduces the total size
+ * of the intermediate results the most. Each contraction is computed as a
+ * single matrix multiplication (or a batch of them), and tensors and tensor
+ * views are not copied if their strides allow it.
+ *
+ * @tparam Rank Dimension of the output, which must match the number of output
+ *              labels. If 0, the result is returned as a scalar.
+ *
+ * @param subscripts Subscripts for summation. Ellipsis are not supported.
+ * @param a, operands... Tensor-like arguments, all with the same value type.
+ *
+ * @return The calculation based on the Einstein summation convention.
+ *
+ * @throw std::invalid_argument Thrown if the subscripts are invalid, don't
+ *                              match the number or the dimensions of the
+ *                              operands, if the sizes of a label don't match
+ *                              or if the number of output labels is not
+ *                              @a Rank.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <size_t Rank, class Container, class T, size_t Rank1,
+          class... Operands>
+typename detail::einsum_result<T, Rank>::type
+einsum(const std::string &subscripts, const expression<Container, T, Rank1> &a,
+       const Operands &...operands);
+
 /**
  * @brief Reverse or permute the axes of a tensor.
  *
@@ -299,13 +364,774 @@ T norm(const expression<Container, std::complex<T>, 1> &a, double ord = 2);
 /**
  * @brief Compute the determinant of a matrix via LU decomposition.
  *
+ * @details For integer types, the determinant is computed exactly by
+ * fraction-free Gaussian elimination instead.
+ *
  * @param a Input matrix to compute determinant for.
  *
  * @return Determinant of @a a.
  *
  * @throw std::invalid_argument Thrown if input matrix is not square.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
  */
 template <class Container, class T> T det(const expression<Container, T, 2> &a);
+
+/**
+ * @brief Compute the determinants of a stack of matrices.
+ *
+ * @details The matrices reside in the last 2 dimensions. Stacks of matrices
+ * of size at most 8 are processed by kernels that interleave many matrices,
+ * so that each operation is applied to several matrices at once with vector
+ * instructions. The matrices of the stack are split among the available
+ * threads.
+ *
+ * @param a A tensor-like object of shape (..., n, n).
+ *
+ * @return A new tensor of shape (...) with the determinants.
+ *
+ * @throw std::invalid_argument Thrown if the last 2 dimensions of @a a are not
+ *                              square.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T, size_t Rank>
+tensor<T, Rank - 2> det(const expression<Container, T, Rank> &a);
+
+/**
+ * @brief Solve a linear matrix equation, @f$Ax = b@f$.
+ *
+ * @details If the arguments are n-dimensional, n > 2, they are treated as
+ * stacks of matrices residing in the last 2 dimensions and broadcast
+ * accordingly. Stacks of matrices of size at most 8 are solved by kernels
+ * that interleave many matrices, so that each operation is applied to
+ * several matrices at once with vector instructions. Larger matrices are
+ * solved by their blocked LU decomposition. The matrices of the stack are
+ * split among the available threads.
+ *
+ * If @a a is the lower or upper triangle of a matrix, as returned by
+ * @c tril or @c triu with no offset, the system is solved by forward or back
+ * substitution instead.
+ *
+ * To solve several systems with the same matrix, see @c lu_factorization.
+ *
+ * @param a Coefficient matrix, of shape (..., n, n).
+ * @param b Ordinate values, of shape (n,) or (..., n, k).
+ *
+ * @return The solution, with the broadcast shape of @a b.
+ *
+ * @throw std::invalid_argument Thrown if the matrices are not square, if the
+ *                              shapes are not aligned or if any matrix is
+ *                              singular.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class Container2, class T>
+tensor<T, 1> solve(const expression<Container1, T, 2> &a,
+                   const expression<Container2, T, 1> &b);
+
+template <class Container1, class Container2, class T, size_t Rank>
+tensor<T, Rank> solve(const expression<Container1, T, Rank> &a,
+                      const expression<Container2, T, Rank> &b);
+
+template <class Container1, class Container2, class T>
+tensor<T, 1> solve(const triangular_expr<Container1, T, 2> &a,
+                   const expression<Container2, T, 1> &b);
+
+template <class Container1, class Container2, class T>
+tensor<T, 2> solve(const triangular_expr<Container1, T, 2> &a,
+                   const expression<Container2, T, 2> &b);
+
+/**
+ * @brief Compute the inverse of a matrix, or of each matrix in a stack.
+ *
+ * @details The inverse is computed by solving @f$AX = I@f$, with the same
+ * methods as @c solve.
+ *
+ * @param a A tensor-like object of shape (..., n, n).
+ *
+ * @return A new tensor of shape (..., n, n) with the inverses.
+ *
+ * @throw std::invalid_argument Thrown if the last 2 dimensions of @a a are not
+ *                              square or if any matrix is singular.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T, size_t Rank>
+tensor<T, Rank> inv(const expression<Container, T, Rank> &a);
+
+/**
+ * @brief Compute the pivoted LU decomposition of a matrix.
+ *
+ * @details The decomposition is @f$A = PLU@f$, where @f$P@f$ is a
+ * permutation matrix, @f$L@f$ is lower triangular with unit diagonal and
+ * @f$U@f$ is upper triangular. The matrix is factorized by blocks of columns.
+ * After each block, the trailing matrix is updated with a matrix
+ * multiplication, which is split among the available threads.
+ *
+ * @param a Matrix to decompose, of size m x n.
+ *
+ * @return A pair with a matrix of size m x n whose part below the diagonal
+ *         holds @f$L@f$ (without its unit diagonal) and whose part on and
+ *         above the diagonal holds @f$U@f$, and a permutation of size m such
+ *         that row i of @f$LU@f$ is row piv[i] of @a a.
+ *
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+std::pair<tensor<T, 2>, tensor<size_t, 1>>
+lu_factor(const expression<Container, T, 2> &a);
+
+/**
+ * @brief Compute the pivoted LU decomposition of a matrix in-place.
+ *
+ * @param a Matrix to decompose, of size m x n. It is overwritten with the
+ *          packed factors returned by @c lu_factor.
+ *
+ * @return A permutation of size m such that row i of @f$LU@f$ is row piv[i]
+ *         of the original matrix.
+ *
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+tensor<size_t, 1> lu_factor_inplace(dense_tensor<Container, T, 2> &a);
+
+/**
+ * @brief Compute the pivoted LU decomposition of a matrix.
+ *
+ * @param a Matrix to decompose, of size m x n.
+ *
+ * @return A tuple with the permutation matrix @f$P@f$ of size m x m, the
+ *         lower triangular matrix @f$L@f$ with unit diagonal of size m x k
+ *         and the upper triangular matrix @f$U@f$ of size k x n, where k =
+ *         min(m, n), such that @f$A = PLU@f$.
+ *
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+std::tuple<tensor<T, 2>, tensor<T, 2>, tensor<T, 2>>
+lu(const expression<Container, T, 2> &a);
+
+/**
+ * @brief Compute the Cholesky decomposition of a Hermitian positive-definite
+ * matrix.
+ *
+ * @details The decomposition is @f$A = LL^*@f$, where @f$L@f$ is lower
+ * triangular with positive diagonal. Only the lower triangle of the matrix is
+ * read. The matrix is factorized by blocks, and the trailing matrix of each
+ * block is updated with matrix multiplications, which are split among the
+ * available threads.
+ *
+ * @param a Matrix to decompose.
+ *
+ * @return The lower triangular matrix @f$L@f$.
+ *
+ * @throw std::invalid_argument Thrown if input matrix is not square or is not
+ *                              positive definite.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+tensor<T, 2> cholesky(const expression<Container, T, 2> &a);
+
+/**
+ * @brief Compute the Cholesky decompositions of a stack of Hermitian
+ * positive-definite matrices.
+ *
+ * @details The matrices reside in the last 2 dimensions. Stacks of matrices
+ * of size at most 8 are processed by kernels that interleave many matrices,
+ * as in @c solve. The matrices of the stack are split among the available
+ * threads.
+ *
+ * @param a A tensor-like object of shape (..., n, n).
+ *
+ * @return A new tensor of shape (..., n, n) with the lower triangular
+ *         factors.
+ *
+ * @throw std::invalid_argument Thrown if the last 2 dimensions of @a a are not
+ *                              square or if any matrix is not positive
+ *                              definite.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T, size_t Rank>
+tensor<T, Rank> cholesky(const expression<Container, T, Rank> &a);
+
+/**
+ * @brief Compute the Cholesky decomposition of a Hermitian positive-definite
+ * matrix in-place.
+ *
+ * @param a Matrix to decompose. It is overwritten with the lower triangular
+ *          matrix @f$L@f$. If it is not positive definite, its contents are
+ *          unspecified.
+ *
+ * @throw std::invalid_argument Thrown if input matrix is not square or is not
+ *                              positive definite.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+void cholesky_inplace(dense_tensor<Container, T, 2> &a);
+
+/**
+ * @brief Compute the LDL decomposition of a Hermitian matrix, without
+ * pivoting.
+ *
+ * @details The decomposition is @f$A = LDL^*@f$, where @f$L@f$ is lower
+ * triangular with unit diagonal and @f$D@f$ is diagonal. Only the lower
+ * triangle of the matrix is read. If a zero pivot is found, the corresponding
+ * column of @f$L@f$ below the diagonal is set to zero. The blocking is the
+ * same as in @c cholesky.
+ *
+ * @param a Matrix to decompose.
+ *
+ * @return A pair with the lower triangular matrix @f$L@f$ and the diagonal of
+ *         @f$D@f$.
+ *
+ * @throw std::invalid_argument Thrown if input matrix is not square.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+std::pair<tensor<T, 2>, tensor<T, 1>> ldl(const expression<Container, T, 2> &a);
+
+/**
+ * @brief Compute the LDL decomposition of a Hermitian matrix in-place, without
+ * pivoting.
+ *
+ * @param a Matrix to decompose. It is overwritten with the lower triangular
+ *          matrix @f$L@f$.
+ *
+ * @return The diagonal of @f$D@f$.
+ *
+ * @throw std::invalid_argument Thrown if input matrix is not square.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+tensor<T, 1> ldl_inplace(dense_tensor<Container, T, 2> &a);
+
+/**
+ * @brief Compute the eigenvalues and eigenvectors of a Hermitian matrix.
+ *
+ * @details The matrix is reduced to real symmetric tridiagonal form by
+ * Householder reflections, applied by blocks with matrix multiplications.
+ * The eigenvalues and eigenvectors of the tridiagonal matrix are computed by
+ * the divide-and-conquer method, and the eigenvectors are transformed back
+ * with the reflectors of the reduction. Only the lower triangle of the matrix
+ * is read.
+ *
+ * @param a A Hermitian matrix.
+ *
+ * @return A pair with the eigenvalues, in ascending order, and a matrix whose
+ *         columns are the corresponding normalized eigenvectors.
+ *
+ * @throw std::invalid_argument Thrown if input matrix is not square.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+std::pair<tensor<typename detail::complex_traits<T>::value_type, 1>,
+          tensor<T, 2>>
+eigh(const expression<Container, T, 2> &a);
+
+/**
+ * @brief Compute a subset of the eigenvalues and eigenvectors of a Hermitian
+ * matrix.
+ *
+ * @details If only a few eigenvalues are requested, they are computed by
+ * bisection on the tridiagonal form, and their eigenvectors by inverse
+ * iteration. Otherwise, all of them are computed as in @c eigh and the
+ * subset is returned.
+ *
+ * @param a A Hermitian matrix.
+ * @param index A slice with the positions of the eigenvalues to compute,
+ *              with the smallest eigenvalue at position 0. Positions beyond
+ *              the size of the matrix are ignored.
+ * @param low, high Compute the eigenvalues in the half-open interval
+ *                  [low, high).
+ *
+ * @return A pair with the selected eigenvalues, in ascending order, and a
+ *         matrix whose columns are the corresponding normalized eigenvectors.
+ *
+ * @throw std::invalid_argument Thrown if input matrix is not square.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+std::pair<tensor<typename detail::complex_traits<T>::value_type, 1>,
+          tensor<T, 2>>
+eigh(const expression<Container, T, 2> &a, slice index);
+
+template <class Container, class T>
+std::pair<tensor<typename detail::complex_traits<T>::value_type, 1>,
+          tensor<T, 2>>
+eigh(const expression<Container, T, 2> &a,
+     typename detail::complex_traits<T>::value_type low,
+     typename detail::complex_traits<T>::value_type high);
+
+/**
+ * @brief Compute the eigenvalues of a Hermitian matrix.
+ *
+ * @details The matrix is reduced to tridiagonal form as in @c eigh. Since
+ * the eigenvectors are not formed, the eigenvalues of the tridiagonal matrix
+ * are computed in quadratic time by the QL method, or by bisection when a
+ * small subset is requested.
+ *
+ * @param a A Hermitian matrix.
+ * @param index A slice with the positions of the eigenvalues to compute,
+ *              with the smallest eigenvalue at position 0. Positions beyond
+ *              the size of the matrix are ignored.
+ * @param low, high Compute the eigenvalues in the half-open interval
+ *                  [low, high).
+ *
+ * @return The eigenvalues, in ascending order.
+ *
+ * @throw std::invalid_argument Thrown if input matrix is not square.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+tensor<typename detail::complex_traits<T>::value_type, 1>
+eigvalsh(const expression<Container, T, 2> &a);
+
+template <class Container, class T>
+tensor<typename detail::complex_traits<T>::value_type, 1>
+eigvalsh(const expression<Container, T, 2> &a, slice index);
+
+template <class Container, class T>
+tensor<typename detail::complex_traits<T>::value_type, 1>
+eigvalsh(const expression<Container, T, 2> &a,
+         typename detail::complex_traits<T>::value_type low,
+         typename detail::complex_traits<T>::value_type high);
+
+/**
+ * @brief Compute the singular value decomposition of a matrix,
+ * @f$A = U \Sigma V^*@f$.
+ *
+ * @details The matrix is reduced to real bidiagonal form by Householder
+ * reflections, and the bidiagonal matrix is diagonalized by implicit QR
+ * sweeps, which compute the singular values to high relative accuracy.
+ * Matrices with many more rows than columns (or columns than rows) are first
+ * reduced to a triangular matrix by a blocked QR factorization, so that the
+ * cost of the bidiagonalization depends only on the smaller dimension.
+ *
+ * @param a A matrix of size m x n.
+ * @param full_matrices If true (default), @f$U@f$ and @f$V^*@f$ have shapes
+ *                      m x m and n x n. Otherwise, they have shapes m x k
+ *                      and k x n, where k = min(m, n).
+ *
+ * @return A tuple with @f$U@f$, the singular values in descending order and
+ *         @f$V^*@f$.
+ *
+ * @throw std::runtime_error Thrown if the computation does not converge.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+svd(const expression<Container, T, 2> &a, bool full_matrices = true);
+
+/**
+ * @brief Compute the singular values of a matrix.
+ *
+ * @details The matrix is reduced to bidiagonal form as in @c svd. Since the
+ * singular vectors are not formed, the singular values of the bidiagonal
+ * matrix are computed in quadratic time.
+ *
+ * @param a A matrix of size m x n.
+ *
+ * @return The min(m, n) singular values, in descending order.
+ *
+ * @throw std::runtime_error Thrown if the computation does not converge.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+tensor<typename detail::complex_traits<T>::value_type, 1>
+svdvals(const expression<Container, T, 2> &a);
+
+/**
+ * @brief Compute the (Moore-Penrose) pseudo-inverse of a matrix from its
+ * singular value decomposition.
+ *
+ * @param a A matrix of size m x n.
+ * @param rcond Cutoff for small singular values. Singular values less than
+ *              or equal to rcond times the largest singular value are
+ *              treated as zero. Defaults to 1e-15.
+ *
+ * @return The pseudo-inverse, of size n x m.
+ *
+ * @throw std::runtime_error Thrown if the computation does not converge.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+tensor<T, 2> pinv(const expression<Container, T, 2> &a, double rcond = 1e-15);
+
+/**
+ * @brief Return the least-squares solution to a linear matrix equation, i.e.,
+ * the @f$x@f$ of minimum norm minimizing @f$\|Ax - b\|_2@f$.
+ *
+ * @details If the matrix has many more rows than columns, it is factorized
+ * as @f$A = QR@f$, @f$Q^*@f$ is applied to @a b without forming @f$Q@f$ and
+ * the problem is solved with the singular value decomposition of @f$R@f$.
+ * Otherwise, the singular value decomposition of the matrix is used. Unlike
+ * @c qr_factorization::solve, rank-deficient matrices are allowed.
+ *
+ * @param a A matrix of size m x n.
+ * @param b Right-hand side, either a vector of size m or a matrix of size
+ *          m x k whose columns are solved together.
+ * @param rcond Cutoff for small singular values. Singular values less than
+ *              or equal to rcond times the largest singular value are
+ *              treated as zero. If negative (default), max(m, n) times the
+ *              machine epsilon is used.
+ *
+ * @return A tuple with the solution, the squared residual norm of each
+ *         column of @a b, the rank of the matrix and its singular values. The
+ *         residuals are only returned if the matrix has full rank and more
+ *         rows than columns. Otherwise, they are empty.
+ *
+ * @throw std::invalid_argument Thrown if the number of rows of @a a and @a b
+ *                              don't match.
+ * @throw std::runtime_error Thrown if the computation does not converge.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class Container2, class T>
+std::tuple<tensor<T, 1>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>, size_t,
+           tensor<typename detail::complex_traits<T>::value_type, 1>>
+lstsq(const expression<Container1, T, 2> &a,
+      const expression<Container2, T, 1> &b, double rcond = -1);
+
+template <class Container1, class Container2, class T>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>, size_t,
+           tensor<typename detail::complex_traits<T>::value_type, 1>>
+lstsq(const expression<Container1, T, 2> &a,
+      const expression<Container2, T, 2> &b, double rcond = -1);
+
+/**
+ * @brief Return an orthonormal basis for the range of a matrix, given by its
+ * left singular vectors.
+ *
+ * @param a A matrix of size m x n.
+ * @param rcond Cutoff for small singular values. Singular values less than
+ *              or equal to rcond times the largest singular value are
+ *              treated as zero. If negative (default), max(m, n) times the
+ *              machine epsilon is used.
+ *
+ * @return A matrix of size m x r, where r is the effective rank of @a a,
+ *         whose columns are an orthonormal basis for its range.
+ *
+ * @throw std::runtime_error Thrown if the computation does not converge.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+tensor<T, 2> orth(const expression<Container, T, 2> &a, double rcond = -1);
+
+/**
+ * @brief Compute an approximate truncated singular value decomposition,
+ * @f$A \approx U \Sigma V^*@f$, with the k largest singular values, by
+ * random projections.
+ *
+ * @details The range of the matrix is sampled by multiplying it with a
+ * Gaussian random matrix of k + oversample columns. The sample is refined
+ * by @a n_iter power iterations, which sharpen the separation between the
+ * leading and the trailing singular values, and is orthonormalized after
+ * every product for numerical stability. Finally, the matrix is projected
+ * onto the sampled range and the small projection is decomposed with
+ * @c svd. All the products with the matrix are done with blocked matrix
+ * multiplications, and tensor views are referenced without being copied.
+ *
+ * This is much faster than @c svd when k is small compared to the size of
+ * the matrix. The approximation is close to optimal when the singular values
+ * decay quickly; otherwise, more power iterations improve its accuracy.
+ *
+ * @param a A matrix of size m x n.
+ * @param k Number of singular values and vectors to compute.
+ * @param oversample Number of additional random samples. Defaults to 10.
+ * @param n_iter Number of power iterations. Defaults to 2.
+ * @param rng Random number generator used for the random projections. If not
+ *            provided, a @c default_rng with default seed is used.
+ *
+ * @return A tuple with @f$U@f$ of size m x k, the k largest singular values
+ *         in descending order and @f$V^*@f$ of size k x n.
+ *
+ * @throw std::invalid_argument Thrown if k is greater than min(m, n).
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+randomized_svd(const expression<Container, T, 2> &a, size_t k,
+               size_t oversample = 10, size_t n_iter = 2);
+
+template <class Container, class T, class bit_generator>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+randomized_svd(const expression<Container, T, 2> &a, size_t k,
+               size_t oversample, size_t n_iter, Generator<bit_generator> &rng);
+
+/**
+ * @brief Compute an approximate truncated singular value decomposition of a
+ * matrix which is read by blocks of rows, such as a matrix which doesn't fit
+ * in memory, a memory-mapped file or a matrix computed on the fly.
+ *
+ * @details The algorithm is the same as in the in-memory version. The matrix
+ * is read exactly 2 * n_iter + 2 times, each time from the first to the last
+ * row, and only a block of rows is kept in memory at a time.
+ *
+ * @tparam T Type of the elements of the matrix.
+ *
+ * @param shape Shape of the matrix, (m, n).
+ * @param read_rows A function with signature
+ *                  @code
+ *                  void read_rows(size_t first, tensor<T, 2> &block);
+ *                  @endcode
+ *                  which fills @a block with the rows first, ...,
+ *                  first + block.shape(0) - 1 of the matrix.
+ * @param k Number of singular values and vectors to compute.
+ * @param oversample Number of additional random samples. Defaults to 10.
+ * @param n_iter Number of power iterations. Defaults to 2.
+ * @param rng Random number generator used for the random projections. If not
+ *            provided, a @c default_rng with default seed is used.
+ *
+ * @return A tuple with @f$U@f$ of size m x k, the k largest singular values
+ *         in descending order and @f$V^*@f$ of size k x n.
+ *
+ * @throw std::invalid_argument Thrown if k is greater than min(m, n).
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class T, class Function>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+randomized_svd(const shape_t<2> &shape, Function &&read_rows, size_t k,
+               size_t oversample = 10, size_t n_iter = 2);
+
+template <class T, class Function, class bit_generator>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+randomized_svd(const shape_t<2> &shape, Function &&read_rows, size_t k,
+               size_t oversample, size_t n_iter, Generator<bit_generator> &rng);
+
+/**
+ * @brief Solve a linear system @f$Ax = b@f$ with a Hermitian positive-definite
+ * matrix by the preconditioned conjugate gradient method.
+ *
+ * @details Each iteration computes one product with the matrix and one
+ * application of the preconditioner, which must also be Hermitian
+ * positive-definite. The work vectors are allocated once, before the first
+ * iteration.
+ *
+ * @param a The matrix of the system. Either a dense matrix, a csr_matrix or a
+ *          function with signature
+ *          @code
+ *          void a(const tensor<T, 1> &x, tensor<T, 1> &y);
+ *          @endcode
+ *          which computes @f$y = Ax@f$. The result must be written in
+ *          place into @a y, which already has the size of @a x.
+ * @param b Right-hand side.
+ * @param x On entry, the initial guess. On exit, the approximate solution.
+ * @param m Preconditioner. A function with signature
+ *          @code
+ *          void m(const tensor<T, 1> &r, tensor<T, 1> &z);
+ *          @endcode
+ *          which computes @f$z = M^{-1}r@f$, such as a jacobi_preconditioner,
+ *          an ilu0_preconditioner or a ssor_preconditioner. The result must
+ *          be written in place into @a z, which already has the size of
+ *          @a r. If not provided, no preconditioning is used.
+ * @param rtol, atol The iteration stops when the norm of the residual is at
+ *                   most max(rtol * norm(b), atol). Defaults to 1e-5 and 0.
+ * @param maxiter Maximum number of iterations. If 0 (the default), it is 10
+ *                times the size of the system.
+ *
+ * @return A convergence_info object with whether the tolerance was reached,
+ *         the number of iterations and the history of the residual norms.
+ *
+ * @throw std::invalid_argument Thrown if the sizes of @a a, @a b and @a x
+ *                              don't match.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Operator, class T, class Preconditioner>
+typename detail::preconditioned_result<Preconditioner, T>::type
+cg(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+   const Preconditioner &m, double rtol = 1e-5, double atol = 0,
+   size_t maxiter = 0);
+
+template <class Operator, class T>
+convergence_info<typename detail::complex_traits<T>::value_type>
+cg(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+   double rtol = 1e-5, double atol = 0, size_t maxiter = 0);
+
+/**
+ * @brief Solve a linear system @f$Ax = b@f$ with a Hermitian, possibly
+ * indefinite, matrix by the preconditioned minimum residual method.
+ *
+ * @details Each iteration computes one product with the matrix and one
+ * application of the preconditioner, which must be Hermitian
+ * positive-definite. When a preconditioner is given, the norms of the
+ * residuals, both in the history and in the stopping criterion, are measured
+ * in the norm induced by @f$M^{-1}@f$, i.e., @f$\sqrt{r^* M^{-1} r}@f$.
+ *
+ * @param a The matrix of the system. Either a dense matrix, a csr_matrix or a
+ *          function with signature
+ *          @code
+ *          void a(const tensor<T, 1> &x, tensor<T, 1> &y);
+ *          @endcode
+ *          which computes @f$y = Ax@f$. The result must be written in
+ *          place into @a y, which already has the size of @a x.
+ * @param b Right-hand side.
+ * @param x On entry, the initial guess. On exit, the approximate solution.
+ * @param m Preconditioner. A function with signature
+ *          @code
+ *          void m(const tensor<T, 1> &r, tensor<T, 1> &z);
+ *          @endcode
+ *          which computes @f$z = M^{-1}r@f$, such as a jacobi_preconditioner,
+ *          an ilu0_preconditioner or a ssor_preconditioner. The result must
+ *          be written in place into @a z, which already has the size of
+ *          @a r. If not provided, no preconditioning is used.
+ * @param rtol, atol The iteration stops when the norm of the residual is at
+ *                   most max(rtol * norm(b), atol). Defaults to 1e-5 and 0.
+ * @param maxiter Maximum number of iterations. If 0 (the default), it is 10
+ *                times the size of the system.
+ *
+ * @return A convergence_info object with whether the tolerance was reached,
+ *         the number of iterations and the history of the residual norms.
+ *
+ * @throw std::invalid_argument Thrown if the sizes of @a a, @a b and @a x
+ *                              don't match, or if the preconditioner is
+ *                              not positive definite.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Operator, class T, class Preconditioner>
+typename detail::preconditioned_result<Preconditioner, T>::type
+minres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+       const Preconditioner &m, double rtol = 1e-5, double atol = 0,
+       size_t maxiter = 0);
+
+template <class Operator, class T>
+convergence_info<typename detail::complex_traits<T>::value_type>
+minres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+       double rtol = 1e-5, double atol = 0, size_t maxiter = 0);
+
+/**
+ * @brief Solve a general linear system @f$Ax = b@f$ by the restarted
+ * generalized minimum residual method, GMRES(restart).
+ *
+ * @details The preconditioner is applied on the right, so the residual norms
+ * are those of the original system. Each iteration computes one product with
+ * the matrix and one application of the preconditioner, and keeps one more
+ * vector of the Krylov basis, up to restart + 1 vectors of size n. The
+ * solver is restarted from the current solution once the basis is full.
+ *
+ * @param a The matrix of the system. Either a dense matrix, a csr_matrix or a
+ *          function with signature
+ *          @code
+ *          void a(const tensor<T, 1> &x, tensor<T, 1> &y);
+ *          @endcode
+ *          which computes @f$y = Ax@f$. The result must be written in
+ *          place into @a y, which already has the size of @a x.
+ * @param b Right-hand side.
+ * @param x On entry, the initial guess. On exit, the approximate solution.
+ * @param m Preconditioner. A function with signature
+ *          @code
+ *          void m(const tensor<T, 1> &r, tensor<T, 1> &z);
+ *          @endcode
+ *          which computes @f$z = M^{-1}r@f$, such as a jacobi_preconditioner,
+ *          an ilu0_preconditioner or a ssor_preconditioner. The result must
+ *          be written in place into @a z, which already has the size of
+ *          @a r. If not provided, no preconditioning is used.
+ * @param rtol, atol The iteration stops when the norm of the residual is at
+ *                   most max(rtol * norm(b), atol). Defaults to 1e-5 and 0.
+ * @param restart Number of iterations between restarts. Defaults to 20.
+ * @param maxiter Maximum number of iterations, counted across restarts. If 0
+ *                (the default), it is 10 times the size of the system.
+ *
+ * @return A convergence_info object with whether the tolerance was reached,
+ *         the number of iterations and the history of the residual norms.
+ *
+ * @throw std::invalid_argument Thrown if the sizes of @a a, @a b and @a x
+ *                              don't match, or if @a restart is 0.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Operator, class T, class Preconditioner>
+typename detail::preconditioned_result<Preconditioner, T>::type
+gmres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+      const Preconditioner &m, double rtol = 1e-5, double atol = 0,
+      size_t restart = 20, size_t maxiter = 0);
+
+template <class Operator, class T>
+convergence_info<typename detail::complex_traits<T>::value_type>
+gmres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+      double rtol = 1e-5, double atol = 0, size_t restart = 20,
+      size_t maxiter = 0);
+
+/**
+ * @brief Solve a general linear system @f$Ax = b@f$ by the stabilized
+ * biconjugate gradient method, BiCGSTAB.
+ *
+ * @details The preconditioner is applied on the right, so the residual norms
+ * are those of the original system. Each iteration computes two products
+ * with the matrix and two applications of the preconditioner. The iteration
+ * stops early, without converging, on a breakdown of the method.
+ *
+ * @param a The matrix of the system. Either a dense matrix, a csr_matrix or a
+ *          function with signature
+ *          @code
+ *          void a(const tensor<T, 1> &x, tensor<T, 1> &y);
+ *          @endcode
+ *          which computes @f$y = Ax@f$. The result must be written in
+ *          place into @a y, which already has the size of @a x.
+ * @param b Right-hand side.
+ * @param x On entry, the initial guess. On exit, the approximate solution.
+ * @param m Preconditioner. A function with signature
+ *          @code
+ *          void m(const tensor<T, 1> &r, tensor<T, 1> &z);
+ *          @endcode
+ *          which computes @f$z = M^{-1}r@f$, such as a jacobi_preconditioner,
+ *          an ilu0_preconditioner or a ssor_preconditioner. The result must
+ *          be written in place into @a z, which already has the size of
+ *          @a r. If not provided, no preconditioning is used.
+ * @param rtol, atol The iteration stops when the norm of the residual is at
+ *                   most max(rtol * norm(b), atol). Defaults to 1e-5 and 0.
+ * @param maxiter Maximum number of iterations. If 0 (the default), it is 10
+ *                times the size of the system.
+ *
+ * @return A convergence_info object with whether the tolerance was reached,
+ *         the number of iterations and the history of the residual norms.
+ *
+ * @throw std::invalid_argument Thrown if the sizes of @a a, @a b and @a x
+ *                              don't match.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Operator, class T, class Preconditioner>
+typename detail::preconditioned_result<Preconditioner, T>::type
+bicgstab(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+         const Preconditioner &m, double rtol = 1e-5, double atol = 0,
+         size_t maxiter = 0);
+
+template <class Operator, class T>
+convergence_info<typename detail::complex_traits<T>::value_type>
+bicgstab(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+         double rtol = 1e-5, double atol = 0, size_t maxiter = 0);
 } // namespace linalg
 
 /**
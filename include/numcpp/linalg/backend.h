@@ -0,0 +1,767 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/backend.h
+ *  This header routes the linear algebra kernels to an external BLAS and
+ *  LAPACK implementation, such as OpenBLAS or MKL. When the library is
+ *  compiled with NUMCPP_USE_BLAS defined (for example, with the
+ *  -DNUMCPP_USE_BLAS flag), matrix products and triangular solves are
+ *  computed by the CBLAS interface, declared in <cblas.h> or in the header
+ *  given by NUMCPP_CBLAS_HEADER. When NUMCPP_USE_LAPACK is defined, the LU,
+ *  Cholesky, Hermitian eigenvalue and singular value decompositions are
+ *  computed by the Fortran LAPACK routines. In both cases, the program must
+ *  be linked against the library (for example, with -lopenblas). Only float,
+ *  double and complex matrices whose rows or columns are contiguous are
+ *  routed; any other operation falls back to the built-in kernels.
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_BACKEND_H_INCLUDED
+#define NUMCPP_BACKEND_H_INCLUDED
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "numcpp/config.h"
+
+#ifdef NUMCPP_USE_BLAS
+#ifdef NUMCPP_CBLAS_HEADER
+#include NUMCPP_CBLAS_HEADER
+#else
+#include <cblas.h>
+#endif
+#endif
+
+namespace numcpp {
+namespace detail {
+template <class T> struct strided_matrix;
+
+/**
+ * @brief Integer type of the dimensions passed to BLAS and LAPACK. Define
+ * NUMCPP_BLAS_INT to override it when linking against a library with 64-bit
+ * integers.
+ */
+#ifdef NUMCPP_BLAS_INT
+typedef NUMCPP_BLAS_INT blas_int;
+#else
+typedef int blas_int;
+#endif
+
+/**
+ * @brief Whether the elements of a matrix have a type supported by BLAS and
+ * LAPACK.
+ */
+template <class T> struct is_blas_type : std::false_type {};
+
+template <> struct is_blas_type<float> : std::true_type {};
+
+template <> struct is_blas_type<double> : std::true_type {};
+
+template <> struct is_blas_type<std::complex<float>> : std::true_type {};
+
+template <> struct is_blas_type<std::complex<double>> : std::true_type {};
+
+/**
+ * @brief Whether the operations on matrices of type T are routed to BLAS and
+ * LAPACK, respectively.
+ */
+#ifdef NUMCPP_USE_BLAS
+template <class T> struct use_blas : is_blas_type<T> {};
+#else
+template <class T> struct use_blas : std::false_type {};
+#endif
+
+#ifdef NUMCPP_USE_LAPACK
+template <class T> struct use_lapack : is_blas_type<T> {};
+#else
+template <class T> struct use_lapack : std::false_type {};
+#endif
+
+/**
+ * @brief Return whether a size can be passed to BLAS and LAPACK.
+ */
+inline bool fits_blas_int(size_t n) {
+  return n <= size_t(std::numeric_limits<blas_int>::max());
+}
+
+/**
+ * @brief Describe a matrix as an operand of BLAS. Returns false if neither
+ * its rows nor its columns are contiguous. Otherwise, @a row_major is set to
+ * whether its rows are contiguous and @a ld to its leading dimension. The
+ * stride along an axis of size one is irrelevant and is ignored.
+ */
+template <class T>
+bool blas_operand(const strided_matrix<T> &a, bool &row_major, blas_int &ld) {
+  ptrdiff_t rows = std::max<ptrdiff_t>(a.rows, 1);
+  ptrdiff_t cols = std::max<ptrdiff_t>(a.cols, 1);
+  ptrdiff_t rs = (a.rows > 1) ? a.rs : cols;
+  ptrdiff_t cs = (a.cols > 1) ? a.cs : rows;
+  if (!fits_blas_int(a.rows) || !fits_blas_int(a.cols)) {
+    return false;
+  }
+  if (cs == 1 && rs >= cols && fits_blas_int(rs)) {
+    row_major = true;
+    ld = blas_int(rs);
+    return true;
+  }
+  if (rs == 1 && cs >= rows && fits_blas_int(cs)) {
+    row_major = false;
+    ld = blas_int(cs);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Return the stride of a vector stored as a matrix with a single
+ * column, or 0 if it can't be passed to BLAS.
+ */
+template <class T> blas_int blas_increment(const strided_matrix<T> &x) {
+  if (x.rows <= 1) {
+    return 1;
+  }
+  return (x.rs > 0 && fits_blas_int(x.rs)) ? blas_int(x.rs) : 0;
+}
+
+#ifdef NUMCPP_USE_BLAS
+/// Overloads of the CBLAS routines for each type.
+
+inline void blas_gemm(CBLAS_ORDER order, CBLAS_TRANSPOSE trans_a,
+                      CBLAS_TRANSPOSE trans_b, blas_int m, blas_int n,
+                      blas_int k, float alpha, const float *a, blas_int lda,
+                      const float *b, blas_int ldb, float beta, float *c,
+                      blas_int ldc) {
+  cblas_sgemm(order, trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c,
+              ldc);
+}
+
+inline void blas_gemm(CBLAS_ORDER order, CBLAS_TRANSPOSE trans_a,
+                      CBLAS_TRANSPOSE trans_b, blas_int m, blas_int n,
+                      blas_int k, double alpha, const double *a, blas_int lda,
+                      const double *b, blas_int ldb, double beta, double *c,
+                      blas_int ldc) {
+  cblas_dgemm(order, trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c,
+              ldc);
+}
+
+inline void blas_gemm(CBLAS_ORDER order, CBLAS_TRANSPOSE trans_a,
+                      CBLAS_TRANSPOSE trans_b, blas_int m, blas_int n,
+                      blas_int k, std::complex<float> alpha,
+                      const std::complex<float> *a, blas_int lda,
+                      const std::complex<float> *b, blas_int ldb,
+                      std::complex<float> beta, std::complex<float> *c,
+                      blas_int ldc) {
+  cblas_cgemm(order, trans_a, trans_b, m, n, k,
+              reinterpret_cast<const float *>(&alpha),
+              reinterpret_cast<const float *>(a), lda,
+              reinterpret_cast<const float *>(b), ldb,
+              reinterpret_cast<const float *>(&beta),
+              reinterpret_cast<float *>(c), ldc);
+}
+
+inline void blas_gemm(CBLAS_ORDER order, CBLAS_TRANSPOSE trans_a,
+                      CBLAS_TRANSPOSE trans_b, blas_int m, blas_int n,
+                      blas_int k, std::complex<double> alpha,
+                      const std::complex<double> *a, blas_int lda,
+                      const std::complex<double> *b, blas_int ldb,
+                      std::complex<double> beta, std::complex<double> *c,
+                      blas_int ldc) {
+  cblas_zgemm(order, trans_a, trans_b, m, n, k,
+              reinterpret_cast<const double *>(&alpha),
+              reinterpret_cast<const double *>(a), lda,
+              reinterpret_cast<const double *>(b), ldb,
+              reinterpret_cast<const double *>(&beta),
+              reinterpret_cast<double *>(c), ldc);
+}
+
+inline void blas_gemv(CBLAS_ORDER order, blas_int m, blas_int n, float alpha,
+                      const float *a, blas_int lda, const float *x,
+                      blas_int incx, float *y, blas_int incy) {
+  cblas_sgemv(order, CblasNoTrans, m, n, alpha, a, lda, x, incx, 1.0f, y,
+              incy);
+}
+
+inline void blas_gemv(CBLAS_ORDER order, blas_int m, blas_int n, double alpha,
+                      const double *a, blas_int lda, const double *x,
+                      blas_int incx, double *y, blas_int incy) {
+  cblas_dgemv(order, CblasNoTrans, m, n, alpha, a, lda, x, incx, 1.0, y, incy);
+}
+
+inline void blas_gemv(CBLAS_ORDER order, blas_int m, blas_int n,
+                      std::complex<float> alpha, const std::complex<float> *a,
+                      blas_int lda, const std::complex<float> *x,
+                      blas_int incx, std::complex<float> *y, blas_int incy) {
+  const std::complex<float> beta(1);
+  cblas_cgemv(order, CblasNoTrans, m, n,
+              reinterpret_cast<const float *>(&alpha),
+              reinterpret_cast<const float *>(a), lda,
+              reinterpret_cast<const float *>(x), incx,
+              reinterpret_cast<const float *>(&beta),
+              reinterpret_cast<float *>(y), incy);
+}
+
+inline void blas_gemv(CBLAS_ORDER order, blas_int m, blas_int n,
+                      std::complex<double> alpha,
+                      const std::complex<double> *a, blas_int lda,
+                      const std::complex<double> *x, blas_int incx,
+                      std::complex<double> *y, blas_int incy) {
+  const std::complex<double> beta(1);
+  cblas_zgemv(order, CblasNoTrans, m, n,
+              reinterpret_cast<const double *>(&alpha),
+              reinterpret_cast<const double *>(a), lda,
+              reinterpret_cast<const double *>(x), incx,
+              reinterpret_cast<const double *>(&beta),
+              reinterpret_cast<double *>(y), incy);
+}
+
+inline void blas_trsm(CBLAS_ORDER order, CBLAS_UPLO uplo,
+                      CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, blas_int m,
+                      blas_int n, const float *a, blas_int lda, float *b,
+                      blas_int ldb) {
+  cblas_strsm(order, CblasLeft, uplo, trans, diag, m, n, 1.0f, a, lda, b,
+              ldb);
+}
+
+inline void blas_trsm(CBLAS_ORDER order, CBLAS_UPLO uplo,
+                      CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, blas_int m,
+                      blas_int n, const double *a, blas_int lda, double *b,
+                      blas_int ldb) {
+  cblas_dtrsm(order, CblasLeft, uplo, trans, diag, m, n, 1.0, a, lda, b, ldb);
+}
+
+inline void blas_trsm(CBLAS_ORDER order, CBLAS_UPLO uplo,
+                      CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, blas_int m,
+                      blas_int n, const std::complex<float> *a, blas_int lda,
+                      std::complex<float> *b, blas_int ldb) {
+  const std::complex<float> alpha(1);
+  cblas_ctrsm(order, CblasLeft, uplo, trans, diag, m, n,
+              reinterpret_cast<const float *>(&alpha),
+              reinterpret_cast<const float *>(a), lda,
+              reinterpret_cast<float *>(b), ldb);
+}
+
+inline void blas_trsm(CBLAS_ORDER order, CBLAS_UPLO uplo,
+                      CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, blas_int m,
+                      blas_int n, const std::complex<double> *a, blas_int lda,
+                      std::complex<double> *b, blas_int ldb) {
+  const std::complex<double> alpha(1);
+  cblas_ztrsm(order, CblasLeft, uplo, trans, diag, m, n,
+              reinterpret_cast<const double *>(&alpha),
+              reinterpret_cast<const double *>(a), lda,
+              reinterpret_cast<double *>(b), ldb);
+}
+#endif // NUMCPP_USE_BLAS
+
+/**
+ * @brief Compute c = alpha * a * b + beta * c with BLAS. The operands may be
+ * stored in different orders, which are passed as transposes. Returns false
+ * if the operation is not supported.
+ */
+template <class T>
+typename std::enable_if<!use_blas<T>::value, bool>::type
+external_gemm(T, const strided_matrix<const T> &,
+              const strided_matrix<const T> &, T, const strided_matrix<T> &) {
+  return false;
+}
+
+/**
+ * @brief Compute y += alpha * a * x with BLAS, where x and y are matrices
+ * with a single column. Returns false if the operation is not supported.
+ */
+template <class T>
+typename std::enable_if<!use_blas<T>::value, bool>::type
+external_gemv(T, const strided_matrix<const T> &,
+              const strided_matrix<const T> &, const strided_matrix<T> &) {
+  return false;
+}
+
+/**
+ * @brief Solve a triangular system with multiple right-hand sides in-place
+ * with BLAS. Returns false if the operation is not supported.
+ */
+template <class T>
+typename std::enable_if<!use_blas<T>::value, bool>::type
+external_trsm(const strided_matrix<const T> &, bool, bool,
+              const strided_matrix<T> &) {
+  return false;
+}
+
+#ifdef NUMCPP_USE_BLAS
+template <class T>
+typename std::enable_if<use_blas<T>::value, bool>::type
+external_gemm(T alpha, const strided_matrix<const T> &a,
+              const strided_matrix<const T> &b, T beta,
+              const strided_matrix<T> &c) {
+  bool a_row, b_row, c_row;
+  blas_int lda, ldb, ldc;
+  if (!blas_operand(a, a_row, lda) || !blas_operand(b, b_row, ldb) ||
+      !blas_operand(c, c_row, ldc)) {
+    return false;
+  }
+  blas_gemm(c_row ? CblasRowMajor : CblasColMajor,
+            (a_row == c_row) ? CblasNoTrans : CblasTrans,
+            (b_row == c_row) ? CblasNoTrans : CblasTrans, blas_int(c.rows),
+            blas_int(c.cols), blas_int(a.cols), alpha, a.data, lda, b.data,
+            ldb, beta, c.data, ldc);
+  return true;
+}
+
+template <class T>
+typename std::enable_if<use_blas<T>::value, bool>::type
+external_gemv(T alpha, const strided_matrix<const T> &a,
+              const strided_matrix<const T> &x, const strided_matrix<T> &y) {
+  bool a_row;
+  blas_int lda, incx = blas_increment(x), incy = blas_increment(y);
+  if (!blas_operand(a, a_row, lda) || incx == 0 || incy == 0) {
+    return false;
+  }
+  blas_gemv(a_row ? CblasRowMajor : CblasColMajor, blas_int(a.rows),
+            blas_int(a.cols), alpha, a.data, lda, x.data, incx, y.data, incy);
+  return true;
+}
+
+template <class T>
+typename std::enable_if<use_blas<T>::value, bool>::type
+external_trsm(const strided_matrix<const T> &a, bool lower, bool unit_diagonal,
+              const strided_matrix<T> &b) {
+  bool a_row, b_row;
+  blas_int lda, ldb;
+  if (!blas_operand(a, a_row, lda) || !blas_operand(b, b_row, ldb)) {
+    return false;
+  }
+  // A matrix stored in the other order is passed as its transpose, whose
+  // nonzero triangle is the opposite one.
+  bool transpose = (a_row != b_row);
+  blas_trsm(b_row ? CblasRowMajor : CblasColMajor,
+            (lower != transpose) ? CblasLower : CblasUpper,
+            transpose ? CblasTrans : CblasNoTrans,
+            unit_diagonal ? CblasUnit : CblasNonUnit, blas_int(b.rows),
+            blas_int(b.cols), a.data, lda, b.data, ldb);
+  return true;
+}
+#endif // NUMCPP_USE_BLAS
+
+#ifdef NUMCPP_USE_LAPACK
+/// Fortran LAPACK routines. Character arguments are followed by their
+/// lengths, which are passed as hidden arguments.
+extern "C" {
+void sgetrf_(const blas_int *m, const blas_int *n, float *a,
+             const blas_int *lda, blas_int *ipiv, blas_int *info);
+void dgetrf_(const blas_int *m, const blas_int *n, double *a,
+             const blas_int *lda, blas_int *ipiv, blas_int *info);
+void cgetrf_(const blas_int *m, const blas_int *n, std::complex<float> *a,
+             const blas_int *lda, blas_int *ipiv, blas_int *info);
+void zgetrf_(const blas_int *m, const blas_int *n, std::complex<double> *a,
+             const blas_int *lda, blas_int *ipiv, blas_int *info);
+
+void spotrf_(const char *uplo, const blas_int *n, float *a,
+             const blas_int *lda, blas_int *info, size_t);
+void dpotrf_(const char *uplo, const blas_int *n, double *a,
+             const blas_int *lda, blas_int *info, size_t);
+void cpotrf_(const char *uplo, const blas_int *n, std::complex<float> *a,
+             const blas_int *lda, blas_int *info, size_t);
+void zpotrf_(const char *uplo, const blas_int *n, std::complex<double> *a,
+             const blas_int *lda, blas_int *info, size_t);
+
+void ssyevd_(const char *jobz, const char *uplo, const blas_int *n, float *a,
+             const blas_int *lda, float *w, float *work, const blas_int *lwork,
+             blas_int *iwork, const blas_int *liwork, blas_int *info, size_t,
+             size_t);
+void dsyevd_(const char *jobz, const char *uplo, const blas_int *n, double *a,
+             const blas_int *lda, double *w, double *work,
+             const blas_int *lwork, blas_int *iwork, const blas_int *liwork,
+             blas_int *info, size_t, size_t);
+void cheevd_(const char *jobz, const char *uplo, const blas_int *n,
+             std::complex<float> *a, const blas_int *lda, float *w,
+             std::complex<float> *work, const blas_int *lwork, float *rwork,
+             const blas_int *lrwork, blas_int *iwork, const blas_int *liwork,
+             blas_int *info, size_t, size_t);
+void zheevd_(const char *jobz, const char *uplo, const blas_int *n,
+             std::complex<double> *a, const blas_int *lda, double *w,
+             std::complex<double> *work, const blas_int *lwork, double *rwork,
+             const blas_int *lrwork, blas_int *iwork, const blas_int *liwork,
+             blas_int *info, size_t, size_t);
+
+void sgesdd_(const char *jobz, const blas_int *m, const blas_int *n, float *a,
+             const blas_int *lda, float *s, float *u, const blas_int *ldu,
+             float *vt, const blas_int *ldvt, float *work,
+             const blas_int *lwork, blas_int *iwork, blas_int *info, size_t);
+void dgesdd_(const char *jobz, const blas_int *m, const blas_int *n,
+             double *a, const blas_int *lda, double *s, double *u,
+             const blas_int *ldu, double *vt, const blas_int *ldvt,
+             double *work, const blas_int *lwork, blas_int *iwork,
+             blas_int *info, size_t);
+void cgesdd_(const char *jobz, const blas_int *m, const blas_int *n,
+             std::complex<float> *a, const blas_int *lda, float *s,
+             std::complex<float> *u, const blas_int *ldu,
+             std::complex<float> *vt, const blas_int *ldvt,
+             std::complex<float> *work, const blas_int *lwork, float *rwork,
+             blas_int *iwork, blas_int *info, size_t);
+void zgesdd_(const char *jobz, const blas_int *m, const blas_int *n,
+             std::complex<double> *a, const blas_int *lda, double *s,
+             std::complex<double> *u, const blas_int *ldu,
+             std::complex<double> *vt, const blas_int *ldvt,
+             std::complex<double> *work, const blas_int *lwork,
+             double *rwork, blas_int *iwork, blas_int *info, size_t);
+}
+
+/// Overloads of the LAPACK routines for each type. Workspaces are queried
+/// and allocated by the overloads.
+
+inline void lapack_getrf(blas_int m, blas_int n, float *a, blas_int lda,
+                         blas_int *ipiv, blas_int &info) {
+  sgetrf_(&m, &n, a, &lda, ipiv, &info);
+}
+
+inline void lapack_getrf(blas_int m, blas_int n, double *a, blas_int lda,
+                         blas_int *ipiv, blas_int &info) {
+  dgetrf_(&m, &n, a, &lda, ipiv, &info);
+}
+
+inline void lapack_getrf(blas_int m, blas_int n, std::complex<float> *a,
+                         blas_int lda, blas_int *ipiv, blas_int &info) {
+  cgetrf_(&m, &n, a, &lda, ipiv, &info);
+}
+
+inline void lapack_getrf(blas_int m, blas_int n, std::complex<double> *a,
+                         blas_int lda, blas_int *ipiv, blas_int &info) {
+  zgetrf_(&m, &n, a, &lda, ipiv, &info);
+}
+
+inline void lapack_potrf(char uplo, blas_int n, float *a, blas_int lda,
+                         blas_int &info) {
+  spotrf_(&uplo, &n, a, &lda, &info, 1);
+}
+
+inline void lapack_potrf(char uplo, blas_int n, double *a, blas_int lda,
+                         blas_int &info) {
+  dpotrf_(&uplo, &n, a, &lda, &info, 1);
+}
+
+inline void lapack_potrf(char uplo, blas_int n, std::complex<float> *a,
+                         blas_int lda, blas_int &info) {
+  cpotrf_(&uplo, &n, a, &lda, &info, 1);
+}
+
+inline void lapack_potrf(char uplo, blas_int n, std::complex<double> *a,
+                         blas_int lda, blas_int &info) {
+  zpotrf_(&uplo, &n, a, &lda, &info, 1);
+}
+
+template <class T, class Routine>
+void call_syevd(Routine routine, char jobz, char uplo, blas_int n, T *a,
+                blas_int lda, T *w, blas_int &info) {
+  blas_int lwork = -1, liwork = -1, iwork_size = 0;
+  T work_size = T(0);
+  routine(&jobz, &uplo, &n, a, &lda, w, &work_size, &lwork, &iwork_size,
+          &liwork, &info, 1, 1);
+  lwork = blas_int(work_size);
+  liwork = iwork_size;
+  std::vector<T> work(std::max<blas_int>(lwork, 1));
+  std::vector<blas_int> iwork(std::max<blas_int>(liwork, 1));
+  routine(&jobz, &uplo, &n, a, &lda, w, work.data(), &lwork, iwork.data(),
+          &liwork, &info, 1, 1);
+}
+
+template <class T, class Routine>
+void call_heevd(Routine routine, char jobz, char uplo, blas_int n,
+                std::complex<T> *a, blas_int lda, T *w, blas_int &info) {
+  blas_int lwork = -1, lrwork = -1, liwork = -1, iwork_size = 0;
+  std::complex<T> work_size = T(0);
+  T rwork_size = T(0);
+  routine(&jobz, &uplo, &n, a, &lda, w, &work_size, &lwork, &rwork_size,
+          &lrwork, &iwork_size, &liwork, &info, 1, 1);
+  lwork = blas_int(work_size.real());
+  lrwork = blas_int(rwork_size);
+  liwork = iwork_size;
+  std::vector<std::complex<T>> work(std::max<blas_int>(lwork, 1));
+  std::vector<T> rwork(std::max<blas_int>(lrwork, 1));
+  std::vector<blas_int> iwork(std::max<blas_int>(liwork, 1));
+  routine(&jobz, &uplo, &n, a, &lda, w, work.data(), &lwork, rwork.data(),
+          &lrwork, iwork.data(), &liwork, &info, 1, 1);
+}
+
+inline void lapack_heevd(char jobz, char uplo, blas_int n, float *a,
+                         blas_int lda, float *w, blas_int &info) {
+  call_syevd(ssyevd_, jobz, uplo, n, a, lda, w, info);
+}
+
+inline void lapack_heevd(char jobz, char uplo, blas_int n, double *a,
+                         blas_int lda, double *w, blas_int &info) {
+  call_syevd(dsyevd_, jobz, uplo, n, a, lda, w, info);
+}
+
+inline void lapack_heevd(char jobz, char uplo, blas_int n,
+                         std::complex<float> *a, blas_int lda, float *w,
+                         blas_int &info) {
+  call_heevd(cheevd_, jobz, uplo, n, a, lda, w, info);
+}
+
+inline void lapack_heevd(char jobz, char uplo, blas_int n,
+                         std::complex<double> *a, blas_int lda, double *w,
+                         blas_int &info) {
+  call_heevd(zheevd_, jobz, uplo, n, a, lda, w, info);
+}
+
+template <class T, class Routine>
+void call_gesdd(Routine routine, char jobz, blas_int m, blas_int n, T *a,
+                blas_int lda, T *s, T *u, blas_int ldu, T *vt, blas_int ldvt,
+                blas_int &info) {
+  blas_int lwork = -1;
+  T work_size = T(0);
+  std::vector<blas_int> iwork(8 * std::min(m, n));
+  routine(&jobz, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, &work_size, &lwork,
+          iwork.data(), &info, 1);
+  lwork = blas_int(work_size);
+  std::vector<T> work(std::max<blas_int>(lwork, 1));
+  routine(&jobz, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work.data(), &lwork,
+          iwork.data(), &info, 1);
+}
+
+template <class T, class Routine>
+void call_gesdd(Routine routine, char jobz, blas_int m, blas_int n,
+                std::complex<T> *a, blas_int lda, T *s, std::complex<T> *u,
+                blas_int ldu, std::complex<T> *vt, blas_int ldvt,
+                blas_int &info) {
+  blas_int lwork = -1, mn = std::min(m, n), mx = std::max(m, n);
+  std::complex<T> work_size = T(0);
+  std::vector<T> rwork(
+      std::max<blas_int>(mn * std::max(5 * mn + 7, 2 * mx + 2 * mn + 1), 1));
+  std::vector<blas_int> iwork(8 * mn);
+  routine(&jobz, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, &work_size, &lwork,
+          rwork.data(), iwork.data(), &info, 1);
+  lwork = blas_int(work_size.real());
+  std::vector<std::complex<T>> work(std::max<blas_int>(lwork, 1));
+  routine(&jobz, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work.data(), &lwork,
+          rwork.data(), iwork.data(), &info, 1);
+}
+
+inline void lapack_gesdd(char jobz, blas_int m, blas_int n, float *a,
+                         blas_int lda, float *s, float *u, blas_int ldu,
+                         float *vt, blas_int ldvt, blas_int &info) {
+  call_gesdd(sgesdd_, jobz, m, n, a, lda, s, u, ldu, vt, ldvt, info);
+}
+
+inline void lapack_gesdd(char jobz, blas_int m, blas_int n, double *a,
+                         blas_int lda, double *s, double *u, blas_int ldu,
+                         double *vt, blas_int ldvt, blas_int &info) {
+  call_gesdd(dgesdd_, jobz, m, n, a, lda, s, u, ldu, vt, ldvt, info);
+}
+
+inline void lapack_gesdd(char jobz, blas_int m, blas_int n,
+                         std::complex<float> *a, blas_int lda, float *s,
+                         std::complex<float> *u, blas_int ldu,
+                         std::complex<float> *vt, blas_int ldvt,
+                         blas_int &info) {
+  call_gesdd(cgesdd_, jobz, m, n, a, lda, s, u, ldu, vt, ldvt, info);
+}
+
+inline void lapack_gesdd(char jobz, blas_int m, blas_int n,
+                         std::complex<double> *a, blas_int lda, double *s,
+                         std::complex<double> *u, blas_int ldu,
+                         std::complex<double> *vt, blas_int ldvt,
+                         blas_int &info) {
+  call_gesdd(zgesdd_, jobz, m, n, a, lda, s, u, ldu, vt, ldvt, info);
+}
+#endif // NUMCPP_USE_LAPACK
+
+/**
+ * @brief LU factorization with partial pivoting with LAPACK, with the same
+ * output as lu_factor. Returns false if the operation is not supported.
+ */
+template <class T>
+typename std::enable_if<!use_lapack<T>::value, bool>::type
+external_lu_factor(const strided_matrix<T> &, size_t *) {
+  return false;
+}
+
+/**
+ * @brief Cholesky factorization with LAPACK. Only the lower triangle is read
+ * and written. Returns false if the operation is not supported.
+ */
+template <class T>
+typename std::enable_if<!use_lapack<T>::value, bool>::type
+external_cholesky_factor(const strided_matrix<T> &) {
+  return false;
+}
+
+/**
+ * @brief Compute all the eigenvalues and, optionally, eigenvectors of a
+ * Hermitian matrix with LAPACK, with the same output as hermitian_eigen.
+ * Returns false if the operation is not supported.
+ */
+template <class T>
+typename std::enable_if<!use_lapack<T>::value, bool>::type
+external_hermitian_eigen(
+    const strided_matrix<T> &,
+    std::vector<typename complex_traits<T>::value_type> &, tensor<T, 2> *) {
+  return false;
+}
+
+/**
+ * @brief Compute the singular value decomposition of a matrix with LAPACK,
+ * with the same output as singular_value_decomposition. Returns false if the
+ * operation is not supported.
+ */
+template <class T>
+typename std::enable_if<!use_lapack<T>::value, bool>::type
+external_svd(tensor<T, 2> &,
+             std::vector<typename complex_traits<T>::value_type> &,
+             tensor<T, 2> *, tensor<T, 2> *, bool) {
+  return false;
+}
+
+#ifdef NUMCPP_USE_LAPACK
+template <class T>
+typename std::enable_if<use_lapack<T>::value, bool>::type
+external_lu_factor(const strided_matrix<T> &a, size_t *ipiv) {
+  size_t m = a.rows, n = a.cols, k = std::min(m, n);
+  bool row_major;
+  blas_int lda;
+  if (k == 0 || !blas_operand(a, row_major, lda)) {
+    return false;
+  }
+  // LAPACK stores matrices by columns. Other matrices are factorized in a
+  // column-major copy.
+  std::vector<T> buffer;
+  strided_matrix<T> b = a;
+  if (row_major) {
+    buffer.resize(m * n);
+    b = strided_matrix<T>(buffer.data(), m, n, 1, m);
+    lda = blas_int(m);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        b(i, j) = a(i, j);
+      }
+    }
+  }
+  std::vector<blas_int> piv(k);
+  blas_int info;
+  lapack_getrf(blas_int(m), blas_int(n), b.data, lda, piv.data(), info);
+  if (row_major) {
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        a(i, j) = b(i, j);
+      }
+    }
+  }
+  for (size_t i = 0; i < k; ++i) {
+    ipiv[i] = size_t(piv[i] - 1);
+  }
+  return true;
+}
+
+template <class T>
+typename std::enable_if<use_lapack<T>::value, bool>::type
+external_cholesky_factor(const strided_matrix<T> &a) {
+  bool row_major;
+  blas_int lda, info;
+  if (a.rows == 0 || !blas_operand(a, row_major, lda)) {
+    return false;
+  }
+  // LAPACK sees a row-major matrix as its transpose, which is its conjugate.
+  // The factor of its upper triangle, conj(a) = u^H * u, is u = l^T, which
+  // is stored in the same positions as l.
+  lapack_potrf(row_major ? 'U' : 'L', blas_int(a.rows), a.data, lda, info);
+  if (info > 0) {
+    throw std::invalid_argument("matrix is not positive definite");
+  }
+  return true;
+}
+
+template <class T>
+typename std::enable_if<use_lapack<T>::value, bool>::type
+external_hermitian_eigen(
+    const strided_matrix<T> &a,
+    std::vector<typename complex_traits<T>::value_type> &w, tensor<T, 2> *v) {
+  size_t n = a.rows;
+  if (n == 0 || !fits_blas_int(n)) {
+    return false;
+  }
+  // The lower triangle is copied by columns, where the eigenvectors are
+  // returned.
+  std::vector<T> buffer(n * n);
+  strided_matrix<T> z(buffer.data(), n, n, 1, n);
+  for (size_t j = 0; j < n; ++j) {
+    for (size_t i = j; i < n; ++i) {
+      z(i, j) = a(i, j);
+    }
+  }
+  w.resize(n);
+  blas_int info;
+  lapack_heevd((v != NULL) ? 'V' : 'N', 'L', blas_int(n), z.data,
+               blas_int(n), w.data(), info);
+  if (info > 0) {
+    throw std::runtime_error("eigenvalue computation did not converge");
+  }
+  if (v != NULL) {
+    *v = tensor<T, 2>(n, n);
+    T *out = v->data();
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        out[i * n + j] = z(i, j);
+      }
+    }
+  }
+  return true;
+}
+
+template <class T>
+typename std::enable_if<use_lapack<T>::value, bool>::type
+external_svd(tensor<T, 2> &a,
+             std::vector<typename complex_traits<T>::value_type> &s,
+             tensor<T, 2> *u, tensor<T, 2> *vh, bool full) {
+  size_t m = a.shape(0), n = a.shape(1), k = std::min(m, n);
+  if (k == 0 || a.layout() != row_major || !fits_blas_int(m) ||
+      !fits_blas_int(n)) {
+    return false;
+  }
+  // LAPACK sees a row-major matrix as its transpose, a^T = vh^T * s * u^T.
+  // Its left singular vectors, stored by columns, are the rows of vh, and its
+  // right singular vectors, stored by rows, are the columns of u.
+  char jobz = 'N';
+  T unused = T(0);
+  T *udata = &unused, *vhdata = &unused;
+  blas_int ldu = 1, ldvh = 1, info;
+  if (u != NULL) {
+    size_t ucols = full ? m : k, vhrows = full ? n : k;
+    jobz = full ? 'A' : 'S';
+    *u = tensor<T, 2>(m, ucols);
+    *vh = tensor<T, 2>(vhrows, n);
+    udata = u->data();
+    vhdata = vh->data();
+    ldu = blas_int(ucols);
+    ldvh = blas_int(n);
+  }
+  s.resize(k);
+  lapack_gesdd(jobz, blas_int(n), blas_int(m), a.data(), blas_int(n),
+               s.data(), vhdata, ldvh, udata, ldu, info);
+  if (info > 0) {
+    throw std::runtime_error("singular value computation did not converge");
+  }
+  return true;
+}
+#endif // NUMCPP_USE_LAPACK
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_BACKEND_H_INCLUDED
@@ -0,0 +1,479 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/batched.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_BATCHED_H_INCLUDED
+#define NUMCPP_BATCHED_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/linalg/blas.h"
+#include "numcpp/linalg/factorization.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Maximum size of the matrices solved with the small-matrix kernels.
+ */
+const size_t small_matrix_max_size = 8;
+
+/**
+ * @brief Number of matrices processed together by the small-matrix kernels.
+ *
+ * @details The matrices are interleaved, so that element (i, j) of the l-th
+ * matrix is at position (i * cols + j) * small_matrix_lanes + l. Every
+ * operation of the kernels is then a loop over the lanes, which the compiler
+ * turns into vector instructions. Pivoting is done with selects instead of
+ * branches, so that each lane can choose a different pivot.
+ */
+const size_t small_matrix_lanes = 16;
+
+/**
+ * @brief Magnitude used to choose pivots. For complex values, it is the sum
+ * of the absolute values of the real and imaginary parts, as in LAPACK.
+ */
+template <class T> inline T pivot_abs(const T &x) { return std::abs(x); }
+
+template <class T> inline T pivot_abs(const std::complex<T> &x) {
+  return std::abs(x.real()) + std::abs(x.imag());
+}
+
+/**
+ * @brief Gaussian elimination with partial pivoting of a batch of interleaved
+ * N x N matrices, applied to interleaved right-hand sides with @a k columns.
+ *
+ * @param a The matrices. They are overwritten with the upper triangular
+ *          factors, with the inverse of the pivots on the diagonal.
+ * @param b The right-hand sides. They are overwritten with l^-1 * p^T * b.
+ *          May be null if k = 0.
+ * @param det If not null, the determinant of each matrix is stored here.
+ * @param singular Set to true for each matrix with a zero pivot.
+ */
+template <class T, size_t N>
+void small_eliminate(T *a, T *b, size_t k, T *det, bool *singular) {
+  typedef typename complex_traits<T>::value_type real_type;
+  const size_t W = small_matrix_lanes;
+  size_t piv[W];
+  real_type best[W];
+  T inv[W], factor[W];
+  if (det != NULL) {
+    std::fill(det, det + W, T(1));
+  }
+  for (size_t c = 0; c < N; ++c) {
+    for (size_t l = 0; l < W; ++l) {
+      piv[l] = c;
+      best[l] = pivot_abs(a[(c * N + c) * W + l]);
+    }
+    for (size_t r = c + 1; r < N; ++r) {
+      for (size_t l = 0; l < W; ++l) {
+        real_type val = pivot_abs(a[(r * N + c) * W + l]);
+        bool larger = best[l] < val;
+        best[l] = larger ? val : best[l];
+        piv[l] = larger ? r : piv[l];
+      }
+    }
+    for (size_t r = c + 1; r < N; ++r) {
+      for (size_t j = c; j < N; ++j) {
+        T *x = a + (c * N + j) * W, *y = a + (r * N + j) * W;
+        for (size_t l = 0; l < W; ++l) {
+          T lo = x[l], hi = y[l];
+          x[l] = (piv[l] == r) ? hi : lo;
+          y[l] = (piv[l] == r) ? lo : hi;
+        }
+      }
+      for (size_t j = 0; j < k; ++j) {
+        T *x = b + (c * k + j) * W, *y = b + (r * k + j) * W;
+        for (size_t l = 0; l < W; ++l) {
+          T lo = x[l], hi = y[l];
+          x[l] = (piv[l] == r) ? hi : lo;
+          y[l] = (piv[l] == r) ? lo : hi;
+        }
+      }
+    }
+    if (det != NULL) {
+      for (size_t l = 0; l < W; ++l) {
+        T val = a[(c * N + c) * W + l];
+        det[l] *= (piv[l] == c) ? val : -val;
+      }
+    }
+    for (size_t l = 0; l < W; ++l) {
+      T val = a[(c * N + c) * W + l];
+      singular[l] = singular[l] || (val == T(0));
+      inv[l] = (val == T(0)) ? T(0) : T(1) / val;
+      a[(c * N + c) * W + l] = inv[l];
+    }
+    for (size_t r = c + 1; r < N; ++r) {
+      for (size_t l = 0; l < W; ++l) {
+        factor[l] = a[(r * N + c) * W + l] * inv[l];
+      }
+      for (size_t j = c + 1; j < N; ++j) {
+        T *x = a + (c * N + j) * W, *y = a + (r * N + j) * W;
+        for (size_t l = 0; l < W; ++l) {
+          y[l] -= factor[l] * x[l];
+        }
+      }
+      for (size_t j = 0; j < k; ++j) {
+        T *x = b + (c * k + j) * W, *y = b + (r * k + j) * W;
+        for (size_t l = 0; l < W; ++l) {
+          y[l] -= factor[l] * x[l];
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Solve a batch of interleaved N x N systems with @a k right-hand
+ * sides each. The right-hand sides are overwritten with the solutions.
+ */
+template <class T, size_t N>
+void small_solve(T *a, T *b, size_t k, bool *singular) {
+  const size_t W = small_matrix_lanes;
+  small_eliminate<T, N>(a, b, k, NULL, singular);
+  for (size_t c = N; c > 0; --c) {
+    for (size_t j = 0; j < k; ++j) {
+      T *y = b + ((c - 1) * k + j) * W;
+      for (size_t p = c; p < N; ++p) {
+        const T *u = a + ((c - 1) * N + p) * W, *x = b + (p * k + j) * W;
+        for (size_t l = 0; l < W; ++l) {
+          y[l] -= u[l] * x[l];
+        }
+      }
+      const T *inv = a + ((c - 1) * N + c - 1) * W;
+      for (size_t l = 0; l < W; ++l) {
+        y[l] *= inv[l];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Cholesky factorization of a batch of interleaved N x N matrices.
+ * Only the lower triangle is read. The matrices are overwritten with their
+ * lower triangular factors.
+ *
+ * @param failed Set to true for each matrix that is not positive definite.
+ */
+template <class T, size_t N> void small_cholesky(T *a, bool *failed) {
+  typedef typename complex_traits<T>::value_type real_type;
+  const size_t W = small_matrix_lanes;
+  real_type diag[W];
+  for (size_t j = 0; j < N; ++j) {
+    for (size_t l = 0; l < W; ++l) {
+      diag[l] = std::real(a[(j * N + j) * W + l]);
+    }
+    for (size_t p = 0; p < j; ++p) {
+      const T *x = a + (j * N + p) * W;
+      for (size_t l = 0; l < W; ++l) {
+        diag[l] -= std::norm(x[l]);
+      }
+    }
+    for (size_t l = 0; l < W; ++l) {
+      bool positive = diag[l] > real_type(0);
+      failed[l] = failed[l] || !positive;
+      diag[l] = positive ? std::sqrt(diag[l]) : real_type(1);
+      a[(j * N + j) * W + l] = diag[l];
+    }
+    for (size_t i = j + 1; i < N; ++i) {
+      T *y = a + (i * N + j) * W;
+      for (size_t p = 0; p < j; ++p) {
+        const T *u = a + (i * N + p) * W, *v = a + (j * N + p) * W;
+        for (size_t l = 0; l < W; ++l) {
+          y[l] -= u[l] * conj_value(v[l]);
+        }
+      }
+      for (size_t l = 0; l < W; ++l) {
+        y[l] /= diag[l];
+      }
+    }
+    for (size_t i = 0; i < j; ++i) {
+      std::fill_n(a + (i * N + j) * W, W, T(0));
+    }
+  }
+}
+
+/**
+ * @brief Copy a group of at most small_matrix_lanes matrices of size m x n,
+ * stored contiguously, into interleaved storage. Missing lanes are filled
+ * with the identity matrix.
+ */
+template <class T>
+void interleave(const T *in, size_t count, size_t m, size_t n, T *out) {
+  const size_t W = small_matrix_lanes;
+  for (size_t l = 0; l < W; ++l) {
+    for (size_t i = 0; i < m * n; ++i) {
+      out[i * W + l] = (l < count) ? in[l * m * n + i]
+                                   : T((i / n == i % n) ? 1 : 0);
+    }
+  }
+}
+
+/**
+ * @brief Copy the first @a count lanes of interleaved matrices of size
+ * m x n back into contiguous storage.
+ */
+template <class T>
+void deinterleave(const T *in, size_t count, size_t m, size_t n, T *out) {
+  const size_t W = small_matrix_lanes;
+  for (size_t l = 0; l < count; ++l) {
+    for (size_t i = 0; i < m * n; ++i) {
+      out[l * m * n + i] = in[i * W + l];
+    }
+  }
+}
+
+/**
+ * @brief Call @a f(first, last) on consecutive ranges of a batch of
+ * @a count matrices, in parallel. @a work is the number of operations per
+ * matrix. If @a group is greater than 1, the range boundaries are multiples
+ * of @a group.
+ */
+template <class Function>
+void parallel_batch(size_t count, size_t work, size_t group, Function &&f) {
+  size_t groups = (count + group - 1) / group;
+  size_t tasks = num_tasks(count * work, groups);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, groups) * group;
+    size_t last = std::min(count, block_begin(task + 1, tasks, groups) * group);
+    f(first, last);
+  });
+}
+
+/**
+ * @brief Solve a batch of small systems with the interleaved kernels.
+ */
+template <class T, size_t N>
+bool small_solve_batch(const T *a, T *b, size_t count, size_t k) {
+  const size_t W = small_matrix_lanes;
+  std::vector<char> singular((count + W - 1) / W, 0);
+  parallel_batch(count, N * N * (N + k), W, [&](size_t first, size_t last) {
+    std::vector<T> sa(N * N * W), sb(N * k * W);
+    for (size_t i = first; i < last; i += W) {
+      size_t lanes = std::min(W, last - i);
+      bool flags[W] = {};
+      interleave(a + i * N * N, lanes, N, N, sa.data());
+      interleave(b + i * N * k, lanes, N, k, sb.data());
+      small_solve<T, N>(sa.data(), sb.data(), k, flags);
+      deinterleave(sb.data(), lanes, N, k, b + i * N * k);
+      singular[i / W] = std::count(flags, flags + W, true) > 0;
+    }
+  });
+  return std::count(singular.begin(), singular.end(), 1) == 0;
+}
+
+template <class T, size_t N>
+void small_det_batch(const T *a, T *out, size_t count) {
+  const size_t W = small_matrix_lanes;
+  parallel_batch(count, N * N * N, W, [&](size_t first, size_t last) {
+    std::vector<T> sa(N * N * W);
+    T det[W];
+    for (size_t i = first; i < last; i += W) {
+      size_t lanes = std::min(W, last - i);
+      bool flags[W] = {};
+      interleave(a + i * N * N, lanes, N, N, sa.data());
+      small_eliminate<T, N>(sa.data(), NULL, 0, det, flags);
+      std::copy(det, det + lanes, out + i);
+    }
+  });
+}
+
+template <class T, size_t N> bool small_cholesky_batch(T *a, size_t count) {
+  const size_t W = small_matrix_lanes;
+  std::vector<char> failed((count + W - 1) / W, 0);
+  parallel_batch(count, N * N * N, W, [&](size_t first, size_t last) {
+    std::vector<T> sa(N * N * W);
+    for (size_t i = first; i < last; i += W) {
+      size_t lanes = std::min(W, last - i);
+      bool flags[W] = {};
+      interleave(a + i * N * N, lanes, N, N, sa.data());
+      small_cholesky<T, N>(sa.data(), flags);
+      deinterleave(sa.data(), lanes, N, N, a + i * N * N);
+      failed[i / W] = std::count(flags, flags + W, true) > 0;
+    }
+  });
+  return std::count(failed.begin(), failed.end(), 1) == 0;
+}
+
+/**
+ * @brief Solve a batch of square systems stored contiguously in row-major
+ * order. Matrices of size at most small_matrix_max_size are solved with the
+ * interleaved kernels, and larger ones, with the blocked LU factorization.
+ *
+ * @param a A batch of @a count matrices of size n x n. It is overwritten.
+ * @param b A batch of @a count matrices of size n x k. It is overwritten with
+ *          the solutions.
+ *
+ * @throw std::invalid_argument Thrown if any matrix is singular.
+ */
+template <class T>
+void solve_batch(T *a, T *b, size_t count, size_t n, size_t k) {
+  bool ok = true;
+  switch (n) {
+  case 0:
+    break;
+  case 1:
+    ok = small_solve_batch<T, 1>(a, b, count, k);
+    break;
+  case 2:
+    ok = small_solve_batch<T, 2>(a, b, count, k);
+    break;
+  case 3:
+    ok = small_solve_batch<T, 3>(a, b, count, k);
+    break;
+  case 4:
+    ok = small_solve_batch<T, 4>(a, b, count, k);
+    break;
+  case 5:
+    ok = small_solve_batch<T, 5>(a, b, count, k);
+    break;
+  case 6:
+    ok = small_solve_batch<T, 6>(a, b, count, k);
+    break;
+  case 7:
+    ok = small_solve_batch<T, 7>(a, b, count, k);
+    break;
+  case 8:
+    ok = small_solve_batch<T, 8>(a, b, count, k);
+    break;
+  default:
+    std::vector<char> singular(count, 0);
+    parallel_batch(count, n * n * (n + k), 1, [&](size_t first, size_t last) {
+      std::vector<size_t> ipiv(n);
+      for (size_t i = first; i < last; ++i) {
+        strided_matrix<T> lu(a + i * n * n, n, n, n, 1);
+        lu_factor(lu, ipiv.data());
+        for (size_t j = 0; j < n; ++j) {
+          singular[i] = singular[i] || (lu(j, j) == T(0));
+        }
+        if (!singular[i]) {
+          lu_solve<T>(lu, ipiv.data(), false,
+                      strided_matrix<T>(b + i * n * k, n, k, k, 1));
+        }
+      }
+    });
+    ok = std::count(singular.begin(), singular.end(), 1) == 0;
+    break;
+  }
+  if (!ok) {
+    throw std::invalid_argument("matrix is singular");
+  }
+}
+
+/**
+ * @brief Compute the determinants of a batch of square matrices stored
+ * contiguously in row-major order. The matrices are overwritten. Integer
+ * matrices are always computed exactly by fraction-free elimination.
+ */
+template <class T> void det_batch(T *a, T *out, size_t count, size_t n) {
+  if (!std::is_integral<T>::value) {
+    switch (n) {
+    case 1:
+      small_det_batch<T, 1>(a, out, count);
+      return;
+    case 2:
+      small_det_batch<T, 2>(a, out, count);
+      return;
+    case 3:
+      small_det_batch<T, 3>(a, out, count);
+      return;
+    case 4:
+      small_det_batch<T, 4>(a, out, count);
+      return;
+    case 5:
+      small_det_batch<T, 5>(a, out, count);
+      return;
+    case 6:
+      small_det_batch<T, 6>(a, out, count);
+      return;
+    case 7:
+      small_det_batch<T, 7>(a, out, count);
+      return;
+    case 8:
+      small_det_batch<T, 8>(a, out, count);
+      return;
+    }
+  }
+  parallel_batch(count, n * n * n, 1, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      out[i] = determinant(strided_matrix<T>(a + i * n * n, n, n, n, 1),
+                           std::is_integral<T>());
+    }
+  });
+}
+
+/**
+ * @brief Compute the Cholesky factorizations of a batch of Hermitian
+ * positive-definite matrices stored contiguously in row-major order. The
+ * matrices are overwritten with their lower triangular factors.
+ *
+ * @throw std::invalid_argument Thrown if any matrix is not positive definite.
+ */
+template <class T> void cholesky_batch(T *a, size_t count, size_t n) {
+  bool ok = true;
+  switch (n) {
+  case 0:
+    break;
+  case 1:
+    ok = small_cholesky_batch<T, 1>(a, count);
+    break;
+  case 2:
+    ok = small_cholesky_batch<T, 2>(a, count);
+    break;
+  case 3:
+    ok = small_cholesky_batch<T, 3>(a, count);
+    break;
+  case 4:
+    ok = small_cholesky_batch<T, 4>(a, count);
+    break;
+  case 5:
+    ok = small_cholesky_batch<T, 5>(a, count);
+    break;
+  case 6:
+    ok = small_cholesky_batch<T, 6>(a, count);
+    break;
+  case 7:
+    ok = small_cholesky_batch<T, 7>(a, count);
+    break;
+  case 8:
+    ok = small_cholesky_batch<T, 8>(a, count);
+    break;
+  default:
+    parallel_batch(count, n * n * n, 1, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        cholesky_factor(strided_matrix<T>(a + i * n * n, n, n, n, 1));
+      }
+    });
+    break;
+  }
+  if (!ok) {
+    throw std::invalid_argument("matrix is not positive definite");
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_BATCHED_H_INCLUDED
@@ -0,0 +1,570 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/blas.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_BLAS_H_INCLUDED
+#define NUMCPP_BLAS_H_INCLUDED
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/linalg/backend.h"
+
+/**
+ * @brief Ask the compiler to fully unroll the following loop. The
+ * micro-kernel of the matrix multiplication relies on it to keep its
+ * accumulators in registers.
+ */
+#if defined(__clang__)
+#define NUMCPP_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#define NUMCPP_UNROLL _Pragma("GCC unroll 16")
+#else
+#define NUMCPP_UNROLL
+#endif
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief A non-owning reference to a matrix stored in memory with arbitrary
+ * strides. The element at row i and column j is data[i * rs + j * cs].
+ */
+template <class T> struct strided_matrix {
+  T *data;
+  size_t rows, cols;
+  ptrdiff_t rs, cs;
+
+  strided_matrix() : data(NULL), rows(0), cols(0), rs(0), cs(0) {}
+
+  strided_matrix(T *data, size_t rows, size_t cols, ptrdiff_t rs,
+                 ptrdiff_t cs)
+      : data(data), rows(rows), cols(cols), rs(rs), cs(cs) {}
+
+  /// Conversion to a read-only reference.
+  template <class U, class = typename std::enable_if<
+                         std::is_convertible<U *, T *>::value>::type>
+  strided_matrix(const strided_matrix<U> &other)
+      : data(other.data), rows(other.rows), cols(other.cols), rs(other.rs),
+        cs(other.cs) {}
+
+  T &operator()(size_t i, size_t j) const {
+    return data[ptrdiff_t(i) * rs + ptrdiff_t(j) * cs];
+  }
+
+  /// Return the submatrix of size m x n whose first element is at (i, j).
+  strided_matrix block(size_t i, size_t j, size_t m, size_t n) const {
+    return strided_matrix(data + ptrdiff_t(i) * rs + ptrdiff_t(j) * cs, m, n,
+                          rs, cs);
+  }
+
+  /// Return the transpose of the matrix.
+  strided_matrix t() const {
+    return strided_matrix(data, cols, rows, cs, rs);
+  }
+};
+
+/**
+ * @brief Return a strided reference to the elements of a matrix.
+ */
+template <class T>
+strided_matrix<T> make_strided_matrix(T *data, size_t rows, size_t cols,
+                                      layout_t order) {
+  if (order == row_major) {
+    return strided_matrix<T>(data, rows, cols, cols, 1);
+  }
+  return strided_matrix<T>(data, rows, cols, 1, rows);
+}
+
+template <class T> strided_matrix<T> make_strided_matrix(tensor<T, 2> &a) {
+  return make_strided_matrix(a.data(), a.shape(0), a.shape(1), a.layout());
+}
+
+template <class T>
+strided_matrix<const T> make_strided_matrix(const tensor<T, 2> &a) {
+  return make_strided_matrix(a.data(), a.shape(0), a.shape(1), a.layout());
+}
+
+template <class T>
+strided_matrix<T> make_strided_matrix(tensor_view<T, 2> &a) {
+  return strided_matrix<T>(a.data(), a.shape(0), a.shape(1), a.strides(0),
+                           a.strides(1));
+}
+
+template <class T>
+strided_matrix<const T> make_strided_matrix(const tensor_view<T, 2> &a) {
+  return strided_matrix<const T>(a.data(), a.shape(0), a.shape(1),
+                                 a.strides(0), a.strides(1));
+}
+
+/**
+ * @brief Return a strided reference to the elements of a matrix. Tensors and
+ * tensor views are referenced directly. Otherwise, the elements are copied
+ * into @a buffer.
+ */
+template <class T>
+inline strided_matrix<const T> make_matrix_operand(const tensor<T, 2> &a,
+                                                   tensor<T, 2> &) {
+  return make_strided_matrix(a);
+}
+
+template <class T>
+inline strided_matrix<const T>
+make_matrix_operand(const tensor_view<T, 2> &a,
+                    tensor<typename std::remove_cv<T>::type, 2> &) {
+  return make_strided_matrix(a);
+}
+
+template <class Container, class T>
+inline strided_matrix<const T>
+make_matrix_operand(const expression<Container, T, 2> &a,
+                    tensor<T, 2> &buffer) {
+  buffer = a;
+  return make_strided_matrix(static_cast<const tensor<T, 2> &>(buffer));
+}
+
+/**
+ * @brief Return a strided reference to the elements of a vector, as a matrix
+ * with a single column. Tensors and tensor views are referenced directly.
+ * Otherwise, the elements are copied into @a buffer.
+ */
+template <class T>
+inline strided_matrix<const T> make_vector_operand(const tensor<T, 1> &a,
+                                                   tensor<T, 1> &) {
+  return strided_matrix<const T>(a.data(), a.size(), 1, 1, 1);
+}
+
+template <class T>
+inline strided_matrix<const T>
+make_vector_operand(const tensor_view<T, 1> &a,
+                    tensor<typename std::remove_cv<T>::type, 1> &) {
+  return strided_matrix<const T>(a.data(), a.size(), 1, a.strides(0), 1);
+}
+
+template <class Container, class T>
+inline strided_matrix<const T>
+make_vector_operand(const expression<Container, T, 1> &a,
+                    tensor<T, 1> &buffer) {
+  buffer = a;
+  return strided_matrix<const T>(buffer.data(), buffer.size(), 1, 1, 1);
+}
+
+/**
+ * @brief Block sizes of the matrix multiplication. Each multiplication is
+ * split into blocks of gemm_mc x gemm_kc elements of the first matrix and
+ * gemm_kc x gemm_nc elements of the second matrix, which are copied into
+ * contiguous buffers sized to stay in cache. The blocks are then multiplied
+ * in tiles of gemm_mr x gemm_nr elements held in registers.
+ */
+const size_t gemm_mr = 4;
+const size_t gemm_nr = 8;
+const size_t gemm_mc = 128;
+const size_t gemm_kc = 256;
+const size_t gemm_nc = 4096;
+
+/**
+ * @brief Matrix multiplications with fewer multiply-adds than this are
+ * computed without blocking.
+ */
+const size_t gemm_small_size = 32768;
+
+/**
+ * @brief Copy a block of the first matrix into a contiguous buffer, in
+ * panels of gemm_mr rows stored column by column. The last panel is padded
+ * with zeros.
+ */
+template <class T>
+void gemm_pack_a(const strided_matrix<const T> &a, T *out) {
+  for (size_t i0 = 0; i0 < a.rows; i0 += gemm_mr) {
+    size_t mr = std::min(gemm_mr, a.rows - i0);
+    for (size_t p = 0; p < a.cols; ++p) {
+      for (size_t i = 0; i < gemm_mr; ++i) {
+        *out++ = (i < mr) ? a(i0 + i, p) : T();
+      }
+    }
+  }
+}
+
+/**
+ * @brief Copy a block of the second matrix into a contiguous buffer, in
+ * panels of gemm_nr columns stored row by row. The last panel is padded with
+ * zeros.
+ */
+template <class T>
+void gemm_pack_b(const strided_matrix<const T> &b, T *out) {
+  for (size_t j0 = 0; j0 < b.cols; j0 += gemm_nr) {
+    size_t nr = std::min(gemm_nr, b.cols - j0);
+    for (size_t p = 0; p < b.rows; ++p) {
+      for (size_t j = 0; j < gemm_nr; ++j) {
+        *out++ = (j < nr) ? b(p, j0 + j) : T();
+      }
+    }
+  }
+}
+
+/**
+ * @brief Multiply a panel of gemm_mr rows by a panel of gemm_nr columns and
+ * add the result, scaled by @a alpha, to the top-left m x n corner of @a c.
+ */
+template <class T>
+void gemm_kernel(size_t kc, const T *a, const T *b, T alpha,
+                 const strided_matrix<T> &c, size_t m, size_t n) {
+  T acc[gemm_mr][gemm_nr];
+  for (size_t i = 0; i < gemm_mr; ++i) {
+    for (size_t j = 0; j < gemm_nr; ++j) {
+      acc[i][j] = T();
+    }
+  }
+  for (size_t p = 0; p < kc; ++p) {
+    NUMCPP_UNROLL
+    for (size_t i = 0; i < gemm_mr; ++i) {
+      NUMCPP_UNROLL
+      for (size_t j = 0; j < gemm_nr; ++j) {
+        acc[i][j] += a[p * gemm_mr + i] * b[p * gemm_nr + j];
+      }
+    }
+  }
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      c(i, j) += alpha * acc[i][j];
+    }
+  }
+}
+
+/**
+ * @brief Add the product of a matrix and a vector, scaled by @a alpha, to
+ * another vector, y += alpha * a * x. The vectors are matrices with a single
+ * column. The rows of @a a are distributed among the available threads. Each
+ * element of @a y is a dot product with a row if the rows are contiguous,
+ * and otherwise the columns update a range of rows of @a y. If an external
+ * BLAS is enabled, supported operands are passed to it instead.
+ */
+template <class T>
+void gemv(T alpha, const strided_matrix<const T> &a,
+          const strided_matrix<const T> &x, const strided_matrix<T> &y) {
+  if (external_gemv(alpha, a, x, y)) {
+    return;
+  }
+  size_t m = a.rows, k = a.cols;
+  size_t tasks = num_tasks(m * k, m);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, m);
+    size_t last = block_begin(task + 1, tasks, m);
+    if (a.cs == 1) {
+      for (size_t i = first; i < last; ++i) {
+        T val = T();
+        for (size_t p = 0; p < k; ++p) {
+          val += a(i, p) * x(p, 0);
+        }
+        y(i, 0) += alpha * val;
+      }
+    } else {
+      for (size_t p = 0; p < k; ++p) {
+        T val = alpha * x(p, 0);
+        for (size_t i = first; i < last; ++i) {
+          y(i, 0) += a(i, p) * val;
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Compute the matrix product c = alpha * a * b + beta * c.
+ *
+ * @details The product is computed by blocks. For each block of the second
+ * matrix, the rows of the first matrix are split into blocks of gemm_mc rows
+ * and, if there are more threads than such blocks, the columns of the second
+ * matrix are split as well. The resulting tiles are distributed among the
+ * available threads. Products with a single row or column are computed as
+ * matrix-vector products. If an external BLAS is enabled, products which are
+ * not too small are passed to it instead, provided the rows or the columns
+ * of each matrix are contiguous.
+ *
+ * @param alpha Scalar multiplying the product.
+ * @param a A matrix of size m x k.
+ * @param b A matrix of size k x n.
+ * @param beta Scalar multiplying @a c. If zero, @a c is not read.
+ * @param c A matrix of size m x n. It must not overlap with @a a or @a b.
+ */
+template <class T>
+void gemm(T alpha, const strided_matrix<const T> &a,
+          const strided_matrix<const T> &b, T beta,
+          const strided_matrix<T> &c) {
+  size_t m = c.rows, n = c.cols, k = a.cols;
+  if (m * n * k >= gemm_small_size && external_gemm(alpha, a, b, beta, c)) {
+    return;
+  }
+  if (beta != T(1)) {
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        c(i, j) = (beta == T(0)) ? T() : beta * c(i, j);
+      }
+    }
+  }
+  if (m == 0 || n == 0 || k == 0 || alpha == T(0)) {
+    return;
+  }
+  if (n == 1) {
+    gemv(alpha, a, b, c);
+    return;
+  }
+  if (m == 1) {
+    gemv(alpha, b.t(), a.t(), c.t());
+    return;
+  }
+
+  if (m * n * k < gemm_small_size) {
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t p = 0; p < k; ++p) {
+        T val = alpha * a(i, p);
+        for (size_t j = 0; j < n; ++j) {
+          c(i, j) += val * b(p, j);
+        }
+      }
+    }
+    return;
+  }
+
+  size_t mblocks = (m + gemm_mc - 1) / gemm_mc;
+  std::vector<T> b_packed(gemm_kc * std::min(n + gemm_nr, gemm_nc));
+  for (size_t jc = 0; jc < n; jc += gemm_nc) {
+    size_t nc = std::min(gemm_nc, n - jc);
+    size_t panels = (nc + gemm_nr - 1) / gemm_nr;
+    size_t threads = num_tasks(m * nc, mblocks * panels);
+    size_t groups = std::min(panels, (threads + mblocks - 1) / mblocks);
+    size_t tiles = mblocks * groups;
+    size_t tasks = (threads > 1) ? tiles : 1;
+    for (size_t pc = 0; pc < k; pc += gemm_kc) {
+      size_t kc = std::min(gemm_kc, k - pc);
+      parallel_for(std::min(threads, panels), [&](size_t task) {
+        size_t ntasks = std::min(threads, panels);
+        size_t first = block_begin(task, ntasks, panels) * gemm_nr;
+        size_t last = std::min(nc, block_begin(task + 1, ntasks, panels) *
+                                       gemm_nr);
+        gemm_pack_b(b.block(pc, jc + first, kc, last - first),
+                    b_packed.data() + first * kc);
+      });
+      parallel_for(tasks, [&](size_t task) {
+        std::vector<T> a_packed(gemm_mc * gemm_kc);
+        size_t last_ib = mblocks;
+        for (size_t tile = block_begin(task, tasks, tiles);
+             tile < block_begin(task + 1, tasks, tiles); ++tile) {
+          size_t ib = tile / groups, group = tile % groups;
+          size_t ic = ib * gemm_mc, mc = std::min(gemm_mc, m - ic);
+          if (ib != last_ib) {
+            gemm_pack_a(a.block(ic, pc, mc, kc), a_packed.data());
+            last_ib = ib;
+          }
+          size_t first = block_begin(group, groups, panels) * gemm_nr;
+          size_t last = std::min(nc, block_begin(group + 1, groups, panels) *
+                                         gemm_nr);
+          for (size_t jr = first; jr < last; jr += gemm_nr) {
+            for (size_t ir = 0; ir < mc; ir += gemm_mr) {
+              gemm_kernel(kc, a_packed.data() + ir * kc,
+                          b_packed.data() + jr * kc, alpha,
+                          c.block(ic + ir, jc + jr, mc - ir, nc - jr),
+                          std::min(gemm_mr, mc - ir),
+                          std::min(gemm_nr, nc - jr));
+            }
+          }
+        }
+      });
+    }
+  }
+}
+
+/**
+ * @brief Number of rows of the diagonal blocks of a blocked triangular solve.
+ */
+const size_t trsm_block_size = 64;
+
+/**
+ * @brief Number of right-hand sides solved together by a thread.
+ */
+const size_t trsm_columns = 256;
+
+/**
+ * @brief Solve a small triangular system with multiple right-hand sides by
+ * substitution. The right-hand sides are distributed among the available
+ * threads.
+ */
+template <class T>
+void trsm_unblocked(const strided_matrix<const T> &a, bool lower,
+                    bool unit_diagonal, const strided_matrix<T> &b) {
+  size_t n = a.rows, chunks = (b.cols + trsm_columns - 1) / trsm_columns;
+  size_t tasks = num_tasks(n * b.cols, chunks);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, chunks) * trsm_columns;
+    size_t last =
+        std::min(b.cols, block_begin(task + 1, tasks, chunks) * trsm_columns);
+    for (size_t t = 0; t < n; ++t) {
+      size_t i = lower ? t : n - 1 - t;
+      size_t pfirst = lower ? 0 : i + 1, plast = lower ? i : n;
+      for (size_t p = pfirst; p < plast; ++p) {
+        T val = a(i, p);
+        for (size_t j = first; j < last; ++j) {
+          b(i, j) -= val * b(p, j);
+        }
+      }
+      if (!unit_diagonal) {
+        T val = a(i, i);
+        for (size_t j = first; j < last; ++j) {
+          b(i, j) /= val;
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Solve a triangular system with a few right-hand sides by
+ * substitution. Each right-hand side is solved by dot products with the rows
+ * of the matrix if these are contiguous, and otherwise by updates with its
+ * columns.
+ */
+template <class T>
+void trsv(const strided_matrix<const T> &a, bool lower, bool unit_diagonal,
+          const strided_matrix<T> &b) {
+  size_t n = a.rows;
+  for (size_t j = 0; j < b.cols; ++j) {
+    for (size_t t = 0; t < n; ++t) {
+      size_t i = lower ? t : n - 1 - t;
+      size_t first = lower ? 0 : i + 1, last = lower ? i : n;
+      if (a.cs == 1) {
+        T val = b(i, j);
+        for (size_t p = first; p < last; ++p) {
+          val -= a(i, p) * b(p, j);
+        }
+        b(i, j) = unit_diagonal ? val : val / a(i, i);
+      } else {
+        // Column i is used to update the unsolved entries below or above it.
+        if (!unit_diagonal) {
+          b(i, j) /= a(i, i);
+        }
+        T val = b(i, j);
+        first = lower ? i + 1 : 0;
+        last = lower ? n : i;
+        for (size_t p = first; p < last; ++p) {
+          b(p, j) -= a(p, i) * val;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Solve a triangular system with multiple right-hand sides in-place.
+ *
+ * @details The system is solved by blocks of trsm_block_size rows. After
+ * each diagonal block is solved, the remaining right-hand sides are updated
+ * with a matrix multiplication. Systems with fewer than gemm_nr right-hand
+ * sides are solved by substitution instead. If an external BLAS is enabled,
+ * supported operands are passed to it instead.
+ *
+ * @param a A square triangular matrix. Only the lower or upper triangle is
+ *          read.
+ * @param lower Whether @a a is lower or upper triangular.
+ * @param unit_diagonal If true, the diagonal of @a a is assumed to be all
+ *                      ones and is not read.
+ * @param b The right-hand sides. It is overwritten with the solution.
+ */
+template <class T>
+void trsm(const strided_matrix<const T> &a, bool lower, bool unit_diagonal,
+          const strided_matrix<T> &b) {
+  if (external_trsm(a, lower, unit_diagonal, b)) {
+    return;
+  }
+  size_t n = a.rows;
+  if (b.cols < gemm_nr) {
+    trsv(a, lower, unit_diagonal, b);
+    return;
+  }
+  for (size_t t = 0; t < n; t += trsm_block_size) {
+    size_t nb = std::min(trsm_block_size, n - t);
+    size_t i = lower ? t : n - t - nb;
+    trsm_unblocked(a.block(i, i, nb, nb), lower, unit_diagonal,
+                   b.block(i, 0, nb, b.cols));
+    if (lower) {
+      gemm<T>(T(-1), a.block(i + nb, i, n - i - nb, nb),
+              b.block(i, 0, nb, b.cols), T(1),
+              b.block(i + nb, 0, n - i - nb, b.cols));
+    } else {
+      gemm<T>(T(-1), a.block(0, i, i, nb), b.block(i, 0, nb, b.cols), T(1),
+              b.block(0, 0, i, b.cols));
+    }
+  }
+}
+
+/**
+ * @brief Compute the product of a triangular matrix and another matrix,
+ * c = tri(a) * b, where tri(a) keeps the elements of @a a on and below its
+ * k-th diagonal (j <= i + k) or on and above it (j >= i + k).
+ *
+ * @details The rows of @a c are computed by blocks of trsm_block_size rows.
+ * The columns of @a a which are full for every row of the block are
+ * multiplied with a matrix multiplication, and the remaining triangular part
+ * with a matrix-vector product for each row.
+ *
+ * @param a A matrix of size m x k. Only its lower or upper triangle is read.
+ * @param lower Whether to keep the lower or the upper triangle of @a a.
+ * @param offset Offset of the diagonal from the main diagonal.
+ * @param b A matrix of size k x n.
+ * @param c A matrix of size m x n. It must not overlap with @a a or @a b.
+ */
+template <class T>
+void trmm(const strided_matrix<const T> &a, bool lower, ptrdiff_t offset,
+          const strided_matrix<const T> &b, const strided_matrix<T> &c) {
+  ptrdiff_t m = a.rows, k = a.cols;
+  size_t n = c.cols;
+  // Number of columns of the triangle in row i: columns [0, i + offset + 1)
+  // if lower, or [i + offset, k) if upper.
+  auto clip = [k](ptrdiff_t j) {
+    return std::min(std::max(j, ptrdiff_t(0)), k);
+  };
+  for (ptrdiff_t i0 = 0; i0 < m; i0 += trsm_block_size) {
+    ptrdiff_t i1 = std::min(i0 + ptrdiff_t(trsm_block_size), m);
+    size_t nb = i1 - i0;
+    ptrdiff_t first = lower ? 0 : clip(i1 - 1 + offset);
+    ptrdiff_t last = lower ? clip(i0 + offset + 1) : k;
+    gemm<T>(T(1), a.block(i0, first, nb, last - first),
+            b.block(first, 0, last - first, n), T(0), c.block(i0, 0, nb, n));
+    size_t tasks = num_tasks(nb * nb * n, nb);
+    parallel_for(tasks, [&](size_t task) {
+      ptrdiff_t ifirst = i0 + block_begin(task, tasks, nb);
+      ptrdiff_t ilast = i0 + block_begin(task + 1, tasks, nb);
+      for (ptrdiff_t i = ifirst; i < ilast; ++i) {
+        ptrdiff_t pfirst = lower ? last : clip(i + offset);
+        ptrdiff_t plast = lower ? clip(i + offset + 1) : first;
+        if (pfirst < plast) {
+          gemv<T>(T(1), b.block(pfirst, 0, plast - pfirst, n).t(),
+                  a.block(i, pfirst, 1, plast - pfirst).t(),
+                  c.block(i, 0, 1, n).t());
+        }
+      }
+    });
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_BLAS_H_INCLUDED
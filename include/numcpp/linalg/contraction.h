@@ -0,0 +1,765 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/contraction.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_CONTRACTION_H_INCLUDED
+#define NUMCPP_CONTRACTION_H_INCLUDED
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/functional/reduction.h"
+#include "numcpp/linalg/blas.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief A non-owning reference to a tensor of any dimension stored in memory
+ * with arbitrary strides. The element at index (i0, i1, ...) is
+ * data[i0 * strides[0] + i1 * strides[1] + ...].
+ */
+template <class T> struct strided_tensor {
+  const T *data;
+  std::vector<size_t> shape;
+  std::vector<ptrdiff_t> strides;
+
+  /// Return the number of elements.
+  size_t size() const {
+    size_t out = 1;
+    for (size_t i = 0; i < shape.size(); ++i) {
+      out *= shape[i];
+    }
+    return out;
+  }
+};
+
+/**
+ * @brief Return a strided reference to the elements of a tensor. Tensors and
+ * tensor views are referenced directly. Any other expression is evaluated
+ * first into @a buffer.
+ */
+template <class Container, class T, size_t Rank>
+strided_tensor<T> make_tensor_operand(const expression<Container, T, Rank> &a,
+                                      tensor<T, Rank> &buffer) {
+  tensor_view<const T, Rank> view = make_strided_view(a.self(), buffer);
+  strided_tensor<T> out;
+  out.data = view.data();
+  out.shape.assign(view.shape().data(), view.shape().data() + Rank);
+  out.strides.assign(view.strides().data(), view.strides().data() + Rank);
+  return out;
+}
+
+/**
+ * @brief Return the product of the sizes of a tensor along the given axes.
+ */
+template <class T>
+size_t axes_size(const strided_tensor<T> &a, const std::vector<size_t> &axes) {
+  size_t size = 1;
+  for (size_t i = 0; i < axes.size(); ++i) {
+    size *= a.shape[axes[i]];
+  }
+  return size;
+}
+
+/**
+ * @brief Return whether the given axes of a tensor, in the given order, can
+ * be traversed as a single axis with a constant stride, and return such
+ * stride. Axes of size 1 are ignored.
+ */
+template <class T>
+bool merge_axes(const strided_tensor<T> &a, const std::vector<size_t> &axes,
+                ptrdiff_t &stride) {
+  bool first = true;
+  ptrdiff_t next = 0;
+  stride = 1;
+  for (size_t i = axes.size(); i-- > 0;) {
+    size_t axis = axes[i];
+    if (a.shape[axis] == 1) {
+      continue;
+    }
+    if (first) {
+      stride = a.strides[axis];
+      first = false;
+    } else if (a.strides[axis] != next) {
+      return false;
+    }
+    next = a.strides[axis] * ptrdiff_t(a.shape[axis]);
+  }
+  return true;
+}
+
+/**
+ * @brief Return the memory offset of the element at the given flat index,
+ * counting in row-major order over the given axes of a tensor.
+ */
+template <class T>
+ptrdiff_t flat_offset(const strided_tensor<T> &a,
+                      const std::vector<size_t> &axes, size_t index) {
+  ptrdiff_t offset = 0;
+  for (size_t i = axes.size(); i-- > 0;) {
+    size_t axis = axes[i];
+    offset += ptrdiff_t(index % a.shape[axis]) * a.strides[axis];
+    index /= a.shape[axis];
+  }
+  return offset;
+}
+
+/**
+ * @brief Copy the elements of a tensor into a contiguous array, in row-major
+ * order over the given permutation of its axes. The copy is split among the
+ * available threads.
+ */
+template <class T>
+void gather(const strided_tensor<T> &a, const std::vector<size_t> &axes,
+            T *out) {
+  size_t size = a.size();
+  if (size == 0) {
+    return;
+  }
+  if (axes.empty()) {
+    out[0] = a.data[0];
+    return;
+  }
+  size_t ndim = axes.size(), inner = a.shape[axes[ndim - 1]];
+  ptrdiff_t inner_stride = a.strides[axes[ndim - 1]];
+  std::vector<size_t> outer_axes(axes.begin(), axes.end() - 1);
+  size_t outer = size / inner;
+  size_t tasks = num_tasks(size, outer);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, outer);
+    size_t last = block_begin(task + 1, tasks, outer);
+    std::vector<size_t> index(ndim - 1);
+    size_t flat = first;
+    for (size_t i = ndim - 1; i-- > 0;) {
+      index[i] = flat % a.shape[outer_axes[i]];
+      flat /= a.shape[outer_axes[i]];
+    }
+    const T *ptr = a.data + flat_offset(a, outer_axes, first);
+    T *dest = out + first * inner;
+    for (size_t row = first; row < last; ++row) {
+      for (size_t j = 0; j < inner; ++j) {
+        *dest++ = ptr[ptrdiff_t(j) * inner_stride];
+      }
+      // Advance to the next row, as an odometer over the outer axes.
+      for (size_t i = ndim - 1; i-- > 0;) {
+        size_t axis = outer_axes[i];
+        ptr += a.strides[axis];
+        if (++index[i] < a.shape[axis]) {
+          break;
+        }
+        ptr -= a.strides[axis] * ptrdiff_t(a.shape[axis]);
+        index[i] = 0;
+      }
+    }
+  });
+}
+
+/**
+ * @brief Return the matrices of a batched contraction operand. The element
+ * (i, j) of batch t is the element of @a a at the t-th index of the
+ * @a batch axes, the i-th index of the @a rows axes and the j-th index of the
+ * @a cols axes. The tensor is referenced directly if each group of axes can
+ * be merged into a single axis. Otherwise, it is copied into @a buffer.
+ *
+ * @return The strided matrix of the first batch. The memory offsets of the
+ *         other batches, relative to the first, are stored in @a offsets.
+ */
+template <class T>
+strided_matrix<const T>
+batched_matrix_operand(const strided_tensor<T> &a,
+                       const std::vector<size_t> &batch,
+                       const std::vector<size_t> &rows,
+                       const std::vector<size_t> &cols, std::vector<T> &buffer,
+                       std::vector<ptrdiff_t> &offsets) {
+  size_t nbatch = axes_size(a, batch);
+  size_t m = axes_size(a, rows), n = axes_size(a, cols);
+  ptrdiff_t rs, cs;
+  offsets.resize(nbatch);
+  if (merge_axes(a, rows, rs) && merge_axes(a, cols, cs)) {
+    for (size_t t = 0; t < nbatch; ++t) {
+      offsets[t] = flat_offset(a, batch, t);
+    }
+    return strided_matrix<const T>(a.data, m, n, rs, cs);
+  }
+  std::vector<size_t> axes(batch);
+  axes.insert(axes.end(), rows.begin(), rows.end());
+  axes.insert(axes.end(), cols.begin(), cols.end());
+  buffer.resize(nbatch * m * n);
+  gather(a, axes, buffer.data());
+  for (size_t t = 0; t < nbatch; ++t) {
+    offsets[t] = ptrdiff_t(t * m * n);
+  }
+  return strided_matrix<const T>(buffer.data(), m, n, n, 1);
+}
+
+/**
+ * @brief Compute a batched contraction of two tensors,
+ * out[t, i, j] = sum_p a[t, i, p] * b[t, p, j], where t, i, p and j stand for
+ * groups of axes of the operands. The corresponding axes of the batch and
+ * summed groups must have the same sizes in both operands.
+ *
+ * @details Each operand is reshaped into a stack of matrices, without copying
+ * if the strides allow it, and each pair of matrices is multiplied with
+ * gemm. If there are enough batches, they are distributed among the
+ * available threads. Otherwise, each product is parallelized.
+ *
+ * @param a, b The operands.
+ * @param a_batch, b_batch Batch axes of each operand.
+ * @param a_free Axes of @a a which are not summed.
+ * @param a_sum, b_sum Summed axes of each operand.
+ * @param b_free Axes of @a b which are not summed.
+ * @param out Output array, of size batch x free(a) x free(b), in row-major
+ *            order.
+ */
+template <class T>
+void contract(const strided_tensor<T> &a, const std::vector<size_t> &a_batch,
+              const std::vector<size_t> &a_free,
+              const std::vector<size_t> &a_sum, const strided_tensor<T> &b,
+              const std::vector<size_t> &b_batch,
+              const std::vector<size_t> &b_sum,
+              const std::vector<size_t> &b_free, T *out) {
+  std::vector<T> a_buffer, b_buffer;
+  std::vector<ptrdiff_t> a_offsets, b_offsets;
+  strided_matrix<const T> a_mat =
+      batched_matrix_operand(a, a_batch, a_free, a_sum, a_buffer, a_offsets);
+  strided_matrix<const T> b_mat =
+      batched_matrix_operand(b, b_batch, b_sum, b_free, b_buffer, b_offsets);
+  size_t nbatch = a_offsets.size(), m = a_mat.rows, n = b_mat.cols;
+  auto multiply = [&](size_t t) {
+    strided_matrix<const T> a_t(a_mat.data + a_offsets[t], m, a_mat.cols,
+                                a_mat.rs, a_mat.cs);
+    strided_matrix<const T> b_t(b_mat.data + b_offsets[t], b_mat.rows, n,
+                                b_mat.rs, b_mat.cs);
+    strided_matrix<T> c_t(out + t * m * n, m, n, n, 1);
+    gemm<T>(T(1), a_t, b_t, T(0), c_t);
+  };
+  if (nbatch > 1 && nbatch >= max_threads()) {
+    size_t tasks = num_tasks(nbatch * m * n * a_mat.cols, nbatch);
+    parallel_for(tasks, [&](size_t task) {
+      for (size_t t = block_begin(task, tasks, nbatch);
+           t < block_begin(task + 1, tasks, nbatch); ++t) {
+        multiply(t);
+      }
+    });
+  } else {
+    for (size_t t = 0; t < nbatch; ++t) {
+      multiply(t);
+    }
+  }
+}
+
+/**
+ * @brief Return the axes of a tensor which are not in @a axes. Throws a
+ * std::invalid_argument exception if an axis is out of bounds or repeated.
+ */
+inline std::vector<size_t> complement_axes(size_t ndim,
+                                           const std::vector<size_t> &axes) {
+  std::vector<bool> used(ndim, false);
+  for (size_t i = 0; i < axes.size(); ++i) {
+    if (axes[i] >= ndim) {
+      std::ostringstream error;
+      error << "axis " << axes[i]
+            << " is out of bounds for tensor of dimension " << ndim;
+      throw std::invalid_argument(error.str());
+    }
+    if (used[axes[i]]) {
+      throw std::invalid_argument("repeated axis in contraction");
+    }
+    used[axes[i]] = true;
+  }
+  std::vector<size_t> out;
+  for (size_t axis = 0; axis < ndim; ++axis) {
+    if (!used[axis]) {
+      out.push_back(axis);
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief Throws a std::invalid_argument exception if the axes of a tensordot
+ * are out of bounds, repeated or don't have the same sizes.
+ */
+template <size_t Rank1, size_t Rank2, size_t N>
+void assert_tensordot_axes(const shape_t<Rank1> &a_shape,
+                           const shape_t<N> &a_axes,
+                           const shape_t<Rank2> &b_shape,
+                           const shape_t<N> &b_axes) {
+  std::vector<size_t> a_sum(a_axes.data(), a_axes.data() + N);
+  std::vector<size_t> b_sum(b_axes.data(), b_axes.data() + N);
+  complement_axes(Rank1, a_sum);
+  complement_axes(Rank2, b_sum);
+  assert_aligned_shapes(a_shape, a_axes, b_shape, b_axes);
+}
+
+/**
+ * @brief Contract two tensors over the given axes and store the result in
+ * @a out, in row-major order over the non-contracted axes of @a a followed by
+ * the non-contracted axes of @a b. The axes must have been validated with
+ * assert_tensordot_axes.
+ */
+template <class Container1, class T, size_t Rank1, class Container2,
+          size_t Rank2, size_t N>
+void tensordot_into(const expression<Container1, T, Rank1> &a,
+                    const expression<Container2, T, Rank2> &b,
+                    const shape_t<N> &a_axes, const shape_t<N> &b_axes,
+                    T *out) {
+  std::vector<size_t> a_sum(a_axes.data(), a_axes.data() + N);
+  std::vector<size_t> b_sum(b_axes.data(), b_axes.data() + N);
+  std::vector<size_t> a_free = complement_axes(Rank1, a_sum);
+  std::vector<size_t> b_free = complement_axes(Rank2, b_sum);
+  tensor<T, Rank1> a_buffer;
+  tensor<T, Rank2> b_buffer;
+  strided_tensor<T> a_op = make_tensor_operand(a.self(), a_buffer);
+  strided_tensor<T> b_op = make_tensor_operand(b.self(), b_buffer);
+  std::vector<size_t> no_batch;
+  contract(a_op, no_batch, a_free, a_sum, b_op, no_batch, b_sum, b_free, out);
+}
+
+/**
+ * @brief An operand of einsum, with a label for each of its axes.
+ */
+template <class T> struct einsum_operand {
+  strided_tensor<T> tensor;
+  std::string labels;
+};
+
+/**
+ * @brief Return the strides of a contiguous tensor in row-major order.
+ */
+inline std::vector<ptrdiff_t>
+row_major_strides(const std::vector<size_t> &shape) {
+  std::vector<ptrdiff_t> strides(shape.size());
+  ptrdiff_t stride = 1;
+  for (size_t i = shape.size(); i-- > 0;) {
+    strides[i] = stride;
+    stride *= ptrdiff_t(shape[i]);
+  }
+  return strides;
+}
+
+/**
+ * @brief Parse the subscripts of einsum. Spaces are ignored. If there is no
+ * output ("->"), the output labels are the labels which appear exactly once,
+ * in alphabetical order.
+ */
+inline void parse_einsum(const std::string &subscripts, size_t noperands,
+                         std::vector<std::string> &inputs,
+                         std::string &output) {
+  std::string terms;
+  bool explicit_output = false;
+  for (size_t i = 0; i < subscripts.size(); ++i) {
+    char c = subscripts[i];
+    if (c == ' ') {
+      continue;
+    } else if (c == '-' && i + 1 < subscripts.size() &&
+               subscripts[i + 1] == '>' && !explicit_output) {
+      explicit_output = true;
+      inputs.push_back(terms);
+      terms.clear();
+      ++i;
+    } else if (c == '.') {
+      throw std::invalid_argument(
+          "ellipsis in einstein sum subscripts is not supported");
+    } else if (c == ',' && !explicit_output) {
+      inputs.push_back(terms);
+      terms.clear();
+    } else if (std::isalpha(static_cast<unsigned char>(c))) {
+      terms += c;
+    } else {
+      std::ostringstream error;
+      error << "invalid subscript '" << c
+            << "' in einstein sum subscripts string, subscripts must be "
+               "letters";
+      throw std::invalid_argument(error.str());
+    }
+  }
+  if (explicit_output) {
+    output = terms;
+  } else {
+    inputs.push_back(terms);
+    std::string all;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      all += inputs[i];
+    }
+    std::sort(all.begin(), all.end());
+    for (size_t i = 0; i < all.size(); ++i) {
+      if ((i == 0 || all[i - 1] != all[i]) &&
+          (i + 1 == all.size() || all[i + 1] != all[i])) {
+        output += all[i];
+      }
+    }
+  }
+  if (inputs.size() != noperands) {
+    std::ostringstream error;
+    error << "einstein sum subscripts string has " << inputs.size()
+          << " terms, but " << noperands << " operands were provided";
+    throw std::invalid_argument(error.str());
+  }
+  for (size_t i = 0; i < output.size(); ++i) {
+    if (output.find(output[i], i + 1) != std::string::npos) {
+      std::ostringstream error;
+      error << "einstein sum subscripts string includes output subscript '"
+            << output[i] << "' multiple times";
+      throw std::invalid_argument(error.str());
+    }
+    bool found = false;
+    for (size_t j = 0; j < inputs.size() && !found; ++j) {
+      found = (inputs[j].find(output[i]) != std::string::npos);
+    }
+    if (!found) {
+      std::ostringstream error;
+      error << "einstein sum subscripts string included output subscript '"
+            << output[i] << "' which never appeared in an input";
+      throw std::invalid_argument(error.str());
+    }
+  }
+}
+
+/**
+ * @brief Merge the axes of an operand with repeated labels into a single
+ * axis, i.e., take its diagonal.
+ */
+template <class T> void einsum_diagonal(einsum_operand<T> &op) {
+  std::string labels;
+  std::vector<size_t> shape;
+  std::vector<ptrdiff_t> strides;
+  for (size_t i = 0; i < op.labels.size(); ++i) {
+    size_t pos = labels.find(op.labels[i]);
+    if (pos == std::string::npos) {
+      labels += op.labels[i];
+      shape.push_back(op.tensor.shape[i]);
+      strides.push_back(op.tensor.strides[i]);
+    } else if (shape[pos] != op.tensor.shape[i]) {
+      std::ostringstream error;
+      error << "dimensions in operand for collapsing index '" << op.labels[i]
+            << "' don't match (" << shape[pos] << " != "
+            << op.tensor.shape[i] << ")";
+      throw std::invalid_argument(error.str());
+    } else {
+      strides[pos] += op.tensor.strides[i];
+    }
+  }
+  op.labels = labels;
+  op.tensor.shape = shape;
+  op.tensor.strides = strides;
+}
+
+/**
+ * @brief Return whether a label is still needed after contracting the
+ * operands @a skip1 and @a skip2, i.e., whether it appears in the output or
+ * in another operand.
+ */
+template <class T>
+bool einsum_needed(char label, const std::vector<einsum_operand<T>> &ops,
+                   size_t skip1, size_t skip2, const std::string &output) {
+  if (output.find(label) != std::string::npos) {
+    return true;
+  }
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (i != skip1 && i != skip2 &&
+        ops[i].labels.find(label) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Contract two operands of einsum into a new operand whose data is
+ * stored in @a buffer. The labels in both operands are batch labels if they
+ * are still needed and summed otherwise. The new operand has the batch
+ * labels, followed by the remaining labels of @a a and @a b.
+ */
+template <class T>
+einsum_operand<T> einsum_pair(const einsum_operand<T> &a,
+                              const einsum_operand<T> &b,
+                              const std::vector<einsum_operand<T>> &ops,
+                              size_t ia, size_t ib, const std::string &output,
+                              std::vector<T> &buffer) {
+  std::vector<size_t> a_batch, b_batch, a_free, a_sum, b_sum, b_free;
+  std::string batch_labels, a_labels, b_labels;
+  for (size_t i = 0; i < a.labels.size(); ++i) {
+    char label = a.labels[i];
+    size_t j = b.labels.find(label);
+    bool needed = einsum_needed(label, ops, ia, ib, output);
+    if (j == std::string::npos) {
+      a_free.push_back(i);
+      a_labels += label;
+    } else if (needed) {
+      a_batch.push_back(i);
+      b_batch.push_back(j);
+      batch_labels += label;
+    } else {
+      a_sum.push_back(i);
+      b_sum.push_back(j);
+    }
+  }
+  for (size_t j = 0; j < b.labels.size(); ++j) {
+    if (a.labels.find(b.labels[j]) == std::string::npos) {
+      b_free.push_back(j);
+      b_labels += b.labels[j];
+    }
+  }
+  einsum_operand<T> out;
+  out.labels = batch_labels + a_labels + b_labels;
+  for (size_t i = 0; i < a_batch.size(); ++i) {
+    out.tensor.shape.push_back(a.tensor.shape[a_batch[i]]);
+  }
+  for (size_t i = 0; i < a_free.size(); ++i) {
+    out.tensor.shape.push_back(a.tensor.shape[a_free[i]]);
+  }
+  for (size_t j = 0; j < b_free.size(); ++j) {
+    out.tensor.shape.push_back(b.tensor.shape[b_free[j]]);
+  }
+  out.tensor.strides = row_major_strides(out.tensor.shape);
+  buffer.resize(out.tensor.size());
+  out.tensor.data = buffer.data();
+  contract(a.tensor, a_batch, a_free, a_sum, b.tensor, b_batch, b_sum, b_free,
+           buffer.data());
+  return out;
+}
+
+/**
+ * @brief Sum an operand of einsum over the labels which are not needed. The
+ * sum is computed as a product with a tensor of ones.
+ */
+template <class T>
+void einsum_reduce(einsum_operand<T> &op,
+                   const std::vector<einsum_operand<T>> &ops, size_t i,
+                   const std::string &output, std::vector<T> &ones,
+                   std::vector<T> &buffer) {
+  std::vector<size_t> sum, free, ones_sum, none;
+  strided_tensor<T> ones_op;
+  einsum_operand<T> out;
+  for (size_t j = 0; j < op.labels.size(); ++j) {
+    if (einsum_needed(op.labels[j], ops, i, i, output)) {
+      free.push_back(j);
+      out.labels += op.labels[j];
+      out.tensor.shape.push_back(op.tensor.shape[j]);
+    } else {
+      sum.push_back(j);
+      ones_sum.push_back(ones_op.shape.size());
+      ones_op.shape.push_back(op.tensor.shape[j]);
+    }
+  }
+  if (sum.empty()) {
+    return;
+  }
+  ones.assign(ones_op.size(), T(1));
+  ones_op.data = ones.data();
+  ones_op.strides = row_major_strides(ones_op.shape);
+  buffer.resize(out.tensor.size());
+  contract(op.tensor, none, free, sum, ones_op, none, ones_sum, none,
+           buffer.data());
+  out.tensor.data = buffer.data();
+  out.tensor.strides = row_major_strides(out.tensor.shape);
+  op = out;
+}
+
+/**
+ * @brief Return the size of the operand which results from contracting two
+ * operands of einsum, and whether they have labels in common.
+ */
+template <class T>
+double einsum_pair_size(const std::vector<einsum_operand<T>> &ops, size_t ia,
+                        size_t ib, const std::string &output, bool &shared) {
+  const einsum_operand<T> &a = ops[ia], &b = ops[ib];
+  double size = 1;
+  shared = false;
+  for (size_t i = 0; i < a.labels.size(); ++i) {
+    bool in_b = (b.labels.find(a.labels[i]) != std::string::npos);
+    shared = shared || in_b;
+    if (!in_b || einsum_needed(a.labels[i], ops, ia, ib, output)) {
+      size *= a.tensor.shape[i];
+    }
+  }
+  for (size_t j = 0; j < b.labels.size(); ++j) {
+    if (a.labels.find(b.labels[j]) == std::string::npos) {
+      size *= b.tensor.shape[j];
+    }
+  }
+  return size;
+}
+
+/**
+ * @brief Evaluate einsum on the given operands. The data of the intermediate
+ * operands is stored in @a buffers.
+ *
+ * @return A strided reference to the result, with its axes in the order of
+ *         the output labels.
+ *
+ * @details Repeated labels within an operand are first reduced to the
+ * diagonal, and labels which appear in a single operand and not in the output
+ * are summed. Then, the operands are contracted two at a time, following a
+ * greedy path: at each step, the pair of operands with labels in common whose
+ * contraction reduces the total size the most is contracted with gemm. Pairs
+ * without labels in common (outer products) are only contracted if no other
+ * pair is left.
+ */
+template <class T>
+strided_tensor<T> einsum_path(const std::string &subscripts,
+                              const std::vector<strided_tensor<T>> &tensors,
+                              std::vector<std::vector<T>> &buffers,
+                              size_t out_rank) {
+  std::vector<std::string> inputs;
+  std::string output;
+  parse_einsum(subscripts, tensors.size(), inputs, output);
+  if (output.size() != out_rank) {
+    std::ostringstream error;
+    error << "einstein sum output has " << output.size()
+          << " dimensions, but the result was requested with " << out_rank;
+    throw std::invalid_argument(error.str());
+  }
+
+  // Label the operands and check the sizes of the labels.
+  std::vector<einsum_operand<T>> ops(tensors.size());
+  std::string seen;
+  std::vector<size_t> seen_size;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (inputs[i].size() != tensors[i].shape.size()) {
+      std::ostringstream error;
+      error << "einstein sum subscripts string has " << inputs[i].size()
+            << " subscripts for operand " << i << ", but it has dimension "
+            << tensors[i].shape.size();
+      throw std::invalid_argument(error.str());
+    }
+    ops[i].tensor = tensors[i];
+    ops[i].labels = inputs[i];
+    for (size_t j = 0; j < inputs[i].size(); ++j) {
+      size_t pos = seen.find(inputs[i][j]);
+      if (pos == std::string::npos) {
+        seen += inputs[i][j];
+        seen_size.push_back(tensors[i].shape[j]);
+      } else if (seen_size[pos] != tensors[i].shape[j]) {
+        std::ostringstream error;
+        error << "size of label '" << inputs[i][j] << "' for operand " << i
+              << " (" << tensors[i].shape[j]
+              << ") does not match previous terms (" << seen_size[pos] << ")";
+        throw std::invalid_argument(error.str());
+      }
+    }
+    einsum_diagonal(ops[i]);
+  }
+
+  std::vector<T> ones;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    buffers.push_back(std::vector<T>());
+    einsum_reduce(ops[i], ops, i, output, ones, buffers.back());
+  }
+  while (ops.size() > 1) {
+    size_t best_a = 0, best_b = 1;
+    bool best_shared = false;
+    double best_cost = std::numeric_limits<double>::infinity();
+    for (size_t ia = 0; ia < ops.size(); ++ia) {
+      for (size_t ib = ia + 1; ib < ops.size(); ++ib) {
+        bool shared;
+        double size = einsum_pair_size(ops, ia, ib, output, shared);
+        double cost = size - double(ops[ia].tensor.size()) -
+                      double(ops[ib].tensor.size());
+        if ((shared && !best_shared) ||
+            (shared == best_shared && cost < best_cost)) {
+          best_a = ia;
+          best_b = ib;
+          best_shared = shared;
+          best_cost = cost;
+        }
+      }
+    }
+    buffers.push_back(std::vector<T>());
+    einsum_operand<T> op = einsum_pair(ops[best_a], ops[best_b], ops, best_a,
+                                       best_b, output, buffers.back());
+    ops.erase(ops.begin() + best_b);
+    ops.erase(ops.begin() + best_a);
+    ops.push_back(op);
+  }
+
+  // Permute the axes of the last operand into the order of the output.
+  strided_tensor<T> out = ops[0].tensor;
+  for (size_t i = 0; i < output.size(); ++i) {
+    size_t pos = ops[0].labels.find(output[i]);
+    out.shape[i] = ops[0].tensor.shape[pos];
+    out.strides[i] = ops[0].tensor.strides[pos];
+  }
+  return out;
+}
+
+/**
+ * @brief Return type of einsum: a scalar if the output has no labels, and a
+ * tensor otherwise. The result is copied from a strided reference.
+ */
+template <class T, size_t Rank> struct einsum_result {
+  typedef tensor<T, Rank> type;
+
+  static type evaluate(const strided_tensor<T> &a) {
+    shape_t<Rank> shape;
+    std::vector<size_t> axes(Rank);
+    for (size_t i = 0; i < Rank; ++i) {
+      shape[i] = a.shape[i];
+      axes[i] = i;
+    }
+    type out(shape);
+    gather(a, axes, out.data());
+    return out;
+  }
+};
+
+template <class T> struct einsum_result<T, 0> {
+  typedef T type;
+
+  static type evaluate(const strided_tensor<T> &a) { return a.data[0]; }
+};
+
+/**
+ * @brief Append the operands of einsum to a list of strided tensors and
+ * evaluate it. The operands which must be copied are evaluated into buffers
+ * which live until the result is computed.
+ */
+template <size_t Rank, class T>
+typename einsum_result<T, Rank>::type
+einsum_evaluate(const std::string &subscripts,
+                std::vector<strided_tensor<T>> &tensors) {
+  std::vector<std::vector<T>> buffers;
+  return einsum_result<T, Rank>::evaluate(
+      einsum_path(subscripts, tensors, buffers, Rank));
+}
+
+template <size_t Rank, class T, class Container, size_t Rank1,
+          class... Operands>
+typename einsum_result<T, Rank>::type
+einsum_evaluate(const std::string &subscripts,
+                std::vector<strided_tensor<T>> &tensors,
+                const expression<Container, T, Rank1> &a,
+                const Operands &...operands) {
+  tensor<T, Rank1> buffer;
+  tensors.push_back(make_tensor_operand(a.self(), buffer));
+  return einsum_evaluate<Rank>(subscripts, tensors, operands...);
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_CONTRACTION_H_INCLUDED
@@ -0,0 +1,346 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/decomposition.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_DECOMPOSITION_H_INCLUDED
+#define NUMCPP_DECOMPOSITION_H_INCLUDED
+
+#include <vector>
+#include "numcpp/linalg/blas.h"
+
+namespace numcpp {
+namespace linalg {
+/**
+ * @brief A lu_factorization object holds the pivoted LU decomposition of a
+ * square matrix, @f$A = PLU@f$. The matrix is factorized once, at
+ * construction, and the factors are reused to solve any number of systems,
+ * and to compute the determinant, the inverse and the condition number of
+ * the matrix.
+ *
+ * @tparam T Type of the elements. It must be a floating-point or a complex
+ *           type.
+ */
+template <class T> class lu_factorization {
+public:
+  /// Member types.
+  typedef T value_type;
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  typedef size_t size_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Computes the LU decomposition of a matrix.
+   *
+   * @param a A square matrix.
+   *
+   * @throw std::invalid_argument Thrown if @a a is not square.
+   * @throw std::bad_alloc If the function fails to allocate storage it may
+   *                       throw an exception.
+   */
+  template <class Container>
+  explicit lu_factorization(const expression<Container, T, 2> &a);
+
+  /// Public methods.
+
+  /**
+   * @brief Return the number of rows (and columns) of the matrix.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Return the packed factors. The part below the diagonal holds
+   * @f$L@f$ (without its unit diagonal) and the part on and above the
+   * diagonal holds @f$U@f$.
+   */
+  const tensor<T, 2> &factors() const;
+
+  /**
+   * @brief Return a permutation such that row i of @f$LU@f$ is row piv[i] of
+   * the matrix.
+   */
+  tensor<size_t, 1> permutation() const;
+
+  /**
+   * @brief Return whether the matrix is singular, i.e., whether @f$U@f$ has
+   * a zero on its diagonal.
+   */
+  bool singular() const;
+
+  /**
+   * @brief Solve the linear system @f$Ax = b@f$.
+   *
+   * @param b Right-hand side, either a vector of size n or a matrix of size
+   *          n x k whose columns are solved together.
+   *
+   * @return The solution, with the same shape as @a b.
+   *
+   * @throw std::invalid_argument Thrown if the size of @a b doesn't match the
+   *                              size of the matrix or if the matrix is
+   *                              singular.
+   */
+  template <class Container>
+  tensor<T, 1> solve(const expression<Container, T, 1> &b) const;
+
+  template <class Container>
+  tensor<T, 2> solve(const expression<Container, T, 2> &b) const;
+
+  /**
+   * @brief Return the determinant of the matrix.
+   */
+  T det() const;
+
+  /**
+   * @brief Return the inverse of the matrix.
+   *
+   * @throw std::invalid_argument Thrown if the matrix is singular.
+   */
+  tensor<T, 2> inv() const;
+
+  /**
+   * @brief Return an estimate of the condition number of the matrix in the
+   * 1-norm. The norm of the inverse is estimated from a few solves with the
+   * factors, without computing the inverse. The estimate is almost always
+   * within a factor of 3 of the true condition number. Returns infinity if
+   * the matrix is singular.
+   */
+  real_type cond() const;
+
+private:
+  // Packed factors.
+  tensor<T, 2> m_lu;
+
+  // Row interchanges. Row i was interchanged with row m_ipiv[i].
+  std::vector<size_t> m_ipiv;
+
+  // 1-norm of the matrix.
+  real_type m_norm;
+};
+
+/**
+ * @brief A cholesky_factorization object holds the Cholesky decomposition of
+ * a Hermitian positive-definite matrix, @f$A = LL^*@f$. The matrix is
+ * factorized once, at construction, and the factor is reused to solve any
+ * number of systems, and to compute the determinant, the inverse and the
+ * condition number of the matrix.
+ *
+ * @tparam T Type of the elements. It must be a floating-point or a complex
+ *           type.
+ */
+template <class T> class cholesky_factorization {
+public:
+  /// Member types.
+  typedef T value_type;
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  typedef size_t size_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Computes the Cholesky decomposition of a matrix. Only the lower
+   * triangle of the matrix is read.
+   *
+   * @param a A Hermitian positive-definite matrix.
+   *
+   * @throw std::invalid_argument Thrown if @a a is not square or is not
+   *                              positive definite.
+   * @throw std::bad_alloc If the function fails to allocate storage it may
+   *                       throw an exception.
+   */
+  template <class Container>
+  explicit cholesky_factorization(const expression<Container, T, 2> &a);
+
+  /// Public methods.
+
+  /**
+   * @brief Return the number of rows (and columns) of the matrix.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Return the lower triangular factor @f$L@f$.
+   */
+  const tensor<T, 2> &l() const;
+
+  /**
+   * @brief Solve the linear system @f$Ax = b@f$.
+   *
+   * @param b Right-hand side, either a vector of size n or a matrix of size
+   *          n x k whose columns are solved together.
+   *
+   * @return The solution, with the same shape as @a b.
+   *
+   * @throw std::invalid_argument Thrown if the size of @a b doesn't match the
+   *                              size of the matrix.
+   */
+  template <class Container>
+  tensor<T, 1> solve(const expression<Container, T, 1> &b) const;
+
+  template <class Container>
+  tensor<T, 2> solve(const expression<Container, T, 2> &b) const;
+
+  /**
+   * @brief Return the determinant of the matrix.
+   */
+  T det() const;
+
+  /**
+   * @brief Return the inverse of the matrix.
+   */
+  tensor<T, 2> inv() const;
+
+  /**
+   * @brief Return an estimate of the condition number of the matrix in the
+   * 1-norm. The norm of the inverse is estimated from a few solves with the
+   * factor, without computing the inverse.
+   */
+  real_type cond() const;
+
+private:
+  // Lower triangular factor.
+  tensor<T, 2> m_l;
+
+  // 1-norm of the matrix.
+  real_type m_norm;
+};
+
+/**
+ * @brief A qr_factorization object holds the QR decomposition of a matrix,
+ * @f$A = QR@f$, where @f$Q@f$ is unitary and @f$R@f$ is upper triangular.
+ * The matrix is factorized once, at construction, and the factors are reused
+ * to solve any number of least-squares problems.
+ *
+ * @details @f$Q@f$ is stored as a product of Householder reflections and is
+ * never formed explicitly, unless requested. The reflections are grouped
+ * into blocks, so that they are applied with matrix multiplications.
+ *
+ * @tparam T Type of the elements. It must be a floating-point or a complex
+ *           type.
+ */
+template <class T> class qr_factorization {
+public:
+  /// Member types.
+  typedef T value_type;
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  typedef size_t size_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Computes the QR decomposition of a matrix.
+   *
+   * @param a A matrix of size m x n.
+   *
+   * @throw std::bad_alloc If the function fails to allocate storage it may
+   *                       throw an exception.
+   */
+  template <class Container>
+  explicit qr_factorization(const expression<Container, T, 2> &a);
+
+  /// Public methods.
+
+  /**
+   * @brief Return the number of rows and columns of the matrix.
+   */
+  size_t rows() const;
+  size_t cols() const;
+
+  /**
+   * @brief Return the first k columns of @f$Q@f$, where k = min(m, n).
+   */
+  tensor<T, 2> q() const;
+
+  /**
+   * @brief Return the first k rows of @f$R@f$, where k = min(m, n).
+   */
+  tensor<T, 2> r() const;
+
+  /**
+   * @brief Return the least-squares solution of the linear system
+   * @f$Ax = b@f$, i.e., the @f$x@f$ minimizing @f$\|Ax - b\|_2@f$. If the
+   * matrix is square, this is the solution of the system.
+   *
+   * @param b Right-hand side, either a vector of size m or a matrix of size
+   *          m x k whose columns are solved together.
+   *
+   * @return The solution, either a vector of size n or a matrix of size
+   *         n x k.
+   *
+   * @throw std::invalid_argument Thrown if the size of @a b doesn't match the
+   *                              number of rows of the matrix, if the matrix
+   *                              has more columns than rows or if it doesn't
+   *                              have full column rank.
+   */
+  template <class Container>
+  tensor<T, 1> solve(const expression<Container, T, 1> &b) const;
+
+  template <class Container>
+  tensor<T, 2> solve(const expression<Container, T, 2> &b) const;
+
+  /**
+   * @brief Return the determinant of the matrix.
+   *
+   * @throw std::invalid_argument Thrown if the matrix is not square.
+   */
+  T det() const;
+
+  /**
+   * @brief Return the inverse of the matrix.
+   *
+   * @throw std::invalid_argument Thrown if the matrix is not square or is
+   *                              singular.
+   */
+  tensor<T, 2> inv() const;
+
+  /**
+   * @brief Return an estimate of the condition number of @f$R@f$ in the
+   * 1-norm. Since @f$Q@f$ is unitary, @f$R@f$ has the same 2-norm condition
+   * number as the matrix. Returns infinity if the matrix doesn't have full
+   * column rank.
+   *
+   * @throw std::invalid_argument Thrown if the matrix has more columns than
+   *                              rows.
+   */
+  real_type cond() const;
+
+private:
+  // R on and above the diagonal and Householder vectors below the diagonal.
+  tensor<T, 2> m_qr;
+
+  // Scalar factors of the Householder reflections.
+  tensor<T, 1> m_tau;
+
+  // Triangular factors of the blocks of reflections.
+  tensor<T, 2> m_t;
+
+  // Solve r * x = b in-place for the first n rows of b.
+  void solve_r(const detail::strided_matrix<T> &b) const;
+
+  // Throw if the matrix has more columns than rows or is rank deficient.
+  void assert_full_rank() const;
+};
+} // namespace linalg
+} // namespace numcpp
+
+#include "numcpp/linalg/decomposition.tcc"
+
+#endif // NUMCPP_DECOMPOSITION_H_INCLUDED
@@ -0,0 +1,395 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/decomposition.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_DECOMPOSITION_TCC_INCLUDED
+#define NUMCPP_DECOMPOSITION_TCC_INCLUDED
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "numcpp/broadcasting/assert.h"
+#include "numcpp/linalg/blas.h"
+#include "numcpp/linalg/factorization.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Asserts whether the right-hand side of a linear system has as many
+ * rows as the matrix. Throws a std::invalid_argument exception if assertion
+ * fails.
+ */
+inline void assert_solve_shape(size_t rows, size_t rhs_rows) {
+  if (rows != rhs_rows) {
+    std::ostringstream error;
+    error << "incompatible dimensions for solve: matrix has " << rows
+          << " rows but right-hand side has " << rhs_rows;
+    throw std::invalid_argument(error.str());
+  }
+}
+
+/**
+ * @brief Return a strided reference to the elements of a vector, as a matrix
+ * with a single column.
+ */
+template <class T> inline strided_matrix<T> make_column(T *data, size_t n) {
+  return strided_matrix<T>(data, n, 1, 1, 1);
+}
+
+template <class T> inline strided_matrix<T> make_column(tensor<T, 1> &x) {
+  return make_column(x.data(), x.size());
+}
+
+/**
+ * @brief Return an identity matrix.
+ */
+template <class T> tensor<T, 2> identity_matrix(size_t n) {
+  tensor<T, 2> out(make_shape(n, n), T(0));
+  for (size_t i = 0; i < n; ++i) {
+    out(i, i) = T(1);
+  }
+  return out;
+}
+} // namespace detail
+
+namespace linalg {
+/// Constructors.
+
+template <class T>
+template <class Container>
+lu_factorization<T>::lu_factorization(const expression<Container, T, 2> &a)
+    : m_lu(a, row_major), m_ipiv(a.shape(0)) {
+  detail::assert_square(a.shape());
+  m_norm = detail::norm1<T>(detail::make_strided_matrix(m_lu), false);
+  detail::lu_factor(detail::make_strided_matrix(m_lu), m_ipiv.data());
+}
+
+/// Public methods.
+
+template <class T> size_t lu_factorization<T>::size() const {
+  return m_lu.shape(0);
+}
+
+template <class T> const tensor<T, 2> &lu_factorization<T>::factors() const {
+  return m_lu;
+}
+
+template <class T> tensor<size_t, 1> lu_factorization<T>::permutation() const {
+  size_t n = size();
+  tensor<size_t, 1> piv(n);
+  detail::row_swaps_to_permutation(m_ipiv.data(), n, piv.data(), n);
+  return piv;
+}
+
+template <class T> bool lu_factorization<T>::singular() const {
+  for (size_t i = 0; i < size(); ++i) {
+    if (m_lu(i, i) == T(0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class T>
+template <class Container>
+tensor<T, 1>
+lu_factorization<T>::solve(const expression<Container, T, 1> &b) const {
+  detail::assert_solve_shape(size(), b.size());
+  if (singular()) {
+    throw std::invalid_argument("matrix is singular");
+  }
+  tensor<T, 1> x(b);
+  detail::lu_solve(detail::make_strided_matrix(m_lu), m_ipiv.data(), false,
+                   detail::make_column(x));
+  return x;
+}
+
+template <class T>
+template <class Container>
+tensor<T, 2>
+lu_factorization<T>::solve(const expression<Container, T, 2> &b) const {
+  detail::assert_solve_shape(size(), b.shape(0));
+  if (singular()) {
+    throw std::invalid_argument("matrix is singular");
+  }
+  tensor<T, 2> x(b, row_major);
+  detail::lu_solve(detail::make_strided_matrix(m_lu), m_ipiv.data(), false,
+                   detail::make_strided_matrix(x));
+  return x;
+}
+
+template <class T> T lu_factorization<T>::det() const {
+  T val = T(1);
+  for (size_t i = 0; i < size(); ++i) {
+    val *= m_lu(i, i);
+    if (m_ipiv[i] != i) {
+      val = -val;
+    }
+  }
+  return val;
+}
+
+template <class T> tensor<T, 2> lu_factorization<T>::inv() const {
+  return solve(detail::identity_matrix<T>(size()));
+}
+
+template <class T>
+typename lu_factorization<T>::real_type lu_factorization<T>::cond() const {
+  if (singular()) {
+    return std::numeric_limits<real_type>::infinity();
+  }
+  size_t n = size();
+  detail::strided_matrix<const T> lu = detail::make_strided_matrix(m_lu);
+  const size_t *ipiv = m_ipiv.data();
+  real_type inv_norm = detail::inverse_norm1_estimate<T>(
+      n,
+      [&](T *x) {
+        detail::lu_solve(lu, ipiv, false, detail::make_column(x, n));
+      },
+      [&](T *x) {
+        detail::lu_solve(lu, ipiv, true, detail::make_column(x, n));
+      });
+  return m_norm * inv_norm;
+}
+
+/// Constructors.
+
+template <class T>
+template <class Container>
+cholesky_factorization<T>::cholesky_factorization(
+    const expression<Container, T, 2> &a)
+    : m_l(a, row_major) {
+  detail::assert_square(a.shape());
+  m_norm = detail::norm1<T>(detail::make_strided_matrix(m_l), true);
+  detail::cholesky_factor(detail::make_strided_matrix(m_l));
+}
+
+/// Public methods.
+
+template <class T> size_t cholesky_factorization<T>::size() const {
+  return m_l.shape(0);
+}
+
+template <class T> const tensor<T, 2> &cholesky_factorization<T>::l() const {
+  return m_l;
+}
+
+template <class T>
+template <class Container>
+tensor<T, 1>
+cholesky_factorization<T>::solve(const expression<Container, T, 1> &b) const {
+  detail::assert_solve_shape(size(), b.size());
+  tensor<T, 1> x(b);
+  detail::cholesky_solve(detail::make_strided_matrix(m_l),
+                         detail::make_column(x));
+  return x;
+}
+
+template <class T>
+template <class Container>
+tensor<T, 2>
+cholesky_factorization<T>::solve(const expression<Container, T, 2> &b) const {
+  detail::assert_solve_shape(size(), b.shape(0));
+  tensor<T, 2> x(b, row_major);
+  detail::cholesky_solve(detail::make_strided_matrix(m_l),
+                         detail::make_strided_matrix(x));
+  return x;
+}
+
+template <class T> T cholesky_factorization<T>::det() const {
+  T val = T(1);
+  for (size_t i = 0; i < size(); ++i) {
+    val *= m_l(i, i);
+  }
+  return val * val;
+}
+
+template <class T> tensor<T, 2> cholesky_factorization<T>::inv() const {
+  return solve(detail::identity_matrix<T>(size()));
+}
+
+template <class T>
+typename cholesky_factorization<T>::real_type
+cholesky_factorization<T>::cond() const {
+  size_t n = size();
+  detail::strided_matrix<const T> l = detail::make_strided_matrix(m_l);
+  auto solve = [&](T *x) {
+    detail::cholesky_solve(l, detail::make_column(x, n));
+  };
+  return m_norm * detail::inverse_norm1_estimate<T>(n, solve, solve);
+}
+
+/// Constructors.
+
+template <class T>
+template <class Container>
+qr_factorization<T>::qr_factorization(const expression<Container, T, 2> &a)
+    : m_qr(a, row_major), m_tau(std::min(a.shape(0), a.shape(1))) {
+  size_t k = m_tau.size();
+  m_t.resize(make_shape(std::min(detail::qr_block_size, k), k));
+  detail::qr_factor(detail::make_strided_matrix(m_qr), m_tau.data(),
+                    detail::make_strided_matrix(m_t));
+}
+
+/// Public methods.
+
+template <class T> size_t qr_factorization<T>::rows() const {
+  return m_qr.shape(0);
+}
+
+template <class T> size_t qr_factorization<T>::cols() const {
+  return m_qr.shape(1);
+}
+
+template <class T> tensor<T, 2> qr_factorization<T>::q() const {
+  size_t m = rows(), k = m_tau.size();
+  tensor<T, 2> out(make_shape(m, k), T(0));
+  for (size_t i = 0; i < k; ++i) {
+    out(i, i) = T(1);
+  }
+  detail::qr_multiply(detail::make_strided_matrix(m_qr),
+                      detail::make_strided_matrix(m_t), false,
+                      detail::make_strided_matrix(out));
+  return out;
+}
+
+template <class T> tensor<T, 2> qr_factorization<T>::r() const {
+  size_t n = cols(), k = m_tau.size();
+  tensor<T, 2> out(make_shape(k, n), T(0));
+  for (size_t i = 0; i < k; ++i) {
+    for (size_t j = i; j < n; ++j) {
+      out(i, j) = m_qr(i, j);
+    }
+  }
+  return out;
+}
+
+template <class T>
+template <class Container>
+tensor<T, 1>
+qr_factorization<T>::solve(const expression<Container, T, 1> &b) const {
+  detail::assert_solve_shape(rows(), b.size());
+  assert_full_rank();
+  tensor<T, 1> x(b);
+  detail::qr_multiply(detail::make_strided_matrix(m_qr),
+                      detail::make_strided_matrix(m_t), true,
+                      detail::make_column(x));
+  solve_r(detail::make_column(x));
+  tensor<T, 1> out(cols());
+  std::copy(x.data(), x.data() + out.size(), out.data());
+  return out;
+}
+
+template <class T>
+template <class Container>
+tensor<T, 2>
+qr_factorization<T>::solve(const expression<Container, T, 2> &b) const {
+  detail::assert_solve_shape(rows(), b.shape(0));
+  assert_full_rank();
+  tensor<T, 2> x(b, row_major);
+  detail::qr_multiply(detail::make_strided_matrix(m_qr),
+                      detail::make_strided_matrix(m_t), true,
+                      detail::make_strided_matrix(x));
+  solve_r(detail::make_strided_matrix(x));
+  tensor<T, 2> out(make_shape(cols(), x.shape(1)));
+  std::copy(x.data(), x.data() + out.size(), out.data());
+  return out;
+}
+
+template <class T> T qr_factorization<T>::det() const {
+  detail::assert_square(m_qr.shape());
+  // The determinant of I - tau * v * v^H is 1 - tau * v^H * v.
+  size_t n = cols();
+  T val = T(1);
+  for (size_t j = 0; j < n; ++j) {
+    real_type norm = 1;
+    for (size_t i = j + 1; i < n; ++i) {
+      norm += std::norm(m_qr(i, j));
+    }
+    val *= m_qr(j, j) * (T(1) - m_tau[j] * norm);
+  }
+  return val;
+}
+
+template <class T> tensor<T, 2> qr_factorization<T>::inv() const {
+  detail::assert_square(m_qr.shape());
+  return solve(detail::identity_matrix<T>(rows()));
+}
+
+template <class T>
+typename qr_factorization<T>::real_type qr_factorization<T>::cond() const {
+  size_t n = cols();
+  if (n > rows()) {
+    throw std::invalid_argument("matrix has more columns than rows");
+  }
+  real_type norm = 0;
+  for (size_t j = 0; j < n; ++j) {
+    if (m_qr(j, j) == T(0)) {
+      return std::numeric_limits<real_type>::infinity();
+    }
+    real_type sum = 0;
+    for (size_t i = 0; i <= j; ++i) {
+      sum += std::abs(m_qr(i, j));
+    }
+    norm = std::max(norm, sum);
+  }
+  detail::strided_matrix<const T> r =
+      detail::make_strided_matrix(m_qr).block(0, 0, n, n);
+  real_type inv_norm = detail::inverse_norm1_estimate<T>(
+      n,
+      [&](T *x) {
+        detail::trsm(r, false, false, detail::make_column(x, n));
+      },
+      [&](T *x) {
+        // r^H * x = b is equivalent to r^T * conj(x) = conj(b).
+        detail::strided_matrix<T> b = detail::make_column(x, n);
+        detail::conj_inplace(b);
+        detail::trsm(r.t(), true, false, b);
+        detail::conj_inplace(b);
+      });
+  return norm * inv_norm;
+}
+
+/// Private methods.
+
+template <class T>
+void qr_factorization<T>::solve_r(const detail::strided_matrix<T> &b) const {
+  size_t n = cols();
+  detail::trsm(detail::make_strided_matrix(m_qr).block(0, 0, n, n), false,
+               false, b.block(0, 0, n, b.cols));
+}
+
+template <class T> void qr_factorization<T>::assert_full_rank() const {
+  if (cols() > rows()) {
+    throw std::invalid_argument("matrix has more columns than rows");
+  }
+  for (size_t i = 0; i < cols(); ++i) {
+    if (m_qr(i, i) == T(0)) {
+      throw std::invalid_argument("matrix does not have full column rank");
+    }
+  }
+}
+} // namespace linalg
+} // namespace numcpp
+
+#endif // NUMCPP_DECOMPOSITION_TCC_INCLUDED
@@ -0,0 +1,1035 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/eigen.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_EIGEN_H_INCLUDED
+#define NUMCPP_EIGEN_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/linalg/blas.h"
+#include "numcpp/linalg/factorization.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Number of columns of the panels of the tridiagonal reduction.
+ */
+const size_t tridiagonal_block_size = 32;
+
+/**
+ * @brief Trailing matrices with at most this many rows are reduced in a
+ * single panel.
+ */
+const size_t tridiagonal_crossover = 128;
+
+/**
+ * @brief Tridiagonal matrices with at most this many rows are solved
+ * directly by the divide-and-conquer method.
+ */
+const size_t divide_conquer_leaf_size = 32;
+
+/**
+ * @brief Compute y = a * x, where a is Hermitian and only its lower triangle
+ * is read. The rows of @a a must be contiguous. The rows are split among the
+ * available threads, each one accumulating into its own copy of y.
+ */
+template <class T>
+void hemv_lower(const strided_matrix<const T> &a, const T *x, T *y) {
+  size_t n = a.rows;
+  size_t tasks = num_tasks(n * n / 2, n);
+  std::vector<T> partial((tasks - 1) * n, T(0));
+  std::fill_n(y, n, T(0));
+  parallel_for(tasks, [&](size_t task) {
+    // Split the rows so that each task reads the same number of elements.
+    size_t first = size_t(n * std::sqrt(double(task) / tasks));
+    size_t last = size_t(n * std::sqrt(double(task + 1) / tasks));
+    T *out = (task == 0) ? y : partial.data() + (task - 1) * n;
+    for (size_t i = first; i < last; ++i) {
+      const T *row = &a(i, 0);
+      T xi = x[i], acc = T(0);
+      for (size_t j = 0; j < i; ++j) {
+        acc += row[j] * x[j];
+        out[j] += conj_value(row[j]) * xi;
+      }
+      out[i] += acc + std::real(row[i]) * xi;
+    }
+  });
+  for (size_t task = 1; task < tasks; ++task) {
+    const T *in = partial.data() + (task - 1) * n;
+    for (size_t i = 0; i < n; ++i) {
+      y[i] += in[i];
+    }
+  }
+}
+
+/**
+ * @brief Reduce the first @a nb columns of a Hermitian matrix to tridiagonal
+ * form, without updating the trailing matrix.
+ *
+ * @details Returns in @a w the matrix such that the trailing matrix is
+ * updated as a - v * w^H - w * v^H, where v holds the reflectors. On exit,
+ * the reflectors are stored below the subdiagonal of the first @a nb columns
+ * of @a a and the subdiagonal holds ones.
+ *
+ * @param a A matrix of size m x m with contiguous rows. Only its lower
+ *          triangle is read.
+ * @param nb Number of columns to reduce.
+ * @param e Pointer to an array where to store the subdiagonal.
+ * @param tau Pointer to an array where to store the scalar factors of the
+ *            reflectors.
+ * @param w A matrix of size m x nb.
+ */
+template <class T>
+void tridiagonal_panel(const strided_matrix<T> &a, size_t nb,
+                       typename complex_traits<T>::value_type *e, T *tau,
+                       const strided_matrix<T> &w) {
+  size_t m = a.rows;
+  std::vector<T> v(m), y(m), tmp1(nb), tmp2(nb);
+  for (size_t i = 0; i < nb; ++i) {
+    // Update column i with the reflectors of the previous columns.
+    a(i, i) = std::real(a(i, i));
+    for (size_t r = i; r < m; ++r) {
+      T val = T(0);
+      for (size_t p = 0; p < i; ++p) {
+        val += a(r, p) * conj_value(w(i, p)) + w(r, p) * conj_value(a(i, p));
+      }
+      a(r, i) -= val;
+    }
+    a(i, i) = std::real(a(i, i));
+    if (i + 1 == m) {
+      break;
+    }
+
+    // Generate the reflector that annihilates a(i + 2:m, i).
+    size_t rows = m - i - 1;
+    tau[i] = householder(a.block(i + 1, i, rows, 1));
+    e[i] = std::real(a(i + 1, i));
+    a(i + 1, i) = T(1);
+    for (size_t r = 0; r < rows; ++r) {
+      v[r] = a(i + 1 + r, i);
+    }
+
+    // w(i + 1:m, i) = tau * (a - v * w^H - w * v^H) * v, where the product
+    // with the trailing matrix only reads its lower triangle.
+    hemv_lower<T>(a.block(i + 1, i + 1, rows, rows), v.data(), y.data());
+    std::fill_n(tmp1.begin(), i, T(0));
+    std::fill_n(tmp2.begin(), i, T(0));
+    for (size_t r = 0; r < rows; ++r) {
+      for (size_t p = 0; p < i; ++p) {
+        tmp1[p] += conj_value(w(i + 1 + r, p)) * v[r];
+        tmp2[p] += conj_value(a(i + 1 + r, p)) * v[r];
+      }
+    }
+    T dot = T(0);
+    for (size_t r = 0; r < rows; ++r) {
+      T val = y[r];
+      for (size_t p = 0; p < i; ++p) {
+        val -= a(i + 1 + r, p) * tmp1[p] + w(i + 1 + r, p) * tmp2[p];
+      }
+      y[r] = tau[i] * val;
+      dot += conj_value(y[r]) * v[r];
+    }
+    T alpha = -T(0.5) * tau[i] * dot;
+    for (size_t r = 0; r < rows; ++r) {
+      w(i + 1 + r, i) = y[r] + alpha * v[r];
+    }
+  }
+}
+
+/**
+ * @brief Reduce a Hermitian matrix to real symmetric tridiagonal form,
+ * @f$A = QTQ^*@f$, by Householder reflections.
+ *
+ * @details The matrix is reduced by panels of tridiagonal_block_size
+ * columns. After each panel, the trailing matrix is updated with matrix
+ * multiplications, which are split among the available threads. The rest of
+ * the work consists of matrix-vector products with the trailing matrix.
+ *
+ * @param a A matrix of size n x n with contiguous rows. Only its lower
+ *          triangle is read. On exit, the reflectors are stored below the
+ *          subdiagonal, as in a QR factorization of a(1:n, 0:n - 1), and
+ *          the upper triangle is overwritten.
+ * @param d, e Pointers to arrays of size n and n - 1 where to store the
+ *             diagonal and the subdiagonal of T.
+ * @param tau Pointer to an array of size n - 1 where to store the scalar
+ *            factors of the reflectors.
+ */
+template <class T>
+void tridiagonalize(const strided_matrix<T> &a,
+                    typename complex_traits<T>::value_type *d,
+                    typename complex_traits<T>::value_type *e, T *tau) {
+  size_t n = a.rows, nb = tridiagonal_block_size;
+  std::vector<T> w, left, right;
+  for (size_t i = 0; i < n;) {
+    size_t m = n - i, jb = (m > tridiagonal_crossover) ? nb : m;
+    w.assign(m * jb, T(0));
+    tridiagonal_panel(a.block(i, i, m, m), jb, e + i, tau + i,
+                      strided_matrix<T>(w.data(), m, jb, jb, 1));
+
+    // Update the lower triangle of the trailing matrix by blocks of columns,
+    // a = a - [v w] * [w v]^H.
+    size_t r = m - jb;
+    if (r > 0) {
+      left.resize(r * 2 * jb);
+      right.resize(2 * jb * r);
+      for (size_t p = 0; p < r; ++p) {
+        for (size_t q = 0; q < jb; ++q) {
+          T vval = a(i + jb + p, i + q), wval = w[(jb + p) * jb + q];
+          left[p * 2 * jb + q] = vval;
+          left[p * 2 * jb + jb + q] = wval;
+          right[q * r + p] = conj_value(wval);
+          right[(jb + q) * r + p] = conj_value(vval);
+        }
+      }
+      strided_matrix<const T> lmat(left.data(), r, 2 * jb, 2 * jb, 1);
+      strided_matrix<const T> rmat(right.data(), 2 * jb, r, r, 1);
+      strided_matrix<T> c = a.block(i + jb, i + jb, r, r);
+      for (size_t j = 0; j < r; j += tridiagonal_crossover) {
+        size_t cols = std::min(tridiagonal_crossover, r - j);
+        gemm<T>(T(-1), lmat.block(j, 0, r - j, 2 * jb),
+                rmat.block(0, j, 2 * jb, cols), T(1),
+                c.block(j, j, r - j, cols));
+      }
+    }
+    for (size_t j = i; j < i + jb; ++j) {
+      if (j + 1 < n) {
+        a(j + 1, j) = e[j];
+      }
+      d[j] = std::real(a(j, j));
+    }
+    i += jb;
+  }
+}
+
+/**
+ * @brief Multiply a matrix from the left by the unitary matrix @f$Q@f$ of a
+ * tridiagonal reduction.
+ *
+ * @param a, tau The reduction returned by tridiagonalize.
+ * @param c A matrix with as many rows as @a a. It is overwritten with the
+ *          product.
+ */
+template <class T>
+void tridiagonal_multiply(const strided_matrix<const T> &a, const T *tau,
+                          const strided_matrix<T> &c) {
+  size_t n = a.rows;
+  if (n < 2) {
+    return;
+  }
+  // Q = diag(1, Q'), where Q' is the orthogonal factor of the QR
+  // factorization stored in a(1:n, 0:n - 1).
+  householder_multiply<T>(a.block(1, 0, n - 1, n - 1), tau, false,
+                          c.block(1, 0, n - 1, c.cols));
+}
+
+/**
+ * @brief Compute the eigenvalues and, optionally, the eigenvectors of a
+ * symmetric tridiagonal matrix by the implicit QL method with Wilkinson
+ * shifts.
+ *
+ * @param n Size of the matrix.
+ * @param d Pointer to the diagonal. It is overwritten with the eigenvalues,
+ *          in ascending order.
+ * @param e Pointer to an array of size n whose first n - 1 elements are the
+ *          subdiagonal. It is destroyed.
+ * @param z Pointer to an n x n matrix in row-major order initialized to the
+ *          identity, or a null pointer if eigenvectors are not required. Row
+ *          i is overwritten with the eigenvector of the i-th eigenvalue.
+ *
+ * @throw std::runtime_error Thrown if the method fails to converge.
+ */
+template <class T> void tridiagonal_ql(size_t n, T *d, T *e, T *z) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  if (n == 0) {
+    return;
+  }
+  e[n - 1] = T(0);
+  T shift = T(0), tst = T(0);
+  for (size_t l = 0; l < n; ++l) {
+    tst = std::max(tst, std::abs(d[l]) + std::abs(e[l]));
+    size_t m = l;
+    while (std::abs(e[m]) > eps * tst) {
+      ++m;
+    }
+    size_t iter = 0;
+    while (m > l) {
+      if (++iter > 30 * n) {
+        throw std::runtime_error("eigenvalue computation did not converge");
+      }
+      // Compute the Wilkinson shift and shift the trailing diagonal.
+      T g = d[l];
+      T p = (d[l + 1] - g) / (T(2) * e[l]);
+      T r = std::copysign(std::hypot(p, T(1)), p);
+      d[l] = e[l] / (p + r);
+      d[l + 1] = e[l] * (p + r);
+      T dl1 = d[l + 1], h = g - d[l];
+      for (size_t i = l + 2; i < n; ++i) {
+        d[i] -= h;
+      }
+      shift += h;
+
+      // Chase the bulge with plane rotations.
+      p = d[m];
+      T c = T(1), c2 = c, c3 = c, el1 = e[l + 1], s = T(0), s2 = T(0);
+      for (size_t i = m; i-- > l;) {
+        c3 = c2;
+        c2 = c;
+        s2 = s;
+        g = c * e[i];
+        h = c * p;
+        r = std::hypot(p, e[i]);
+        e[i + 1] = s * r;
+        s = e[i] / r;
+        c = p / r;
+        p = c * d[i] - s * g;
+        d[i + 1] = h + s * (c * g + s * d[i]);
+        if (z != NULL) {
+          T *zi = z + i * n, *zj = z + (i + 1) * n;
+          for (size_t k = 0; k < n; ++k) {
+            T zk = zj[k];
+            zj[k] = s * zi[k] + c * zk;
+            zi[k] = c * zi[k] - s * zk;
+          }
+        }
+      }
+      p = -s * s2 * c3 * el1 * e[l] / dl1;
+      e[l] = s * p;
+      d[l] = c * p;
+      if (std::abs(e[l]) <= eps * tst) {
+        break;
+      }
+    }
+    d[l] += shift;
+    e[l] = T(0);
+  }
+
+  // Sort the eigenvalues and eigenvectors.
+  for (size_t i = 0; i + 1 < n; ++i) {
+    size_t k = std::min_element(d + i, d + n) - d;
+    if (k != i) {
+      std::swap(d[i], d[k]);
+      if (z != NULL) {
+        std::swap_ranges(z + i * n, z + (i + 1) * n, z + k * n);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Solve the secular equation 1 + rho * sum(z(j)^2 / (d(j) - x)) = 0,
+ * whose roots are the eigenvalues of diag(d) + rho * z * z^T.
+ *
+ * @details The i-th root lies between d(i) and d(i + 1). Each root is
+ * computed as an offset from the closest of these two poles, so that the
+ * differences d(j) - x, which determine the eigenvectors, are accurate even
+ * when the root is very close to a pole. At each step, the function is
+ * interpolated by a rational function with the same poles, safeguarded by
+ * bisection.
+ *
+ * @param k Number of terms.
+ * @param d Pointer to the poles, in strictly increasing order.
+ * @param z Pointer to the weights. They must not be zero.
+ * @param rho A positive scalar.
+ * @param lambda Pointer to an array of size k where to store the roots.
+ * @param delta Pointer to a k x k matrix in row-major order where to store
+ *              delta(i, j) = d(j) - lambda(i).
+ */
+template <class T>
+void secular_solve(size_t k, const T *d, const T *z, T rho, T *lambda,
+                   T *delta) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  T znorm = T(0);
+  for (size_t j = 0; j < k; ++j) {
+    znorm += z[j] * z[j];
+  }
+  for (size_t i = 0; i < k; ++i) {
+    T *dlt = delta + i * k;
+    size_t origin = i;
+    T lo = T(0), hi = rho * znorm;
+    if (i + 1 < k) {
+      // The function is increasing between the poles. Its sign at the
+      // midpoint tells which pole is closer to the root.
+      T gap = d[i + 1] - d[i], mid = gap / T(2), f = T(1);
+      for (size_t j = 0; j < k; ++j) {
+        f += rho * z[j] * z[j] / ((d[j] - d[i]) - mid);
+      }
+      if (f >= T(0)) {
+        hi = mid;
+      } else {
+        origin = i + 1;
+        lo = mid - gap;
+        hi = T(0);
+      }
+    }
+
+    T tau = (lo + hi) / T(2);
+    for (size_t iter = 0; iter < 200; ++iter) {
+      T psi = T(0), dpsi = T(0), phi = T(0), dphi = T(0), err = T(1);
+      for (size_t j = 0; j < k; ++j) {
+        dlt[j] = (d[j] - d[origin]) - tau;
+        T term = rho * z[j] / dlt[j];
+        if (j <= i) {
+          psi += term * z[j];
+          dpsi += term * term / rho;
+        } else {
+          phi += term * z[j];
+          dphi += term * term / rho;
+        }
+        err += std::abs(term * z[j]);
+      }
+      T f = T(1) + psi + phi;
+      if (std::abs(f) <= eps * err) {
+        break;
+      }
+      if (f < T(0)) {
+        lo = tau;
+      } else {
+        hi = tau;
+      }
+
+      // Interpolate by c + s / (delta(i) - eta) + t / (delta(i + 1) - eta)
+      // and take the root between the poles.
+      T da = dlt[i], eta;
+      if (i + 1 < k) {
+        T db = dlt[i + 1];
+        T s = da * da * dpsi, t = db * db * dphi;
+        T c = f - da * dpsi - db * dphi;
+        T b = c * (da + db) + s + t, prod = da * db * f;
+        T disc = std::sqrt(std::max(b * b - T(4) * c * prod, T(0)));
+        if (b >= T(0)) {
+          eta = T(2) * prod / (b + disc);
+        } else {
+          eta = (b - disc) / (T(2) * c);
+        }
+      } else {
+        T s = da * da * dpsi, c = f - da * dpsi;
+        eta = da + s / c;
+      }
+      T next = tau + eta;
+      if (!(next > lo && next < hi)) {
+        next = (lo + hi) / T(2);
+      }
+      if (next == tau || hi - lo <= T(2) * eps * std::abs(tau)) {
+        break;
+      }
+      tau = next;
+    }
+    for (size_t j = 0; j < k; ++j) {
+      dlt[j] = (d[j] - d[origin]) - tau;
+    }
+    lambda[i] = d[origin] + tau;
+  }
+}
+
+/**
+ * @brief Merge step of the divide-and-conquer method. Compute the
+ * eigendecomposition of a tridiagonal matrix from the eigendecompositions of
+ * its leading m x m and trailing (n - m) x (n - m) blocks.
+ *
+ * @details The matrix is the direct sum of the blocks plus a rank-one
+ * correction. Eigenvalues with a negligible weight, or too close to another
+ * one, are deflated. The remaining eigenvalues are the roots of a secular
+ * equation. The weights are recomputed from the roots (Gu and Eisenstat), so
+ * that the eigenvectors are orthogonal to working precision. The
+ * eigenvectors are multiplied by those of the blocks with matrix
+ * multiplications, skipping the zero blocks.
+ *
+ * @param n Size of the matrix.
+ * @param m Size of the leading block.
+ * @param d Pointer to the eigenvalues of the blocks, with the rank-one
+ *          correction removed. It is overwritten with the eigenvalues of the
+ *          matrix, in ascending order.
+ * @param beta Element of the subdiagonal coupling both blocks.
+ * @param q A matrix of size n x n with contiguous rows holding the
+ *          eigenvectors of the blocks in its diagonal blocks and zeros
+ *          elsewhere. It is overwritten with the eigenvectors of the matrix.
+ */
+template <class T>
+void tridiagonal_merge(size_t n, size_t m, T *d, T beta,
+                       const strided_matrix<T> &q) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  // The correction is rho * z * z^T, where z is made of the last row of the
+  // eigenvectors of the first block and the first row of the second one.
+  // Each column of q is labelled by the rows where it is nonzero: the top
+  // block (0), both blocks (1) or the bottom block (2).
+  std::vector<T> z(n);
+  std::vector<int> type(n);
+  T scale = std::sqrt(T(0.5)), sign = (beta < T(0)) ? T(-1) : T(1);
+  for (size_t j = 0; j < n; ++j) {
+    z[j] = (j < m) ? scale * q(m - 1, j) : sign * scale * q(m, j);
+    type[j] = (j < m) ? 0 : 2;
+  }
+  T rho = T(2) * std::abs(beta);
+
+  // Deflation.
+  std::vector<size_t> perm(n), kept, deflated;
+  std::iota(perm.begin(), perm.end(), 0);
+  std::stable_sort(perm.begin(), perm.end(),
+                   [&](size_t i, size_t j) { return d[i] < d[j]; });
+  T dmax = T(0), zmax = T(0);
+  for (size_t j = 0; j < n; ++j) {
+    dmax = std::max(dmax, std::abs(d[j]));
+    zmax = std::max(zmax, std::abs(z[j]));
+  }
+  T tol = T(8) * eps * std::max(dmax, zmax);
+  size_t pj = n;
+  for (size_t nj : perm) {
+    if (rho * std::abs(z[nj]) <= tol) {
+      deflated.push_back(nj);
+      continue;
+    }
+    if (pj == n) {
+      pj = nj;
+      continue;
+    }
+    // If two eigenvalues are close, a plane rotation zeros one of the
+    // weights.
+    T s = z[pj], c = z[nj], r = std::hypot(c, s), t = d[nj] - d[pj];
+    c /= r;
+    s = -s / r;
+    if (std::abs(t * c * s) <= tol) {
+      z[nj] = r;
+      z[pj] = T(0);
+      for (size_t i = 0; i < n; ++i) {
+        T x = q(i, pj), y = q(i, nj);
+        q(i, pj) = c * x + s * y;
+        q(i, nj) = c * y - s * x;
+      }
+      if (type[pj] != type[nj]) {
+        type[nj] = 1;
+      }
+      T dp = d[pj] * c * c + d[nj] * s * s;
+      d[nj] = d[pj] * s * s + d[nj] * c * c;
+      d[pj] = dp;
+      deflated.push_back(pj);
+    } else {
+      kept.push_back(pj);
+    }
+    pj = nj;
+  }
+  if (pj != n) {
+    kept.push_back(pj);
+  }
+  std::stable_sort(kept.begin(), kept.end(),
+                   [&](size_t i, size_t j) { return d[i] < d[j]; });
+
+  // Solve the secular equation and recompute the weights from its roots.
+  size_t k = kept.size();
+  std::vector<T> dk(k), zk(k), lambda(k), delta(k * k), u(k * k);
+  for (size_t j = 0; j < k; ++j) {
+    dk[j] = d[kept[j]];
+    zk[j] = z[kept[j]];
+  }
+  secular_solve(k, dk.data(), zk.data(), rho, lambda.data(), delta.data());
+  for (size_t j = 0; j < k; ++j) {
+    T w = -delta[j * k + j] / rho;
+    for (size_t i = 0; i < k; ++i) {
+      if (i != j) {
+        w *= -delta[i * k + j] / (dk[i] - dk[j]);
+      }
+    }
+    zk[j] = std::copysign(std::sqrt(w), zk[j]);
+  }
+
+  // Order the kept columns by type. Row r of u holds the r-th of them.
+  std::vector<size_t> order(k);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+    return type[kept[i]] < type[kept[j]];
+  });
+  size_t ntop = 0, nbottom = 0;
+  for (size_t j : kept) {
+    ntop += (type[j] == 0);
+    nbottom += (type[j] == 2);
+  }
+  for (size_t i = 0; i < k; ++i) {
+    T norm = T(0);
+    for (size_t j = 0; j < k; ++j) {
+      T val = zk[j] / delta[i * k + j];
+      delta[i * k + j] = val;
+      norm += val * val;
+    }
+    norm = std::sqrt(norm);
+    for (size_t r = 0; r < k; ++r) {
+      u[r * k + i] = delta[i * k + order[r]] / norm;
+    }
+  }
+
+  // Move the kept columns to the front, in the order of u, followed by the
+  // deflated columns.
+  std::vector<size_t> columns(n);
+  for (size_t r = 0; r < k; ++r) {
+    columns[r] = kept[order[r]];
+  }
+  std::copy(deflated.begin(), deflated.end(), columns.begin() + k);
+  std::vector<T> row(n);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t c = 0; c < n; ++c) {
+      row[c] = q(i, columns[c]);
+    }
+    for (size_t c = 0; c < n; ++c) {
+      q(i, c) = row[c];
+    }
+  }
+
+  // Multiply the eigenvectors of the blocks by those of the correction. If
+  // every pole was deflated, there is nothing to multiply.
+  std::vector<T> prod(n * k);
+  if (k > 0) {
+    strided_matrix<T> pmat(prod.data(), n, k, k, 1);
+    strided_matrix<const T> umat(u.data(), k, k, k, 1);
+    gemm<T>(T(1), q.block(0, 0, m, k - nbottom),
+            umat.block(0, 0, k - nbottom, k), T(0), pmat.block(0, 0, m, k));
+    gemm<T>(T(1), q.block(m, ntop, n - m, k - ntop),
+            umat.block(ntop, 0, k - ntop, k), T(0),
+            pmat.block(m, 0, n - m, k));
+  }
+
+  // Merge the roots and the deflated eigenvalues in ascending order.
+  std::vector<T> values(n);
+  std::copy(lambda.begin(), lambda.end(), values.begin());
+  for (size_t c = k; c < n; ++c) {
+    values[c] = d[columns[c]];
+  }
+  std::iota(perm.begin(), perm.end(), 0);
+  std::stable_sort(perm.begin(), perm.end(), [&](size_t i, size_t j) {
+    return values[i] < values[j];
+  });
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t c = 0; c < n; ++c) {
+      size_t src = perm[c];
+      row[c] = (src < k) ? prod[i * k + src] : q(i, src);
+    }
+    for (size_t c = 0; c < n; ++c) {
+      q(i, c) = row[c];
+    }
+  }
+  for (size_t c = 0; c < n; ++c) {
+    d[c] = values[perm[c]];
+  }
+}
+
+/**
+ * @brief Compute the eigenvalues and eigenvectors of a symmetric tridiagonal
+ * matrix by the divide-and-conquer method.
+ *
+ * @details The deflation tolerance is not relative to the size of the
+ * matrix, which should be scaled so that its largest element is about one.
+ *
+ * @param n Size of the matrix.
+ * @param d Pointer to the diagonal. It is overwritten with the eigenvalues,
+ *          in ascending order.
+ * @param e Pointer to the subdiagonal.
+ * @param q A matrix of size n x n with contiguous rows, initialized to zero.
+ *          It is overwritten with the eigenvectors, stored by columns.
+ */
+template <class T>
+void tridiagonal_divide(size_t n, T *d, const T *e,
+                        const strided_matrix<T> &q) {
+  if (n <= divide_conquer_leaf_size) {
+    std::vector<T> sub(n + 1, T(0)), z(n * n, T(0));
+    std::copy(e, e + (n > 0 ? n - 1 : 0), sub.begin());
+    for (size_t i = 0; i < n; ++i) {
+      z[i * n + i] = T(1);
+    }
+    tridiagonal_ql(n, d, sub.data(), z.data());
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        q(i, j) = z[j * n + i];
+      }
+    }
+    return;
+  }
+  // Tear the matrix into two blocks and a rank-one correction.
+  size_t m = n / 2;
+  T beta = e[m - 1];
+  d[m - 1] -= std::abs(beta);
+  d[m] -= std::abs(beta);
+  tridiagonal_divide(m, d, e, q.block(0, 0, m, m));
+  tridiagonal_divide(n - m, d + m, e + m, q.block(m, m, n - m, n - m));
+  tridiagonal_merge(n, m, d, beta, q);
+}
+
+/**
+ * @brief Return the number of eigenvalues of a symmetric tridiagonal matrix
+ * less than @a x, from the signs of the pivots of T - x * I (Sturm
+ * sequence).
+ */
+template <class T>
+size_t tridiagonal_count(size_t n, const T *d, const T *e, T x, T pivmin) {
+  size_t count = 0;
+  T pivot = T(1);
+  for (size_t i = 0; i < n; ++i) {
+    pivot = (d[i] - x) - ((i > 0) ? e[i - 1] * e[i - 1] / pivot : T(0));
+    if (std::abs(pivot) <= pivmin) {
+      pivot = -pivmin;
+    }
+    count += (pivot < T(0));
+  }
+  return count;
+}
+
+/**
+ * @brief Compute selected eigenvalues of a symmetric tridiagonal matrix by
+ * bisection. The eigenvalues are split among the available threads.
+ *
+ * @param n Size of the matrix.
+ * @param d, e Pointers to the diagonal and the subdiagonal.
+ * @param index Pointer to the positions of the eigenvalues to compute, in
+ *              ascending order.
+ * @param k Number of eigenvalues to compute.
+ * @param w Pointer to an array of size k where to store the eigenvalues.
+ */
+template <class T>
+void tridiagonal_bisect(size_t n, const T *d, const T *e, const size_t *index,
+                        size_t k, T *w) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  T lower = T(0), upper = T(0), emax = T(0);
+  for (size_t i = 0; i < n; ++i) {
+    T radius = ((i > 0) ? std::abs(e[i - 1]) : T(0)) +
+               ((i + 1 < n) ? std::abs(e[i]) : T(0));
+    lower = (i == 0) ? d[i] - radius : std::min(lower, d[i] - radius);
+    upper = (i == 0) ? d[i] + radius : std::max(upper, d[i] + radius);
+    if (i + 1 < n) {
+      emax = std::max(emax, e[i] * e[i]);
+    }
+  }
+  T pivmin = std::numeric_limits<T>::min() * std::max(T(1), emax);
+  T margin = T(2) * eps * std::max(std::abs(lower), std::abs(upper)) + pivmin;
+  lower -= margin;
+  upper += margin;
+  size_t tasks = num_tasks(k * n, k);
+  parallel_for(tasks, [&](size_t task) {
+    for (size_t c = block_begin(task, tasks, k);
+         c < block_begin(task + 1, tasks, k); ++c) {
+      T lo = lower, hi = upper;
+      while (hi - lo > T(2) * eps * std::max(std::abs(lo), std::abs(hi)) +
+                           pivmin) {
+        T mid = lo + (hi - lo) / T(2);
+        if (mid <= lo || mid >= hi) {
+          break;
+        }
+        if (tridiagonal_count(n, d, e, mid, pivmin) > index[c]) {
+          hi = mid;
+        } else {
+          lo = mid;
+        }
+      }
+      w[c] = lo + (hi - lo) / T(2);
+    }
+  });
+}
+
+/**
+ * @brief Compute the eigenvectors of a symmetric tridiagonal matrix for
+ * given eigenvalues by inverse iteration.
+ *
+ * @details Each eigenvector is the result of a few solves with
+ * T - lambda * I, which is factorized by Gaussian elimination with partial
+ * pivoting. Eigenvectors of close eigenvalues are reorthogonalized against
+ * each other.
+ *
+ * @param n Size of the matrix.
+ * @param d, e Pointers to the diagonal and the subdiagonal.
+ * @param w Pointer to the eigenvalues, in ascending order.
+ * @param k Number of eigenvalues.
+ * @param z A matrix of size n x k where to store the eigenvectors, by
+ *          columns.
+ */
+template <class T>
+void tridiagonal_inverse_iteration(size_t n, const T *d, const T *e,
+                                   const T *w, size_t k,
+                                   const strided_matrix<T> &z) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  T tnorm = T(0);
+  for (size_t i = 0; i < n; ++i) {
+    tnorm = std::max(tnorm, std::abs(d[i]) +
+                                ((i > 0) ? std::abs(e[i - 1]) : T(0)) +
+                                ((i + 1 < n) ? std::abs(e[i]) : T(0)));
+  }
+  T pivtol = std::max(eps * tnorm, std::numeric_limits<T>::min());
+  T cluster_tol = T(1e-3) * tnorm;
+  T threshold = T(0.1) / (std::sqrt(T(n)) * pivtol);
+  std::vector<T> diag(n), lower(n), upper(n), upper2(n), x(n), vectors(k * n);
+  std::vector<char> swapped(n);
+  size_t first = 0;
+  T lambda = T(0);
+  unsigned long seed = 1;
+  for (size_t c = 0; c < k; ++c) {
+    // Vectors of the same cluster are reorthogonalized. Equal eigenvalues
+    // are perturbed slightly so that the factorizations differ.
+    T prev = lambda;
+    lambda = w[c];
+    if (c > 0 && lambda - w[c - 1] > cluster_tol) {
+      first = c;
+    } else if (c > 0) {
+      lambda = std::max(lambda, prev + T(10) * pivtol);
+    }
+
+    // Factorize T - lambda * I = P * L * U.
+    for (size_t i = 0; i < n; ++i) {
+      diag[i] = d[i] - lambda;
+      lower[i] = upper[i] = (i + 1 < n) ? e[i] : T(0);
+      upper2[i] = T(0);
+      swapped[i] = false;
+    }
+    for (size_t i = 0; i + 1 < n; ++i) {
+      if (std::abs(diag[i]) >= std::abs(lower[i])) {
+        if (diag[i] != T(0)) {
+          lower[i] /= diag[i];
+          diag[i + 1] -= lower[i] * upper[i];
+        }
+      } else {
+        T fact = diag[i] / lower[i];
+        diag[i] = lower[i];
+        lower[i] = fact;
+        T temp = upper[i];
+        upper[i] = diag[i + 1];
+        diag[i + 1] = temp - fact * diag[i + 1];
+        if (i + 2 < n) {
+          upper2[i] = upper[i + 1];
+          upper[i + 1] *= -fact;
+        }
+        swapped[i] = true;
+      }
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (std::abs(diag[i]) < pivtol) {
+        diag[i] = (diag[i] < T(0)) ? -pivtol : pivtol;
+      }
+    }
+
+    // Start from a pseudo-random vector.
+    for (size_t i = 0; i < n; ++i) {
+      seed = (seed * 1103515245ul + 12345ul) % 2147483648ul;
+      x[i] = T(seed) / T(1073741824) - T(1);
+    }
+    T *v = vectors.data() + c * n;
+    for (size_t iter = 0, extra = 0; iter < 5 && extra < 2; ++iter) {
+      for (size_t i = 0; i + 1 < n; ++i) {
+        if (!swapped[i]) {
+          x[i + 1] -= lower[i] * x[i];
+        } else {
+          T temp = x[i];
+          x[i] = x[i + 1];
+          x[i + 1] = temp - lower[i] * x[i];
+        }
+      }
+      for (size_t i = n; i-- > 0;) {
+        T val = x[i];
+        if (i + 1 < n) {
+          val -= upper[i] * x[i + 1];
+        }
+        if (i + 2 < n) {
+          val -= upper2[i] * x[i + 2];
+        }
+        x[i] = val / diag[i];
+      }
+      for (size_t p = first; p < c; ++p) {
+        const T *u = vectors.data() + p * n;
+        T dot = std::inner_product(u, u + n, x.begin(), T(0));
+        for (size_t i = 0; i < n; ++i) {
+          x[i] -= dot * u[i];
+        }
+      }
+      T norm = std::sqrt(std::inner_product(x.begin(), x.end(), x.begin(),
+                                            T(0)));
+      for (size_t i = 0; i < n; ++i) {
+        x[i] /= norm;
+      }
+      if (norm >= threshold) {
+        ++extra;
+      }
+    }
+    std::copy(x.begin(), x.end(), v);
+  }
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t c = 0; c < k; ++c) {
+      z(i, c) = vectors[c * n + i];
+    }
+  }
+}
+
+/**
+ * @brief A subset of the eigenvalues of a matrix: either those at the
+ * positions selected by a slice or those in a half-open interval.
+ */
+template <class T> struct eigen_subset {
+  bool by_value;
+  slice index;
+  T low, high;
+};
+
+/**
+ * @brief Compute selected eigenvalues and, optionally, eigenvectors of a
+ * Hermitian matrix.
+ *
+ * @details The matrix is reduced to tridiagonal form. If most of the
+ * eigenvalues are requested, all of them are computed, by the
+ * divide-and-conquer method if eigenvectors are required or by the QL method
+ * otherwise. Otherwise, the selected eigenvalues are computed by bisection
+ * and their eigenvectors by inverse iteration. Finally, the eigenvectors are
+ * transformed back with the reflectors of the reduction. If an external
+ * LAPACK is enabled and all the eigenvalues are requested, they are computed
+ * by it instead.
+ *
+ * @param a A square matrix with contiguous rows. Only its lower triangle is
+ *          read. It is overwritten.
+ * @param subset The eigenvalues to compute.
+ * @param w Vector where to store the eigenvalues, in ascending order.
+ * @param v A pointer to a matrix where to store the eigenvectors, by
+ *          columns, or a null pointer if they are not required.
+ */
+template <class T>
+void hermitian_eigen(
+    const strided_matrix<T> &a,
+    const eigen_subset<typename complex_traits<T>::value_type> &subset,
+    std::vector<typename complex_traits<T>::value_type> &w,
+    tensor<T, 2> *v) {
+  typedef typename complex_traits<T>::value_type real_type;
+  const real_type eps = std::numeric_limits<real_type>::epsilon();
+  size_t n = a.rows;
+  if (!subset.by_value && subset.index.start() == 0 &&
+      subset.index.stride() == 1 && subset.index.size() >= n &&
+      external_hermitian_eigen(a, w, v)) {
+    return;
+  }
+
+  // Scale the matrix if its norm is too small or too large.
+  real_type anorm = real_type(0), scale = real_type(1);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j <= i; ++j) {
+      anorm = std::max(anorm, real_type(std::abs(a(i, j))));
+    }
+  }
+  real_type rmin = std::sqrt(std::numeric_limits<real_type>::min() / eps);
+  real_type rmax = real_type(1) / rmin;
+  if (anorm > real_type(0) && anorm < rmin) {
+    scale = rmin / anorm;
+  } else if (anorm > rmax) {
+    scale = rmax / anorm;
+  }
+  if (scale != real_type(1)) {
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j <= i; ++j) {
+        a(i, j) *= scale;
+      }
+    }
+  }
+
+  std::vector<real_type> d(n), e(n, real_type(0));
+  std::vector<T> tau(n);
+  tridiagonalize(a, d.data(), e.data(), tau.data());
+
+  // Scale the tridiagonal matrix so that its largest element is one.
+  real_type tnorm = real_type(0);
+  for (size_t i = 0; i < n; ++i) {
+    tnorm = std::max(tnorm, std::max(std::abs(d[i]), std::abs(e[i])));
+  }
+  if (tnorm > real_type(0)) {
+    for (size_t i = 0; i < n; ++i) {
+      d[i] /= tnorm;
+      e[i] /= tnorm;
+    }
+    scale /= tnorm;
+  }
+
+  // Positions of the selected eigenvalues.
+  std::vector<size_t> index;
+  if (subset.by_value) {
+    real_type emax = real_type(0);
+    for (size_t i = 0; i + 1 < n; ++i) {
+      emax = std::max(emax, e[i] * e[i]);
+    }
+    real_type pivmin =
+        std::numeric_limits<real_type>::min() * std::max(real_type(1), emax);
+    size_t first = tridiagonal_count(n, d.data(), e.data(),
+                                     subset.low * scale, pivmin);
+    size_t last = tridiagonal_count(n, d.data(), e.data(),
+                                    subset.high * scale, pivmin);
+    for (size_t i = first; i < last; ++i) {
+      index.push_back(i);
+    }
+  } else {
+    for (size_t i = 0; i < subset.index.size(); ++i) {
+      size_t pos = subset.index.start() + i * subset.index.stride();
+      if (pos >= n) {
+        break;
+      }
+      index.push_back(pos);
+    }
+  }
+
+  size_t k = index.size();
+  w.resize(k);
+  std::vector<real_type> z;
+  if (v != NULL) {
+    z.assign(n * k, real_type(0));
+  }
+  strided_matrix<real_type> zmat(z.data(), n, k, k, 1);
+  if (4 * k >= n) {
+    if (v != NULL) {
+      std::vector<real_type> q(n * n, real_type(0));
+      strided_matrix<real_type> qmat(q.data(), n, n, n, 1);
+      tridiagonal_divide(n, d.data(), e.data(), qmat);
+      for (size_t i = 0; i < n; ++i) {
+        for (size_t c = 0; c < k; ++c) {
+          zmat(i, c) = qmat(i, index[c]);
+        }
+      }
+    } else {
+      tridiagonal_ql<real_type>(n, d.data(), e.data(), NULL);
+    }
+    for (size_t c = 0; c < k; ++c) {
+      w[c] = d[index[c]];
+    }
+  } else {
+    tridiagonal_bisect(n, d.data(), e.data(), index.data(), k, w.data());
+    if (v != NULL) {
+      tridiagonal_inverse_iteration(n, d.data(), e.data(), w.data(), k, zmat);
+    }
+  }
+  for (size_t c = 0; c < k; ++c) {
+    w[c] /= scale;
+  }
+
+  if (v != NULL) {
+    *v = tensor<T, 2>(n, k);
+    strided_matrix<T> vmat = make_strided_matrix(*v);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t c = 0; c < k; ++c) {
+        vmat(i, c) = zmat(i, c);
+      }
+    }
+    tridiagonal_multiply<T>(a, tau.data(), vmat);
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_EIGEN_H_INCLUDED
@@ -0,0 +1,984 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/factorization.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_FACTORIZATION_H_INCLUDED
+#define NUMCPP_FACTORIZATION_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/linalg/blas.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Return the complex conjugate of a value. Real values are returned
+ * unchanged.
+ */
+template <class T> inline T conj_value(const T &x) { return x; }
+
+template <class T>
+inline std::complex<T> conj_value(const std::complex<T> &x) {
+  return std::conj(x);
+}
+
+/**
+ * @brief Number of columns of the panels of the blocked factorizations.
+ */
+const size_t factorization_block_size = 128;
+
+/**
+ * @brief Panels with at most this many columns are factorized without
+ * recursion.
+ */
+const size_t lu_panel_size = 8;
+
+/**
+ * @brief Call @a f on a strided reference to the elements of a matrix. If
+ * the rows of the matrix are not contiguous, @a f works on a row-major copy
+ * which is then copied back.
+ */
+template <class T, class Function>
+void with_row_major(tensor<T, 2> &a, Function &&f) {
+  if (a.layout() == row_major) {
+    f(make_strided_matrix(a));
+  } else {
+    tensor<T, 2> buffer(a.shape(), row_major);
+    buffer = a;
+    f(make_strided_matrix(buffer));
+    a = buffer;
+  }
+}
+
+template <class T, class Function>
+void with_row_major(tensor_view<T, 2> &a, Function &&f) {
+  if (a.strides(1) == 1 || a.shape(1) < 2) {
+    f(make_strided_matrix(a));
+  } else {
+    tensor<T, 2> buffer(a.shape(), row_major);
+    buffer = a;
+    f(make_strided_matrix(buffer));
+    a = buffer;
+  }
+}
+
+template <class Container, class T, class Function>
+void with_row_major(dense_tensor<Container, T, 2> &a, Function &&f) {
+  tensor<T, 2> buffer(a.shape(), row_major);
+  buffer = a;
+  f(make_strided_matrix(buffer));
+  a = buffer;
+}
+
+/**
+ * @brief Interchange rows i and ipiv[i] of a matrix for each i in
+ * [first, last), in that order. The columns are distributed among the
+ * available threads.
+ */
+template <class T>
+void apply_row_swaps(const strided_matrix<T> &a, const size_t *ipiv,
+                     size_t first, size_t last) {
+  size_t tasks = num_tasks((last - first) * a.cols, a.cols);
+  parallel_for(tasks, [&](size_t task) {
+    size_t j0 = block_begin(task, tasks, a.cols);
+    size_t j1 = block_begin(task + 1, tasks, a.cols);
+    for (size_t i = first; i < last; ++i) {
+      if (ipiv[i] != i) {
+        for (size_t j = j0; j < j1; ++j) {
+          std::swap(a(i, j), a(ipiv[i], j));
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief LU factorization with partial pivoting of a panel.
+ *
+ * @details The panel is split into two halves of columns. The left half is
+ * factorized recursively, the right half is updated with a triangular solve
+ * and a matrix multiplication, and then its lower part is factorized
+ * recursively. Columns without a nonzero pivot are left as they are.
+ *
+ * @param a A matrix of size m x n. It is overwritten with its factors.
+ * @param ipiv Pointer to an array of size min(m, n) where to store the row
+ *             interchanges. Row i was interchanged with row ipiv[i].
+ */
+template <class T> void lu_panel(const strided_matrix<T> &a, size_t *ipiv) {
+  size_t m = a.rows, n = a.cols, k = std::min(m, n);
+  if (k <= lu_panel_size) {
+    for (size_t j = 0; j < k; ++j) {
+      size_t pivot = j;
+      for (size_t i = j + 1; i < m; ++i) {
+        if (std::abs(a(pivot, j)) < std::abs(a(i, j))) {
+          pivot = i;
+        }
+      }
+      ipiv[j] = pivot;
+      if (a(pivot, j) == T(0)) {
+        continue;
+      }
+      for (size_t p = 0; p < n; ++p) {
+        std::swap(a(j, p), a(pivot, p));
+      }
+      for (size_t i = j + 1; i < m; ++i) {
+        T val = a(i, j) /= a(j, j);
+        for (size_t p = j + 1; p < n; ++p) {
+          a(i, p) -= val * a(j, p);
+        }
+      }
+    }
+    return;
+  }
+
+  size_t n1 = k / 2, n2 = n - n1;
+  strided_matrix<T> left = a.block(0, 0, m, n1);
+  strided_matrix<T> right = a.block(0, n1, m, n2);
+  lu_panel(left, ipiv);
+  apply_row_swaps(right, ipiv, 0, n1);
+  trsm<T>(a.block(0, 0, n1, n1), true, true, right.block(0, 0, n1, n2));
+  gemm<T>(T(-1), a.block(n1, 0, m - n1, n1), right.block(0, 0, n1, n2), T(1),
+          right.block(n1, 0, m - n1, n2));
+  lu_panel(right.block(n1, 0, m - n1, n2), ipiv + n1);
+  for (size_t i = n1; i < k; ++i) {
+    ipiv[i] += n1;
+  }
+  apply_row_swaps(left, ipiv, n1, k);
+}
+
+/**
+ * @brief Blocked LU factorization with partial pivoting, a = p * l * u.
+ *
+ * @details At each step, a panel of factorization_block_size columns is
+ * factorized. Then, the row interchanges are applied to the rest of the
+ * matrix, the block row to the right of the panel is solved against the unit
+ * lower triangular factor, and the trailing matrix is updated with a matrix
+ * multiplication, which is split among the available threads. If an
+ * external LAPACK is enabled, supported matrices are factorized by it
+ * instead.
+ *
+ * @param a A matrix of size m x n. It is overwritten with l (without its unit
+ *          diagonal) below the diagonal and u on and above the diagonal.
+ * @param ipiv Pointer to an array of size min(m, n) where to store the row
+ *             interchanges. Row i was interchanged with row ipiv[i].
+ */
+template <class T> void lu_factor(const strided_matrix<T> &a, size_t *ipiv) {
+  if (external_lu_factor(a, ipiv)) {
+    return;
+  }
+  size_t m = a.rows, n = a.cols, k = std::min(m, n);
+  for (size_t j = 0; j < k; j += factorization_block_size) {
+    size_t jb = std::min(factorization_block_size, k - j);
+    lu_panel(a.block(j, j, m - j, jb), ipiv + j);
+    for (size_t i = j; i < j + jb; ++i) {
+      ipiv[i] += j;
+    }
+    apply_row_swaps(a.block(0, 0, m, j), ipiv, j, j + jb);
+    if (j + jb < n) {
+      strided_matrix<T> right = a.block(0, j + jb, m, n - j - jb);
+      apply_row_swaps(right, ipiv, j, j + jb);
+      trsm<T>(a.block(j, j, jb, jb), true, true,
+              right.block(j, 0, jb, right.cols));
+      gemm<T>(T(-1), a.block(j + jb, j, m - j - jb, jb),
+              right.block(j, 0, jb, right.cols), T(1),
+              right.block(j + jb, 0, m - j - jb, right.cols));
+    }
+  }
+}
+
+/**
+ * @brief Convert a sequence of row interchanges into a permutation. Row i of
+ * the permuted matrix is row perm[i] of the original matrix.
+ */
+inline void row_swaps_to_permutation(const size_t *ipiv, size_t k,
+                                     size_t *perm, size_t m) {
+  for (size_t i = 0; i < m; ++i) {
+    perm[i] = i;
+  }
+  for (size_t i = 0; i < k; ++i) {
+    std::swap(perm[i], perm[ipiv[i]]);
+  }
+}
+
+/**
+ * @brief Update the lower triangle of c = c - a * b, where c is square. The
+ * columns of c are updated by blocks, so that only the blocks intersecting
+ * the lower triangle are computed.
+ */
+template <class T>
+void update_lower(const strided_matrix<const T> &a,
+                  const strided_matrix<const T> &b,
+                  const strided_matrix<T> &c) {
+  size_t n = c.rows;
+  for (size_t j = 0; j < n; j += factorization_block_size) {
+    size_t jb = std::min(factorization_block_size, n - j);
+    gemm<T>(T(-1), a.block(j, 0, n - j, a.cols), b.block(0, j, b.rows, jb),
+            T(1), c.block(j, j, n - j, jb));
+  }
+}
+
+/**
+ * @brief Cholesky factorization of a small Hermitian positive-definite
+ * matrix by columns. Only the lower triangle is read and written.
+ */
+template <class T> void cholesky_unblocked(const strided_matrix<T> &a) {
+  typedef decltype(std::real(T())) real_type;
+  for (size_t j = 0; j < a.rows; ++j) {
+    real_type d = std::real(a(j, j));
+    for (size_t p = 0; p < j; ++p) {
+      d -= std::norm(a(j, p));
+    }
+    if (!(d > real_type(0))) {
+      throw std::invalid_argument("matrix is not positive definite");
+    }
+    d = std::sqrt(d);
+    a(j, j) = d;
+    for (size_t i = j + 1; i < a.rows; ++i) {
+      T val = a(i, j);
+      for (size_t p = 0; p < j; ++p) {
+        val -= a(i, p) * conj_value(a(j, p));
+      }
+      a(i, j) = val / d;
+    }
+  }
+}
+
+/**
+ * @brief Blocked Cholesky factorization, a = l * l^H.
+ *
+ * @details At each step, the diagonal block is factorized, the panel below
+ * it is solved against the factor, and the lower triangle of the trailing
+ * matrix is updated with matrix multiplications, which are split among the
+ * available threads. If an external LAPACK is enabled, supported matrices
+ * are factorized by it instead.
+ *
+ * @param a A Hermitian positive-definite matrix. Only its lower triangle is
+ *          read. It is overwritten with l, and its upper triangle is set to
+ *          zero.
+ *
+ * @throw std::invalid_argument Thrown if the matrix is not positive definite.
+ */
+template <class T> void cholesky_factor(const strided_matrix<T> &a) {
+  size_t n = a.rows;
+  if (!external_cholesky_factor(a)) {
+    std::vector<T> buffer;
+    for (size_t j = 0; j < n; j += factorization_block_size) {
+      size_t jb = std::min(factorization_block_size, n - j), m = n - j - jb;
+      cholesky_unblocked(a.block(j, j, jb, jb));
+      if (m == 0) {
+        break;
+      }
+      // w = l11^-1 * a21^H holds l21^H, the right operand of the update.
+      strided_matrix<T> panel = a.block(j + jb, j, m, jb);
+      buffer.resize(jb * m);
+      strided_matrix<T> w(buffer.data(), jb, m, m, 1);
+      for (size_t i = 0; i < m; ++i) {
+        for (size_t p = 0; p < jb; ++p) {
+          w(p, i) = conj_value(panel(i, p));
+        }
+      }
+      trsm<T>(a.block(j, j, jb, jb), true, false, w);
+      for (size_t i = 0; i < m; ++i) {
+        for (size_t p = 0; p < jb; ++p) {
+          panel(i, p) = conj_value(w(p, i));
+        }
+      }
+      update_lower<T>(panel, w, a.block(j + jb, j + jb, m, m));
+    }
+  }
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = i + 1; j < n; ++j) {
+      a(i, j) = T(0);
+    }
+  }
+}
+
+/**
+ * @brief LDL factorization of a small Hermitian matrix by columns, without
+ * pivoting. Only the lower triangle is read and written. Columns with a zero
+ * pivot are set to zero.
+ */
+template <class T> void ldl_unblocked(const strided_matrix<T> &a, T *d) {
+  for (size_t j = 0; j < a.rows; ++j) {
+    T val = std::real(a(j, j));
+    for (size_t p = 0; p < j; ++p) {
+      val -= d[p] * std::norm(a(j, p));
+    }
+    d[j] = val;
+    for (size_t i = j + 1; i < a.rows; ++i) {
+      val = a(i, j);
+      for (size_t p = 0; p < j; ++p) {
+        val -= a(i, p) * d[p] * conj_value(a(j, p));
+      }
+      a(i, j) = (d[j] == T(0)) ? T(0) : val / d[j];
+    }
+  }
+}
+
+/**
+ * @brief Blocked LDL factorization without pivoting, a = l * d * l^H.
+ *
+ * @details The blocking is the same as in the Cholesky factorization. The
+ * panel below each diagonal block is first solved against the unit lower
+ * triangular factor and then scaled by the inverse of d.
+ *
+ * @param a A Hermitian matrix. Only its lower triangle is read. It is
+ *          overwritten with l, including its unit diagonal, and its upper
+ *          triangle is set to zero.
+ * @param d Pointer to an array where to store the diagonal of d.
+ */
+template <class T> void ldl_factor(const strided_matrix<T> &a, T *d) {
+  size_t n = a.rows;
+  std::vector<T> buffer;
+  for (size_t j = 0; j < n; j += factorization_block_size) {
+    size_t jb = std::min(factorization_block_size, n - j), m = n - j - jb;
+    ldl_unblocked(a.block(j, j, jb, jb), d + j);
+    if (m == 0) {
+      break;
+    }
+    // w = l11^-1 * a21^H holds d1 * l21^H, the right operand of the update.
+    strided_matrix<T> panel = a.block(j + jb, j, m, jb);
+    buffer.resize(jb * m);
+    strided_matrix<T> w(buffer.data(), jb, m, m, 1);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t p = 0; p < jb; ++p) {
+        w(p, i) = conj_value(panel(i, p));
+      }
+    }
+    trsm<T>(a.block(j, j, jb, jb), true, true, w);
+    for (size_t p = 0; p < jb; ++p) {
+      T dp = d[j + p];
+      for (size_t i = 0; i < m; ++i) {
+        if (dp == T(0)) {
+          w(p, i) = T(0);
+        }
+        panel(i, p) = (dp == T(0)) ? T(0) : conj_value(w(p, i)) / dp;
+      }
+    }
+    update_lower<T>(panel, w, a.block(j + jb, j + jb, m, m));
+  }
+  for (size_t i = 0; i < n; ++i) {
+    a(i, i) = T(1);
+    for (size_t j = i + 1; j < n; ++j) {
+      a(i, j) = T(0);
+    }
+  }
+}
+
+/**
+ * @brief Determinant of an integer matrix by fraction-free Gaussian
+ * elimination (Bareiss algorithm). Every intermediate value is a minor of
+ * the matrix, so the result is exact as long as the minors fit in T.
+ *
+ * @param a A square matrix. It is overwritten.
+ */
+template <class T> T bareiss_det(const strided_matrix<T> &a) {
+  size_t n = a.rows;
+  T sign = T(1), prev = T(1);
+  for (size_t k = 0; k < n; ++k) {
+    if (a(k, k) == T(0)) {
+      size_t pivot = k + 1;
+      while (pivot < n && a(pivot, k) == T(0)) {
+        ++pivot;
+      }
+      if (pivot == n) {
+        return T(0);
+      }
+      for (size_t j = k; j < n; ++j) {
+        std::swap(a(k, j), a(pivot, j));
+      }
+      sign = -sign;
+    }
+    for (size_t i = k + 1; i < n; ++i) {
+      for (size_t j = k + 1; j < n; ++j) {
+        a(i, j) = (a(i, j) * a(k, k) - a(i, k) * a(k, j)) / prev;
+      }
+    }
+    prev = a(k, k);
+  }
+  return (n > 0) ? sign * a(n - 1, n - 1) : T(1);
+}
+
+/**
+ * @brief Determinant of a square matrix. The matrix is overwritten.
+ */
+template <class T>
+T determinant(const strided_matrix<T> &a, std::true_type /* integral */) {
+  return bareiss_det(a);
+}
+
+template <class T>
+T determinant(const strided_matrix<T> &a, std::false_type /* integral */) {
+  std::vector<size_t> ipiv(a.rows);
+  lu_factor(a, ipiv.data());
+  T val = T(1);
+  for (size_t i = 0; i < a.rows; ++i) {
+    val *= a(i, i);
+    if (ipiv[i] != i) {
+      val = -val;
+    }
+  }
+  return val;
+}
+/**
+ * @brief Set each element of a matrix to its complex conjugate. Real matrices
+ * are left unchanged.
+ */
+template <class T> inline void conj_inplace(const strided_matrix<T> &) {}
+
+template <class T>
+void conj_inplace(const strided_matrix<std::complex<T>> &a) {
+  for (size_t i = 0; i < a.rows; ++i) {
+    for (size_t j = 0; j < a.cols; ++j) {
+      a(i, j) = std::conj(a(i, j));
+    }
+  }
+}
+
+/**
+ * @brief Solve a system with multiple right-hand sides from the LU
+ * factorization of a square matrix, a = p * l * u.
+ *
+ * @param lu The packed factors returned by lu_factor.
+ * @param ipiv The row interchanges returned by lu_factor.
+ * @param conj_transpose If true, solve a^H * x = b instead of a * x = b.
+ * @param b The right-hand sides. It is overwritten with the solution.
+ */
+template <class T>
+void lu_solve(const strided_matrix<const T> &lu, const size_t *ipiv,
+              bool conj_transpose, const strided_matrix<T> &b) {
+  size_t n = lu.rows;
+  if (!conj_transpose) {
+    apply_row_swaps(b, ipiv, 0, n);
+    trsm(lu, true, true, b);
+    trsm(lu, false, false, b);
+  } else {
+    // a^H * x = b is equivalent to u^T * l^T * p^T * conj(x) = conj(b).
+    conj_inplace(b);
+    trsm(lu.t(), true, false, b);
+    trsm(lu.t(), false, true, b);
+    for (size_t i = n; i > 0; --i) {
+      if (ipiv[i - 1] != i - 1) {
+        for (size_t j = 0; j < b.cols; ++j) {
+          std::swap(b(i - 1, j), b(ipiv[i - 1], j));
+        }
+      }
+    }
+    conj_inplace(b);
+  }
+}
+
+/**
+ * @brief Solve a system with multiple right-hand sides from the Cholesky
+ * factorization of a Hermitian positive-definite matrix, a = l * l^H.
+ *
+ * @param l The lower triangular factor returned by cholesky_factor.
+ * @param b The right-hand sides. It is overwritten with the solution.
+ */
+template <class T>
+void cholesky_solve(const strided_matrix<const T> &l,
+                    const strided_matrix<T> &b) {
+  // l^H * x = y is equivalent to l^T * conj(x) = conj(y).
+  trsm(l, true, false, b);
+  conj_inplace(b);
+  trsm(l.t(), false, false, b);
+  conj_inplace(b);
+}
+
+/**
+ * @brief Number of columns of the panels of the blocked QR factorization.
+ */
+const size_t qr_block_size = 64;
+
+/**
+ * @brief Panels with at most this many columns are factorized one column at
+ * a time.
+ */
+const size_t qr_leaf_size = 8;
+
+/**
+ * @brief Generate an elementary reflector h = I - tau * v * v^H such that
+ * h^H * x = beta * e_1, where beta is real and v(0) = 1.
+ *
+ * @param x A column vector. It is overwritten with beta in its first element
+ *          and with v, without its first element, below it.
+ *
+ * @return The scalar tau. If it is zero, h is the identity.
+ */
+template <class T> T householder(const strided_matrix<T> &x) {
+  typedef typename complex_traits<T>::value_type real_type;
+  T alpha = x(0, 0);
+  real_type scale = 0, xnorm = 0;
+  for (size_t i = 1; i < x.rows; ++i) {
+    scale = std::max(scale, real_type(std::abs(x(i, 0))));
+  }
+  if (scale > real_type(0)) {
+    for (size_t i = 1; i < x.rows; ++i) {
+      xnorm += std::norm(x(i, 0) / scale);
+    }
+    xnorm = scale * std::sqrt(xnorm);
+  } else if (std::imag(alpha) == real_type(0)) {
+    return T(0);
+  }
+  real_type beta =
+      -std::copysign(std::hypot(std::abs(alpha), xnorm), std::real(alpha));
+  T factor = T(1) / (alpha - beta);
+  for (size_t i = 1; i < x.rows; ++i) {
+    x(i, 0) *= factor;
+  }
+  x(0, 0) = beta;
+  return (beta - alpha) / beta;
+}
+
+/**
+ * @brief Multiply a matrix from the left by the elementary reflector
+ * h = I - tau * v * v^H, where v is stored below the first element of the
+ * column vector @a v and v(0) = 1 is implicit.
+ */
+template <class T>
+void apply_householder(const strided_matrix<const T> &v, T tau,
+                       const strided_matrix<T> &c, std::vector<T> &w) {
+  if (tau == T(0)) {
+    return;
+  }
+  w.assign(c.cols, T(0));
+  for (size_t p = 0; p < c.cols; ++p) {
+    w[p] = c(0, p);
+  }
+  for (size_t i = 1; i < c.rows; ++i) {
+    T val = conj_value(v(i, 0));
+    for (size_t p = 0; p < c.cols; ++p) {
+      w[p] += val * c(i, p);
+    }
+  }
+  for (size_t p = 0; p < c.cols; ++p) {
+    c(0, p) -= tau * w[p];
+  }
+  for (size_t i = 1; i < c.rows; ++i) {
+    T val = tau * v(i, 0);
+    for (size_t p = 0; p < c.cols; ++p) {
+      c(i, p) -= val * w[p];
+    }
+  }
+}
+
+/**
+ * @brief QR factorization of a panel by Householder reflections, a = q * r,
+ * where q = h(0) * h(1) * ... * h(k - 1).
+ */
+template <class T> void qr_unblocked(const strided_matrix<T> &a, T *tau) {
+  size_t m = a.rows, n = a.cols, k = std::min(m, n);
+  std::vector<T> w;
+  for (size_t j = 0; j < k; ++j) {
+    tau[j] = householder(a.block(j, j, m - j, 1));
+    apply_householder<T>(a.block(j, j, m - j, 1), conj_value(tau[j]),
+                         a.block(j, j + 1, m - j, n - j - 1), w);
+  }
+}
+
+/**
+ * @brief Multiply a matrix from the left by an upper triangular matrix or, if
+ * @a conj_transpose is true, by its conjugate transpose, in-place.
+ */
+template <class T>
+void triangular_multiply(const strided_matrix<const T> &t, bool conj_transpose,
+                         const strided_matrix<T> &w) {
+  size_t b = t.rows, n = w.cols;
+  if (!conj_transpose) {
+    for (size_t p = 0; p < b; ++p) {
+      for (size_t j = 0; j < n; ++j) {
+        w(p, j) *= t(p, p);
+      }
+      for (size_t q = p + 1; q < b; ++q) {
+        T val = t(p, q);
+        for (size_t j = 0; j < n; ++j) {
+          w(p, j) += val * w(q, j);
+        }
+      }
+    }
+  } else {
+    for (size_t p = b; p > 0; --p) {
+      for (size_t j = 0; j < n; ++j) {
+        w(p - 1, j) *= conj_value(t(p - 1, p - 1));
+      }
+      for (size_t q = 0; q < p - 1; ++q) {
+        T val = conj_value(t(q, p - 1));
+        for (size_t j = 0; j < n; ++j) {
+          w(p - 1, j) += val * w(q, j);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief A block of Householder reflectors h(0) * h(1) * ... * h(b - 1),
+ * represented as I - v * t * v^H, where v has unit lower trapezoidal shape
+ * and t is upper triangular (compact WY representation).
+ */
+template <class T> struct block_reflector {
+  size_t rows, cols;
+  std::vector<T> v, vh, t;
+
+  /// Load the reflectors stored below the diagonal of a factorized panel.
+  void load(const strided_matrix<const T> &a) {
+    rows = a.rows;
+    cols = a.cols;
+    v.assign(rows * cols, T(0));
+    vh.resize(cols * rows);
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < std::min(i + 1, cols); ++j) {
+        v[i * cols + j] = (i == j) ? T(1) : a(i, j);
+      }
+    }
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        vh[j * rows + i] = conj_value(v[i * cols + j]);
+      }
+    }
+  }
+
+  /// Load the triangular factor from the upper triangle of a matrix.
+  void load_t(const strided_matrix<const T> &t_in) {
+    t.assign(cols * cols, T(0));
+    for (size_t i = 0; i < cols; ++i) {
+      for (size_t j = i; j < cols; ++j) {
+        t[i * cols + j] = t_in(i, j);
+      }
+    }
+  }
+
+  /// Compute the triangular factor from the scalar factors of the
+  /// reflectors and store it in the upper triangle of a matrix.
+  void compute_t(const T *tau, const strided_matrix<T> &t_out) {
+    // t(0:i, i) = -tau(i) * t(0:i, 0:i) * v(:, 0:i)^H * v(:, i).
+    std::vector<T> s(cols * cols);
+    gemm<T>(T(1), strided_matrix<const T>(vh.data(), cols, rows, rows, 1),
+            strided_matrix<const T>(v.data(), rows, cols, cols, 1), T(0),
+            strided_matrix<T>(s.data(), cols, cols, cols, 1));
+    t.assign(cols * cols, T(0));
+    for (size_t i = 0; i < cols; ++i) {
+      t[i * cols + i] = tau[i];
+      for (size_t p = 0; p < i; ++p) {
+        T val = T(0);
+        for (size_t q = p; q < i; ++q) {
+          val += t[p * cols + q] * s[q * cols + i];
+        }
+        t[p * cols + i] = -tau[i] * val;
+      }
+    }
+    for (size_t i = 0; i < cols; ++i) {
+      for (size_t j = i; j < cols; ++j) {
+        t_out(i, j) = t[i * cols + j];
+      }
+    }
+  }
+
+  /// Multiply a matrix from the left by the block of reflectors or, if
+  /// @a conj_transpose is true, by its conjugate transpose.
+  void apply(bool conj_transpose, const strided_matrix<T> &c,
+             std::vector<T> &w) const {
+    size_t b = cols, n = c.cols;
+    w.resize(b * n);
+    strided_matrix<T> wmat(w.data(), b, n, n, 1);
+    gemm<T>(T(1), strided_matrix<const T>(vh.data(), b, rows, rows, 1), c,
+            T(0), wmat);
+    triangular_multiply<T>(strided_matrix<const T>(t.data(), b, b, b, 1),
+                           conj_transpose, wmat);
+    gemm<T>(T(-1), strided_matrix<const T>(v.data(), rows, b, b, 1), wmat,
+            T(1), c);
+  }
+};
+
+/**
+ * @brief Multiply a matrix with few columns from the left by a block of
+ * reflectors, I - v * t * v^H, or by its conjugate transpose. Unlike
+ * block_reflector, the reflectors are read in-place, one row at a time.
+ */
+template <class T>
+void apply_block_reflector(const strided_matrix<const T> &v,
+                           const strided_matrix<const T> &t,
+                           bool conj_transpose, const strided_matrix<T> &c,
+                           std::vector<T> &w) {
+  size_t b = v.cols, n = c.cols;
+  w.assign(b * n, T(0));
+  strided_matrix<T> wmat(w.data(), b, n, n, 1);
+  for (size_t i = 0; i < v.rows; ++i) {
+    size_t last = std::min(i, b);
+    for (size_t j = 0; j < n; ++j) {
+      T val = c(i, j);
+      for (size_t p = 0; p < last; ++p) {
+        wmat(p, j) += conj_value(v(i, p)) * val;
+      }
+      if (i < b) {
+        wmat(i, j) += val;
+      }
+    }
+  }
+  triangular_multiply(t, conj_transpose, wmat);
+  for (size_t i = 0; i < v.rows; ++i) {
+    size_t last = std::min(i, b);
+    for (size_t j = 0; j < n; ++j) {
+      T val = (i < b) ? wmat(i, j) : T(0);
+      for (size_t p = 0; p < last; ++p) {
+        val += v(i, p) * wmat(p, j);
+      }
+      c(i, j) -= val;
+    }
+  }
+}
+
+/**
+ * @brief Recursive QR factorization of a panel. The left half of the panel is
+ * factorized recursively and its reflectors are applied to the right half as
+ * a block reflector, before factorizing the right half. Thus, most of the
+ * work in tall panels is done by matrix multiplications instead of passes
+ * over one column at a time.
+ */
+template <class T> void qr_recursive(const strided_matrix<T> &a, T *tau) {
+  size_t m = a.rows, n = a.cols, n1 = n / 2;
+  if (n <= qr_leaf_size || n1 >= m) {
+    // Factorize a copy with contiguous columns, so that each column of a
+    // row-major panel is not fetched from memory once per reflector.
+    std::vector<T> buffer(m * n);
+    strided_matrix<T> b(buffer.data(), m, n, 1, m);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        b(i, j) = a(i, j);
+      }
+    }
+    qr_unblocked(b, tau);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        a(i, j) = b(i, j);
+      }
+    }
+    return;
+  }
+  qr_recursive(a.block(0, 0, m, n1), tau);
+  block_reflector<T> reflector;
+  std::vector<T> t(n1 * n1), w;
+  reflector.load(a.block(0, 0, m, n1));
+  reflector.compute_t(tau, strided_matrix<T>(t.data(), n1, n1, n1, 1));
+  reflector.apply(true, a.block(0, n1, m, n - n1), w);
+  qr_recursive(a.block(n1, n1, m - n1, n - n1), tau + n1);
+}
+
+/**
+ * @brief Blocked QR factorization by Householder reflections, a = q * r.
+ *
+ * @details At each step, a panel of qr_block_size columns is factorized and
+ * its reflectors are accumulated into a block reflector, which is applied to
+ * the trailing matrix with matrix multiplications. These are split among the
+ * available threads.
+ *
+ * @param a A matrix of size m x n. It is overwritten with r on and above the
+ *          diagonal and with the Householder vectors below the diagonal.
+ * @param tau Pointer to an array of size min(m, n) where to store the scalar
+ *            factors of the reflectors.
+ * @param t A matrix of size min(qr_block_size, k) x k, where k = min(m, n),
+ *          where to store the triangular factors of the block reflectors.
+ *          The factor of the block starting at column j is stored at
+ *          columns j to j + qr_block_size.
+ */
+template <class T>
+void qr_factor(const strided_matrix<T> &a, T *tau,
+               const strided_matrix<T> &t) {
+  size_t m = a.rows, n = a.cols, k = std::min(m, n);
+  block_reflector<T> reflector;
+  std::vector<T> w;
+  for (size_t j = 0; j < k; j += qr_block_size) {
+    size_t jb = std::min(qr_block_size, k - j);
+    qr_recursive(a.block(j, j, m - j, jb), tau + j);
+    reflector.load(a.block(j, j, m - j, jb));
+    reflector.compute_t(tau + j, t.block(0, j, jb, jb));
+    if (j + jb < n) {
+      reflector.apply(true, a.block(j, j + jb, m - j, n - j - jb), w);
+    }
+  }
+}
+
+/**
+ * @brief Multiply a matrix from the left by the orthogonal factor of a QR
+ * factorization or, if @a conj_transpose is true, by its conjugate
+ * transpose. The reflectors are applied by blocks, with matrix
+ * multiplications unless @a c has few columns.
+ *
+ * @param a, t The factorization returned by qr_factor.
+ * @param c A matrix with as many rows as @a a. It is overwritten with the
+ *          product.
+ */
+template <class T>
+void qr_multiply(const strided_matrix<const T> &a,
+                 const strided_matrix<const T> &t, bool conj_transpose,
+                 const strided_matrix<T> &c) {
+  size_t m = a.rows, k = std::min(a.rows, a.cols);
+  size_t blocks = (k + qr_block_size - 1) / qr_block_size;
+  block_reflector<T> reflector;
+  std::vector<T> w;
+  for (size_t i = 0; i < blocks; ++i) {
+    size_t j = (conj_transpose ? i : blocks - 1 - i) * qr_block_size;
+    size_t jb = std::min(qr_block_size, k - j);
+    if (c.cols < gemm_nr) {
+      apply_block_reflector(a.block(j, j, m - j, jb), t.block(0, j, jb, jb),
+                            conj_transpose, c.block(j, 0, m - j, c.cols), w);
+    } else {
+      reflector.load(a.block(j, j, m - j, jb));
+      reflector.load_t(t.block(0, j, jb, jb));
+      reflector.apply(conj_transpose, c.block(j, 0, m - j, c.cols), w);
+    }
+  }
+}
+
+/**
+ * @brief Multiply a matrix from the left by a product of Householder
+ * reflectors stored as in a QR factorization, h(0) * h(1) * ... * h(k - 1),
+ * or by its conjugate transpose. Unlike qr_multiply, the triangular factors
+ * of the blocks are computed from the scalar factors of the reflectors.
+ *
+ * @param a A matrix with the reflectors below its diagonal.
+ * @param tau Pointer to the scalar factors of the reflectors.
+ * @param c A matrix with as many rows as @a a. It is overwritten with the
+ *          product.
+ */
+template <class T>
+void householder_multiply(const strided_matrix<const T> &a, const T *tau,
+                          bool conj_transpose, const strided_matrix<T> &c) {
+  size_t k = std::min(a.rows, a.cols);
+  if (k == 0) {
+    return;
+  }
+  size_t rows = std::min(qr_block_size, k);
+  std::vector<T> t(rows * k);
+  strided_matrix<T> tmat(t.data(), rows, k, k, 1);
+  block_reflector<T> reflector;
+  for (size_t j = 0; j < k; j += qr_block_size) {
+    size_t jb = std::min(qr_block_size, k - j);
+    reflector.load(a.block(j, j, a.rows - j, jb));
+    reflector.compute_t(tau + j, tmat.block(0, j, jb, jb));
+  }
+  qr_multiply<T>(a, tmat, conj_transpose, c);
+}
+
+/**
+ * @brief Return the 1-norm of a matrix, i.e., its maximum absolute column
+ * sum. If @a hermitian is true, only the lower triangle is read and the upper
+ * triangle is taken as its conjugate transpose.
+ */
+template <class T>
+typename complex_traits<T>::value_type
+norm1(const strided_matrix<const T> &a, bool hermitian) {
+  typedef typename complex_traits<T>::value_type real_type;
+  std::vector<real_type> sums(a.cols, real_type(0));
+  for (size_t i = 0; i < a.rows; ++i) {
+    for (size_t j = 0; j < (hermitian ? i + 1 : a.cols); ++j) {
+      real_type val = std::abs(a(i, j));
+      sums[j] += val;
+      if (hermitian && j < i) {
+        sums[i] += val;
+      }
+    }
+  }
+  real_type val = 0;
+  for (size_t j = 0; j < a.cols; ++j) {
+    val = std::max(val, sums[j]);
+  }
+  return val;
+}
+
+/**
+ * @brief Estimate the 1-norm of the inverse of a square matrix without
+ * computing it.
+ *
+ * @details Hager's method, as refined by Higham (LAPACK's xLACON). Each
+ * iteration solves one system with the matrix and one with its conjugate
+ * transpose, and at most 5 iterations are done. The estimate is a lower
+ * bound that is almost always within a factor of 3 of the true norm.
+ *
+ * @param n Size of the matrix.
+ * @param solve Function overwriting a vector of size n with the solution of
+ *              a * x = b.
+ * @param solve_h Function overwriting a vector of size n with the solution
+ *                of a^H * x = b.
+ */
+template <class T, class Solve, class SolveH>
+typename complex_traits<T>::value_type
+inverse_norm1_estimate(size_t n, Solve &&solve, SolveH &&solve_h) {
+  typedef typename complex_traits<T>::value_type real_type;
+  const size_t max_iter = 5;
+  if (n == 0) {
+    return real_type(0);
+  }
+  std::vector<T> x(n, T(real_type(1) / real_type(n))), z(n);
+  real_type est = 0;
+  size_t last = 0;
+  for (size_t iter = 0; iter < max_iter; ++iter) {
+    solve(x.data());
+    real_type val = 0;
+    for (size_t i = 0; i < n; ++i) {
+      val += std::abs(x[i]);
+    }
+    if (iter > 0 && val <= est) {
+      break;
+    }
+    est = val;
+    for (size_t i = 0; i < n; ++i) {
+      real_type abs = std::abs(x[i]);
+      z[i] = (abs == real_type(0)) ? T(1) : x[i] / abs;
+    }
+    solve_h(z.data());
+    size_t j = 0;
+    for (size_t i = 1; i < n; ++i) {
+      if (std::abs(z[j]) < std::abs(z[i])) {
+        j = i;
+      }
+    }
+    if (iter > 0 && std::abs(z[j]) <= std::abs(z[last])) {
+      break;
+    }
+    last = j;
+    std::fill(x.begin(), x.end(), T(0));
+    x[j] = T(1);
+  }
+  // Alternative estimate for matrices where the iteration performs poorly.
+  for (size_t i = 0; i < n; ++i) {
+    real_type val =
+        real_type(1) + real_type(i) / real_type(std::max<size_t>(n - 1, 1));
+    x[i] = T((i % 2 == 0) ? val : -val);
+  }
+  solve(x.data());
+  real_type alt = 0;
+  for (size_t i = 0; i < n; ++i) {
+    alt += std::abs(x[i]);
+  }
+  return std::max(est, 2 * alt / (3 * real_type(n)));
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_FACTORIZATION_H_INCLUDED
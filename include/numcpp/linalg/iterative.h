@@ -0,0 +1,323 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/iterative.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_ITERATIVE_H_INCLUDED
+#define NUMCPP_ITERATIVE_H_INCLUDED
+
+#include <type_traits>
+#include <vector>
+#include "numcpp/linalg/blas.h"
+
+namespace numcpp {
+namespace linalg {
+/**
+ * @brief A csr_matrix object holds a sparse matrix in compressed sparse row
+ * format. The column indices of the nonzero elements of row i are stored, in
+ * increasing order, in @a indices[indptr[i]:indptr[i+1]], and their values
+ * in the same positions of @a data.
+ *
+ * @tparam T Type of the elements.
+ */
+template <class T> class csr_matrix {
+public:
+  /// Member types.
+  typedef T value_type;
+  typedef size_t size_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Default constructor. Constructs an empty matrix with no rows and
+   * no columns.
+   */
+  csr_matrix();
+
+  /**
+   * @brief Constructs a sparse matrix with the nonzero elements of a dense
+   * matrix.
+   *
+   * @param a A dense matrix.
+   *
+   * @throw std::bad_alloc If the function fails to allocate storage it may
+   *                       throw an exception.
+   */
+  template <class Container>
+  explicit csr_matrix(const expression<Container, T, 2> &a);
+
+  /**
+   * @brief Constructs a sparse matrix from its compressed sparse row
+   * representation. The column indices of each row may be given in any
+   * order; they are sorted and duplicated entries are summed.
+   *
+   * @param shape Number of rows and columns of the matrix.
+   * @param indptr Row pointers, of size rows + 1.
+   * @param indices Column indices of the stored elements.
+   * @param data Values of the stored elements.
+   *
+   * @throw std::invalid_argument Thrown if the row pointers are not
+   *                              non-decreasing or don't match the number of
+   *                              stored elements, or if a column index is out
+   *                              of bounds.
+   * @throw std::bad_alloc If the function fails to allocate storage it may
+   *                       throw an exception.
+   */
+  template <class Container1, class Container2, class Container3>
+  csr_matrix(const shape_t<2> &shape,
+             const expression<Container1, size_t, 1> &indptr,
+             const expression<Container2, size_t, 1> &indices,
+             const expression<Container3, T, 1> &data);
+
+  /// Public methods.
+
+  /**
+   * @brief Return the number of rows and columns of the matrix.
+   */
+  const shape_t<2> &shape() const;
+
+  /**
+   * @brief Return the size of the matrix along the given axis.
+   */
+  size_t shape(size_t axis) const;
+
+  /**
+   * @brief Return the number of stored elements.
+   */
+  size_t nnz() const;
+
+  /**
+   * @brief Return the row pointers.
+   */
+  const tensor<size_t, 1> &indptr() const;
+
+  /**
+   * @brief Return the column indices of the stored elements.
+   */
+  const tensor<size_t, 1> &indices() const;
+
+  /**
+   * @brief Return the values of the stored elements.
+   */
+  const tensor<T, 1> &data() const;
+
+  /**
+   * @brief Return the main diagonal of the matrix.
+   */
+  tensor<T, 1> diagonal() const;
+
+  /**
+   * @brief Return the matrix-vector product of the matrix and a vector.
+   *
+   * @throw std::invalid_argument Thrown if the size of @a x doesn't match the
+   *                              number of columns of the matrix.
+   */
+  template <class Container>
+  tensor<T, 1> dot(const expression<Container, T, 1> &x) const;
+
+  /**
+   * @brief Return a dense copy of the matrix.
+   */
+  tensor<T, 2> todense() const;
+
+private:
+  // Number of rows and columns.
+  shape_t<2> m_shape;
+
+  // Compressed sparse row representation.
+  tensor<size_t, 1> m_indptr;
+  tensor<size_t, 1> m_indices;
+  tensor<T, 1> m_data;
+};
+
+/**
+ * @brief A jacobi_preconditioner object approximates the inverse of a matrix
+ * by the inverse of its diagonal. It is cheap to apply and is computed in
+ * parallel.
+ *
+ * @tparam T Type of the elements. It must be a floating-point or a complex
+ *           type.
+ */
+template <class T> class jacobi_preconditioner {
+public:
+  /// Member types.
+  typedef T value_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Constructs the preconditioner of a matrix.
+   *
+   * @param a A square matrix, either sparse or dense.
+   *
+   * @throw std::invalid_argument Thrown if @a a is not square or has a zero
+   *                              on its diagonal.
+   */
+  explicit jacobi_preconditioner(const csr_matrix<T> &a);
+
+  template <class Container>
+  explicit jacobi_preconditioner(const expression<Container, T, 2> &a);
+
+  /// Public methods.
+
+  /**
+   * @brief Apply the preconditioner, @f$z = M^{-1}r@f$.
+   */
+  void operator()(const tensor<T, 1> &r, tensor<T, 1> &z) const;
+
+private:
+  // Inverse of the diagonal.
+  tensor<T, 1> m_inv_diag;
+};
+
+/**
+ * @brief An ilu0_preconditioner object holds the incomplete LU factorization
+ * of a sparse matrix with no fill-in, @f$A \approx LU@f$, where @f$L@f$ and
+ * @f$U@f$ have the same sparsity pattern as the lower and upper parts of the
+ * matrix. Applying the preconditioner solves two sparse triangular systems,
+ * which is inherently sequential.
+ *
+ * @tparam T Type of the elements. It must be a floating-point or a complex
+ *           type.
+ */
+template <class T> class ilu0_preconditioner {
+public:
+  /// Member types.
+  typedef T value_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Computes the incomplete factorization of a sparse matrix.
+   *
+   * @param a A square sparse matrix. Every element of its diagonal must be
+   *          stored.
+   *
+   * @throw std::invalid_argument Thrown if @a a is not square or if a zero
+   *                              pivot is found.
+   */
+  explicit ilu0_preconditioner(const csr_matrix<T> &a);
+
+  /// Public methods.
+
+  /**
+   * @brief Apply the preconditioner, @f$z = (LU)^{-1}r@f$.
+   */
+  void operator()(const tensor<T, 1> &r, tensor<T, 1> &z) const;
+
+private:
+  // Sparsity pattern of the matrix.
+  tensor<size_t, 1> m_indptr;
+  tensor<size_t, 1> m_indices;
+
+  // Packed factors, stored in the positions of the sparsity pattern. The
+  // unit diagonal of L is not stored.
+  tensor<T, 1> m_lu;
+
+  // Position of the diagonal elements.
+  std::vector<size_t> m_diag;
+};
+
+/**
+ * @brief A ssor_preconditioner object holds the symmetric successive
+ * over-relaxation preconditioner of a sparse matrix,
+ * @f$M = \frac{\omega}{2 - \omega} (D/\omega + L) (D/\omega)^{-1}
+ * (D/\omega + U)@f$, where @f$D@f$, @f$L@f$ and @f$U@f$ are the diagonal,
+ * strictly lower and strictly upper parts of the matrix. If the matrix is
+ * Hermitian positive-definite, so is the preconditioner.
+ *
+ * @tparam T Type of the elements. It must be a floating-point or a complex
+ *           type.
+ */
+template <class T> class ssor_preconditioner {
+public:
+  /// Member types.
+  typedef T value_type;
+  typedef typename detail::complex_traits<T>::value_type real_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Constructs the preconditioner of a sparse matrix.
+   *
+   * @param a A square sparse matrix.
+   * @param omega Relaxation parameter, between 0 and 2 (exclusive). Defaults
+   *              to 1, the symmetric Gauss-Seidel preconditioner.
+   *
+   * @throw std::invalid_argument Thrown if @a a is not square, has a zero on
+   *                              its diagonal, or if @a omega is out of
+   *                              range.
+   */
+  explicit ssor_preconditioner(const csr_matrix<T> &a, double omega = 1.0);
+
+  /// Public methods.
+
+  /**
+   * @brief Apply the preconditioner, @f$z = M^{-1}r@f$.
+   */
+  void operator()(const tensor<T, 1> &r, tensor<T, 1> &z) const;
+
+private:
+  // The matrix.
+  csr_matrix<T> m_a;
+
+  // Position of the diagonal elements.
+  std::vector<size_t> m_diag;
+
+  // Relaxation parameter.
+  real_type m_omega;
+};
+
+/**
+ * @brief A convergence_info object reports the outcome of an iterative
+ * solver.
+ *
+ * @tparam T Type of the residual norms.
+ */
+template <class T> struct convergence_info {
+  /// Whether the residual norm reached the requested tolerance.
+  bool converged;
+
+  /// Number of iterations performed.
+  size_t iterations;
+
+  /// Residual norm before the first iteration and after each iteration.
+  std::vector<T> residuals;
+};
+} // namespace linalg
+
+namespace detail {
+/**
+ * @brief Return type of the iterative solvers which take a preconditioner.
+ * Disables these overloads when the argument in the place of the
+ * preconditioner is a tolerance.
+ */
+template <class Preconditioner, class T>
+struct preconditioned_result
+    : std::enable_if<!std::is_arithmetic<Preconditioner>::value,
+                     linalg::convergence_info<
+                         typename complex_traits<T>::value_type>> {};
+} // namespace detail
+} // namespace numcpp
+
+#include "numcpp/linalg/iterative.tcc"
+
+#endif // NUMCPP_ITERATIVE_H_INCLUDED
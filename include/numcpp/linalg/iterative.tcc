@@ -0,0 +1,1015 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/iterative.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_ITERATIVE_TCC_INCLUDED
+#define NUMCPP_ITERATIVE_TCC_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include "numcpp/broadcasting/assert.h"
+#include "numcpp/functional/parallel.h"
+#include "numcpp/linalg/blas.h"
+#include "numcpp/linalg/decomposition.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Maximum number of partial sums of a parallel reduction.
+ */
+const size_t reduction_max_tasks = 64;
+
+/**
+ * @brief Call @a f(first, last) on consecutive ranges of [0, n), distributed
+ * among the available threads.
+ */
+template <class Function> void parallel_ranges(size_t n, Function &&f) {
+  size_t tasks = num_tasks(n, n);
+  parallel_for(tasks, [&](size_t task) {
+    f(block_begin(task, tasks, n), block_begin(task + 1, tasks, n));
+  });
+}
+
+/**
+ * @brief Return the sum of @a f(first, last) over consecutive ranges of
+ * [0, n), distributed among the available threads. The partial sums are
+ * added in order, so the result doesn't depend on scheduling.
+ */
+template <class U, class Function> U parallel_sum(size_t n, Function &&f) {
+  U partial[reduction_max_tasks];
+  size_t tasks = num_tasks(n, reduction_max_tasks);
+  parallel_for(tasks, [&](size_t task) {
+    partial[task] =
+        f(block_begin(task, tasks, n), block_begin(task + 1, tasks, n));
+  });
+  U sum = U(0);
+  for (size_t task = 0; task < tasks; ++task) {
+    sum += partial[task];
+  }
+  return sum;
+}
+
+/**
+ * @brief Return the inner product of two vectors, conjugating the first.
+ */
+template <class T> T vdot(const tensor<T, 1> &x, const tensor<T, 1> &y) {
+  const T *px = x.data(), *py = y.data();
+  return parallel_sum<T>(x.size(), [&](size_t first, size_t last) {
+    T sum = T(0);
+    for (size_t i = first; i < last; ++i) {
+      sum += conj_value(px[i]) * py[i];
+    }
+    return sum;
+  });
+}
+
+/**
+ * @brief Return the Euclidean norm of a vector.
+ */
+template <class T>
+typename complex_traits<T>::value_type norm2(const tensor<T, 1> &x) {
+  typedef typename complex_traits<T>::value_type R;
+  const T *px = x.data();
+  return std::sqrt(parallel_sum<R>(x.size(), [&](size_t first, size_t last) {
+    R sum = R(0);
+    for (size_t i = first; i < last; ++i) {
+      sum += std::norm(px[i]);
+    }
+    return sum;
+  }));
+}
+
+/**
+ * @brief Compute y = alpha * x + beta * y.
+ */
+template <class T>
+void axpby(const T &alpha, const tensor<T, 1> &x, const T &beta,
+           tensor<T, 1> &y) {
+  const T *px = x.data();
+  T *py = y.data();
+  parallel_ranges(x.size(), [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      py[i] = alpha * px[i] + beta * py[i];
+    }
+  });
+}
+
+/**
+ * @brief Compute the product of a sparse matrix and a vector. The rows are
+ * distributed among the available threads.
+ */
+template <class T>
+void csr_multiply(const linalg::csr_matrix<T> &a, const T *x, T *y) {
+  size_t rows = a.shape(0);
+  const size_t *indptr = a.indptr().data();
+  const size_t *indices = a.indices().data();
+  const T *data = a.data().data();
+  size_t tasks = num_tasks(a.nnz() + rows, rows);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, rows);
+    size_t last = block_begin(task + 1, tasks, rows);
+    for (size_t i = first; i < last; ++i) {
+      T val = T(0);
+      for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+        val += data[p] * x[indices[p]];
+      }
+      y[i] = val;
+    }
+  });
+}
+
+/**
+ * @brief Compute the product of a dense matrix and a vector.
+ */
+template <class T>
+void dense_multiply(const strided_matrix<const T> &a, const T *x, T *y) {
+  std::fill(y, y + a.rows, T(0));
+  gemv(T(1), a, make_column(x, a.cols), make_column(y, a.rows));
+}
+
+/**
+ * @brief Compute y = A x, where A is a dense matrix, a sparse matrix or a
+ * function which computes the product.
+ */
+template <class Operator, class T>
+inline void apply_operator(const Operator &a, const tensor<T, 1> &x,
+                           tensor<T, 1> &y) {
+  a(x, y);
+}
+
+template <class T>
+inline void apply_operator(const tensor<T, 2> &a, const tensor<T, 1> &x,
+                           tensor<T, 1> &y) {
+  dense_multiply(make_strided_matrix(a), x.data(), y.data());
+}
+
+template <class T>
+inline void apply_operator(const tensor_view<T, 2> &a, const tensor<T, 1> &x,
+                           tensor<T, 1> &y) {
+  dense_multiply(make_strided_matrix(a), x.data(), y.data());
+}
+
+template <class T>
+inline void apply_operator(const linalg::csr_matrix<T> &a,
+                           const tensor<T, 1> &x, tensor<T, 1> &y) {
+  csr_multiply(a, x.data(), y.data());
+}
+
+/**
+ * @brief Asserts whether the operator of a linear system is a square matrix
+ * of the same size as the right-hand side and the initial guess. The size of
+ * a function is not known and can't be checked. Throws a
+ * std::invalid_argument exception if assertion fails.
+ */
+inline void assert_iterative_shape(size_t n, size_t x_size) {
+  if (n != x_size) {
+    std::ostringstream error;
+    error << "incompatible dimensions for solve: right-hand side has " << n
+          << " elements but initial guess has " << x_size;
+    throw std::invalid_argument(error.str());
+  }
+}
+
+template <class Operator>
+inline void assert_iterative_shape(const Operator &, size_t n,
+                                   size_t x_size) {
+  assert_iterative_shape(n, x_size);
+}
+
+template <class T>
+inline void assert_iterative_shape(const tensor<T, 2> &a, size_t n,
+                                   size_t x_size) {
+  assert_square(a.shape());
+  assert_solve_shape(a.shape(0), n);
+  assert_iterative_shape(n, x_size);
+}
+
+template <class T>
+inline void assert_iterative_shape(const tensor_view<T, 2> &a, size_t n,
+                                   size_t x_size) {
+  assert_square(a.shape());
+  assert_solve_shape(a.shape(0), n);
+  assert_iterative_shape(n, x_size);
+}
+
+template <class T>
+inline void assert_iterative_shape(const linalg::csr_matrix<T> &a, size_t n,
+                                   size_t x_size) {
+  assert_square(a.shape());
+  assert_solve_shape(a.shape(0), n);
+  assert_iterative_shape(n, x_size);
+}
+
+/**
+ * @brief Compute the residual r = b - A x.
+ */
+template <class Operator, class T>
+void residual(const Operator &a, const tensor<T, 1> &b, const tensor<T, 1> &x,
+              tensor<T, 1> &r) {
+  apply_operator(a, x, r);
+  axpby(T(1), b, T(-1), r);
+}
+
+/**
+ * @brief The identity preconditioner, z = r.
+ */
+struct identity_preconditioner {
+  template <class T>
+  void operator()(const tensor<T, 1> &r, tensor<T, 1> &z) const {
+    axpby(T(1), r, T(0), z);
+  }
+};
+
+/**
+ * @brief Return the position of the diagonal elements of a sparse matrix.
+ * Throws a std::invalid_argument exception if a diagonal element is not
+ * stored or is zero.
+ */
+template <class T>
+std::vector<size_t> diagonal_positions(const linalg::csr_matrix<T> &a) {
+  assert_square(a.shape());
+  size_t n = a.shape(0);
+  const size_t *indptr = a.indptr().data();
+  const size_t *indices = a.indices().data();
+  std::vector<size_t> diag(n);
+  for (size_t i = 0; i < n; ++i) {
+    const size_t *it =
+        std::lower_bound(indices + indptr[i], indices + indptr[i + 1], i);
+    if (it == indices + indptr[i + 1] || *it != i ||
+        a.data()[it - indices] == T(0)) {
+      throw std::invalid_argument("matrix has a zero on its diagonal");
+    }
+    diag[i] = it - indices;
+  }
+  return diag;
+}
+
+/**
+ * @brief Compute a plane rotation such that
+ * [c s; -conj(s) c] [f; g] = [r; 0], with c real.
+ */
+template <class T>
+void plane_rotation(const T &f, const T &g,
+                    typename complex_traits<T>::value_type &c, T &s, T &r) {
+  typedef typename complex_traits<T>::value_type R;
+  R abs_f = std::abs(f), abs_g = std::abs(g);
+  if (abs_g == R(0)) {
+    c = R(1);
+    s = T(0);
+    r = f;
+  } else if (abs_f == R(0)) {
+    c = R(0);
+    s = conj_value(g) / abs_g;
+    r = abs_g;
+  } else {
+    R norm = std::hypot(abs_f, abs_g);
+    T phase = f / abs_f;
+    c = abs_f / norm;
+    s = phase * conj_value(g) / norm;
+    r = phase * norm;
+  }
+}
+
+/**
+ * @brief Return the maximum number of iterations of an iterative solver. A
+ * value of 0 stands for 10 times the size of the system.
+ */
+inline size_t iteration_limit(size_t maxiter, size_t n) {
+  return maxiter > 0 ? maxiter : 10 * n;
+}
+
+/**
+ * @brief Return the stopping tolerance of an iterative solver.
+ */
+template <class R>
+inline R stopping_tolerance(R bnorm, double rtol, double atol) {
+  return std::max(R(rtol) * bnorm, R(atol));
+}
+
+/**
+ * @brief Solve a Hermitian positive-definite system by the preconditioned
+ * conjugate gradient method.
+ */
+template <class Operator, class T, class Preconditioner>
+linalg::convergence_info<typename complex_traits<T>::value_type>
+conjugate_gradient(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+                   const Preconditioner &m, double rtol, double atol,
+                   size_t maxiter) {
+  typedef typename complex_traits<T>::value_type R;
+  size_t n = b.size();
+  linalg::convergence_info<R> info = {false, 0, std::vector<R>()};
+  tensor<T, 1> r(n), z(n), p(n), q(n);
+  R tol = stopping_tolerance(norm2(b), rtol, atol);
+  residual(a, b, x, r);
+  R rnorm = norm2(r);
+  info.residuals.push_back(rnorm);
+  if (rnorm <= tol) {
+    info.converged = true;
+    return info;
+  }
+  m(r, z);
+  axpby(T(1), z, T(0), p);
+  T rho = vdot(r, z);
+  while (info.iterations < maxiter) {
+    apply_operator(a, p, q);
+    T curvature = vdot(p, q);
+    if (curvature == T(0)) {
+      break;
+    }
+    T alpha = rho / curvature;
+    // The operator and the preconditioner may reallocate their outputs, so
+    // the pointers are fetched again after each call.
+    T *px = x.data(), *pr = r.data(), *pp = p.data();
+    const T *pq = q.data();
+    R rnorm2 = parallel_sum<R>(n, [&](size_t first, size_t last) {
+      R sum = R(0);
+      for (size_t i = first; i < last; ++i) {
+        px[i] += alpha * pp[i];
+        pr[i] -= alpha * pq[i];
+        sum += std::norm(pr[i]);
+      }
+      return sum;
+    });
+    rnorm = std::sqrt(rnorm2);
+    ++info.iterations;
+    info.residuals.push_back(rnorm);
+    if (rnorm <= tol) {
+      info.converged = true;
+      break;
+    }
+    m(r, z);
+    T rho_next = vdot(r, z);
+    T beta = rho_next / rho;
+    rho = rho_next;
+    const T *pz = z.data();
+    parallel_ranges(n, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        pp[i] = pz[i] + beta * pp[i];
+      }
+    });
+  }
+  return info;
+}
+
+/**
+ * @brief Return the norm of a vector induced by the inverse of a Hermitian
+ * positive-definite preconditioner, given the vector and the preconditioner
+ * applied to it.
+ */
+template <class T>
+typename complex_traits<T>::value_type
+preconditioned_norm(const tensor<T, 1> &r, const tensor<T, 1> &z) {
+  typedef typename complex_traits<T>::value_type R;
+  R val = std::real(vdot(r, z));
+  if (val < R(0)) {
+    throw std::invalid_argument("preconditioner is not positive definite");
+  }
+  return std::sqrt(val);
+}
+
+/**
+ * @brief Solve a Hermitian system by the preconditioned minimum residual
+ * method (Paige and Saunders). The preconditioner must be Hermitian
+ * positive-definite and the residuals are measured in the norm induced by
+ * its inverse.
+ */
+template <class Operator, class T, class Preconditioner>
+linalg::convergence_info<typename complex_traits<T>::value_type>
+minimal_residual(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+                 const Preconditioner &m, double rtol, double atol,
+                 size_t maxiter) {
+  typedef typename complex_traits<T>::value_type R;
+  size_t n = b.size();
+  linalg::convergence_info<R> info = {false, 0, std::vector<R>()};
+  tensor<T, 1> r1(n), r2(n), y(n), v(n), w(n), w1(n), w2(n);
+  m(b, y);
+  R tol = stopping_tolerance(preconditioned_norm(b, y), rtol, atol);
+  residual(a, b, x, r1);
+  m(r1, y);
+  R beta1 = preconditioned_norm(r1, y);
+  info.residuals.push_back(beta1);
+  if (beta1 <= tol) {
+    info.converged = true;
+    return info;
+  }
+  axpby(T(1), r1, T(0), r2);
+  std::fill(w.data(), w.data() + n, T(0));
+  std::fill(w2.data(), w2.data() + n, T(0));
+  R eps = std::numeric_limits<R>::epsilon();
+  R oldb = R(0), beta = beta1, dbar = R(0), epsln = R(0), phibar = beta1;
+  R cs = R(-1), sn = R(0);
+  while (info.iterations < maxiter) {
+    // Lanczos step: v is the next basis vector and y = A v is orthogonalized
+    // against the last two.
+    axpby(T(R(1) / beta), y, T(0), v);
+    apply_operator(a, v, y);
+    if (info.iterations > 0) {
+      axpby(T(-beta / oldb), r1, T(1), y);
+    }
+    R alfa = std::real(vdot(v, y));
+    axpby(T(-alfa / beta), r2, T(1), y);
+    std::swap(r1, r2);
+    std::swap(r2, y);
+    m(r2, y);
+    oldb = beta;
+    beta = preconditioned_norm(r2, y);
+
+    // Apply the previous rotation and compute the next one.
+    R oldeps = epsln;
+    R delta = cs * dbar + sn * alfa;
+    R gbar = sn * dbar - cs * alfa;
+    epsln = sn * beta;
+    dbar = -cs * beta;
+    R gamma = std::max(std::hypot(gbar, beta), eps);
+    cs = gbar / gamma;
+    sn = beta / gamma;
+    R phi = cs * phibar;
+    phibar = sn * phibar;
+
+    // Update the solution.
+    std::swap(w1, w2);
+    std::swap(w2, w);
+    T *pw = w.data(), *pw1 = w1.data(), *pw2 = w2.data(), *px = x.data();
+    const T *pv = v.data();
+    parallel_ranges(n, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        pw[i] = (pv[i] - oldeps * pw1[i] - delta * pw2[i]) / gamma;
+        px[i] += phi * pw[i];
+      }
+    });
+    ++info.iterations;
+    info.residuals.push_back(phibar);
+    if (phibar <= tol) {
+      info.converged = true;
+      break;
+    }
+    if (beta == R(0)) {
+      break;
+    }
+  }
+  return info;
+}
+
+/**
+ * @brief Solve a general system by the restarted generalized minimum
+ * residual method, with right preconditioning. The Krylov basis is
+ * orthogonalized by modified Gram-Schmidt and the least squares problems are
+ * updated with plane rotations.
+ */
+template <class Operator, class T, class Preconditioner>
+linalg::convergence_info<typename complex_traits<T>::value_type>
+restarted_gmres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+                const Preconditioner &m, size_t restart, double rtol,
+                double atol, size_t maxiter) {
+  typedef typename complex_traits<T>::value_type R;
+  if (restart == 0) {
+    throw std::invalid_argument("restart must be positive");
+  }
+  size_t n = b.size(), k = std::max<size_t>(1, std::min(restart, n));
+  linalg::convergence_info<R> info = {false, 0, std::vector<R>()};
+  std::vector<tensor<T, 1>> v(k + 1, tensor<T, 1>(n));
+  tensor<T, 1> u(n), z(n);
+  std::vector<T> h((k + 1) * k), g(k + 1), sn(k), y(k);
+  std::vector<R> cs(k);
+  R tol = stopping_tolerance(norm2(b), rtol, atol);
+  while (true) {
+    residual(a, b, x, u);
+    R beta = norm2(u);
+    if (info.residuals.empty()) {
+      info.residuals.push_back(beta);
+    }
+    if (beta <= tol) {
+      info.converged = true;
+      break;
+    }
+    if (info.iterations >= maxiter) {
+      break;
+    }
+    axpby(T(R(1) / beta), u, T(0), v[0]);
+    std::fill(g.begin(), g.end(), T(0));
+    g[0] = beta;
+
+    // Arnoldi process. Column j of the Hessenberg matrix is stored in
+    // h[j*(k + 1):(j + 1)*(k + 1)].
+    size_t j = 0;
+    while (j < k && info.iterations < maxiter) {
+      T *hj = h.data() + j * (k + 1);
+      m(v[j], z);
+      apply_operator(a, z, v[j + 1]);
+      for (size_t i = 0; i <= j; ++i) {
+        hj[i] = vdot(v[i], v[j + 1]);
+        axpby(-hj[i], v[i], T(1), v[j + 1]);
+      }
+      R hnext = norm2(v[j + 1]);
+      hj[j + 1] = hnext;
+      if (hnext != R(0)) {
+        axpby(T(R(1) / hnext), v[j + 1], T(0), v[j + 1]);
+      }
+      for (size_t i = 0; i < j; ++i) {
+        T temp = cs[i] * hj[i] + sn[i] * hj[i + 1];
+        hj[i + 1] = -conj_value(sn[i]) * hj[i] + cs[i] * hj[i + 1];
+        hj[i] = temp;
+      }
+      plane_rotation(hj[j], hj[j + 1], cs[j], sn[j], hj[j]);
+      hj[j + 1] = T(0);
+      g[j + 1] = -conj_value(sn[j]) * g[j];
+      g[j] = cs[j] * g[j];
+      ++j;
+      ++info.iterations;
+      R rnorm = std::abs(g[j]);
+      info.residuals.push_back(rnorm);
+      if (rnorm <= tol) {
+        info.converged = true;
+        break;
+      }
+      if (hnext == R(0)) {
+        break;
+      }
+    }
+
+    // Solve the triangular system and update the solution with the
+    // preconditioned combination of the basis.
+    for (size_t i = j; i-- > 0;) {
+      T val = g[i];
+      for (size_t l = i + 1; l < j; ++l) {
+        val -= h[l * (k + 1) + i] * y[l];
+      }
+      y[i] = val / h[i * (k + 1) + i];
+    }
+    T *pu = u.data();
+    parallel_ranges(n, [&](size_t first, size_t last) {
+      std::fill(pu + first, pu + last, T(0));
+      for (size_t i = 0; i < j; ++i) {
+        const T *pv = v[i].data();
+        for (size_t l = first; l < last; ++l) {
+          pu[l] += y[i] * pv[l];
+        }
+      }
+    });
+    m(u, z);
+    axpby(T(1), z, T(1), x);
+    if (info.converged) {
+      break;
+    }
+  }
+  return info;
+}
+
+/**
+ * @brief Solve a general system by the stabilized biconjugate gradient
+ * method (van der Vorst), with right preconditioning.
+ */
+template <class Operator, class T, class Preconditioner>
+linalg::convergence_info<typename complex_traits<T>::value_type>
+biconjugate_gradient_stabilized(const Operator &a, const tensor<T, 1> &b,
+                                tensor<T, 1> &x, const Preconditioner &m,
+                                double rtol, double atol, size_t maxiter) {
+  typedef typename complex_traits<T>::value_type R;
+  size_t n = b.size();
+  linalg::convergence_info<R> info = {false, 0, std::vector<R>()};
+  tensor<T, 1> r(n), rhat(n), p(n), v(n), phat(n), shat(n), t(n);
+  R tol = stopping_tolerance(norm2(b), rtol, atol);
+  residual(a, b, x, r);
+  R rnorm = norm2(r);
+  info.residuals.push_back(rnorm);
+  if (rnorm <= tol) {
+    info.converged = true;
+    return info;
+  }
+  axpby(T(1), r, T(0), rhat);
+  T rho = T(1), alpha = T(1), omega = T(1);
+  while (info.iterations < maxiter) {
+    T rho_next = vdot(rhat, r);
+    if (rho_next == T(0)) {
+      break;
+    }
+    if (info.iterations == 0) {
+      axpby(T(1), r, T(0), p);
+    } else {
+      T beta = (rho_next / rho) * (alpha / omega);
+      // The operator and the preconditioner may reallocate their outputs, so
+      // the pointers are fetched again after each call.
+      T *pp = p.data();
+      const T *pr = r.data(), *pv = v.data();
+      parallel_ranges(n, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+          pp[i] = pr[i] + beta * (pp[i] - omega * pv[i]);
+        }
+      });
+    }
+    rho = rho_next;
+    m(p, phat);
+    apply_operator(a, phat, v);
+    T rhat_v = vdot(rhat, v);
+    if (rhat_v == T(0)) {
+      break;
+    }
+    alpha = rho / rhat_v;
+
+    // The intermediate residual s overwrites r.
+    T *pr = r.data();
+    const T *pv = v.data();
+    R snorm = std::sqrt(parallel_sum<R>(n, [&](size_t first, size_t last) {
+      R sum = R(0);
+      for (size_t i = first; i < last; ++i) {
+        pr[i] -= alpha * pv[i];
+        sum += std::norm(pr[i]);
+      }
+      return sum;
+    }));
+    if (snorm <= tol) {
+      axpby(alpha, phat, T(1), x);
+      ++info.iterations;
+      info.residuals.push_back(snorm);
+      info.converged = true;
+      break;
+    }
+    m(r, shat);
+    apply_operator(a, shat, t);
+    R tnorm = norm2(t);
+    if (tnorm == R(0)) {
+      break;
+    }
+    omega = vdot(t, r) / (tnorm * tnorm);
+    T *px = x.data();
+    const T *pphat = phat.data(), *pshat = shat.data(), *pt = t.data();
+    rnorm = std::sqrt(parallel_sum<R>(n, [&](size_t first, size_t last) {
+      R sum = R(0);
+      for (size_t i = first; i < last; ++i) {
+        px[i] += alpha * pphat[i] + omega * pshat[i];
+        pr[i] -= omega * pt[i];
+        sum += std::norm(pr[i]);
+      }
+      return sum;
+    }));
+    ++info.iterations;
+    info.residuals.push_back(rnorm);
+    if (rnorm <= tol) {
+      info.converged = true;
+      break;
+    }
+    if (omega == T(0)) {
+      break;
+    }
+  }
+  return info;
+}
+} // namespace detail
+
+namespace linalg {
+/// Constructors.
+
+template <class T>
+csr_matrix<T>::csr_matrix()
+    : m_shape(0, 0), m_indptr(1), m_indices(0), m_data(0) {
+  m_indptr.data()[0] = 0;
+}
+
+template <class T>
+template <class Container>
+csr_matrix<T>::csr_matrix(const expression<Container, T, 2> &a)
+    : m_shape(a.shape()), m_indptr(a.shape(0) + 1) {
+  size_t rows = m_shape[0], cols = m_shape[1], nnz = 0;
+  size_t *indptr = m_indptr.data();
+  indptr[0] = 0;
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      if (a[{i, j}] != T(0)) {
+        ++nnz;
+      }
+    }
+    indptr[i + 1] = nnz;
+  }
+  m_indices = tensor<size_t, 1>(nnz);
+  m_data = tensor<T, 1>(nnz);
+  for (size_t i = 0, p = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      T val = a[{i, j}];
+      if (val != T(0)) {
+        m_indices.data()[p] = j;
+        m_data.data()[p++] = val;
+      }
+    }
+  }
+}
+
+template <class T>
+template <class Container1, class Container2, class Container3>
+csr_matrix<T>::csr_matrix(const shape_t<2> &shape,
+                          const expression<Container1, size_t, 1> &indptr,
+                          const expression<Container2, size_t, 1> &indices,
+                          const expression<Container3, T, 1> &data)
+    : m_shape(shape), m_indptr(indptr), m_indices(indices), m_data(data) {
+  size_t rows = m_shape[0], cols = m_shape[1], nnz = m_indices.size();
+  if (m_indptr.size() != rows + 1) {
+    std::ostringstream error;
+    error << "expected " << rows + 1 << " row pointers, got "
+          << m_indptr.size();
+    throw std::invalid_argument(error.str());
+  }
+  if (m_data.size() != nnz) {
+    std::ostringstream error;
+    error << "number of column indices (" << nnz
+          << ") doesn't match number of values (" << m_data.size() << ")";
+    throw std::invalid_argument(error.str());
+  }
+  size_t *ptr = m_indptr.data(), *idx = m_indices.data();
+  T *val = m_data.data();
+  if (ptr[0] != 0 || ptr[rows] != nnz ||
+      !std::is_sorted(ptr, ptr + rows + 1)) {
+    throw std::invalid_argument("row pointers must be non-decreasing, start "
+                                "at 0 and end at the number of values");
+  }
+  for (size_t p = 0; p < nnz; ++p) {
+    if (idx[p] >= cols) {
+      std::ostringstream error;
+      error << "column index " << idx[p]
+            << " is out of bounds for a matrix with " << cols << " columns";
+      throw std::invalid_argument(error.str());
+    }
+  }
+
+  // Sort the column indices of each row and sum duplicated entries,
+  // compacting the arrays in-place.
+  std::vector<std::pair<size_t, T>> entries;
+  size_t out = 0;
+  for (size_t i = 0, first = 0; i < rows; ++i) {
+    size_t last = ptr[i + 1];
+    bool sorted = true;
+    for (size_t p = first + 1; p < last && sorted; ++p) {
+      sorted = idx[p - 1] < idx[p];
+    }
+    if (sorted) {
+      for (size_t p = first; p < last; ++p, ++out) {
+        idx[out] = idx[p];
+        val[out] = val[p];
+      }
+    } else {
+      entries.clear();
+      for (size_t p = first; p < last; ++p) {
+        entries.emplace_back(idx[p], val[p]);
+      }
+      std::stable_sort(entries.begin(), entries.end(),
+                       [](const std::pair<size_t, T> &lhs,
+                          const std::pair<size_t, T> &rhs) {
+                         return lhs.first < rhs.first;
+                       });
+      for (size_t p = 0; p < entries.size(); ++p) {
+        if (out > ptr[i] && idx[out - 1] == entries[p].first) {
+          val[out - 1] += entries[p].second;
+        } else {
+          idx[out] = entries[p].first;
+          val[out++] = entries[p].second;
+        }
+      }
+    }
+    ptr[i + 1] = out;
+    first = last;
+  }
+  if (out < nnz) {
+    m_indices = tensor<size_t, 1>(idx, out);
+    m_data = tensor<T, 1>(val, out);
+  }
+}
+
+/// Public methods.
+
+template <class T> const shape_t<2> &csr_matrix<T>::shape() const {
+  return m_shape;
+}
+
+template <class T> size_t csr_matrix<T>::shape(size_t axis) const {
+  return m_shape[axis];
+}
+
+template <class T> size_t csr_matrix<T>::nnz() const {
+  return m_indices.size();
+}
+
+template <class T>
+const tensor<size_t, 1> &csr_matrix<T>::indptr() const {
+  return m_indptr;
+}
+
+template <class T>
+const tensor<size_t, 1> &csr_matrix<T>::indices() const {
+  return m_indices;
+}
+
+template <class T> const tensor<T, 1> &csr_matrix<T>::data() const {
+  return m_data;
+}
+
+template <class T> tensor<T, 1> csr_matrix<T>::diagonal() const {
+  size_t n = std::min(m_shape[0], m_shape[1]);
+  const size_t *indptr = m_indptr.data(), *indices = m_indices.data();
+  tensor<T, 1> out(n);
+  for (size_t i = 0; i < n; ++i) {
+    const size_t *it =
+        std::lower_bound(indices + indptr[i], indices + indptr[i + 1], i);
+    bool found = (it != indices + indptr[i + 1] && *it == i);
+    out.data()[i] = found ? m_data.data()[it - indices] : T(0);
+  }
+  return out;
+}
+
+template <class T>
+template <class Container>
+tensor<T, 1> csr_matrix<T>::dot(const expression<Container, T, 1> &x) const {
+  if (x.size() != m_shape[1]) {
+    std::ostringstream error;
+    error << "matmul: Number of rows in right operand does not match number "
+          << "of columns in left operand: (" << m_shape[0] << ","
+          << m_shape[1] << ") (" << x.size() << ",)";
+    throw std::invalid_argument(error.str());
+  }
+  tensor<T, 1> xcopy(x), out(m_shape[0]);
+  detail::csr_multiply(*this, xcopy.data(), out.data());
+  return out;
+}
+
+template <class T> tensor<T, 2> csr_matrix<T>::todense() const {
+  tensor<T, 2> out(m_shape, T(0));
+  const size_t *indptr = m_indptr.data(), *indices = m_indices.data();
+  for (size_t i = 0; i < m_shape[0]; ++i) {
+    for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+      out(i, indices[p]) = m_data.data()[p];
+    }
+  }
+  return out;
+}
+
+/// Constructors.
+
+template <class T>
+jacobi_preconditioner<T>::jacobi_preconditioner(const csr_matrix<T> &a)
+    : m_inv_diag(a.shape(0)) {
+  std::vector<size_t> diag = detail::diagonal_positions(a);
+  for (size_t i = 0; i < diag.size(); ++i) {
+    m_inv_diag.data()[i] = T(1) / a.data().data()[diag[i]];
+  }
+}
+
+template <class T>
+template <class Container>
+jacobi_preconditioner<T>::jacobi_preconditioner(
+    const expression<Container, T, 2> &a)
+    : m_inv_diag(a.shape(0)) {
+  detail::assert_square(a.shape());
+  for (size_t i = 0; i < a.shape(0); ++i) {
+    T val = a[{i, i}];
+    if (val == T(0)) {
+      throw std::invalid_argument("matrix has a zero on its diagonal");
+    }
+    m_inv_diag.data()[i] = T(1) / val;
+  }
+}
+
+/// Public methods.
+
+template <class T>
+void jacobi_preconditioner<T>::operator()(const tensor<T, 1> &r,
+                                          tensor<T, 1> &z) const {
+  const T *pr = r.data(), *pd = m_inv_diag.data();
+  T *pz = z.data();
+  detail::parallel_ranges(r.size(), [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      pz[i] = pd[i] * pr[i];
+    }
+  });
+}
+
+/// Constructors.
+
+template <class T>
+ilu0_preconditioner<T>::ilu0_preconditioner(const csr_matrix<T> &a)
+    : m_indptr(a.indptr()), m_indices(a.indices()), m_lu(a.data()),
+      m_diag(detail::diagonal_positions(a)) {
+  size_t n = a.shape(0);
+  const size_t *indptr = m_indptr.data(), *indices = m_indices.data();
+  T *lu = m_lu.data();
+
+  // Row i is eliminated with the previous rows (IKJ variant). pos[j] is the
+  // position of column j in row i, or npos if it's not stored.
+  const size_t npos = size_t(-1);
+  std::vector<size_t> pos(n, npos);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+      pos[indices[p]] = p;
+    }
+    for (size_t p = indptr[i]; p < m_diag[i]; ++p) {
+      size_t k = indices[p];
+      lu[p] /= lu[m_diag[k]];
+      for (size_t q = m_diag[k] + 1; q < indptr[k + 1]; ++q) {
+        if (pos[indices[q]] != npos) {
+          lu[pos[indices[q]]] -= lu[p] * lu[q];
+        }
+      }
+    }
+    if (lu[m_diag[i]] == T(0)) {
+      throw std::invalid_argument("zero pivot in incomplete LU factorization");
+    }
+    for (size_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+      pos[indices[p]] = npos;
+    }
+  }
+}
+
+/// Public methods.
+
+template <class T>
+void ilu0_preconditioner<T>::operator()(const tensor<T, 1> &r,
+                                        tensor<T, 1> &z) const {
+  size_t n = m_diag.size();
+  const size_t *indptr = m_indptr.data(), *indices = m_indices.data();
+  const T *lu = m_lu.data(), *pr = r.data();
+  T *pz = z.data();
+  for (size_t i = 0; i < n; ++i) {
+    T val = pr[i];
+    for (size_t p = indptr[i]; p < m_diag[i]; ++p) {
+      val -= lu[p] * pz[indices[p]];
+    }
+    pz[i] = val;
+  }
+  for (size_t i = n; i-- > 0;) {
+    T val = pz[i];
+    for (size_t p = m_diag[i] + 1; p < indptr[i + 1]; ++p) {
+      val -= lu[p] * pz[indices[p]];
+    }
+    pz[i] = val / lu[m_diag[i]];
+  }
+}
+
+/// Constructors.
+
+template <class T>
+ssor_preconditioner<T>::ssor_preconditioner(const csr_matrix<T> &a,
+                                            double omega)
+    : m_a(a), m_diag(detail::diagonal_positions(a)), m_omega(omega) {
+  if (!(omega > 0 && omega < 2)) {
+    throw std::invalid_argument("relaxation parameter must be in (0, 2)");
+  }
+}
+
+/// Public methods.
+
+template <class T>
+void ssor_preconditioner<T>::operator()(const tensor<T, 1> &r,
+                                        tensor<T, 1> &z) const {
+  size_t n = m_diag.size();
+  const size_t *indptr = m_a.indptr().data();
+  const size_t *indices = m_a.indices().data();
+  const T *data = m_a.data().data(), *pr = r.data();
+  T *pz = z.data();
+
+  // Solve (D/w + L) y = r, then scale by D/w and solve (D/w + U) z = y.
+  for (size_t i = 0; i < n; ++i) {
+    T val = pr[i];
+    for (size_t p = indptr[i]; p < m_diag[i]; ++p) {
+      val -= data[p] * pz[indices[p]];
+    }
+    pz[i] = val * m_omega / data[m_diag[i]];
+  }
+  real_type scale = (real_type(2) - m_omega) / m_omega;
+  for (size_t i = n; i-- > 0;) {
+    T diag = data[m_diag[i]] / m_omega;
+    T val = diag * pz[i];
+    for (size_t p = m_diag[i] + 1; p < indptr[i + 1]; ++p) {
+      val -= data[p] * pz[indices[p]];
+    }
+    pz[i] = val / diag;
+  }
+  detail::parallel_ranges(n, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      pz[i] *= scale;
+    }
+  });
+}
+} // namespace linalg
+} // namespace numcpp
+
+#endif // NUMCPP_ITERATIVE_TCC_INCLUDED
@@ -24,10 +24,18 @@
 #ifndef NUMCPP_LINALG_TCC_INCLUDED
 #define NUMCPP_LINALG_TCC_INCLUDED
 
-#include <numeric>
+#include <limits>
+#include <type_traits>
+#include <vector>
 #include "numcpp/broadcasting/assert.h"
 #include "numcpp/math/constants.h"
-#include "numcpp/iterators/axes_iterator.h"
+#include "numcpp/functional/scan.h"
+#include "numcpp/linalg/batched.h"
+#include "numcpp/linalg/blas.h"
+#include "numcpp/linalg/contraction.h"
+#include "numcpp/linalg/eigen.h"
+#include "numcpp/linalg/factorization.h"
+#include "numcpp/linalg/svd.h"
 
 namespace numcpp {
 /// Basic linear algebra.
@@ -118,6 +126,196 @@ tensor<T, Rank> cross(const expression<Container1, T, Rank> &a,
   return out;
 }
 
+namespace detail {
+/**
+ * @brief Whether a matrix expression has a structure which the matrix product
+ * can exploit: an identity matrix, a diagonal matrix or a triangular matrix.
+ */
+template <class Container> struct is_structured_matrix : std::false_type {};
+
+template <class T>
+struct is_structured_matrix<identity_expr<T>> : std::true_type {};
+
+template <class Container, class T>
+struct is_structured_matrix<diagonal_expr<Container, T, 1>>
+    : std::true_type {};
+
+template <class Container, class T>
+struct is_structured_matrix<triangular_expr<Container, T, 2>>
+    : std::true_type {};
+
+/**
+ * @brief Compute c(i, :) = scale(i) * b(i + k, :), leaving zeros in the rows
+ * for which i + k is out of bounds. This is the product of a matrix whose
+ * only nonzero diagonal is the k-th one and @a b. The rows are distributed
+ * among the available threads.
+ */
+template <class T, class Function>
+void scale_rows(ptrdiff_t k, Function scale, const strided_matrix<const T> &b,
+                const strided_matrix<T> &c) {
+  size_t m = c.rows, n = c.cols;
+  size_t tasks = num_tasks(m * n, m);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, m);
+    size_t last = block_begin(task + 1, tasks, m);
+    for (size_t i = first; i < last; ++i) {
+      ptrdiff_t p = ptrdiff_t(i) + k;
+      if (p < 0 || p >= ptrdiff_t(b.rows)) {
+        for (size_t j = 0; j < n; ++j) {
+          c(i, j) = T();
+        }
+      } else {
+        T val = scale(i);
+        for (size_t j = 0; j < n; ++j) {
+          c(i, j) = val * b(p, j);
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Compute c(:, j) = a(:, j - k) * scale(j - k), leaving zeros in the
+ * columns for which j - k is out of bounds. This is the product of @a a and a
+ * matrix whose only nonzero diagonal is the k-th one. The rows are
+ * distributed among the available threads.
+ */
+template <class T, class Function>
+void scale_columns(ptrdiff_t k, Function scale,
+                   const strided_matrix<const T> &a,
+                   const strided_matrix<T> &c) {
+  size_t m = c.rows, n = c.cols;
+  size_t tasks = num_tasks(m * n, m);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, m);
+    size_t last = block_begin(task + 1, tasks, m);
+    for (size_t i = first; i < last; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        ptrdiff_t p = ptrdiff_t(j) - k;
+        c(i, j) = (p < 0 || p >= ptrdiff_t(a.cols)) ? T()
+                                                    : a(i, p) * scale(p);
+      }
+    }
+  });
+}
+
+/**
+ * @brief Return the elements on the nonzero diagonal of a diagonal matrix.
+ * The element at row i is at position i + min(k, 0).
+ */
+template <class Container, class T>
+std::vector<T> diagonal_values(const diagonal_expr<Container, T, 1> &a) {
+  return std::vector<T>(a.base().begin(), a.base().end());
+}
+
+/**
+ * @brief Compute the matrix product c = a * b, exploiting the structure of
+ * the first matrix. Identity and diagonal matrices shift and scale the rows
+ * of @a b, and triangular matrices skip their zero triangle.
+ */
+template <class Container, class T>
+void left_multiply(const expression<Container, T, 2> &a,
+                   const strided_matrix<const T> &b,
+                   const strided_matrix<T> &c) {
+  tensor<T, 2> a_buffer;
+  gemm(T(1), make_matrix_operand(a.self(), a_buffer), b, T(0), c);
+}
+
+template <class T>
+void left_multiply(const identity_expr<T> &a, const strided_matrix<const T> &b,
+                   const strided_matrix<T> &c) {
+  scale_rows(a.offset(), [](size_t) { return T(1); }, b, c);
+}
+
+template <class Container, class T>
+void left_multiply(const diagonal_expr<Container, T, 1> &a,
+                   const strided_matrix<const T> &b,
+                   const strided_matrix<T> &c) {
+  std::vector<T> diag = diagonal_values(a);
+  ptrdiff_t k = a.offset(), shift = std::min(k, ptrdiff_t(0));
+  scale_rows(k, [&](size_t i) { return diag[i + shift]; }, b, c);
+}
+
+template <class Container, class T>
+void left_multiply(const triangular_expr<Container, T, 2> &a,
+                   const strided_matrix<const T> &b,
+                   const strided_matrix<T> &c) {
+  tensor<T, 2> a_buffer;
+  trmm(make_matrix_operand(a.base(), a_buffer), a.lower(), a.offset(), b, c);
+}
+
+/**
+ * @brief Compute the matrix product c = a * b, exploiting the structure of
+ * the second matrix. Identity and diagonal matrices shift and scale the
+ * columns of @a a, and triangular matrices skip their zero triangle.
+ */
+template <class Container, class T>
+void right_multiply(const strided_matrix<const T> &a,
+                    const expression<Container, T, 2> &b,
+                    const strided_matrix<T> &c) {
+  tensor<T, 2> b_buffer;
+  gemm(T(1), a, make_matrix_operand(b.self(), b_buffer), T(0), c);
+}
+
+template <class T>
+void right_multiply(const strided_matrix<const T> &a,
+                    const identity_expr<T> &b, const strided_matrix<T> &c) {
+  scale_columns(b.offset(), [](size_t) { return T(1); }, a, c);
+}
+
+template <class Container, class T>
+void right_multiply(const strided_matrix<const T> &a,
+                    const diagonal_expr<Container, T, 1> &b,
+                    const strided_matrix<T> &c) {
+  std::vector<T> diag = diagonal_values(b);
+  ptrdiff_t k = b.offset(), shift = std::min(k, ptrdiff_t(0));
+  scale_columns(k, [&](size_t i) { return diag[i + shift]; }, a, c);
+}
+
+template <class Container, class T>
+void right_multiply(const strided_matrix<const T> &a,
+                    const triangular_expr<Container, T, 2> &b,
+                    const strided_matrix<T> &c) {
+  // (a * tri(b))^T = tri(b)^T * a^T, where tri(b)^T is the opposite triangle
+  // of b^T with the opposite offset.
+  tensor<T, 2> b_buffer;
+  trmm(make_matrix_operand(b.base(), b_buffer).t(), !b.lower(), -b.offset(),
+       a.t(), c.t());
+}
+
+/**
+ * @brief Compute the matrix product c = a * b. If only the second matrix has
+ * a known structure, it is exploited. Otherwise, the structure of the first
+ * matrix is, if any.
+ */
+template <class Container1, class Container2, class T>
+void structured_matmul(const expression<Container1, T, 2> &a,
+                       const expression<Container2, T, 2> &b,
+                       const strided_matrix<T> &c, std::true_type) {
+  tensor<T, 2> a_buffer;
+  right_multiply(make_matrix_operand(a.self(), a_buffer), b.self(), c);
+}
+
+template <class Container1, class Container2, class T>
+void structured_matmul(const expression<Container1, T, 2> &a,
+                       const expression<Container2, T, 2> &b,
+                       const strided_matrix<T> &c, std::false_type) {
+  tensor<T, 2> b_buffer;
+  left_multiply(a.self(), make_matrix_operand(b.self(), b_buffer), c);
+}
+
+template <class Container1, class Container2, class T>
+void structured_matmul(const expression<Container1, T, 2> &a,
+                       const expression<Container2, T, 2> &b,
+                       const strided_matrix<T> &c) {
+  typedef std::integral_constant<bool,
+                                 !is_structured_matrix<Container1>::value &&
+                                     is_structured_matrix<Container2>::value>
+      right_structured;
+  structured_matmul(a, b, c, right_structured());
+}
+} // namespace detail
+
 template <class Container1, class Container2, class T>
 inline T matmul(const expression<Container1, T, 1> &a,
                 const expression<Container2, T, 1> &b) {
@@ -128,17 +326,8 @@ template <class Container1, class Container2, class T>
 tensor<T, 2> matmul(const expression<Container1, T, 2> &a,
                     const expression<Container2, T, 2> &b) {
   detail::assert_aligned_shapes(a.shape(), 1, b.shape(), 0);
-  size_t m = a.shape(0), p = a.shape(1), n = b.shape(1);
-  tensor<T, 2> out(m, n);
-  for (size_t i = 0; i < m; ++i) {
-    for (size_t j = 0; j < n; ++j) {
-      T val = T(0);
-      for (size_t k = 0; k < p; ++k) {
-        val += a[{i, k}] * b[{k, j}];
-      }
-      out[{i, j}] = val;
-    }
-  }
+  tensor<T, 2> out(a.shape(0), b.shape(1));
+  detail::structured_matmul(a, b, detail::make_strided_matrix(out));
   return out;
 }
 
@@ -146,15 +335,11 @@ template <class Container1, class Container2, class T>
 tensor<T, 1> matmul(const expression<Container1, T, 1> &a,
                     const expression<Container2, T, 2> &b) {
   detail::assert_aligned_shapes(a.shape(), 0, b.shape(), 0);
-  size_t m = b.shape(0), n = b.shape(1);
-  tensor<T, 1> out(n);
-  for (size_t j = 0; j < n; ++j) {
-    T val = T(0);
-    for (size_t i = 0; i < m; ++i) {
-      val += a[i] * b[{i, j}];
-    }
-    out[j] = val;
-  }
+  tensor<T, 1> a_buffer;
+  tensor<T, 1> out(b.shape(1));
+  detail::strided_matrix<T> c(out.data(), out.size(), 1, 1, 1);
+  detail::right_multiply(detail::make_vector_operand(a.self(), a_buffer).t(),
+                         b.self(), c.t());
   return out;
 }
 
@@ -162,15 +347,11 @@ template <class Container1, class Container2, class T>
 tensor<T, 1> matmul(const expression<Container1, T, 2> &a,
                     const expression<Container2, T, 1> &b) {
   detail::assert_aligned_shapes(a.shape(), 1, b.shape(), 0);
-  size_t m = a.shape(0), n = a.shape(1);
-  tensor<T, 1> out(m);
-  for (size_t i = 0; i < m; ++i) {
-    T val = T(0);
-    for (size_t j = 0; j < n; ++j) {
-      val += a[{i, j}] * b[j];
-    }
-    out[i] = val;
-  }
+  tensor<T, 1> b_buffer;
+  tensor<T, 1> out(a.shape(0));
+  detail::strided_matrix<T> c(out.data(), out.size(), 1, 1, 1);
+  detail::left_multiply(
+      a.self(), detail::make_vector_operand(b.self(), b_buffer), c);
   return out;
 }
 
@@ -275,26 +456,11 @@ tensordot(const expression<Container1, T, Rank1> &a,
   static_assert(N < Rank1 && N < Rank2,
                 "The number of dimensions to contract cannot be larger than "
                 "the tensor dimension");
-  size_t size =
-      detail::assert_aligned_shapes(a.shape(), a_axes, b.shape(), b_axes);
+  detail::assert_tensordot_axes(a.shape(), a_axes, b.shape(), b_axes);
   constexpr size_t Rank = (Rank1 - N) + (Rank2 - N);
-  shape_t<Rank1 - N> a_squeezed = detail::remove_axes(a.shape(), a_axes);
-  shape_t<Rank2 - N> b_squeezed = detail::remove_axes(b.shape(), b_axes);
-  shape_t<Rank> shape = shape_cat(a_squeezed, b_squeezed);
-  tensor<T, Rank> out(shape);
-  for (index_t<Rank1 - N> i : make_index_sequence(a_squeezed)) {
-    for (index_t<Rank2 - N> j : make_index_sequence(b_squeezed)) {
-      typedef axes_iterator<const Container1, T, Rank1, N, void, T> iterator1;
-      typedef axes_iterator<const Container2, T, Rank2, N, void, T> iterator2;
-      index_t<Rank1> a_index = detail::insert_axes(i, a_axes);
-      index_t<Rank2> b_index = detail::insert_axes(j, b_axes);
-      index_t<Rank> out_index = shape_cat(i, j);
-      iterator1 first1(&a.self(), a_index, a_axes, 0);
-      iterator1 last1(&a.self(), a_index, a_axes, size);
-      iterator2 first2(&b.self(), b_index, b_axes, 0);
-      out[out_index] = std::inner_product(first1, last1, first2, T());
-    }
-  }
+  tensor<T, Rank> out(shape_cat(detail::remove_axes(a.shape(), a_axes),
+                                detail::remove_axes(b.shape(), b_axes)));
+  detail::tensordot_into(a, b, a_axes, b_axes, out.data());
   return out;
 }
 
@@ -306,21 +472,9 @@ tensor<T, Rank1 - Rank2> tensordot(const expression<Container1, T, Rank1> &a,
                                    const shape_t<Rank2> &b_axes) {
   static_assert(Rank2 < Rank1, "The number of dimensions to contract cannot "
                                "be larger than the tensor dimension");
-  size_t size =
-      detail::assert_aligned_shapes(a.shape(), a_axes, b.shape(), b_axes);
-  constexpr size_t Rank = Rank1 - Rank2;
-  shape_t<Rank> shape = detail::remove_axes(a.shape(), a_axes);
-  tensor<T, Rank> out(shape);
-  for (index_t<Rank> out_index : make_index_sequence_for(out)) {
-    typedef axes_iterator<const Container1, T, Rank1, Rank2, void, T> iterator1;
-    typedef axes_iterator<const Container2, T, Rank2, Rank2, void, T> iterator2;
-    index_t<Rank1> a_index = detail::insert_axes(out_index, a_axes);
-    index_t<Rank2> b_index;
-    iterator1 first1(&a.self(), a_index, a_axes, 0);
-    iterator1 last1(&a.self(), a_index, a_axes, size);
-    iterator2 first2(&b.self(), b_index, b_axes, 0);
-    out[out_index] = std::inner_product(first1, last1, first2, T());
-  }
+  detail::assert_tensordot_axes(a.shape(), a_axes, b.shape(), b_axes);
+  tensor<T, Rank1 - Rank2> out(detail::remove_axes(a.shape(), a_axes));
+  detail::tensordot_into(a, b, a_axes, b_axes, out.data());
   return out;
 }
 
@@ -330,22 +484,31 @@ tensor<T, Rank2 - Rank1> tensordot(const expression<Container1, T, Rank1> &a,
                                    const expression<Container2, T, Rank2> &b,
                                    const shape_t<Rank1> &a_axes,
                                    const shape_t<Rank1> &b_axes) {
-  return tensordot(b, a, b_axes, a_axes);
+  static_assert(Rank1 < Rank2, "The number of dimensions to contract cannot "
+                               "be larger than the tensor dimension");
+  detail::assert_tensordot_axes(a.shape(), a_axes, b.shape(), b_axes);
+  tensor<T, Rank2 - Rank1> out(detail::remove_axes(b.shape(), b_axes));
+  detail::tensordot_into(a, b, a_axes, b_axes, out.data());
+  return out;
 }
 
 template <class Container1, class T, size_t Rank, class Container2>
 T tensordot(const expression<Container1, T, Rank> &a,
             const expression<Container2, T, Rank> &b,
             const shape_t<Rank> &a_axes, const shape_t<Rank> &b_axes) {
-  size_t size =
-      detail::assert_aligned_shapes(a.shape(), a_axes, b.shape(), b_axes);
-  typedef axes_iterator<const Container1, T, Rank, Rank, void, T> iterator1;
-  typedef axes_iterator<const Container2, T, Rank, Rank, void, T> iterator2;
-  index_t<Rank> a_index, b_index;
-  iterator1 first1(&a.self(), a_index, a_axes, 0);
-  iterator1 last1(&a.self(), a_index, a_axes, size);
-  iterator2 first2(&b.self(), b_index, b_axes, 0);
-  return std::inner_product(first1, last1, first2, T());
+  detail::assert_tensordot_axes(a.shape(), a_axes, b.shape(), b_axes);
+  T val;
+  detail::tensordot_into(a, b, a_axes, b_axes, &val);
+  return val;
+}
+
+template <size_t Rank, class Container, class T, size_t Rank1,
+          class... Operands>
+typename detail::einsum_result<T, Rank>::type
+einsum(const std::string &subscripts, const expression<Container, T, Rank1> &a,
+       const Operands &...operands) {
+  std::vector<detail::strided_tensor<T>> tensors;
+  return detail::einsum_evaluate<Rank>(subscripts, tensors, a, operands...);
 }
 
 namespace detail {
@@ -402,6 +565,207 @@ T p_norm(InputIterator first, InputIterator last, T init, double ord) {
   }
   return init;
 }
+
+/**
+ * @brief Return the number of matrices in a stack of matrices.
+ */
+template <size_t Rank> size_t num_matrices(const shape_t<Rank> &shape) {
+  size_t count = 1;
+  for (size_t axis = 0; axis < Rank - 2; ++axis) {
+    count *= shape[axis];
+  }
+  return count;
+}
+
+/**
+ * @brief Copy a tensor-like object into a new row-major tensor. Tensors and
+ * tensor views already stored in row-major order are copied directly, without
+ * going through their indices.
+ */
+template <class Container, class T, size_t Rank>
+tensor<T, Rank> row_major_copy(const expression<Container, T, Rank> &a) {
+  tensor<T, Rank> buffer;
+  const T *data = make_row_major(a.self(), buffer);
+  if (data == buffer.data() && buffer.shape() == a.shape()) {
+    return buffer;
+  }
+  return tensor<T, Rank>(data, a.shape(), row_major);
+}
+
+/**
+ * @brief Copy a stack of matrices into a new row-major tensor of the given
+ * shape, broadcasting its leading dimensions.
+ */
+template <class Container, class T, size_t Rank>
+tensor<T, Rank> broadcast_matrices(const expression<Container, T, Rank> &a,
+                                   const shape_t<Rank> &shape) {
+  if (a.shape() == shape) {
+    return row_major_copy(a);
+  }
+  tensor<T, Rank> out(shape, row_major);
+  for (index_t<Rank> index : make_index_sequence(shape, row_major)) {
+    index_t<Rank> a_index = index;
+    for (size_t axis = 0; axis < Rank - 2; ++axis) {
+      if (a.shape(axis) == 1) {
+        a_index[axis] = 0;
+      }
+    }
+    out[index] = a[a_index];
+  }
+  return out;
+}
+
+/**
+ * @brief Compute selected eigenvalues and, if @a vectors is true,
+ * eigenvectors of a Hermitian matrix.
+ */
+template <class Container, class T>
+std::pair<tensor<typename complex_traits<T>::value_type, 1>, tensor<T, 2>>
+hermitian_eigen(
+    const expression<Container, T, 2> &a,
+    const eigen_subset<typename complex_traits<T>::value_type> &subset,
+    bool vectors) {
+  typedef typename complex_traits<T>::value_type real_type;
+  assert_square(a.shape());
+  tensor<T, 2> buffer = row_major_copy(a);
+  std::vector<real_type> w;
+  tensor<T, 2> v;
+  hermitian_eigen(make_strided_matrix(buffer), subset, w,
+                  vectors ? &v : NULL);
+  return std::make_pair(tensor<real_type, 1>(w.begin(), w.size()),
+                        std::move(v));
+}
+
+/**
+ * @brief Return the number of singular values above rcond times the largest
+ * one. If rcond is negative, max(m, n) times the machine epsilon is used.
+ */
+template <class T>
+size_t singular_value_rank(const std::vector<T> &s, double rcond, size_t m,
+                           size_t n) {
+  if (rcond < 0) {
+    rcond = std::numeric_limits<T>::epsilon() * std::max(m, n);
+  }
+  T cutoff = s.empty() ? T(0) : T(rcond) * s[0];
+  size_t rank = 0;
+  while (rank < s.size() && s[rank] > cutoff) {
+    ++rank;
+  }
+  return rank;
+}
+
+/**
+ * @brief Compute x = v(:, 0:rank) * diag(1/s(0:rank)) * u(:, 0:rank)^H * b
+ * from a thin singular value decomposition, u * diag(s) * vh.
+ */
+template <class T>
+void svd_solve(const tensor<T, 2> &u,
+               const std::vector<typename complex_traits<T>::value_type> &s,
+               const tensor<T, 2> &vh, size_t rank,
+               const strided_matrix<const T> &b, const strided_matrix<T> &x) {
+  size_t m = u.shape(0), n = vh.shape(1), k = b.cols;
+  tensor<T, 2> uh(rank, m), v(n, rank), y(rank, k);
+  for (size_t i = 0; i < rank; ++i) {
+    for (size_t j = 0; j < m; ++j) {
+      uh(i, j) = conj_value(u(j, i));
+    }
+  }
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < rank; ++j) {
+      v(i, j) = conj_value(vh(j, i)) / s[j];
+    }
+  }
+  gemm<T>(T(1), make_strided_matrix(uh), b, T(0), make_strided_matrix(y));
+  gemm<T>(T(1), make_strided_matrix(v), make_strided_matrix(y), T(0), x);
+}
+
+/**
+ * @brief Return the minimum norm least-squares solution of a * x = b, the
+ * squared residual norms, the rank of a and its singular values.
+ */
+template <class Container, class T>
+std::tuple<tensor<T, 2>, tensor<typename complex_traits<T>::value_type, 1>,
+           size_t, tensor<typename complex_traits<T>::value_type, 1>>
+least_squares(const expression<Container, T, 2> &a, tensor<T, 2> &b,
+              double rcond) {
+  typedef typename complex_traits<T>::value_type real_type;
+  size_t m = a.shape(0), n = a.shape(1), k = b.shape(1);
+  tensor<T, 2> buffer = row_major_copy(a);
+  strided_matrix<T> bmat = make_strided_matrix(b);
+  std::vector<real_type> s, res(k, real_type(0));
+  tensor<T, 2> u, vh;
+  size_t rows = m;
+  if (n > 0 && m > n && m >= svd_qr_crossover * n) {
+    // a = q * r, so that the problem reduces to r * x = (q^H * b)(0:n),
+    // with residual ||(q^H * b)(n:m)||.
+    strided_matrix<T> amat = make_strided_matrix(buffer);
+    size_t tb = std::min(qr_block_size, n);
+    std::vector<T> tau(n), t(tb * n);
+    strided_matrix<T> tmat(t.data(), tb, n, n, 1);
+    qr_factor(amat, tau.data(), tmat);
+    qr_multiply<T>(amat, tmat, true, bmat);
+    for (size_t i = n; i < m; ++i) {
+      for (size_t j = 0; j < k; ++j) {
+        res[j] += std::norm(bmat(i, j));
+      }
+    }
+    tensor<T, 2> r(n, n);
+    std::fill_n(r.data(), n * n, T(0));
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = i; j < n; ++j) {
+        r(i, j) = amat(i, j);
+      }
+    }
+    singular_value_decomposition(r, s, &u, &vh, false);
+    rows = n;
+  } else {
+    singular_value_decomposition(buffer, s, &u, &vh, false);
+  }
+
+  size_t rank = singular_value_rank(s, rcond, m, n);
+  tensor<T, 2> x(n, k);
+  svd_solve<T>(u, s, vh, rank, bmat.block(0, 0, rows, k),
+            make_strided_matrix(x));
+  if (rank < n || m <= n) {
+    res.clear();
+  } else if (rows == m) {
+    // The residual is b - u * u^H * b.
+    tensor<T, 2> uh(n, m), y(n, k);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < m; ++j) {
+        uh(i, j) = conj_value(u(j, i));
+      }
+    }
+    gemm<T>(T(1), make_strided_matrix(uh), bmat, T(0),
+            make_strided_matrix(y));
+    gemm<T>(T(-1), make_strided_matrix(u), make_strided_matrix(y), T(1),
+            bmat);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < k; ++j) {
+        res[j] += std::norm(bmat(i, j));
+      }
+    }
+  }
+  return std::make_tuple(std::move(x),
+                         tensor<real_type, 1>(res.begin(), res.size()), rank,
+                         tensor<real_type, 1>(s.begin(), s.size()));
+}
+
+/**
+ * @brief Solve a triangular system in-place by substitution.
+ */
+template <class Container, class T>
+void triangular_solve(const triangular_expr<Container, T, 2> &a,
+                      const strided_matrix<T> &b) {
+  tensor<T, 2> a_buffer;
+  strided_matrix<const T> mat = make_matrix_operand(a.base(), a_buffer);
+  for (size_t i = 0; i < mat.rows; ++i) {
+    if (mat(i, i) == T(0)) {
+      throw std::invalid_argument("matrix is singular");
+    }
+  }
+  trsm(mat, a.lower(), false, b);
+}
 } // namespace detail
 
 namespace linalg {
@@ -430,6 +794,478 @@ T norm(const expression<Container, std::complex<T>, 1> &a, double ord) {
     return detail::p_norm(a.self().begin(), a.self().end(), T());
   }
 }
+
+template <class Container, class T>
+T det(const expression<Container, T, 2> &a) {
+  detail::assert_square(a.shape());
+  tensor<T, 2> buffer(a, row_major);
+  return detail::determinant(detail::make_strided_matrix(buffer),
+                             std::is_integral<T>());
+}
+
+template <class Container, class T, size_t Rank>
+tensor<T, Rank - 2> det(const expression<Container, T, Rank> &a) {
+  detail::assert_square(a.shape());
+  tensor<T, Rank> buffer = detail::row_major_copy(a);
+  shape_t<Rank - 2> shape;
+  for (size_t axis = 0; axis < Rank - 2; ++axis) {
+    shape[axis] = a.shape(axis);
+  }
+  tensor<T, Rank - 2> out(shape);
+  detail::det_batch(buffer.data(), out.data(), out.size(), a.shape(Rank - 1));
+  return out;
+}
+
+template <class Container1, class Container2, class T>
+tensor<T, 1> solve(const expression<Container1, T, 2> &a,
+                   const expression<Container2, T, 1> &b) {
+  detail::assert_square(a.shape());
+  detail::assert_aligned_shapes(a.shape(), 1, b.shape(), 0);
+  tensor<T, 2> buffer = detail::row_major_copy(a);
+  tensor<T, 1> out = detail::row_major_copy(b);
+  detail::solve_batch(buffer.data(), out.data(), 1, b.size(), 1);
+  return out;
+}
+
+template <class Container1, class Container2, class T, size_t Rank>
+tensor<T, Rank> solve(const expression<Container1, T, Rank> &a,
+                      const expression<Container2, T, Rank> &b) {
+  detail::assert_square(a.shape());
+  detail::assert_aligned_shapes(a.shape(), Rank - 1, b.shape(), Rank - 2);
+  shape_t<Rank> shape = detail::broadcast_matmul(a.shape(), b.shape());
+  shape_t<Rank> a_shape = shape;
+  a_shape[Rank - 1] = a.shape(Rank - 1);
+  tensor<T, Rank> buffer = detail::broadcast_matrices(a, a_shape);
+  tensor<T, Rank> out = detail::broadcast_matrices(b, shape);
+  detail::solve_batch(buffer.data(), out.data(), detail::num_matrices(shape),
+                      shape[Rank - 2], shape[Rank - 1]);
+  return out;
+}
+
+template <class Container1, class Container2, class T>
+tensor<T, 1> solve(const triangular_expr<Container1, T, 2> &a,
+                   const expression<Container2, T, 1> &b) {
+  if (a.offset() != 0) {
+    return solve(detail::row_major_copy(a), b);
+  }
+  detail::assert_square(a.shape());
+  detail::assert_aligned_shapes(a.shape(), 1, b.shape(), 0);
+  tensor<T, 1> out = detail::row_major_copy(b);
+  detail::triangular_solve(
+      a, detail::strided_matrix<T>(out.data(), out.size(), 1, 1, 1));
+  return out;
+}
+
+template <class Container1, class Container2, class T>
+tensor<T, 2> solve(const triangular_expr<Container1, T, 2> &a,
+                   const expression<Container2, T, 2> &b) {
+  if (a.offset() != 0) {
+    return solve(detail::row_major_copy(a), b);
+  }
+  detail::assert_square(a.shape());
+  detail::assert_aligned_shapes(a.shape(), 1, b.shape(), 0);
+  tensor<T, 2> out = detail::row_major_copy(b);
+  detail::triangular_solve(a, detail::make_strided_matrix(out));
+  return out;
+}
+
+template <class Container, class T, size_t Rank>
+tensor<T, Rank> inv(const expression<Container, T, Rank> &a) {
+  detail::assert_square(a.shape());
+  size_t count = detail::num_matrices(a.shape()), n = a.shape(Rank - 1);
+  tensor<T, Rank> buffer = detail::row_major_copy(a);
+  tensor<T, Rank> out(a.shape(), T(0), row_major);
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      out.data()[(i * n + j) * n + j] = T(1);
+    }
+  }
+  detail::solve_batch(buffer.data(), out.data(), count, n, n);
+  return out;
+}
+
+template <class Container, class T>
+std::pair<tensor<T, 2>, tensor<size_t, 1>>
+lu_factor(const expression<Container, T, 2> &a) {
+  tensor<T, 2> out(a, row_major);
+  tensor<size_t, 1> piv = lu_factor_inplace(out);
+  return std::make_pair(std::move(out), std::move(piv));
+}
+
+template <class Container, class T>
+tensor<size_t, 1> lu_factor_inplace(dense_tensor<Container, T, 2> &a) {
+  size_t m = a.shape(0), n = a.shape(1), k = std::min(m, n);
+  std::vector<size_t> ipiv(k);
+  detail::with_row_major(a.self(), [&](const detail::strided_matrix<T> &mat) {
+    detail::lu_factor(mat, ipiv.data());
+  });
+  tensor<size_t, 1> piv(m);
+  detail::row_swaps_to_permutation(ipiv.data(), k, piv.data(), m);
+  return piv;
+}
+
+template <class Container, class T>
+std::tuple<tensor<T, 2>, tensor<T, 2>, tensor<T, 2>>
+lu(const expression<Container, T, 2> &a) {
+  std::pair<tensor<T, 2>, tensor<size_t, 1>> factors = lu_factor(a);
+  const tensor<T, 2> &packed = factors.first;
+  const tensor<size_t, 1> &piv = factors.second;
+  size_t m = packed.shape(0), n = packed.shape(1), k = std::min(m, n);
+  tensor<T, 2> p(make_shape(m, m), T(0));
+  tensor<T, 2> l(make_shape(m, k), T(0)), u(make_shape(k, n), T(0));
+  for (size_t i = 0; i < m; ++i) {
+    p(piv[i], i) = T(1);
+    for (size_t j = 0; j < std::min(i, k); ++j) {
+      l(i, j) = packed(i, j);
+    }
+    if (i < k) {
+      l(i, i) = T(1);
+      for (size_t j = i; j < n; ++j) {
+        u(i, j) = packed(i, j);
+      }
+    }
+  }
+  return std::make_tuple(std::move(p), std::move(l), std::move(u));
+}
+
+template <class Container, class T>
+tensor<T, 2> cholesky(const expression<Container, T, 2> &a) {
+  detail::assert_square(a.shape());
+  tensor<T, 2> out(a, row_major);
+  cholesky_inplace(out);
+  return out;
+}
+
+template <class Container, class T, size_t Rank>
+tensor<T, Rank> cholesky(const expression<Container, T, Rank> &a) {
+  detail::assert_square(a.shape());
+  tensor<T, Rank> out = detail::row_major_copy(a);
+  detail::cholesky_batch(out.data(), detail::num_matrices(a.shape()),
+                         a.shape(Rank - 1));
+  return out;
+}
+
+template <class Container, class T>
+void cholesky_inplace(dense_tensor<Container, T, 2> &a) {
+  detail::assert_square(a.shape());
+  detail::with_row_major(a.self(), [](const detail::strided_matrix<T> &mat) {
+    detail::cholesky_factor(mat);
+  });
+}
+
+template <class Container, class T>
+std::pair<tensor<T, 2>, tensor<T, 1>>
+ldl(const expression<Container, T, 2> &a) {
+  detail::assert_square(a.shape());
+  tensor<T, 2> out(a, row_major);
+  tensor<T, 1> d = ldl_inplace(out);
+  return std::make_pair(std::move(out), std::move(d));
+}
+
+template <class Container, class T>
+tensor<T, 1> ldl_inplace(dense_tensor<Container, T, 2> &a) {
+  detail::assert_square(a.shape());
+  tensor<T, 1> d(a.shape(0));
+  detail::with_row_major(a.self(), [&](const detail::strided_matrix<T> &mat) {
+    detail::ldl_factor(mat, d.data());
+  });
+  return d;
+}
+
+template <class Container, class T>
+std::pair<tensor<typename detail::complex_traits<T>::value_type, 1>,
+          tensor<T, 2>>
+eigh(const expression<Container, T, 2> &a) {
+  return eigh(a, slice(a.shape(0)));
+}
+
+template <class Container, class T>
+std::pair<tensor<typename detail::complex_traits<T>::value_type, 1>,
+          tensor<T, 2>>
+eigh(const expression<Container, T, 2> &a, slice index) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  detail::eigen_subset<real_type> subset = {false, index, 0, 0};
+  return detail::hermitian_eigen(a, subset, true);
+}
+
+template <class Container, class T>
+std::pair<tensor<typename detail::complex_traits<T>::value_type, 1>,
+          tensor<T, 2>>
+eigh(const expression<Container, T, 2> &a,
+     typename detail::complex_traits<T>::value_type low,
+     typename detail::complex_traits<T>::value_type high) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  detail::eigen_subset<real_type> subset = {true, slice(), low, high};
+  return detail::hermitian_eigen(a, subset, true);
+}
+
+template <class Container, class T>
+tensor<typename detail::complex_traits<T>::value_type, 1>
+eigvalsh(const expression<Container, T, 2> &a) {
+  return eigvalsh(a, slice(a.shape(0)));
+}
+
+template <class Container, class T>
+tensor<typename detail::complex_traits<T>::value_type, 1>
+eigvalsh(const expression<Container, T, 2> &a, slice index) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  detail::eigen_subset<real_type> subset = {false, index, 0, 0};
+  return detail::hermitian_eigen(a, subset, false).first;
+}
+
+template <class Container, class T>
+tensor<typename detail::complex_traits<T>::value_type, 1>
+eigvalsh(const expression<Container, T, 2> &a,
+         typename detail::complex_traits<T>::value_type low,
+         typename detail::complex_traits<T>::value_type high) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  detail::eigen_subset<real_type> subset = {true, slice(), low, high};
+  return detail::hermitian_eigen(a, subset, false).first;
+}
+
+template <class Container, class T>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+svd(const expression<Container, T, 2> &a, bool full_matrices) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  tensor<T, 2> buffer = detail::row_major_copy(a);
+  std::vector<real_type> s;
+  tensor<T, 2> u, vh;
+  detail::singular_value_decomposition(buffer, s, &u, &vh, full_matrices);
+  return std::make_tuple(std::move(u),
+                         tensor<real_type, 1>(s.begin(), s.size()),
+                         std::move(vh));
+}
+
+template <class Container, class T>
+tensor<typename detail::complex_traits<T>::value_type, 1>
+svdvals(const expression<Container, T, 2> &a) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  tensor<T, 2> buffer = detail::row_major_copy(a);
+  std::vector<real_type> s;
+  detail::singular_value_decomposition<T>(buffer, s, NULL, NULL, false);
+  return tensor<real_type, 1>(s.begin(), s.size());
+}
+
+template <class Container, class T>
+tensor<T, 2> pinv(const expression<Container, T, 2> &a, double rcond) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  size_t m = a.shape(0), n = a.shape(1);
+  tensor<T, 2> buffer = detail::row_major_copy(a);
+  std::vector<real_type> s;
+  tensor<T, 2> u, vh;
+  detail::singular_value_decomposition(buffer, s, &u, &vh, false);
+  size_t rank = detail::singular_value_rank(s, rcond, m, n);
+  // pinv(a) = v * diag(1/s) * u^H, which is the solution for b = I.
+  tensor<T, 2> uh(rank, m), out(n, m);
+  for (size_t i = 0; i < rank; ++i) {
+    for (size_t j = 0; j < m; ++j) {
+      uh(i, j) = detail::conj_value(u(j, i));
+    }
+  }
+  tensor<T, 2> v(n, rank);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < rank; ++j) {
+      v(i, j) = detail::conj_value(vh(j, i)) / s[j];
+    }
+  }
+  detail::gemm<T>(T(1), detail::make_strided_matrix(v),
+                  detail::make_strided_matrix(uh), T(0),
+                  detail::make_strided_matrix(out));
+  return out;
+}
+
+template <class Container1, class Container2, class T>
+std::tuple<tensor<T, 1>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>, size_t,
+           tensor<typename detail::complex_traits<T>::value_type, 1>>
+lstsq(const expression<Container1, T, 2> &a,
+      const expression<Container2, T, 1> &b, double rcond) {
+  detail::assert_aligned_shapes(a.shape(), 0, b.shape(), 0);
+  tensor<T, 1> column = detail::row_major_copy(b);
+  tensor<T, 2> buffer(column.data(), b.size(), size_t(1));
+  auto out = detail::least_squares(a, buffer, rcond);
+  tensor<T, 2> &x = std::get<0>(out);
+  return std::make_tuple(tensor<T, 1>(x.data(), x.size()),
+                         std::move(std::get<1>(out)), std::get<2>(out),
+                         std::move(std::get<3>(out)));
+}
+
+template <class Container1, class Container2, class T>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>, size_t,
+           tensor<typename detail::complex_traits<T>::value_type, 1>>
+lstsq(const expression<Container1, T, 2> &a,
+      const expression<Container2, T, 2> &b, double rcond) {
+  detail::assert_aligned_shapes(a.shape(), 0, b.shape(), 0);
+  tensor<T, 2> buffer = detail::row_major_copy(b);
+  return detail::least_squares(a, buffer, rcond);
+}
+
+template <class Container, class T>
+tensor<T, 2> orth(const expression<Container, T, 2> &a, double rcond) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  size_t m = a.shape(0), n = a.shape(1);
+  tensor<T, 2> buffer = detail::row_major_copy(a);
+  std::vector<real_type> s;
+  tensor<T, 2> u, vh;
+  detail::singular_value_decomposition(buffer, s, &u, &vh, false);
+  size_t rank = detail::singular_value_rank(s, rcond, m, n);
+  tensor<T, 2> out(m, rank);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < rank; ++j) {
+      out(i, j) = u(i, j);
+    }
+  }
+  return out;
+}
+
+template <class Container, class T>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+randomized_svd(const expression<Container, T, 2> &a, size_t k,
+               size_t oversample, size_t n_iter) {
+  default_rng rng;
+  return randomized_svd(a, k, oversample, n_iter, rng);
+}
+
+template <class Container, class T, class bit_generator>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+randomized_svd(const expression<Container, T, 2> &a, size_t k,
+               size_t oversample, size_t n_iter,
+               Generator<bit_generator> &rng) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  size_t m = a.shape(0), n = a.shape(1);
+  tensor<T, 2> buffer;
+  detail::strided_matrix<const T> amat =
+      detail::make_matrix_operand(a.self(), buffer);
+  std::vector<real_type> s;
+  tensor<T, 2> u, vh;
+  detail::randomized_svd<T>(
+      m, n, std::max<size_t>(m, 1),
+      [&](size_t first, size_t count) {
+        return amat.block(first, 0, count, n);
+      },
+      k, oversample, n_iter, rng, s, u, vh);
+  return std::make_tuple(std::move(u),
+                         tensor<real_type, 1>(s.begin(), s.size()),
+                         std::move(vh));
+}
+
+template <class T, class Function>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+randomized_svd(const shape_t<2> &shape, Function &&read_rows, size_t k,
+               size_t oversample, size_t n_iter) {
+  default_rng rng;
+  return randomized_svd<T>(shape, std::forward<Function>(read_rows), k,
+                           oversample, n_iter, rng);
+}
+
+template <class T, class Function, class bit_generator>
+std::tuple<tensor<T, 2>,
+           tensor<typename detail::complex_traits<T>::value_type, 1>,
+           tensor<T, 2>>
+randomized_svd(const shape_t<2> &shape, Function &&read_rows, size_t k,
+               size_t oversample, size_t n_iter,
+               Generator<bit_generator> &rng) {
+  typedef typename detail::complex_traits<T>::value_type real_type;
+  size_t m = shape[0], n = shape[1];
+  size_t block = std::max<size_t>(1, detail::svd_stream_block_size /
+                                         std::max<size_t>(n, 1));
+  tensor<T, 2> buffer;
+  std::vector<real_type> s;
+  tensor<T, 2> u, vh;
+  detail::randomized_svd<T>(
+      m, n, block,
+      [&](size_t first, size_t count) -> detail::strided_matrix<const T> {
+        if (buffer.shape(0) != count || buffer.shape(1) != n) {
+          buffer = tensor<T, 2>(count, n);
+        }
+        read_rows(first, buffer);
+        return detail::make_strided_matrix(buffer);
+      },
+      k, oversample, n_iter, rng, s, u, vh);
+  return std::make_tuple(std::move(u),
+                         tensor<real_type, 1>(s.begin(), s.size()),
+                         std::move(vh));
+}
+
+template <class Operator, class T, class Preconditioner>
+typename detail::preconditioned_result<Preconditioner, T>::type
+cg(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+   const Preconditioner &m, double rtol, double atol, size_t maxiter) {
+  detail::assert_iterative_shape(a, b.size(), x.size());
+  return detail::conjugate_gradient(
+      a, b, x, m, rtol, atol, detail::iteration_limit(maxiter, b.size()));
+}
+
+template <class Operator, class T>
+convergence_info<typename detail::complex_traits<T>::value_type>
+cg(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x, double rtol,
+   double atol, size_t maxiter) {
+  return cg(a, b, x, detail::identity_preconditioner(), rtol, atol, maxiter);
+}
+
+template <class Operator, class T, class Preconditioner>
+typename detail::preconditioned_result<Preconditioner, T>::type
+minres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+       const Preconditioner &m, double rtol, double atol,
+       size_t maxiter) {
+  detail::assert_iterative_shape(a, b.size(), x.size());
+  return detail::minimal_residual(
+      a, b, x, m, rtol, atol, detail::iteration_limit(maxiter, b.size()));
+}
+
+template <class Operator, class T>
+convergence_info<typename detail::complex_traits<T>::value_type>
+minres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x, double rtol,
+       double atol, size_t maxiter) {
+  return minres(a, b, x, detail::identity_preconditioner(), rtol, atol,
+                maxiter);
+}
+
+template <class Operator, class T, class Preconditioner>
+typename detail::preconditioned_result<Preconditioner, T>::type
+gmres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+      const Preconditioner &m, double rtol, double atol, size_t restart,
+      size_t maxiter) {
+  detail::assert_iterative_shape(a, b.size(), x.size());
+  return detail::restarted_gmres(
+      a, b, x, m, restart, rtol, atol,
+      detail::iteration_limit(maxiter, b.size()));
+}
+
+template <class Operator, class T>
+convergence_info<typename detail::complex_traits<T>::value_type>
+gmres(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x, double rtol,
+      double atol, size_t restart, size_t maxiter) {
+  return gmres(a, b, x, detail::identity_preconditioner(), rtol, atol, restart,
+               maxiter);
+}
+
+template <class Operator, class T, class Preconditioner>
+typename detail::preconditioned_result<Preconditioner, T>::type
+bicgstab(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+         const Preconditioner &m, double rtol, double atol,
+         size_t maxiter) {
+  detail::assert_iterative_shape(a, b.size(), x.size());
+  return detail::biconjugate_gradient_stabilized(
+      a, b, x, m, rtol, atol, detail::iteration_limit(maxiter, b.size()));
+}
+
+template <class Operator, class T>
+convergence_info<typename detail::complex_traits<T>::value_type>
+bicgstab(const Operator &a, const tensor<T, 1> &b, tensor<T, 1> &x,
+         double rtol, double atol, size_t maxiter) {
+  return bicgstab(a, b, x, detail::identity_preconditioner(), rtol, atol,
+                  maxiter);
+}
 } // namespace linalg
 
 template <class Container, class T>
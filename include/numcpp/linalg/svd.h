@@ -0,0 +1,817 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/linalg/svd.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/linalg.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SVD_H_INCLUDED
+#define NUMCPP_SVD_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/linalg/blas.h"
+#include "numcpp/linalg/factorization.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Matrices with at least this many rows per column are reduced to
+ * triangular form by a QR factorization before the bidiagonalization.
+ */
+const double svd_qr_crossover = 1.6;
+
+/**
+ * @brief Generate a plane rotation such that [c s; -s c] * [f; g] = [r; 0].
+ */
+template <class T> void givens_rotation(T f, T g, T &c, T &s, T &r) {
+  if (g == T(0)) {
+    c = T(1);
+    s = T(0);
+    r = f;
+  } else if (f == T(0)) {
+    c = T(0);
+    s = T(1);
+    r = g;
+  } else {
+    r = std::hypot(f, g);
+    c = f / r;
+    s = g / r;
+    if (std::abs(f) > std::abs(g) && c < T(0)) {
+      c = -c;
+      s = -s;
+      r = -r;
+    }
+  }
+}
+
+/**
+ * @brief Compute the singular values of the 2 x 2 upper triangular matrix
+ * [f g; 0 h], avoiding overflow and unnecessary underflow.
+ */
+template <class T>
+void singular_values_2x2(T f, T g, T h, T &smin, T &smax) {
+  T fa = std::abs(f), ga = std::abs(g), ha = std::abs(h);
+  T fhmin = std::min(fa, ha), fhmax = std::max(fa, ha);
+  if (fhmin == T(0)) {
+    smin = T(0);
+    smax = (fhmax == T(0)) ? ga : std::hypot(fhmax, ga);
+  } else if (ga < fhmax) {
+    T as = T(1) + fhmin / fhmax, at = (fhmax - fhmin) / fhmax;
+    T au = (ga / fhmax) * (ga / fhmax);
+    T c = T(2) / (std::sqrt(as * as + au) + std::sqrt(at * at + au));
+    smin = fhmin * c;
+    smax = fhmax / c;
+  } else {
+    T au = fhmax / ga;
+    if (au == T(0)) {
+      smin = (fhmin * fhmax) / ga;
+      smax = ga;
+    } else {
+      T as = T(1) + fhmin / fhmax, at = (fhmax - fhmin) / fhmax;
+      T c = T(1) / (std::sqrt(T(1) + (as * au) * (as * au)) +
+                    std::sqrt(T(1) + (at * au) * (at * au)));
+      smin = T(2) * (fhmin * c) * au;
+      smax = ga / (c + c);
+    }
+  }
+}
+
+/**
+ * @brief Apply a sequence of plane rotations to the rows first, ...,
+ * first + k of a row-major matrix with @a cols columns. The j-th rotation
+ * acts on rows first + j and first + j + 1. The rotations are applied in
+ * increasing order if @a forward is true, and in decreasing order otherwise.
+ * The columns are split among the available threads.
+ */
+template <class T>
+void rotate_rows(T *a, size_t cols, size_t first, size_t k, const T *c,
+                 const T *s, bool forward) {
+  const size_t group = 8;
+  size_t groups = (cols + group - 1) / group;
+  size_t tasks = num_tasks(k * cols, groups);
+  parallel_for(tasks, [&](size_t task) {
+    size_t begin = block_begin(task, tasks, groups) * group;
+    size_t end = std::min(cols, block_begin(task + 1, tasks, groups) * group);
+    for (size_t i = 0; i < k; ++i) {
+      size_t j = forward ? i : k - 1 - i;
+      if (c[j] == T(1) && s[j] == T(0)) {
+        continue;
+      }
+      T *x = a + (first + j) * cols, *y = x + cols;
+      for (size_t p = begin; p < end; ++p) {
+        T tmp = y[p];
+        y[p] = c[j] * tmp - s[j] * x[p];
+        x[p] = s[j] * tmp + c[j] * x[p];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Compute the singular value decomposition of a real upper
+ * bidiagonal matrix, b = u * diag(d) * vt, by the implicit QR method with
+ * the zero shift of Demmel and Kahan.
+ *
+ * @details The singular values are computed to high relative accuracy. At
+ * each sweep, the bulge is chased in the direction of decreasing diagonal
+ * elements, and the shift is dropped when it would spoil the accuracy of the
+ * smallest singular value. The rotations are accumulated into the rows of
+ * @a vt and @a ut, so that each rotation streams through two contiguous rows.
+ *
+ * @param n Size of the matrix.
+ * @param d Diagonal of the matrix. It is overwritten with the singular
+ *          values in descending order.
+ * @param e Superdiagonal of the matrix, of size n - 1. It is destroyed.
+ * @param vt A row-major matrix of size n x ncvt. It is multiplied from the
+ *           left by the transpose of the right singular vectors.
+ * @param ut A row-major matrix of size n x nru. It is multiplied from the
+ *           left by the transpose of the left singular vectors.
+ *
+ * @throw std::runtime_error Thrown if the method fails to converge.
+ */
+template <class T>
+void bidiagonal_svd(size_t n, T *d, T *e, T *vt, size_t ncvt, T *ut,
+                    size_t nru) {
+  const T eps = std::numeric_limits<T>::epsilon() / T(2);
+  const T unfl = std::numeric_limits<T>::min();
+  const T tol =
+      std::max(T(10), std::min(T(100), std::pow(eps, T(-0.125)))) * eps;
+  if (n == 0) {
+    return;
+  }
+  ptrdiff_t last = n - 1;
+
+  // Threshold for the superdiagonal, relative to a bound on the smallest
+  // singular value.
+  T sminoa = std::abs(d[0]);
+  for (ptrdiff_t i = 1; i <= last && sminoa > T(0); ++i) {
+    T mu = std::abs(d[i]) * (sminoa / (sminoa + std::abs(e[i - 1])));
+    sminoa = std::min(sminoa, mu);
+  }
+  sminoa /= std::sqrt(T(n));
+  T thresh = std::max(tol * sminoa, T(6) * T(n) * T(n) * unfl);
+
+  std::vector<T> work(4 * n);
+  T *cs1 = work.data(), *sn1 = cs1 + n, *cs2 = sn1 + n, *sn2 = cs2 + n;
+  size_t maxit = 6 * n * n, iter = 0;
+  ptrdiff_t oldll = -1, oldm = -1, m = last;
+  bool top_down = true;
+  while (m > 0) {
+    if (iter > maxit) {
+      throw std::runtime_error(
+          "singular value computation did not converge");
+    }
+
+    // Find the unreduced block d[ll:m + 1].
+    T smax = std::abs(d[m]);
+    ptrdiff_t ll = m;
+    while (ll > 0) {
+      T abse = std::abs(e[ll - 1]);
+      if (abse <= thresh) {
+        e[ll - 1] = T(0);
+        break;
+      }
+      smax = std::max(smax, std::max(std::abs(d[ll - 1]), abse));
+      --ll;
+    }
+    if (ll == m) {
+      --m;
+      continue;
+    }
+
+    // Chase the bulge from the larger end of a new block to the smaller.
+    if (ll > oldm || m < oldll) {
+      top_down = std::abs(d[ll]) >= std::abs(d[m]);
+    }
+
+    // Convergence tests, which also give a bound on the smallest singular
+    // value of the block.
+    T sminl;
+    bool split = false;
+    if (top_down) {
+      if (std::abs(e[m - 1]) <= tol * std::abs(d[m])) {
+        e[m - 1] = T(0);
+        continue;
+      }
+      T mu = std::abs(d[ll]);
+      sminl = mu;
+      for (ptrdiff_t i = ll; i < m && !split; ++i) {
+        if (std::abs(e[i]) <= tol * mu) {
+          e[i] = T(0);
+          split = true;
+        }
+        mu = std::abs(d[i + 1]) * (mu / (mu + std::abs(e[i])));
+        sminl = std::min(sminl, mu);
+      }
+    } else {
+      if (std::abs(e[ll]) <= tol * std::abs(d[ll])) {
+        e[ll] = T(0);
+        continue;
+      }
+      T mu = std::abs(d[m]);
+      sminl = mu;
+      for (ptrdiff_t i = m - 1; i >= ll && !split; --i) {
+        if (std::abs(e[i]) <= tol * mu) {
+          e[i] = T(0);
+          split = true;
+        }
+        mu = std::abs(d[i]) * (mu / (mu + std::abs(e[i])));
+        sminl = std::min(sminl, mu);
+      }
+    }
+    if (split) {
+      continue;
+    }
+    oldll = ll;
+    oldm = m;
+
+    // Compute the shift from the trailing (or leading) 2 x 2 block. It is
+    // dropped if it would be negligible or would destroy the relative
+    // accuracy of the smallest singular value.
+    T shift = T(0), r;
+    if (T(n) * tol * (sminl / smax) > std::max(eps, T(0.01) * tol)) {
+      T sll;
+      if (top_down) {
+        sll = std::abs(d[ll]);
+        singular_values_2x2(d[m - 1], e[m - 1], d[m], shift, r);
+      } else {
+        sll = std::abs(d[m]);
+        singular_values_2x2(d[ll], e[ll], d[ll + 1], shift, r);
+      }
+      if (sll > T(0) && (shift / sll) * (shift / sll) < eps) {
+        shift = T(0);
+      }
+    }
+    iter += m - ll;
+
+    size_t k = m - ll;
+    if (shift == T(0) && top_down) {
+      T c = T(1), s = T(0), oldc = T(1), olds = T(0), h;
+      for (ptrdiff_t i = ll; i < m; ++i) {
+        givens_rotation(d[i] * c, e[i], c, s, r);
+        if (i > ll) {
+          e[i - 1] = olds * r;
+        }
+        givens_rotation(oldc * r, d[i + 1] * s, oldc, olds, d[i]);
+        cs1[i - ll] = c;
+        sn1[i - ll] = s;
+        cs2[i - ll] = oldc;
+        sn2[i - ll] = olds;
+      }
+      h = d[m] * c;
+      d[m] = h * oldc;
+      e[m - 1] = h * olds;
+      rotate_rows(vt, ncvt, ll, k, cs1, sn1, true);
+      rotate_rows(ut, nru, ll, k, cs2, sn2, true);
+      if (std::abs(e[m - 1]) <= thresh) {
+        e[m - 1] = T(0);
+      }
+    } else if (shift == T(0)) {
+      T c = T(1), s = T(0), oldc = T(1), olds = T(0), h;
+      for (ptrdiff_t i = m; i > ll; --i) {
+        givens_rotation(d[i] * c, e[i - 1], c, s, r);
+        if (i < m) {
+          e[i] = olds * r;
+        }
+        givens_rotation(oldc * r, d[i - 1] * s, oldc, olds, d[i]);
+        cs1[i - ll - 1] = c;
+        sn1[i - ll - 1] = -s;
+        cs2[i - ll - 1] = oldc;
+        sn2[i - ll - 1] = -olds;
+      }
+      h = d[ll] * c;
+      d[ll] = h * oldc;
+      e[ll] = h * olds;
+      rotate_rows(vt, ncvt, ll, k, cs2, sn2, false);
+      rotate_rows(ut, nru, ll, k, cs1, sn1, false);
+      if (std::abs(e[ll]) <= thresh) {
+        e[ll] = T(0);
+      }
+    } else if (top_down) {
+      T f = (std::abs(d[ll]) - shift) *
+            (std::copysign(T(1), d[ll]) + shift / d[ll]);
+      T g = e[ll];
+      for (ptrdiff_t i = ll; i < m; ++i) {
+        T cosr, sinr, cosl, sinl;
+        givens_rotation(f, g, cosr, sinr, r);
+        if (i > ll) {
+          e[i - 1] = r;
+        }
+        f = cosr * d[i] + sinr * e[i];
+        e[i] = cosr * e[i] - sinr * d[i];
+        g = sinr * d[i + 1];
+        d[i + 1] = cosr * d[i + 1];
+        givens_rotation(f, g, cosl, sinl, r);
+        d[i] = r;
+        f = cosl * e[i] + sinl * d[i + 1];
+        d[i + 1] = cosl * d[i + 1] - sinl * e[i];
+        if (i < m - 1) {
+          g = sinl * e[i + 1];
+          e[i + 1] = cosl * e[i + 1];
+        }
+        cs1[i - ll] = cosr;
+        sn1[i - ll] = sinr;
+        cs2[i - ll] = cosl;
+        sn2[i - ll] = sinl;
+      }
+      e[m - 1] = f;
+      rotate_rows(vt, ncvt, ll, k, cs1, sn1, true);
+      rotate_rows(ut, nru, ll, k, cs2, sn2, true);
+      if (std::abs(e[m - 1]) <= thresh) {
+        e[m - 1] = T(0);
+      }
+    } else {
+      T f = (std::abs(d[m]) - shift) *
+            (std::copysign(T(1), d[m]) + shift / d[m]);
+      T g = e[m - 1];
+      for (ptrdiff_t i = m; i > ll; --i) {
+        T cosr, sinr, cosl, sinl;
+        givens_rotation(f, g, cosr, sinr, r);
+        if (i < m) {
+          e[i] = r;
+        }
+        f = cosr * d[i] + sinr * e[i - 1];
+        e[i - 1] = cosr * e[i - 1] - sinr * d[i];
+        g = sinr * d[i - 1];
+        d[i - 1] = cosr * d[i - 1];
+        givens_rotation(f, g, cosl, sinl, r);
+        d[i] = r;
+        f = cosl * e[i - 1] + sinl * d[i - 1];
+        d[i - 1] = cosl * d[i - 1] - sinl * e[i - 1];
+        if (i > ll + 1) {
+          g = sinl * e[i - 2];
+          e[i - 2] = cosl * e[i - 2];
+        }
+        cs1[i - ll - 1] = cosr;
+        sn1[i - ll - 1] = -sinr;
+        cs2[i - ll - 1] = cosl;
+        sn2[i - ll - 1] = -sinl;
+      }
+      e[ll] = f;
+      rotate_rows(vt, ncvt, ll, k, cs2, sn2, false);
+      rotate_rows(ut, nru, ll, k, cs1, sn1, false);
+      if (std::abs(e[ll]) <= thresh) {
+        e[ll] = T(0);
+      }
+    }
+  }
+
+  // Make the singular values positive and sort them in descending order.
+  for (size_t i = 0; i < n; ++i) {
+    if (d[i] < T(0)) {
+      d[i] = -d[i];
+      for (size_t p = 0; p < ncvt; ++p) {
+        vt[i * ncvt + p] = -vt[i * ncvt + p];
+      }
+    }
+  }
+  for (size_t i = 0; i + 1 < n; ++i) {
+    size_t imax = i;
+    for (size_t j = i + 1; j < n; ++j) {
+      if (d[j] > d[imax]) {
+        imax = j;
+      }
+    }
+    if (imax != i) {
+      std::swap(d[i], d[imax]);
+      std::swap_ranges(vt + i * ncvt, vt + (i + 1) * ncvt, vt + imax * ncvt);
+      std::swap_ranges(ut + i * nru, ut + (i + 1) * nru, ut + imax * nru);
+    }
+  }
+}
+
+/**
+ * @brief Reduce a matrix with at least as many rows as columns to real upper
+ * bidiagonal form, a = q * b * p^H, by Householder reflections applied
+ * alternately from the left and from the right.
+ *
+ * @param a A matrix of size m x n, with m >= n and contiguous rows. It is
+ *          overwritten with the reflectors of q below the diagonal, stored
+ *          as in a QR factorization.
+ * @param d, e Pointers to arrays of size n and n - 1 where to store the
+ *             diagonal and the superdiagonal of b.
+ * @param tauq, taup Pointers to arrays of size n and n - 1 where to store the
+ *                   scalar factors of the reflectors of q and p.
+ * @param p A matrix of size n x n where to store the reflectors of p, such
+ *          that p = diag(1, p'), where p' is stored as in a QR factorization
+ *          in p(1:n, 0:n - 1). It may be empty if p is not required.
+ */
+template <class T>
+void bidiagonalize(const strided_matrix<T> &a,
+                   typename complex_traits<T>::value_type *d,
+                   typename complex_traits<T>::value_type *e, T *tauq,
+                   T *taup, const strided_matrix<T> &p) {
+  size_t m = a.rows, n = a.cols;
+  std::vector<T> w;
+  for (size_t i = 0; i < n; ++i) {
+    // Annihilate a(i + 1:m, i) from the left.
+    tauq[i] = householder(a.block(i, i, m - i, 1));
+    d[i] = std::real(a(i, i));
+    apply_householder<T>(a.block(i, i, m - i, 1), conj_value(tauq[i]),
+                         a.block(i, i + 1, m - i, n - i - 1), w);
+    if (i + 1 == n) {
+      break;
+    }
+
+    // Annihilate a(i, i + 2:n) from the right. The reflector is generated
+    // from the conjugate of the row, so that row * g = beta * e_1.
+    strided_matrix<T> x = a.block(i, i + 1, 1, n - i - 1).t();
+    for (size_t j = 0; j < x.rows; ++j) {
+      x(j, 0) = conj_value(x(j, 0));
+    }
+    T tau = householder(x);
+    taup[i] = tau;
+    e[i] = std::real(x(0, 0));
+    x(0, 0) = T(1);
+    if (p.rows > 0) {
+      for (size_t j = 1; j < x.rows; ++j) {
+        p(i + 1 + j, i) = x(j, 0);
+      }
+    }
+
+    // a(i + 1:m, i + 1:n) *= g, one row at a time.
+    if (tau != T(0)) {
+      for (size_t r = i + 1; r < m; ++r) {
+        T *row = &a(r, i + 1);
+        T val = T(0);
+        for (size_t j = 0; j < x.rows; ++j) {
+          val += row[j] * x(j, 0);
+        }
+        val *= tau;
+        for (size_t j = 0; j < x.rows; ++j) {
+          row[j] -= val * conj_value(x(j, 0));
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Compute the singular value decomposition of a matrix with at least
+ * as many rows as columns, a = u * diag(s) * vh.
+ *
+ * @details Matrices with many more rows than columns are first factorized
+ * as a = q * r, so that only the triangular factor is bidiagonalized. The
+ * bidiagonal matrix is then diagonalized by implicit QR sweeps, and the
+ * singular vectors are obtained by applying the reflectors of both
+ * reductions, in blocks, to the singular vectors of the bidiagonal matrix.
+ *
+ * @param a A matrix of size m x n, with m >= n and contiguous rows. It is
+ *          destroyed.
+ * @param s Pointer to an array of size n where to store the singular values
+ *          in descending order.
+ * @param u, vh Pointers to the matrices where to store the left singular
+ *              vectors, of size m x m if @a full is true and m x n
+ *              otherwise, and the conjugate transpose of the right singular
+ *              vectors, of size n x n. Null pointers if they are not
+ *              required.
+ */
+template <class T>
+void tall_svd(const strided_matrix<T> &a,
+              typename complex_traits<T>::value_type *s, tensor<T, 2> *u,
+              tensor<T, 2> *vh, bool full) {
+  typedef typename complex_traits<T>::value_type real_type;
+  size_t m = a.rows, n = a.cols;
+  bool vectors = (u != NULL);
+
+  // Reduce to triangular form.
+  bool use_qr = (n > 0 && m > n && m >= svd_qr_crossover * n);
+  std::vector<T> tau, t, rbuf;
+  strided_matrix<T> b = a;
+  if (use_qr) {
+    size_t rows = std::min(qr_block_size, n);
+    tau.resize(n);
+    t.resize(rows * n);
+    qr_factor(a, tau.data(), strided_matrix<T>(t.data(), rows, n, n, 1));
+    rbuf.assign(n * n, T(0));
+    b = strided_matrix<T>(rbuf.data(), n, n, n, 1);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = i; j < n; ++j) {
+        b(i, j) = a(i, j);
+      }
+    }
+  }
+
+  // Reduce to bidiagonal form.
+  std::vector<real_type> e(n);
+  std::vector<T> tauq(n), taup(n), pbuf;
+  if (vectors) {
+    pbuf.assign(n * n, T(0));
+  }
+  strided_matrix<T> pmat(pbuf.data(), vectors ? n : 0, n, n, 1);
+  bidiagonalize(b, s, e.data(), tauq.data(), taup.data(), pmat);
+
+  // Diagonalize the bidiagonal matrix.
+  std::vector<real_type> ut, vt;
+  if (vectors) {
+    ut.assign(n * n, real_type(0));
+    vt.assign(n * n, real_type(0));
+    for (size_t i = 0; i < n; ++i) {
+      ut[i * n + i] = vt[i * n + i] = real_type(1);
+    }
+  }
+  bidiagonal_svd(n, s, e.data(), vt.data(), vectors ? n : 0, ut.data(),
+                 vectors ? n : 0);
+  if (!vectors) {
+    return;
+  }
+
+  // u = q * [ub 0; 0 I], where ub is the transpose of ut.
+  size_t ucols = full ? m : n;
+  *u = tensor<T, 2>(m, ucols);
+  std::fill_n(u->data(), m * ucols, T(0));
+  strided_matrix<T> umat = make_strided_matrix(*u);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      umat(i, j) = ut[j * n + i];
+    }
+  }
+  for (size_t j = n; j < ucols; ++j) {
+    umat(j, j) = T(1);
+  }
+  if (use_qr) {
+    householder_multiply<T>(b, tauq.data(), false, umat.block(0, 0, n, n));
+    qr_multiply<T>(a, strided_matrix<T>(t.data(), t.size() / n, n, n, 1),
+                   false, umat);
+  } else {
+    householder_multiply<T>(b, tauq.data(), false, umat);
+  }
+
+  // vh = (p * vb)^H = vb^H * p^H, where vb is the transpose of vt.
+  std::vector<T> vbuf(n * n);
+  strided_matrix<T> vmat(vbuf.data(), n, n, n, 1);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      vmat(i, j) = vt[j * n + i];
+    }
+  }
+  if (n > 1) {
+    householder_multiply<T>(pmat.block(1, 0, n - 1, n - 1), taup.data(),
+                            false, vmat.block(1, 0, n - 1, n));
+  }
+  *vh = tensor<T, 2>(n, n);
+  strided_matrix<T> vhmat = make_strided_matrix(*vh);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      vhmat(i, j) = conj_value(vmat(j, i));
+    }
+  }
+}
+
+/**
+ * @brief Compute the singular value decomposition of a matrix with more
+ * columns than rows through its conjugate transpose.
+ */
+template <class T>
+void wide_svd(tensor<T, 2> &a, typename complex_traits<T>::value_type *s,
+              tensor<T, 2> *u, tensor<T, 2> *vh, bool full) {
+  size_t m = a.shape(0), n = a.shape(1);
+  tensor<T, 2> ah(n, m);
+  strided_matrix<T> amat = make_strided_matrix(a);
+  strided_matrix<T> ahmat = make_strided_matrix(ah);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < m; ++j) {
+      ahmat(i, j) = conj_value(amat(j, i));
+    }
+  }
+  a = tensor<T, 2>();
+  if (u == NULL) {
+    tall_svd(ahmat, s, u, vh, full);
+    return;
+  }
+
+  // a^H = u' * diag(s) * vh', so that a = vh'^H * diag(s) * u'^H.
+  tensor<T, 2> u1, vh1;
+  tall_svd(ahmat, s, &u1, &vh1, full);
+  *u = tensor<T, 2>(m, m);
+  *vh = tensor<T, 2>(u1.shape(1), n);
+  strided_matrix<T> umat = make_strided_matrix(*u);
+  strided_matrix<T> vhmat = make_strided_matrix(*vh);
+  strided_matrix<T> u1mat = make_strided_matrix(u1);
+  strided_matrix<T> vh1mat = make_strided_matrix(vh1);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < m; ++j) {
+      umat(i, j) = conj_value(vh1mat(j, i));
+    }
+  }
+  for (size_t i = 0; i < vhmat.rows; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      vhmat(i, j) = conj_value(u1mat(j, i));
+    }
+  }
+}
+
+/**
+ * @brief Compute the singular value decomposition of a matrix,
+ * a = u * diag(s) * vh. Matrices with more columns than rows are
+ * decomposed through their conjugate transpose. If an external LAPACK is
+ * enabled, the decomposition is computed by it instead.
+ *
+ * @param a A row-major matrix of size m x n. It is destroyed.
+ * @param s A vector of size min(m, n) where to store the singular values in
+ *          descending order.
+ * @param u, vh Pointers to the matrices where to store the singular vectors,
+ *              or null pointers if they are not required. If @a full is
+ *              true, u and vh are square. Otherwise, they have min(m, n)
+ *              columns and rows, respectively.
+ */
+template <class T>
+void singular_value_decomposition(
+    tensor<T, 2> &a, std::vector<typename complex_traits<T>::value_type> &s,
+    tensor<T, 2> *u, tensor<T, 2> *vh, bool full) {
+  typedef typename complex_traits<T>::value_type real_type;
+  const real_type eps = std::numeric_limits<real_type>::epsilon();
+  size_t m = a.shape(0), n = a.shape(1);
+  s.resize(std::min(m, n));
+  if (external_svd(a, s, u, vh, full)) {
+    return;
+  }
+
+  // Scale the matrix if its norm is too small or too large.
+  real_type anorm = real_type(0), scale = real_type(1);
+  for (size_t i = 0; i < a.size(); ++i) {
+    anorm = std::max(anorm, real_type(std::abs(a.data()[i])));
+  }
+  real_type rmin = std::sqrt(std::numeric_limits<real_type>::min()) / eps;
+  real_type rmax = real_type(1) / rmin;
+  if (anorm > real_type(0) && anorm < rmin) {
+    scale = rmin / anorm;
+  } else if (anorm > rmax) {
+    scale = rmax / anorm;
+  }
+  if (scale != real_type(1)) {
+    for (size_t i = 0; i < a.size(); ++i) {
+      a.data()[i] *= scale;
+    }
+  }
+
+  if (m >= n) {
+    tall_svd(make_strided_matrix(a), s.data(), u, vh, full);
+  } else {
+    wide_svd(a, s.data(), u, vh, full);
+  }
+  for (size_t i = 0; i < s.size(); ++i) {
+    s[i] /= scale;
+  }
+}
+
+/**
+ * @brief Number of elements in the blocks of rows read at a time by the
+ * streaming randomized SVD.
+ */
+const size_t svd_stream_block_size = 1 << 20;
+
+/**
+ * @brief Fill an array with samples from a standard normal distribution.
+ * Complex samples have independent real and imaginary parts.
+ */
+template <class T, class Random>
+void fill_standard_normal(T *first, size_t n, Random &rng) {
+  for (size_t i = 0; i < n; ++i) {
+    first[i] = rng.template standard_normal<T>();
+  }
+}
+
+template <class T, class Random>
+void fill_standard_normal(std::complex<T> *first, size_t n, Random &rng) {
+  for (size_t i = 0; i < n; ++i) {
+    T re = rng.template standard_normal<T>();
+    T im = rng.template standard_normal<T>();
+    first[i] = std::complex<T>(re, im);
+  }
+}
+
+/**
+ * @brief Replace the columns of a matrix, with at least as many rows as
+ * columns, by an orthonormal basis for their span.
+ */
+template <class T> void orthonormalize(tensor<T, 2> &y) {
+  size_t m = y.shape(0), l = y.shape(1), rows = std::min(qr_block_size, l);
+  std::vector<T> tau(l), t(rows * l);
+  strided_matrix<T> ymat = make_strided_matrix(y);
+  strided_matrix<T> tmat(t.data(), rows, l, l, 1);
+  qr_factor(ymat, tau.data(), tmat);
+  tensor<T, 2> q(m, l);
+  std::fill_n(q.data(), m * l, T(0));
+  for (size_t i = 0; i < l; ++i) {
+    q(i, i) = T(1);
+  }
+  qr_multiply<T>(ymat, tmat, false, make_strided_matrix(q));
+  y = std::move(q);
+}
+
+/**
+ * @brief Compute an approximate truncated singular value decomposition by
+ * the randomized range finder of Halko, Martinsson and Tropp.
+ *
+ * @details The range of the matrix is sampled by its product with a Gaussian
+ * matrix of k + oversample columns, refined by @a n_iter power iterations
+ * with orthonormalization after every product. The matrix is then projected
+ * onto the sampled range and the small projection is decomposed directly.
+ * The matrix is only accessed through 2 * n_iter + 2 passes over its rows,
+ * in blocks, each pass computing either a * x or y^H * a.
+ *
+ * @param m, n Size of the matrix.
+ * @param block Number of rows per block.
+ * @param rows A function such that rows(first, count) returns a strided
+ *             reference to count rows of the matrix starting at row first.
+ * @param k Number of singular triplets to compute.
+ * @param rng A random number generator.
+ */
+template <class T, class Rows, class Random>
+void randomized_svd(size_t m, size_t n, size_t block, Rows &&rows, size_t k,
+                    size_t oversample, size_t n_iter, Random &rng,
+                    std::vector<typename complex_traits<T>::value_type> &s,
+                    tensor<T, 2> &u, tensor<T, 2> &vh) {
+  size_t l = std::min(k + oversample, std::min(m, n));
+  if (k > std::min(m, n)) {
+    throw std::invalid_argument(
+        "number of singular values exceeds the dimensions of the matrix");
+  }
+
+  // y = a * x, one block of rows at a time.
+  auto multiply = [&](const tensor<T, 2> &x, tensor<T, 2> &y) {
+    strided_matrix<T> ymat = make_strided_matrix(y);
+    for (size_t i = 0; i < m; i += block) {
+      size_t count = std::min(block, m - i);
+      gemm<T>(T(1), rows(i, count), make_strided_matrix(x), T(0),
+              ymat.block(i, 0, count, l));
+    }
+  };
+  // w = y^H * a, accumulated over the blocks of rows.
+  auto adjoint_multiply = [&](const tensor<T, 2> &y, tensor<T, 2> &w) {
+    std::vector<T> yh;
+    strided_matrix<T> wmat = make_strided_matrix(w);
+    std::fill_n(w.data(), l * n, T(0));
+    for (size_t i = 0; i < m; i += block) {
+      size_t count = std::min(block, m - i);
+      yh.resize(l * count);
+      strided_matrix<T> yhmat(yh.data(), l, count, count, 1);
+      for (size_t r = 0; r < count; ++r) {
+        for (size_t c = 0; c < l; ++c) {
+          yhmat(c, r) = conj_value(y(i + r, c));
+        }
+      }
+      gemm<T>(T(1), yhmat, rows(i, count), T(1), wmat);
+    }
+  };
+
+  tensor<T, 2> x(n, l), y(m, l), w(l, n);
+  fill_standard_normal(x.data(), n * l, rng);
+  multiply(x, y);
+  for (size_t iter = 0; iter < n_iter; ++iter) {
+    orthonormalize(y);
+    adjoint_multiply(y, w);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < l; ++j) {
+        x(i, j) = conj_value(w(j, i));
+      }
+    }
+    orthonormalize(x);
+    multiply(x, y);
+  }
+  orthonormalize(y);
+
+  // a ~ y * (y^H * a) = (y * ub) * diag(s) * vh.
+  adjoint_multiply(y, w);
+  tensor<T, 2> ub, vb;
+  singular_value_decomposition(w, s, &ub, &vb, false);
+  s.resize(k);
+  u = tensor<T, 2>(m, k);
+  gemm<T>(T(1), make_strided_matrix(y),
+          make_strided_matrix(ub).block(0, 0, l, k), T(0),
+          make_strided_matrix(u));
+  vh = tensor<T, 2>(k, n);
+  strided_matrix<T> vhmat = make_strided_matrix(vh);
+  for (size_t i = 0; i < k; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      vhmat(i, j) = vb(i, j);
+    }
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_SVD_H_INCLUDED
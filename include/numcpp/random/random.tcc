@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <numeric>
 #include "numcpp/iterators/axes_iterator.h"
+#include "numcpp/routines/sorting.h"
 
 namespace numcpp {
 /// Constructors.
@@ -352,15 +353,11 @@ template <class bit_generator>
 template <class Container, class T, size_t Rank>
 void Generator<bit_generator>::shuffle(dense_tensor<Container, T, Rank> &a,
                                        size_t axis) {
-  shape_t<Rank> shape = a.shape();
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    typedef axes_iterator<Container, T, Rank, 1> iterator;
-    iterator first(&a.self(), index, axis, 0);
-    iterator last(&a.self(), index, axis, size);
-    std::shuffle(first, last, m_rng);
-  }
+  // The lanes are shuffled in order by this thread, so that the result only
+  // depends on the state of the generator.
+  detail::transform_lanes(
+      a, axis, [&](T *first, T *last) { std::shuffle(first, last, m_rng); },
+      false);
 }
 
 template <class bit_generator>
@@ -23,11 +23,15 @@
 #ifndef NUMCPP_ROUTINES_H_INCLUDED
 #define NUMCPP_ROUTINES_H_INCLUDED
 
+#include <tuple>
 #include "numcpp/config.h"
 #include "numcpp/routines/ranges.h"
 #include "numcpp/routines/new.h"
 #include "numcpp/routines/ternary_op.h"
 #include "numcpp/routines/rearrange.h"
+#include "numcpp/routines/summary.h"
+#include "numcpp/routines/quantile_sketch.h"
+#include "numcpp/routines/search_tree.h"
 
 namespace numcpp {
 /// Tensor creation routines.
@@ -292,7 +296,7 @@ geomspace(const T &start, const U &stop, size_t num = 50, bool endpoint = true);
  *         object is returned with ones on the diagonal and zeros elsewhere.
  */
 template <class T = double> identity_expr<T> eye(size_t n) {
-  return eye<T>(n, n);
+  return identity_expr<T>({n, n});
 }
 
 template <class T = double>
@@ -1017,6 +1021,12 @@ bool allclose(const typename Container::value_type &val,
 /**
  * @brief Return the indices that would sort the tensor.
  *
+ * @details If T is a 32 or 64-bit integer or floating point type and the
+ * elements are sorted in ascending order with the default comparator, a radix
+ * sort is used instead of a comparison sort. The radix sort is always stable,
+ * and NaN values are sorted last. Otherwise, a parallel merge sort is used, so
+ * the comparator may be called concurrently from several threads.
+ *
  * @param a Tensor-like object to sort.
  * @param comp Custom comparator. A binary function that accepts two elements of
  *             type T as arguments, and returns a value convertible to bool. The
@@ -1044,6 +1054,13 @@ tensor<index_t<Rank>, 1> argsort(const expression<Container, T, Rank> &a,
 /**
  * @brief Return the indices that would sort the tensor along the given axis.
  *
+ * @details If T is a 32 or 64-bit integer or floating point type and the
+ * elements are sorted in ascending order with the default comparator, a radix
+ * sort is used instead of a comparison sort. The radix sort is always stable,
+ * and NaN values are sorted last. The lanes along the axis are distributed
+ * among the available threads, so the comparator may be called concurrently
+ * from several threads.
+ *
  * @param a Tensor-like object to sort.
  * @param axis Axis along which to sort.
  * @param comp Custom comparator. A binary function that accepts two elements of
@@ -1071,9 +1088,55 @@ template <class Container, class T, size_t Rank, class Compare,
 tensor<size_t, Rank> argsort(const expression<Container, T, Rank> &a,
                              size_t axis, Compare comp, bool stable = false);
 
+/**
+ * @brief Return the flat indices that would sort the tensor.
+ *
+ * @details Unlike @c argsort, which returns a tuple of indices for each
+ * element, the flat indices take a single integer per element. The values are
+ * copied into a contiguous buffer and sorted together with their positions,
+ * so the comparisons never compute a multi-dimensional index. If the
+ * multi-dimensional indices are needed, @c unravel_index(indices,a.shape(),
+ * a.layout()) computes them lazily.
+ *
+ * @tparam Index Integer type of the indices. Defaults to size_t. A smaller
+ *               type, e.g., uint32_t, can be used to save memory if it can
+ *               represent all the positions in the tensor.
+ *
+ * @param a Tensor-like object to sort.
+ * @param comp Custom comparator. A binary function that accepts two elements of
+ *             type T as arguments, and returns a value convertible to bool. The
+ *             value returned indicates whether the element passed as first
+ *             argument is considered to go before the second.
+ * @param stable If true, preserve the relative order of the elements with
+ *               equivalent values. Otherwise, equivalent elements are not
+ *               guaranteed to keep their original relative order.
+ *
+ * @return A 1-dimensional tensor of indices into the flattened tensor, i.e.,
+ *         positions of the elements in the order given by @c a.layout(), that
+ *         sort the tensor.
+ *
+ * @throw std::invalid_argument Thrown if @a Index can't represent all the
+ *                              positions in the tensor.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Index = size_t, class Container, class T, size_t Rank>
+tensor<Index, 1> flatargsort(const expression<Container, T, Rank> &a);
+
+template <class Index = size_t, class Container, class T, size_t Rank,
+          class Compare, detail::RequiresCallable<Compare, T, T> = 0>
+tensor<Index, 1> flatargsort(const expression<Container, T, Rank> &a,
+                             Compare comp, bool stable = false);
+
 /**
  * @brief Return a sorted copy of the flattened tensor.
  *
+ * @details If T is a 32 or 64-bit integer or floating point type and the
+ * elements are sorted in ascending order with the default comparator, a radix
+ * sort is used instead of a comparison sort. The radix sort is always stable,
+ * and NaN values are sorted last. Otherwise, a parallel merge sort is used, so
+ * the comparator may be called concurrently from several threads.
+ *
  * @param a Tensor-like object to sort.
  * @param comp Custom comparator. A binary function that accepts two elements of
  *             type T as arguments, and returns a value convertible to bool. The
@@ -1099,6 +1162,13 @@ tensor<T, 1> sort(const expression<Container, T, Rank> &a, Compare comp,
 /**
  * @brief Return a sorted copy of the tensor along the given axis.
  *
+ * @details If T is a 32 or 64-bit integer or floating point type and the
+ * elements are sorted in ascending order with the default comparator, a radix
+ * sort is used instead of a comparison sort. The radix sort is always stable,
+ * and NaN values are sorted last. The lanes along the axis are distributed
+ * among the available threads, so the comparator may be called concurrently
+ * from several threads.
+ *
  * @param a Tensor-like object to sort.
  * @param axis Axis along which to sort.
  * @param comp Custom comparator. A binary function that accepts two elements of
@@ -1156,6 +1226,9 @@ tensor<index_t<Rank>, 1> argpartition(const expression<Container, T, Rank> &a,
  * @brief Return the indices that would partition the tensor along the given
  * axis.
  *
+ * @details The lanes along the axis are distributed among the available
+ * threads, so the comparator may be called concurrently from several threads.
+ *
  * @param a Tensor-like object to partition.
  * @param kth Element index to partition by. The element at the @a kth position
  *            is the element that would be in that position in the sorted
@@ -1185,6 +1258,44 @@ template <class Container, class T, size_t Rank, class Compare,
 tensor<size_t, Rank> argpartition(const expression<Container, T, Rank> &a,
                                   size_t kth, size_t axis, Compare comp);
 
+/**
+ * @brief Return the flat indices that would partition the tensor.
+ *
+ * @details The values are copied into a contiguous buffer and partitioned
+ * together with their positions. If the multi-dimensional indices are needed,
+ * @c unravel_index(indices,a.shape(),a.layout()) computes them lazily.
+ *
+ * @tparam Index Integer type of the indices. Defaults to size_t.
+ *
+ * @param a Tensor-like object to partition.
+ * @param kth Element index to partition by. The element at the @a kth position
+ *            is the element that would be in that position in the sorted
+ *            tensor. The other elements are left without any specific order,
+ *            except that none of the elements preceding @a kth are greater than
+ *            it, and none of the elements following it are less.
+ * @param comp Custom comparator. A binary function that accepts two elements of
+ *             type T as arguments, and returns a value convertible to bool. The
+ *             value returned indicates whether the element passed as first
+ *             argument is considered to go before the second.
+ *
+ * @return A 1-dimensional tensor of indices into the flattened tensor, i.e.,
+ *         positions of the elements in the order given by @c a.layout(), that
+ *         partition the tensor.
+ *
+ * @throw std::invalid_argument Thrown if @a Index can't represent all the
+ *                              positions in the tensor.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Index = size_t, class Container, class T, size_t Rank>
+tensor<Index, 1> flatargpartition(const expression<Container, T, Rank> &a,
+                                  size_t kth);
+
+template <class Index = size_t, class Container, class T, size_t Rank,
+          class Compare, detail::RequiresCallable<Compare, T, T> = 0>
+tensor<Index, 1> flatargpartition(const expression<Container, T, Rank> &a,
+                                  size_t kth, Compare comp);
+
 /**
  * @brief Return a partitioned copy of the flattened tensor.
  *
@@ -1215,6 +1326,9 @@ tensor<T, 1> partition(const expression<Container, T, Rank> &a, size_t kth,
 /**
  * @brief Return a partitioned copy of the tensor along the given axis.
  *
+ * @details The lanes along the axis are distributed among the available
+ * threads, so the comparator may be called concurrently from several threads.
+ *
  * @param a Tensor-like object to partition.
  * @param kth Element index to partition by. The element at the @a kth position
  *            is the element that would be in that position in the sorted
@@ -1241,6 +1355,92 @@ template <class Container, class T, size_t Rank, class Compare,
 tensor<T, Rank> partition(const expression<Container, T, Rank> &a, size_t kth,
                           size_t axis, Compare comp);
 
+/**
+ * @brief Return the k largest (or smallest) elements along the given axis.
+ *
+ * @details The tensor is not fully sorted. For small @a k, each lane is
+ * streamed through a bounded heap holding the best elements seen so far.
+ * Otherwise, the lane is partitioned with nth_element and, if requested, only
+ * the first @a k elements are sorted. Lanes along non-contiguous axes are
+ * staged into contiguous buffers, and lanes are processed in parallel. Equal
+ * elements are selected in order of position.
+ *
+ * @param a Tensor-like object to select from.
+ * @param k Number of elements to select.
+ * @param axis Axis along which to select.
+ * @param largest If true, select the largest elements. Otherwise, select the
+ *                smallest elements. Default is true.
+ * @param sorted If true, the selected elements are returned in order, i.e.,
+ *               in descending order if @a largest is true, and in ascending
+ *               order otherwise. If false, their order is unspecified. Default
+ *               is true.
+ *
+ * @return A new tensor with the same shape as @a a, except along @a axis,
+ *         whose length is @a k.
+ *
+ * @throw std::invalid_argument Thrown if @a k is greater than the size of the
+ *                              axis.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T, size_t Rank>
+tensor<T, Rank> topk(const expression<Container, T, Rank> &a, size_t k,
+                     size_t axis, bool largest = true, bool sorted = true);
+
+/**
+ * @brief Return the indices of the k largest (or smallest) elements along the
+ * given axis.
+ *
+ * @param a Tensor-like object to select from.
+ * @param k Number of elements to select.
+ * @param axis Axis along which to select.
+ * @param largest If true, select the largest elements. Otherwise, select the
+ *                smallest elements. Default is true.
+ * @param sorted If true, the indices are returned in the order of their
+ *               elements. If false, their order is unspecified. Default is
+ *               true.
+ *
+ * @return A tensor of indices with the same shape as @a a, except along
+ *         @a axis, whose length is @a k. If @a indices is the returned tensor
+ *         of indices for @a a, then @c take_along_axis(a,indices,axis) yields
+ *         the same as @c topk(a,k,axis,largest,sorted).
+ *
+ * @throw std::invalid_argument Thrown if @a k is greater than the size of the
+ *                              axis.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T, size_t Rank>
+tensor<size_t, Rank> argtopk(const expression<Container, T, Rank> &a, size_t k,
+                             size_t axis, bool largest = true,
+                             bool sorted = true);
+
+/**
+ * @brief Find the indices into a sorted tensor such that, if the elements of
+ * @a v were inserted before the indices, the order would be preserved.
+ *
+ * @details Each query uses a branchless binary search, and several queries are
+ * searched together so that their memory accesses overlap. Queries are
+ * distributed among the available threads. To search repeatedly in the same
+ * sorted tensor, see also search_tree.
+ *
+ * @param a A 1-dimensional tensor-like object sorted in ascending order.
+ * @param v A tensor-like object with the values to insert into @a a.
+ * @param side If "left", the index of the first suitable location is returned,
+ *             i.e., a[i-1] < v <= a[i]. If "right", return the last such
+ *             index, i.e., a[i-1] <= v < a[i]. Default is "left".
+ *
+ * @return A new tensor of insertion points with the same shape as @a v.
+ *
+ * @throw std::invalid_argument Thrown if @a side is not "left" or "right".
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, class Container2, size_t Rank>
+tensor<size_t, Rank> searchsorted(const expression<Container1, T, 1> &a,
+                                  const expression<Container2, T, Rank> &v,
+                                  const std::string &side = "left");
+
 /**
  * @brief Return the indices of the elements that are non-zero.
  *
@@ -1255,6 +1455,29 @@ tensor<T, Rank> partition(const expression<Container, T, Rank> &a, size_t kth,
 template <class Container, class T, size_t Rank>
 tensor<index_t<Rank>, 1> nonzero(const expression<Container, T, Rank> &a);
 
+/**
+ * @brief Return the flat indices of the elements that are non-zero.
+ *
+ * @details The elements are scanned in parallel. If the multi-dimensional
+ * indices are needed, @c unravel_index(indices,a.shape(),a.layout()) computes
+ * them lazily.
+ *
+ * @tparam Index Integer type of the indices. Defaults to size_t.
+ *
+ * @param a A tensor-like object.
+ *
+ * @return A 1-dimensional tensor with the indices into the flattened tensor,
+ *         i.e., positions in the order given by @c a.layout(), of the elements
+ *         that are non-zero.
+ *
+ * @throw std::invalid_argument Thrown if @a Index can't represent all the
+ *                              positions in the tensor.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Index = size_t, class Container, class T, size_t Rank>
+tensor<Index, 1> flatnonzero(const expression<Container, T, Rank> &a);
+
 /**
  * @brief Return elements chosen from two tensors depending on @a condition.
  * When only @a condition is provided, this function is equivalent to
@@ -1374,6 +1597,11 @@ rotate(const expression<Container, T, Rank> &a, const index_t<N> &shift,
 /**
  * @brief Find the sorted unique elements of a tensor.
  *
+ * @details If the elements are already sorted, the unique elements are found
+ * in a single pass. Otherwise, integer tensors with few unique elements
+ * compared to their size are deduplicated with a hash table, which takes
+ * linear time, and any other tensor is sorted. Both methods run in parallel.
+ *
  * @param a A tensor-like object.
  *
  * @return A new tensor with the sorted unique elements of @a a.
@@ -1388,6 +1616,36 @@ rotate(const expression<Container, T, Rank> &a, const index_t<N> &shift,
 template <class Container, class T, size_t Rank>
 tensor<T, 1> unique(const expression<Container, T, Rank> &a);
 
+/**
+ * @brief Find the sorted unique elements of a tensor, together with the
+ * positions of their first occurrences, the position of each element among
+ * the unique elements and the number of times each one appears.
+ *
+ * @param a A tensor-like object.
+ * @param return_index If true, also return the flat index of the first
+ *                     occurrence of each unique element, i.e., its position in
+ *                     the order given by @c a.layout().
+ * @param return_inverse If true, also return the indices of the unique
+ *                       elements that reconstruct @a a.
+ * @param return_counts If true, also return the number of times each unique
+ *                      element appears in @a a.
+ *
+ * @return A tuple of tensors. The first one contains the sorted unique
+ *         elements of @a a. The second one, the flat indices of the first
+ *         occurrences. The third one has the same shape as @a a and contains
+ *         the position among the unique elements of each element in @a a. The
+ *         fourth one contains the counts. The outputs which are not requested
+ *         are empty.
+ *
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T, size_t Rank>
+std::tuple<tensor<T, 1>, tensor<size_t, 1>, tensor<size_t, Rank>,
+           tensor<size_t, 1>>
+unique(const expression<Container, T, Rank> &a, bool return_index,
+       bool return_inverse = false, bool return_counts = false);
+
 /**
  * @brief Test whether a value is present in a tensor.
  *
@@ -1405,11 +1663,12 @@ bool contains(const expression<Container, T, 1> &a,
  * @brief Test whether all the elements in a tensor are also present in another
  * tensor.
  *
+ * @details The unique elements of both tensors are found as in @c unique and
+ * then compared in a single pass.
+ *
  * @param a A 1-dimensional tensor-like object. This function test whether @a b
- *          contains all the elements of @a a. The elements in @a a must be
- *          sorted.
- * @param b A 1-dimensional tensor-like object. The elements in @a b must be
- *          sorted.
+ *          contains all the elements of @a a.
+ * @param b A 1-dimensional tensor-like object.
  *
  * @return true if @a a is a subset of @a b and false otherwise.
  */
@@ -1421,10 +1680,11 @@ bool is_subset(const expression<Container1, T, 1> &a,
  * @brief Find the set union of two tensors. Return the unique sorted elements
  * that are present in either one of two tensors, or in both.
  *
- * @param a A 1-dimensional tensor-like object. The elements in @a a must be
- *          sorted.
- * @param b A 1-dimensional tensor-like object. The elements in @a b must be
- *          sorted.
+ * @details The unique elements of both tensors are found as in @c unique and
+ * then merged in a single pass.
+ *
+ * @param a A 1-dimensional tensor-like object.
+ * @param b A 1-dimensional tensor-like object.
  *
  * @return A new tensor with the set union of both tensors.
  *
@@ -1439,10 +1699,11 @@ tensor<T, 1> set_union(const expression<Container1, T, 1> &a,
  * @brief Find the set intersection of two tensors. Return the unique sorted
  * elements that are present in both tensors.
  *
- * @param a A 1-dimensional tensor-like object. The elements in @a a must be
- *          sorted.
- * @param b A 1-dimensional tensor-like object. The elements in @a b must be
- *          sorted.
+ * @details The unique elements of both tensors are found as in @c unique and
+ * then merged in a single pass.
+ *
+ * @param a A 1-dimensional tensor-like object.
+ * @param b A 1-dimensional tensor-like object.
  *
  * @return A new tensor with the set intersection of both tensors.
  *
@@ -1457,10 +1718,11 @@ tensor<T, 1> set_intersection(const expression<Container1, T, 1> &a,
  * @brief Find the set difference of two tensors. Return the unique sorted
  * elements that are present in the first tensor, but not in the second.
  *
- * @param a A 1-dimensional tensor-like object. The elements in @a a must be
- *          sorted.
- * @param b A 1-dimensional tensor-like object. The elements in @a b must be
- *          sorted.
+ * @details The unique elements of both tensors are found as in @c unique and
+ * then merged in a single pass.
+ *
+ * @param a A 1-dimensional tensor-like object.
+ * @param b A 1-dimensional tensor-like object.
  *
  * @return A new tensor with the set difference of both tensors.
  *
@@ -1475,10 +1737,11 @@ tensor<T, 1> set_difference(const expression<Container1, T, 1> &a,
  * @brief Find the set symmetric difference of two tensors. Return the unique
  * sorted elements that are present in one of the tensors, but not in the other.
  *
- * @param a A 1-dimensional tensor-like object. The elements in @a a must be
- *          sorted.
- * @param b A 1-dimensional tensor-like object. The elements in @a b must be
- *          sorted.
+ * @details The unique elements of both tensors are found as in @c unique and
+ * then merged in a single pass.
+ *
+ * @param a A 1-dimensional tensor-like object.
+ * @param b A 1-dimensional tensor-like object.
  *
  * @return A new tensor with the set symmetric difference of both tensors.
  *
@@ -1670,6 +1933,55 @@ template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> stddev(const expression<Container, T, Rank> &a,
                            const shape_t<N> &axes, bool bias, dropdims_t);
 
+/**
+ * @brief Return descriptive statistics of the tensor elements.
+ *
+ * @details The number of elements, the number of non-zero elements, the
+ * minimum, the maximum, the mean and the variance are all computed in a single
+ * pass over the tensor. Large tensors are split into blocks which are
+ * summarized in parallel and then merged in a fixed order, so the result does
+ * not depend on the number of threads.
+ *
+ * @param a A tensor-like object.
+ *
+ * @return A @c summary_t object with the statistics of the tensor elements.
+ *
+ * @throw std::invalid_argument Thrown if the tensor is empty.
+ */
+template <class Container, class T, size_t Rank>
+summary_t<T> describe(const expression<Container, T, Rank> &a);
+
+/**
+ * @brief Return descriptive statistics of the tensor elements over the given
+ * axes.
+ *
+ * @param a A tensor-like object.
+ * @param axes A @c shape_t object with the axes along which the statistics are
+ *             computed.
+ * @param keepdims If set to @a keepdims, the axes which are reduced are left as
+ *                 dimensions with size one. If set to @a dropdims, the axes
+ *                 which are reduced are dropped. Defaults to @a dropdims.
+ *
+ * @return A new tensor of @c summary_t objects with the statistics over the
+ *         given axes.
+ *
+ * @throw std::invalid_argument Thrown if the statistics are computed over an
+ *                              empty axis.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T, size_t Rank, size_t N>
+tensor<summary_t<T>, Rank - N> describe(const expression<Container, T, Rank> &a,
+                                        const shape_t<N> &axes);
+
+template <class Container, class T, size_t Rank, size_t N>
+tensor<summary_t<T>, Rank> describe(const expression<Container, T, Rank> &a,
+                                    const shape_t<N> &axes, keepdims_t);
+
+template <class Container, class T, size_t Rank, size_t N>
+tensor<summary_t<T>, Rank - N> describe(const expression<Container, T, Rank> &a,
+                                        const shape_t<N> &axes, dropdims_t);
+
 /**
  * @brief Return the q-th quantile of the tensor elements.
  *
@@ -1729,6 +2041,101 @@ tensor<T, Rank - N> quantile(const expression<Container, T, Rank> &a, double q,
                              const shape_t<N> &axes, const std::string &method,
                              dropdims_t);
 
+/**
+ * @brief Return several quantiles of the tensor elements at once.
+ *
+ * @details All the order statistics required by the quantiles are found with
+ * a single selection pass over a copy of the tensor.
+ *
+ * @param a A tensor-like object.
+ * @param q A 1-dimensional tensor with the quantiles to compute, which must be
+ *          between 0 and 1 (inclusive).
+ * @param method This parameter specifies the method to use for estimating the
+ *               quantiles. Must be one of "lower", "higher", "nearest",
+ *               "midpoint" or "linear".
+ *
+ * @return A new tensor with the i-th quantile at position i.
+ *
+ * @throw std::invalid_argument Thrown if the tensor is empty.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, size_t Rank, class Container2>
+tensor<T, 1> quantile(const expression<Container1, T, Rank> &a,
+                      const expression<Container2, double, 1> &q,
+                      const std::string &method = "linear");
+
+/**
+ * @brief Return several quantiles of the tensor elements over the given axes
+ * at once.
+ *
+ * @param a A tensor-like object.
+ * @param q A 1-dimensional tensor with the quantiles to compute, which must be
+ *          between 0 and 1 (inclusive).
+ * @param axes A @c shape_t object with the axes along which the quantiles are
+ *             computed.
+ * @param method This parameter specifies the method to use for estimating the
+ *               quantiles. Must be one of "lower", "higher", "nearest",
+ *               "midpoint" or "linear".
+ * @param keepdims If set to @a keepdims, the axes which are reduced are left as
+ *                 dimensions with size one. If set to @a dropdims, the axes
+ *                 which are reduced are dropped. Defaults to @a dropdims.
+ *
+ * @return A new tensor with the quantiles over the given axes. The first axis
+ *         of the result corresponds to the quantiles and the remaining axes to
+ *         the axes of @a a that are not reduced.
+ *
+ * @throw std::invalid_argument Thrown if the quantiles are computed over an
+ *                              empty axis.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, size_t Rank, class Container2, size_t N>
+tensor<T, Rank - N + 1> quantile(const expression<Container1, T, Rank> &a,
+                                 const expression<Container2, double, 1> &q,
+                                 const shape_t<N> &axes,
+                                 const std::string &method = "linear");
+
+template <class Container1, class T, size_t Rank, class Container2, size_t N>
+tensor<T, Rank + 1> quantile(const expression<Container1, T, Rank> &a,
+                             const expression<Container2, double, 1> &q,
+                             const shape_t<N> &axes, const std::string &method,
+                             keepdims_t);
+
+template <class Container1, class T, size_t Rank, class Container2, size_t N>
+tensor<T, Rank - N + 1> quantile(const expression<Container1, T, Rank> &a,
+                                 const expression<Container2, double, 1> &q,
+                                 const shape_t<N> &axes,
+                                 const std::string &method, dropdims_t);
+
+/**
+ * @brief Group values by key and compute a statistic of each group.
+ *
+ * @details Sorted keys are reduced run by run, and unsorted keys are reduced
+ * into per-block hash tables which are merged at the end. In both cases, the
+ * groups are reduced in parallel and the result does not depend on the number
+ * of threads.
+ *
+ * @param keys A 1-dimensional tensor-like object with the key of each element.
+ *             The keys must be hashable and totally ordered.
+ * @param values A 1-dimensional tensor-like object with the values to reduce.
+ * @param op Statistic to compute for each group. Must be one of "sum",
+ *           "mean", "min", "max" or "count".
+ *
+ * @return A pair of tensors. The first one contains the distinct keys in
+ *         ascending order and the second one the statistic of each group.
+ *
+ * @throw std::invalid_argument Thrown if @a keys and @a values have different
+ *                              sizes or if @a op is not a valid statistic.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class Key, class Container2, class T>
+std::pair<tensor<Key, 1>, tensor<T, 1>>
+groupby_reduce(const expression<Container1, Key, 1> &keys,
+               const expression<Container2, T, 1> &values,
+               const std::string &op);
+
 /**
  * @brief Return the covariance of two 1-dimensional tensors.
  *
@@ -1823,6 +2230,259 @@ T corrcoef(const expression<Container1, T, 1> &x,
  */
 template <class Container, class T>
 tensor<T, 2> corrcoef(const expression<Container, T, 2> &a, bool rowvar = true);
+
+/// Histograms.
+
+/**
+ * @brief Count the number of occurrences of each value in a tensor of
+ * non-negative integers.
+ *
+ * @details The counts are accumulated in parallel into separate arrays of bins
+ * which are added at the end.
+ *
+ * @param x A 1-dimensional tensor-like object of non-negative integers.
+ * @param minlength A minimum number of bins for the output. Default is 0.
+ *
+ * @return A new tensor whose i-th element is the number of occurrences of
+ *         @a i in @a x. Its size is the maximum of @a minlength and
+ *         max(x) + 1.
+ *
+ * @throw std::invalid_argument Thrown if @a x contains negative values.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T>
+tensor<size_t, 1> bincount(const expression<Container, T, 1> &x,
+                           size_t minlength = 0);
+
+/**
+ * @brief Return the sum of the weights of each value in a tensor of
+ * non-negative integers.
+ *
+ * @param x A 1-dimensional tensor-like object of non-negative integers.
+ * @param weights A 1-dimensional tensor-like object with the weight of each
+ *                element in @a x.
+ * @param minlength A minimum number of bins for the output. Default is 0.
+ *
+ * @return A new tensor whose i-th element is the sum of the weights of the
+ *         occurrences of @a i in @a x.
+ *
+ * @throw std::invalid_argument Thrown if @a x contains negative values or if
+ *                              @a x and @a weights have different sizes.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, class Container2, class W>
+tensor<W, 1> bincount(const expression<Container1, T, 1> &x,
+                      const expression<Container2, W, 1> &weights,
+                      size_t minlength = 0);
+
+/**
+ * @brief Return the indices of the bins to which each value belongs.
+ *
+ * @details If @a bins is increasing, the returned index i satisfies
+ * bins[i-1] <= x < bins[i] if @a right is false, and bins[i-1] < x <= bins[i]
+ * otherwise. If @a bins is decreasing, the inequalities are reversed. Values
+ * beyond the bins are given the index 0 or bins.size(), respectively.
+ *
+ * @param x A tensor-like object with the values to bin.
+ * @param bins A 1-dimensional tensor-like object with the edges of the bins.
+ *             It must be monotonically increasing or decreasing.
+ * @param right Whether the bins include their right edge instead of their left
+ *              edge. Default is false.
+ *
+ * @return A new tensor of indices with the same shape as @a x.
+ *
+ * @throw std::invalid_argument Thrown if @a bins is not monotonic.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, size_t Rank, class Container2>
+tensor<size_t, Rank> digitize(const expression<Container1, T, Rank> &x,
+                              const expression<Container2, T, 1> &bins,
+                              bool right = false);
+
+/**
+ * @brief Compute the histogram of the tensor elements.
+ *
+ * @details Every bin is a half-open interval [edges[i], edges[i + 1]), except
+ * the last one, which also includes its right edge. Values outside the edges
+ * are ignored. If the bins have the same width, the bin of each element is
+ * computed by arithmetic. Otherwise, it is found by binary search. The counts
+ * are accumulated in parallel into separate arrays of bins which are added at
+ * the end.
+ *
+ * @param a A tensor-like object with the values to count.
+ * @param bins Number of bins of the same width. Default is 10.
+ * @param first Left edge of the first bin. If not provided, the minimum of
+ *              @a a is used.
+ * @param last Right edge of the last bin. If not provided, the maximum of
+ *             @a a is used.
+ *
+ * @return A new tensor with the number of elements in each bin.
+ *
+ * @throw std::invalid_argument Thrown if @a bins is zero or if @a first is
+ *                              greater than @a last.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container, class T, size_t Rank>
+tensor<size_t, 1> histogram(const expression<Container, T, Rank> &a,
+                            size_t bins = 10);
+
+template <class Container, class T, size_t Rank>
+tensor<size_t, 1> histogram(const expression<Container, T, Rank> &a,
+                            size_t bins, double first, double last);
+
+/**
+ * @brief Compute the histogram of the tensor elements.
+ *
+ * @param a A tensor-like object with the values to count.
+ * @param edges A 1-dimensional tensor-like object with the edges of the bins.
+ *              It must be monotonically increasing.
+ *
+ * @return A new tensor with the number of elements in each bin.
+ *
+ * @throw std::invalid_argument Thrown if @a edges has less than two elements
+ *                              or is not monotonically increasing.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, size_t Rank, class Container2, class U>
+tensor<size_t, 1> histogram(const expression<Container1, T, Rank> &a,
+                            const expression<Container2, U, 1> &edges);
+
+/**
+ * @brief Compute the weighted histogram of the tensor elements.
+ *
+ * @param a A tensor-like object with the values to count.
+ * @param bins Number of bins of the same width.
+ * @param first Left edge of the first bin.
+ * @param last Right edge of the last bin.
+ * @param weights A tensor-like object with the weight of each element in
+ *                @a a.
+ *
+ * @return A new tensor with the sum of the weights of the elements in each
+ *         bin.
+ *
+ * @throw std::invalid_argument Thrown if @a bins is zero, if @a first is
+ *                              greater than @a last or if @a a and @a weights
+ *                              have different shapes.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, size_t Rank, class Container2, class W>
+tensor<W, 1> histogram(const expression<Container1, T, Rank> &a, size_t bins,
+                       double first, double last,
+                       const expression<Container2, W, Rank> &weights);
+
+/**
+ * @brief Compute the weighted histogram of the tensor elements.
+ *
+ * @param a A tensor-like object with the values to count.
+ * @param edges A 1-dimensional tensor-like object with the edges of the bins.
+ *              It must be monotonically increasing.
+ * @param weights A tensor-like object with the weight of each element in
+ *                @a a.
+ *
+ * @return A new tensor with the sum of the weights of the elements in each
+ *         bin.
+ *
+ * @throw std::invalid_argument Thrown if @a edges has less than two elements
+ *                              or is not monotonically increasing, or if @a a
+ *                              and @a weights have different shapes.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, size_t Rank, class Container2, class U,
+          class Container3, class W>
+tensor<W, 1> histogram(const expression<Container1, T, Rank> &a,
+                       const expression<Container2, U, 1> &edges,
+                       const expression<Container3, W, Rank> &weights);
+
+/**
+ * @brief Compute the bi-dimensional histogram of two data samples.
+ *
+ * @param x A 1-dimensional tensor-like object with the x coordinates of the
+ *          points.
+ * @param y A 1-dimensional tensor-like object with the y coordinates of the
+ *          points.
+ * @param bins Number of bins of the same width along each dimension, spanning
+ *             from the minimum to the maximum of each coordinate. Default is
+ *             10.
+ *
+ * @return A new tensor whose element at @a (i,j) is the number of points in
+ *         the i-th bin along x and the j-th bin along y.
+ *
+ * @throw std::invalid_argument Thrown if @a bins is zero or if @a x and @a y
+ *                              have different sizes.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, class Container2>
+tensor<size_t, 2> histogram2d(const expression<Container1, T, 1> &x,
+                              const expression<Container2, T, 1> &y,
+                              size_t bins = 10);
+
+/**
+ * @brief Compute the bi-dimensional histogram of two data samples.
+ *
+ * @param x A 1-dimensional tensor-like object with the x coordinates of the
+ *          points.
+ * @param y A 1-dimensional tensor-like object with the y coordinates of the
+ *          points.
+ * @param xedges A 1-dimensional tensor-like object with the edges of the bins
+ *               along x. It must be monotonically increasing.
+ * @param yedges A 1-dimensional tensor-like object with the edges of the bins
+ *               along y. It must be monotonically increasing.
+ *
+ * @return A new tensor whose element at @a (i,j) is the number of points in
+ *         the i-th bin along x and the j-th bin along y.
+ *
+ * @throw std::invalid_argument Thrown if any of the edges has less than two
+ *                              elements or is not monotonically increasing, or
+ *                              if @a x and @a y have different sizes.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, class Container2, class Container3,
+          class U, class Container4>
+tensor<size_t, 2> histogram2d(const expression<Container1, T, 1> &x,
+                              const expression<Container2, T, 1> &y,
+                              const expression<Container3, U, 1> &xedges,
+                              const expression<Container4, U, 1> &yedges);
+
+/**
+ * @brief Compute the weighted bi-dimensional histogram of two data samples.
+ *
+ * @param x A 1-dimensional tensor-like object with the x coordinates of the
+ *          points.
+ * @param y A 1-dimensional tensor-like object with the y coordinates of the
+ *          points.
+ * @param xedges A 1-dimensional tensor-like object with the edges of the bins
+ *               along x. It must be monotonically increasing.
+ * @param yedges A 1-dimensional tensor-like object with the edges of the bins
+ *               along y. It must be monotonically increasing.
+ * @param weights A 1-dimensional tensor-like object with the weight of each
+ *                point.
+ *
+ * @return A new tensor whose element at @a (i,j) is the sum of the weights of
+ *         the points in the i-th bin along x and the j-th bin along y.
+ *
+ * @throw std::invalid_argument Thrown if any of the edges has less than two
+ *                              elements or is not monotonically increasing, or
+ *                              if @a x, @a y and @a weights have different
+ *                              sizes.
+ * @throw std::bad_alloc If the function fails to allocate storage it may throw
+ *                       an exception.
+ */
+template <class Container1, class T, class Container2, class Container3,
+          class U, class Container4, class Container5, class W>
+tensor<W, 2> histogram2d(const expression<Container1, T, 1> &x,
+                         const expression<Container2, T, 1> &y,
+                         const expression<Container3, U, 1> &xedges,
+                         const expression<Container4, U, 1> &yedges,
+                         const expression<Container5, W, 1> &weights);
 } // namespace numcpp
 
 #include "numcpp/routines/routines.tcc"
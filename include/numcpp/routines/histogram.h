@@ -0,0 +1,300 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/histogram.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_HISTOGRAM_H_INCLUDED
+#define NUMCPP_HISTOGRAM_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Locates the bin of a value given the edges of the bins. Every bin is
+ * a half-open interval [edges[i], edges[i + 1]), except the last one, which
+ * also includes its right edge.
+ *
+ * @details If the bins have the same width, the bin is computed by arithmetic
+ * and then corrected by at most one position by comparing against the edges,
+ * so that the result is the same as the one from a binary search. Otherwise,
+ * the bin is found by a branchless binary search.
+ */
+class bin_locator {
+public:
+  /**
+   * @brief Constructs a locator for bins of the same width.
+   *
+   * @param bins Number of bins. Must be positive.
+   * @param first Left edge of the first bin.
+   * @param last Right edge of the last bin.
+   *
+   * @throw std::invalid_argument Thrown if @a bins is zero or if the range is
+   *                              not finite or @a first is greater than
+   *                              @a last.
+   */
+  bin_locator(size_t bins, double first, double last) {
+    if (bins == 0) {
+      throw std::invalid_argument("number of bins must be positive");
+    }
+    if (!(std::isfinite(first) && std::isfinite(last))) {
+      std::ostringstream error;
+      error << "range of [" << first << ", " << last << "] is not finite";
+      throw std::invalid_argument(error.str());
+    }
+    if (first > last) {
+      throw std::invalid_argument("max must be larger than min in range");
+    }
+    if (first == last) {
+      first -= 0.5;
+      last += 0.5;
+    }
+    m_edges.resize(bins + 1);
+    double width = (last - first) / bins;
+    for (size_t i = 0; i < bins; ++i) {
+      m_edges[i] = first + i * width;
+    }
+    m_edges[bins] = last;
+    m_scale = bins / (last - first);
+    m_uniform = true;
+  }
+
+  /**
+   * @brief Constructs a locator for the given edges.
+   *
+   * @param edges Pointer to the edges of the bins.
+   * @param size Number of edges. Must be at least 2.
+   *
+   * @throw std::invalid_argument Thrown if there are less than two edges or if
+   *                              the edges are not monotonically increasing.
+   */
+  template <class T> bin_locator(const T *edges, size_t size) {
+    if (size < 2) {
+      throw std::invalid_argument("bins must contain at least two edges");
+    }
+    m_edges.assign(edges, edges + size);
+    for (size_t i = 1; i < size; ++i) {
+      if (!(m_edges[i - 1] <= m_edges[i])) {
+        throw std::invalid_argument("bins must increase monotonically");
+      }
+    }
+    // Use the arithmetic path only if it is off by at most one bin.
+    size_t bins = size - 1;
+    double first = m_edges[0], last = m_edges[bins];
+    double width = (last - first) / bins;
+    m_uniform = (width > 0 && std::isfinite(width));
+    for (size_t i = 1; i < bins && m_uniform; ++i) {
+      m_uniform = std::abs(m_edges[i] - (first + i * width)) <= 1e-9 * width;
+    }
+    m_scale = m_uniform ? bins / (last - first) : 0;
+  }
+
+  /**
+   * @brief Return the number of bins.
+   */
+  size_t size() const { return m_edges.size() - 1; }
+
+  /**
+   * @brief Return the bin containing a value, or size() if the value is
+   * outside the edges or is NaN.
+   */
+  size_t operator()(double val) const {
+    size_t bins = m_edges.size() - 1;
+    const double *edges = m_edges.data();
+    if (!(edges[0] <= val && val <= edges[bins])) {
+      return bins;
+    }
+    size_t i;
+    if (m_uniform) {
+      i = std::min(size_t((val - edges[0]) * m_scale), bins - 1);
+      i -= (val < edges[i]);
+      i += (i + 1 < bins && edges[i + 1] <= val);
+    } else {
+      const double *base = edges;
+      size_t n = bins + 1;
+      while (n > 1) {
+        size_t half = n / 2;
+        base += (base[half] <= val) ? half : 0;
+        n -= half;
+      }
+      i = std::min(size_t(base - edges), bins - 1);
+    }
+    return i;
+  }
+
+private:
+  // Edges of the bins.
+  std::vector<double> m_edges;
+
+  // Number of bins per unit, if all the bins have the same width.
+  double m_scale;
+
+  // Whether all the bins have the same width.
+  bool m_uniform;
+};
+
+/**
+ * @brief Return the minimum and maximum of a sequence as a range for a
+ * histogram. An empty sequence gives the range [0, 1].
+ */
+template <class T>
+void histogram_range(const T *data, size_t size, double &first, double &last) {
+  first = 0;
+  last = 1;
+  if (size > 0) {
+    first = last = data[0];
+    for (size_t i = 1; i < size; ++i) {
+      double val = data[i];
+      first = (val < first) ? val : first;
+      last = (last < val) ? val : last;
+    }
+  }
+}
+
+/**
+ * @brief Return the number of bins needed to count a sequence of non-negative
+ * integers.
+ *
+ * @throw std::invalid_argument Thrown if the sequence contains negative values.
+ */
+template <class T>
+size_t bincount_size(const T *data, size_t size, size_t minlength) {
+  size_t nbins = minlength;
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] < T(0)) {
+      throw std::invalid_argument("bincount requires non-negative values");
+    }
+    nbins = std::max<size_t>(nbins, size_t(data[i]) + 1);
+  }
+  return nbins;
+}
+
+/**
+ * @brief Maximum number of blocks in which the elements are split to fill a
+ * histogram. Each block fills its own array of bins and the arrays are added
+ * in block order, so the result doesn't depend on the number of threads.
+ */
+const size_t histogram_max_blocks = 64;
+
+/**
+ * @brief Fill the bins of the elements in [first, last).
+ */
+template <class Locate, class W>
+void fill_bins(Locate &locate, size_t first, size_t last, const W *weights,
+               size_t nbins, W *out) {
+  if (weights == NULL) {
+    for (size_t i = first; i < last; ++i) {
+      size_t bin = locate(i);
+      if (bin < nbins) {
+        out[bin] += W(1);
+      }
+    }
+  } else {
+    for (size_t i = first; i < last; ++i) {
+      size_t bin = locate(i);
+      if (bin < nbins) {
+        out[bin] += weights[i];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Fill a histogram.
+ *
+ * @details The elements are split into blocks, each block fills its own array
+ * of bins in parallel and the arrays are added at the end. The number of
+ * blocks is limited so that the partial arrays never take more memory than the
+ * input.
+ *
+ * @param locate A function taking the position of an element and returning its
+ *               bin, or a value greater than or equal to @a nbins if the
+ *               element must be ignored.
+ * @param size Number of elements.
+ * @param weights Pointer to the weight of each element. If NULL, each element
+ *                has a weight of 1.
+ * @param nbins Number of bins.
+ * @param out Pointer to the bins.
+ */
+template <class Locate, class W>
+void histogram_fill(Locate locate, size_t size, const W *weights, size_t nbins,
+                    W *out) {
+  std::fill_n(out, nbins, W(0));
+  size_t nblocks = std::min(histogram_max_blocks, size / parallel_grain_size);
+  nblocks = std::min(nblocks, size / std::max<size_t>(nbins, 1));
+  if (nblocks <= 1) {
+    fill_bins(locate, 0, size, weights, nbins, out);
+    return;
+  }
+  std::vector<std::vector<W>> partial(nblocks);
+  parallel_for(nblocks, [&](size_t b) {
+    partial[b].assign(nbins, W(0));
+    fill_bins(locate, block_begin(b, nblocks, size),
+              block_begin(b + 1, nblocks, size), weights, nbins,
+              partial[b].data());
+  });
+  size_t tasks = num_tasks(nblocks * nbins, nbins);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, nbins);
+    size_t last = block_begin(task + 1, tasks, nbins);
+    for (size_t b = 0; b < nblocks; ++b) {
+      for (size_t i = first; i < last; ++i) {
+        out[i] += partial[b][i];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Fill a histogram of a sequence with the bins of a locator.
+ */
+template <class T, class W>
+void histogram1d_fill(const T *data, size_t size, const bin_locator &locate,
+                      const W *weights, W *out) {
+  histogram_fill([&](size_t i) { return locate(data[i]); }, size, weights,
+                 locate.size(), out);
+}
+
+/**
+ * @brief Fill a bi-dimensional histogram. The bins are stored in row-major
+ * order.
+ */
+template <class T, class W>
+void histogram2d_fill(const T *x, const T *y, size_t size,
+                      const bin_locator &xlocate, const bin_locator &ylocate,
+                      const W *weights, W *out) {
+  size_t nx = xlocate.size(), ny = ylocate.size();
+  histogram_fill(
+      [&](size_t i) {
+        size_t row = xlocate(x[i]), col = ylocate(y[i]);
+        return (row < nx && col < ny) ? row * ny + col : nx * ny;
+      },
+      size, weights, nx * ny, out);
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_HISTOGRAM_H_INCLUDED
@@ -395,6 +395,11 @@ public:
    * @brief Return the memory layout in which elements are stored.
    */
   layout_t layout() const { return default_layout; }
+
+  /**
+   * @brief Return the offset of the diagonal from the main diagonal.
+   */
+  difference_type offset() const { return m_offset; }
 };
 
 /**
@@ -547,6 +552,16 @@ public:
    * @brief Return the memory layout in which elements are stored.
    */
   layout_t layout() const { return m_arg.layout(); }
+
+  /**
+   * @brief Return the tensor whose elements are referenced.
+   */
+  const Container &base() const { return m_arg; }
+
+  /**
+   * @brief Return the offset of the diagonal from the main diagonal.
+   */
+  difference_type offset() const { return m_offset; }
 };
 
 /**
@@ -680,6 +695,16 @@ public:
    * @brief Return the memory layout in which elements are stored.
    */
   layout_t layout() const { return default_layout; }
+
+  /**
+   * @brief Return the tensor whose elements are referenced.
+   */
+  const Container &base() const { return m_arg; }
+
+  /**
+   * @brief Return the offset of the diagonal from the main diagonal.
+   */
+  difference_type offset() const { return m_offset; }
 };
 
 /**
@@ -825,6 +850,22 @@ public:
    * @brief Return the memory layout in which elements are stored.
    */
   layout_t layout() const { return m_arg.layout(); }
+
+  /**
+   * @brief Return the tensor whose elements are referenced.
+   */
+  const Container &base() const { return m_arg; }
+
+  /**
+   * @brief Return whether the expression is the lower triangle (true) or the
+   * upper triangle (false) of the referenced tensor.
+   */
+  bool lower() const { return m_lower; }
+
+  /**
+   * @brief Return the offset of the diagonal from the main diagonal.
+   */
+  difference_type offset() const { return m_offset; }
 };
 } // namespace numcpp
 
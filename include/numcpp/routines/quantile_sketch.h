@@ -0,0 +1,212 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/quantile_sketch.h
+ *  This header defines the quantile_sketch class used to estimate quantiles of
+ *  data streams.
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_QUANTILE_SKETCH_H_INCLUDED
+#define NUMCPP_QUANTILE_SKETCH_H_INCLUDED
+
+#include <cstdint>
+#include <iosfwd>
+#include <utility>
+#include <vector>
+
+namespace numcpp {
+/**
+ * @brief A quantile_sketch object summarizes a stream of values in a small,
+ * bounded amount of memory and answers approximate quantile and rank queries.
+ * Values can be added one at a time or by whole tensors, and the sketches of
+ * different parts of a stream can be merged, for example, when each part is
+ * processed by a different thread or process.
+ *
+ * @details The sketch is a KLL sketch (Karnin, Lang and Liberty, 2016). Values
+ * are stored in a hierarchy of buffers, where each value stored at level h
+ * represents 2^h values of the stream. When a buffer is full, it is sorted and
+ * every other value is promoted to the next level. The number of retained
+ * values grows only logarithmically with the number of values in the stream.
+ *
+ * @tparam T Type of the values. It must be a totally ordered type.
+ */
+template <class T> class quantile_sketch {
+public:
+  /// Member types.
+  typedef T value_type;
+  typedef size_t size_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Constructs an empty sketch.
+   *
+   * @param k Parameter controlling the size and the accuracy of the sketch.
+   *          The normalized rank error is roughly inversely proportional to
+   *          @a k. Must be at least 8. Defaults to 200, which gives an error of
+   *          about 1.3% with 99% confidence.
+   *
+   * @throw std::invalid_argument Thrown if @a k is less than 8.
+   */
+  explicit quantile_sketch(size_t k = 200);
+
+  /// Public methods.
+
+  /**
+   * @brief Update the sketch with a new value.
+   *
+   * @param val Value to add.
+   */
+  void update(const T &val);
+
+  /**
+   * @brief Update the sketch with the elements of a tensor.
+   *
+   * @param a A tensor-like object with the values to add.
+   */
+  template <class Container, size_t Rank>
+  void update(const expression<Container, T, Rank> &a);
+
+  /**
+   * @brief Update the sketch with the values summarized by another sketch.
+   * If the sketches have a different @a k, the smallest one is kept.
+   *
+   * @param other Sketch to merge.
+   */
+  void merge(const quantile_sketch &other);
+
+  /**
+   * @brief Return the parameter @a k of the sketch.
+   */
+  size_t k() const;
+
+  /**
+   * @brief Return the number of values in the stream.
+   */
+  size_t count() const;
+
+  /**
+   * @brief Return whether the sketch is empty.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Return the number of values retained by the sketch.
+   */
+  size_t num_retained() const;
+
+  /**
+   * @brief Return the approximate normalized rank error of the sketch with 99%
+   * confidence.
+   */
+  double epsilon() const;
+
+  /**
+   * @brief Return the minimum and maximum values of the stream. These are
+   * exact.
+   *
+   * @throw std::invalid_argument Thrown if the sketch is empty.
+   */
+  T min() const;
+  T max() const;
+
+  /**
+   * @brief Return the approximate fraction of values in the stream that are
+   * less than or equal to a given value.
+   *
+   * @param val Value to query.
+   *
+   * @throw std::invalid_argument Thrown if the sketch is empty.
+   */
+  double rank(const T &val) const;
+
+  /**
+   * @brief Return an approximate q-th quantile of the stream, i.e., a value
+   * of the stream whose normalized rank is approximately @a q. The 0-th and
+   * 1-th quantiles are the exact minimum and maximum.
+   *
+   * @param q Quantile to compute, which must be between 0 and 1 (inclusive).
+   *
+   * @throw std::invalid_argument Thrown if the sketch is empty or if @a q is
+   *                              not in the range [0, 1].
+   */
+  T quantile(double q) const;
+
+  /**
+   * @brief Return several approximate quantiles of the stream at once.
+   *
+   * @param q A 1-dimensional tensor with the quantiles to compute, which must
+   *          be between 0 and 1 (inclusive).
+   *
+   * @return A new tensor with the i-th quantile at position i.
+   *
+   * @throw std::invalid_argument Thrown if the sketch is empty or if any
+   *                              quantile is not in the range [0, 1].
+   */
+  template <class Container>
+  tensor<T, 1> quantile(const expression<Container, double, 1> &q) const;
+
+private:
+  // Parameter controlling the accuracy of the sketch.
+  size_t m_k;
+
+  // Number of values in the stream.
+  size_t m_count;
+
+  // Number of retained values and total capacity of the levels.
+  size_t m_size, m_capacity;
+
+  // Minimum and maximum values of the stream.
+  T m_min, m_max;
+
+  // State of the generator deciding which values are promoted.
+  std::uint64_t m_state;
+
+  // Retained values at each level.
+  std::vector<std::vector<T>> m_levels;
+
+  // Minimum capacity of a level.
+  static const size_t min_level_capacity = 8;
+
+  // Return the capacity of the h-th level.
+  size_t level_capacity(size_t h) const;
+
+  // Update the total capacity of the levels.
+  void update_capacity();
+
+  // Compact levels until the retained values fit in the sketch.
+  void compress();
+
+  // Return the retained values, sorted, together with their cumulative
+  // weights.
+  std::vector<std::pair<T, size_t>> sorted_items() const;
+
+  // Return the quantile q from the sorted retained values.
+  T quantile(const std::vector<std::pair<T, size_t>> &items, double q) const;
+
+  template <class U>
+  friend void save(std::ostream &file, const quantile_sketch<U> &sketch);
+
+  template <class U>
+  friend void load(std::istream &file, quantile_sketch<U> &sketch);
+};
+} // namespace numcpp
+
+#include "numcpp/routines/quantile_sketch.tcc"
+
+#endif // NUMCPP_QUANTILE_SKETCH_H_INCLUDED
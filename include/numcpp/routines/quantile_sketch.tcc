@@ -0,0 +1,261 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/quantile_sketch.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_QUANTILE_SKETCH_TCC_INCLUDED
+#define NUMCPP_QUANTILE_SKETCH_TCC_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace numcpp {
+template <class T> const size_t quantile_sketch<T>::min_level_capacity;
+
+/// Constructors.
+
+template <class T>
+quantile_sketch<T>::quantile_sketch(size_t k)
+    : m_k(k), m_count(0), m_size(0), m_capacity(0), m_min(), m_max(),
+      m_state(0x9E3779B97F4A7C15ULL), m_levels(1) {
+  if (k < min_level_capacity) {
+    throw std::invalid_argument("k must be at least 8");
+  }
+  update_capacity();
+}
+
+/// Public methods.
+
+template <class T> void quantile_sketch<T>::update(const T &val) {
+  if (m_count == 0) {
+    m_min = m_max = val;
+  } else if (val < m_min) {
+    m_min = val;
+  } else if (m_max < val) {
+    m_max = val;
+  }
+  ++m_count;
+  m_levels[0].push_back(val);
+  if (++m_size > m_capacity) {
+    compress();
+  }
+}
+
+template <class T>
+template <class Container, size_t Rank>
+void quantile_sketch<T>::update(const expression<Container, T, Rank> &a) {
+  for (auto it = a.self().begin(); it != a.self().end(); ++it) {
+    update(*it);
+  }
+}
+
+template <class T>
+void quantile_sketch<T>::merge(const quantile_sketch &other) {
+  if (this == &other) {
+    quantile_sketch copy(other);
+    merge(copy);
+    return;
+  }
+  if (other.m_count == 0) {
+    return;
+  }
+  if (m_count == 0) {
+    m_min = other.m_min;
+    m_max = other.m_max;
+  } else {
+    m_min = (other.m_min < m_min) ? other.m_min : m_min;
+    m_max = (m_max < other.m_max) ? other.m_max : m_max;
+  }
+  if (m_levels.size() < other.m_levels.size()) {
+    m_levels.resize(other.m_levels.size());
+  }
+  for (size_t h = 0; h < other.m_levels.size(); ++h) {
+    m_levels[h].insert(m_levels[h].end(), other.m_levels[h].begin(),
+                       other.m_levels[h].end());
+  }
+  m_k = std::min(m_k, other.m_k);
+  m_count += other.m_count;
+  m_size += other.m_size;
+  update_capacity();
+  compress();
+}
+
+template <class T> inline size_t quantile_sketch<T>::k() const { return m_k; }
+
+template <class T> inline size_t quantile_sketch<T>::count() const {
+  return m_count;
+}
+
+template <class T> inline bool quantile_sketch<T>::empty() const {
+  return (m_count == 0);
+}
+
+template <class T> inline size_t quantile_sketch<T>::num_retained() const {
+  return m_size;
+}
+
+template <class T> inline double quantile_sketch<T>::epsilon() const {
+  return 2.296 / std::pow(m_k, 0.9723);
+}
+
+template <class T> T quantile_sketch<T>::min() const {
+  if (m_count == 0) {
+    throw std::invalid_argument("attempt to get min of an empty sketch");
+  }
+  return m_min;
+}
+
+template <class T> T quantile_sketch<T>::max() const {
+  if (m_count == 0) {
+    throw std::invalid_argument("attempt to get max of an empty sketch");
+  }
+  return m_max;
+}
+
+template <class T> double quantile_sketch<T>::rank(const T &val) const {
+  if (m_count == 0) {
+    throw std::invalid_argument("attempt to get rank of an empty sketch");
+  }
+  size_t weight = 0;
+  for (size_t h = 0; h < m_levels.size(); ++h) {
+    size_t n = 0;
+    for (size_t i = 0; i < m_levels[h].size(); ++i) {
+      n += !(val < m_levels[h][i]);
+    }
+    weight += n << h;
+  }
+  return double(weight) / m_count;
+}
+
+template <class T> T quantile_sketch<T>::quantile(double q) const {
+  if (!(0 <= q && q <= 1)) {
+    throw std::invalid_argument("quantiles must be in the range [0, 1]");
+  }
+  if (m_count == 0) {
+    throw std::invalid_argument("attempt to get quantile of an empty sketch");
+  }
+  return quantile(sorted_items(), q);
+}
+
+template <class T>
+template <class Container>
+tensor<T, 1>
+quantile_sketch<T>::quantile(const expression<Container, double, 1> &q) const {
+  tensor<double, 1> q_values(q);
+  for (size_t i = 0; i < q_values.size(); ++i) {
+    if (!(0 <= q_values[i] && q_values[i] <= 1)) {
+      throw std::invalid_argument("quantiles must be in the range [0, 1]");
+    }
+  }
+  if (m_count == 0) {
+    throw std::invalid_argument("attempt to get quantile of an empty sketch");
+  }
+  std::vector<std::pair<T, size_t>> items = sorted_items();
+  tensor<T, 1> out(q_values.size());
+  for (size_t i = 0; i < q_values.size(); ++i) {
+    out[i] = quantile(items, q_values[i]);
+  }
+  return out;
+}
+
+/// Private methods.
+
+template <class T>
+inline size_t quantile_sketch<T>::level_capacity(size_t h) const {
+  size_t depth = m_levels.size() - 1 - h;
+  size_t capacity = std::ceil(m_k * std::pow(2.0 / 3.0, depth));
+  return std::max(capacity, min_level_capacity);
+}
+
+template <class T> void quantile_sketch<T>::update_capacity() {
+  m_capacity = 0;
+  for (size_t h = 0; h < m_levels.size(); ++h) {
+    m_capacity += level_capacity(h);
+  }
+}
+
+template <class T> void quantile_sketch<T>::compress() {
+  while (m_size > m_capacity) {
+    // Compact the lowest level which is full.
+    size_t h = 0;
+    while (m_levels[h].size() < level_capacity(h)) {
+      ++h;
+    }
+    if (h + 1 == m_levels.size()) {
+      m_levels.emplace_back();
+      update_capacity();
+    }
+    std::vector<T> &level = m_levels[h];
+    std::vector<T> &next = m_levels[h + 1];
+    std::sort(level.begin(), level.end());
+
+    // If the level has an odd number of values, the smallest one stays. Every
+    // other value among the rest is promoted, starting at a random offset.
+    m_state ^= m_state << 13;
+    m_state ^= m_state >> 7;
+    m_state ^= m_state << 17;
+    size_t first = level.size() % 2;
+    size_t offset = m_state >> 63;
+    for (size_t i = first + offset; i < level.size(); i += 2) {
+      next.push_back(level[i]);
+    }
+    m_size -= (level.size() - first) / 2;
+    level.resize(first);
+  }
+}
+
+template <class T>
+std::vector<std::pair<T, size_t>> quantile_sketch<T>::sorted_items() const {
+  std::vector<std::pair<T, size_t>> items;
+  items.reserve(m_size);
+  for (size_t h = 0; h < m_levels.size(); ++h) {
+    for (size_t i = 0; i < m_levels[h].size(); ++i) {
+      items.emplace_back(m_levels[h][i], size_t(1) << h);
+    }
+  }
+  std::sort(items.begin(), items.end(),
+            [](const std::pair<T, size_t> &x, const std::pair<T, size_t> &y) {
+              return x.first < y.first;
+            });
+  for (size_t i = 1; i < items.size(); ++i) {
+    items[i].second += items[i - 1].second;
+  }
+  return items;
+}
+
+template <class T>
+T quantile_sketch<T>::quantile(const std::vector<std::pair<T, size_t>> &items,
+                               double q) const {
+  if (q == 0) {
+    return m_min;
+  } else if (q == 1) {
+    return m_max;
+  }
+  double weight = q * m_count;
+  auto it = std::lower_bound(
+      items.begin(), items.end(), weight,
+      [](const std::pair<T, size_t> &x, double w) { return x.second < w; });
+  return (it != items.end()) ? it->first : m_max;
+}
+} // namespace numcpp
+
+#endif // NUMCPP_QUANTILE_SKETCH_TCC_INCLUDED
@@ -0,0 +1,252 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/radix_sort.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_RADIX_SORT_H_INCLUDED
+#define NUMCPP_RADIX_SORT_H_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Maps the values of a type to unsigned integer keys with the same
+ * order. The member value is false if the type can't be radix sorted.
+ */
+template <class T, class Enable = void> struct radix_traits {
+  static const bool value = false;
+};
+
+/**
+ * @brief Specialization for 32 and 64-bit integers. Signed integers flip their
+ * sign bit so that negative values come first.
+ */
+template <class T>
+struct radix_traits<
+    T, typename std::enable_if<std::is_integral<T>::value &&
+                               !std::is_same<T, bool>::value &&
+                               (sizeof(T) == 4 || sizeof(T) == 8)>::type> {
+  static const bool value = true;
+  typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type
+      key_type;
+
+  static key_type encode(T val) {
+    const key_type sign = std::is_signed<T>::value
+                              ? key_type(1) << (8 * sizeof(T) - 1)
+                              : key_type(0);
+    return key_type(val) ^ sign;
+  }
+};
+
+/**
+ * @brief Specialization for IEEE 754 single and double precision. Negative
+ * values flip all their bits and non-negative values flip their sign bit.
+ * Negative and positive zero are mapped to the same key, since they compare
+ * equal, and NaNs are mapped to the largest key, so they are sorted last.
+ */
+template <class T>
+struct radix_traits<
+    T, typename std::enable_if<std::is_floating_point<T>::value &&
+                               std::numeric_limits<T>::is_iec559 &&
+                               (sizeof(T) == 4 || sizeof(T) == 8)>::type> {
+  static const bool value = true;
+  typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type
+      key_type;
+
+  static key_type encode(T val) {
+    const key_type sign = key_type(1) << (8 * sizeof(T) - 1);
+    if (val != val) {
+      return ~key_type(0);
+    }
+    if (val == T(0)) {
+      return sign;
+    }
+    key_type bits;
+    std::memcpy(&bits, &val, sizeof(T));
+    return (bits & sign) ? ~bits : (bits | sign);
+  }
+};
+
+/**
+ * @brief Minimum number of elements to use a radix sort. Shorter sequences use
+ * a comparison sort on the keys.
+ */
+const size_t radix_sort_threshold = 512;
+
+/**
+ * @brief Number of bits and buckets of each pass of the radix sort.
+ */
+const size_t radix_bits = 8;
+const size_t radix_buckets = size_t(1) << radix_bits;
+
+/**
+ * @brief An element to sort together with its position.
+ */
+template <class Key, class Index> struct radix_item {
+  Key key;
+  Index index;
+};
+
+/**
+ * @brief Count the digits of each pass in a block of elements.
+ */
+template <class T, class KeyOf>
+void radix_count(const T *data, size_t first, size_t last, KeyOf key_of,
+                 size_t pass, size_t npasses, size_t *count) {
+  std::fill_n(count, npasses * radix_buckets, size_t(0));
+  for (size_t i = first; i < last; ++i) {
+    auto key = key_of(data[i]);
+    for (size_t p = pass; p < pass + npasses; ++p) {
+      ++count[(p - pass) * radix_buckets +
+              ((key >> (radix_bits * p)) & (radix_buckets - 1))];
+    }
+  }
+}
+
+/**
+ * @brief Sort a sequence using a least significant digit radix sort. The sort
+ * is stable.
+ *
+ * @details The elements are split into blocks. Each pass counts the digits of
+ * each block, computes the position of each block inside each bucket and
+ * scatters the blocks in parallel. Passes in which all the keys have the same
+ * digit are skipped.
+ *
+ * @param data Pointer to the elements to sort.
+ * @param size Number of elements.
+ * @param key_of A function returning the unsigned integer key of an element.
+ */
+template <class T, class KeyOf>
+void radix_sort(T *data, size_t size, KeyOf key_of) {
+  typedef decltype(key_of(*data)) key_type;
+  const size_t npasses = sizeof(key_type) * 8 / radix_bits;
+  size_t nblocks = std::max<size_t>(num_tasks(size, size), 1);
+  size_t stride = npasses * radix_buckets;
+  std::vector<size_t> count(nblocks * stride);
+  parallel_for(nblocks, [&](size_t b) {
+    radix_count(data, block_begin(b, nblocks, size),
+                block_begin(b + 1, nblocks, size), key_of, 0, npasses,
+                count.data() + b * stride);
+  });
+
+  std::vector<T> buffer(size);
+  T *src = data, *dst = buffer.data();
+  bool moved = false;
+  for (size_t p = 0; p < npasses; ++p) {
+    size_t *pass_count = count.data() + p * radix_buckets;
+    bool trivial = false;
+    for (size_t d = 0; d < radix_buckets && !trivial; ++d) {
+      size_t total = 0;
+      for (size_t b = 0; b < nblocks; ++b) {
+        total += pass_count[b * stride + d];
+      }
+      trivial = (total == size);
+    }
+    if (trivial) {
+      continue;
+    }
+    // The counts of the first pass are still valid. Afterwards, the elements
+    // have moved between blocks and must be counted again.
+    if (moved && nblocks > 1) {
+      parallel_for(nblocks, [&](size_t b) {
+        radix_count(src, block_begin(b, nblocks, size),
+                    block_begin(b + 1, nblocks, size), key_of, p, 1,
+                    pass_count + b * stride);
+      });
+    }
+    size_t offset = 0;
+    for (size_t d = 0; d < radix_buckets; ++d) {
+      for (size_t b = 0; b < nblocks; ++b) {
+        size_t n = pass_count[b * stride + d];
+        pass_count[b * stride + d] = offset;
+        offset += n;
+      }
+    }
+    size_t shift = radix_bits * p;
+    parallel_for(nblocks, [&](size_t b) {
+      size_t *pos = pass_count + b * stride;
+      size_t first = block_begin(b, nblocks, size);
+      size_t last = block_begin(b + 1, nblocks, size);
+      for (size_t i = first; i < last; ++i) {
+        dst[pos[(key_of(src[i]) >> shift) & (radix_buckets - 1)]++] = src[i];
+      }
+    });
+    std::swap(src, dst);
+    moved = true;
+  }
+  if (src != data) {
+    std::copy(src, src + size, data);
+  }
+}
+
+/**
+ * @brief Sort a range of values by their radix keys. Short ranges use a
+ * comparison sort on the keys, so that the order doesn't depend on the size of
+ * the range.
+ */
+template <class T> void radix_sort(T *first, T *last) {
+  typedef radix_traits<T> traits;
+  if (size_t(last - first) < radix_sort_threshold) {
+    std::stable_sort(first, last, [](const T &lhs, const T &rhs) {
+      return traits::encode(lhs) < traits::encode(rhs);
+    });
+  } else {
+    radix_sort(first, last - first,
+               [](const T &val) { return traits::encode(val); });
+  }
+}
+
+/**
+ * @brief Return the permutation that sorts a sequence by the radix keys of its
+ * values. Each key is sorted together with its position.
+ */
+template <class T, class Index>
+void radix_argsort(const T *data, size_t size, Index *out) {
+  typedef radix_traits<T> traits;
+  typedef radix_item<typename traits::key_type, Index> item;
+  std::vector<item> items(size);
+  for (size_t i = 0; i < size; ++i) {
+    items[i].key = traits::encode(data[i]);
+    items[i].index = Index(i);
+  }
+  if (size < radix_sort_threshold) {
+    std::stable_sort(items.begin(), items.end(),
+                     [](const item &lhs, const item &rhs) {
+                       return lhs.key < rhs.key;
+                     });
+  } else {
+    radix_sort(items.data(), size, [](const item &x) { return x.key; });
+  }
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = items[i].index;
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_RADIX_SORT_H_INCLUDED
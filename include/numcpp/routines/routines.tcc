@@ -24,7 +24,17 @@
 #ifndef NUMCPP_ROUTINES_TCC_INCLUDED
 #define NUMCPP_ROUTINES_TCC_INCLUDED
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
+#include "numcpp/functional/reduction.h"
+#include "numcpp/functional/scan.h"
+#include "numcpp/functional/segmented.h"
+#include "numcpp/routines/histogram.h"
+#include "numcpp/routines/searching.h"
+#include "numcpp/routines/selection.h"
+#include "numcpp/routines/sorting.h"
+#include "numcpp/routines/unique.h"
 #include "numcpp/iterators/axes_iterator.h"
 #include "numcpp/iterators/index_sequence.h"
 
@@ -236,13 +246,13 @@ tensor<T, Rank - N> amax(const expression<Container, T, Rank> &a,
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> amax(const expression<Container, T, Rank> &a,
                      const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<T>(ranges::max(), a, axes, keepdims);
+  return detail::reduce_over_axes<T>(ranges::maximum(), a, axes, keepdims);
 }
 
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> amax(const expression<Container, T, Rank> &a,
                          const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<T>(ranges::max(), a, axes, dropdims);
+  return detail::reduce_over_axes<T>(ranges::maximum(), a, axes, dropdims);
 }
 
 template <class Container, class T, size_t Rank>
@@ -260,13 +270,13 @@ tensor<T, Rank - N> amin(const expression<Container, T, Rank> &a,
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> amin(const expression<Container, T, Rank> &a,
                      const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<T>(ranges::min(), a, axes, keepdims);
+  return detail::reduce_over_axes<T>(ranges::minimum(), a, axes, keepdims);
 }
 
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> amin(const expression<Container, T, Rank> &a,
                          const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<T>(ranges::min(), a, axes, dropdims);
+  return detail::reduce_over_axes<T>(ranges::minimum(), a, axes, dropdims);
 }
 
 /// Sums and products.
@@ -286,13 +296,13 @@ tensor<T, Rank - N> sum(const expression<Container, T, Rank> &a,
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> sum(const expression<Container, T, Rank> &a,
                     const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<T>(ranges::sum(), a, axes, keepdims);
+  return detail::reduce_over_axes<T>(plus(), a, axes, keepdims, T());
 }
 
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> sum(const expression<Container, T, Rank> &a,
                         const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<T>(ranges::sum(), a, axes, dropdims);
+  return detail::reduce_over_axes<T>(plus(), a, axes, dropdims, T());
 }
 
 template <class Container, class T, size_t Rank>
@@ -310,47 +320,23 @@ tensor<T, Rank - N> prod(const expression<Container, T, Rank> &a,
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> prod(const expression<Container, T, Rank> &a,
                      const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<T>(ranges::prod(), a, axes, keepdims);
+  return detail::reduce_over_axes<T>(multiplies(), a, axes, keepdims, T(1));
 }
 
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> prod(const expression<Container, T, Rank> &a,
                          const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<T>(ranges::prod(), a, axes, dropdims);
+  return detail::reduce_over_axes<T>(multiplies(), a, axes, dropdims, T(1));
 }
 
 template <class Container, class T, size_t Rank>
 tensor<T, Rank> cumsum(const expression<Container, T, Rank> &a, size_t axis) {
-  shape_t<Rank> shape = a.shape();
-  tensor<T, Rank> out(shape);
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    typedef axes_iterator<const Container, T, Rank, 1, void, T> input_iterator;
-    typedef axes_iterator<tensor<T, Rank>, T, Rank, 1> output_iterator;
-    input_iterator first(&a.self(), index, axis, 0);
-    input_iterator last(&a.self(), index, axis, size);
-    output_iterator result(&out, index, axis, 0);
-    std::partial_sum(first, last, result, plus());
-  }
-  return out;
+  return detail::scan_over_axis(plus(), a, axis);
 }
 
 template <class Container, class T, size_t Rank>
 tensor<T, Rank> cumprod(const expression<Container, T, Rank> &a, size_t axis) {
-  shape_t<Rank> shape = a.shape();
-  tensor<T, Rank> out(shape);
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    typedef axes_iterator<const Container, T, Rank, 1, void, T> input_iterator;
-    typedef axes_iterator<tensor<T, Rank>, T, Rank, 1> output_iterator;
-    input_iterator first(&a.self(), index, axis, 0);
-    input_iterator last(&a.self(), index, axis, size);
-    output_iterator result(&out, index, axis, 0);
-    std::partial_sum(first, last, result, multiplies());
-  }
-  return out;
+  return detail::scan_over_axis(multiplies(), a, axis);
 }
 
 /// Logic functions.
@@ -370,13 +356,15 @@ tensor<bool, Rank - N> all(const expression<Container, bool, Rank> &a,
 template <class Container, size_t Rank, size_t N>
 tensor<bool, Rank> all(const expression<Container, bool, Rank> &a,
                        const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<bool>(ranges::all(), a, axes, keepdims);
+  return detail::reduce_over_axes<bool>(logical_and(), a, axes, keepdims,
+                                        true);
 }
 
 template <class Container, size_t Rank, size_t N>
 tensor<bool, Rank - N> all(const expression<Container, bool, Rank> &a,
                            const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<bool>(ranges::all(), a, axes, dropdims);
+  return detail::reduce_over_axes<bool>(logical_and(), a, axes, dropdims,
+                                        true);
 }
 
 template <class Container, size_t Rank>
@@ -394,13 +382,15 @@ tensor<bool, Rank - N> any(const expression<Container, bool, Rank> &a,
 template <class Container, size_t Rank, size_t N>
 tensor<bool, Rank> any(const expression<Container, bool, Rank> &a,
                        const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<bool>(ranges::any(), a, axes, keepdims);
+  return detail::reduce_over_axes<bool>(logical_or(), a, axes, keepdims,
+                                        false);
 }
 
 template <class Container, size_t Rank, size_t N>
 tensor<bool, Rank - N> any(const expression<Container, bool, Rank> &a,
                            const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<bool>(ranges::any(), a, axes, dropdims);
+  return detail::reduce_over_axes<bool>(logical_or(), a, axes, dropdims,
+                                        false);
 }
 
 template <class Container, class T, size_t Rank>
@@ -418,15 +408,15 @@ tensor<size_t, Rank - N> count_nonzero(const expression<Container, T, Rank> &a,
 template <class Container, class T, size_t Rank, size_t N>
 tensor<size_t, Rank> count_nonzero(const expression<Container, T, Rank> &a,
                                    const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<size_t>(ranges::count_nonzero(), a, axes,
-                                         keepdims);
+  auto count = [](size_t n, const T &val) { return (val == T()) ? n : n + 1; };
+  return detail::reduce_over_axes<size_t>(count, a, axes, keepdims, size_t(0));
 }
 
 template <class Container, class T, size_t Rank, size_t N>
 tensor<size_t, Rank - N> count_nonzero(const expression<Container, T, Rank> &a,
                                        const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<size_t>(ranges::count_nonzero(), a, axes,
-                                         dropdims);
+  auto count = [](size_t n, const T &val) { return (val == T()) ? n : n + 1; };
+  return detail::reduce_over_axes<size_t>(count, a, axes, dropdims, size_t(0));
 }
 
 template <class T, class U>
@@ -475,20 +465,8 @@ template <class Container, class T, size_t Rank, class Compare,
           detail::RequiresCallable<Compare, T, T>>
 tensor<index_t<Rank>, 1> argsort(const expression<Container, T, Rank> &a,
                                  Compare comp, bool stable) {
-  index_sequence<Rank> indices(a.shape(), a.layout());
-  tensor<index_t<Rank>, 1> out(indices.begin(), a.size());
-  if (stable) {
-    std::stable_sort(out.data(), out.data() + out.size(),
-                     [&](const index_t<Rank> &i, const index_t<Rank> &j) {
-                       return comp(a[i], a[j]);
-                     });
-  } else {
-    std::sort(out.data(), out.data() + out.size(),
-              [&](const index_t<Rank> &i, const index_t<Rank> &j) {
-                return comp(a[i], a[j]);
-              });
-  }
-  return out;
+  return detail::unravel_indices(flatargsort(a, comp, stable), a.shape(),
+                                 a.layout());
 }
 
 template <class Container, class T, size_t Rank>
@@ -501,30 +479,40 @@ template <class Container, class T, size_t Rank, class Compare,
           detail::RequiresCallable<Compare, T, T>>
 tensor<size_t, Rank> argsort(const expression<Container, T, Rank> &a,
                              size_t axis, Compare comp, bool stable) {
-  shape_t<Rank> shape = a.shape();
-  tensor<size_t, Rank> out(shape);
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    typedef axes_iterator<tensor<size_t, Rank>, size_t, Rank, 1> iterator;
-    iterator first(&out, index, axis, 0);
-    iterator last(&out, index, axis, size);
-    std::iota(first, last, size_t(0));
-    index_t<Rank> i = index, j = index;
-    if (stable) {
-      std::stable_sort(first, last, [&](size_t i_axis, size_t j_axis) {
-        i[axis] = i_axis;
-        j[axis] = j_axis;
-        return comp(a[i], a[j]);
-      });
-    } else {
-      std::sort(first, last, [&](size_t i_axis, size_t j_axis) {
-        i[axis] = i_axis;
-        j[axis] = j_axis;
-        return comp(a[i], a[j]);
+  typedef std::pair<std::vector<T>, std::vector<size_t>> workspace;
+  tensor<size_t, Rank> out(a.shape());
+  size_t size = a.shape(axis);
+  size_t batch = detail::lane_batch_size<T>(a.shape(), axis, a.layout());
+  detail::for_each_lane_batch<workspace>(
+      a.shape(), axis, a.layout(), batch,
+      [&](const index_t<Rank> *lanes, size_t count, workspace &buffer) {
+        buffer.first.resize(count * size);
+        buffer.second.resize(count * size);
+        detail::gather_lanes(a.self(), lanes, count, axis, size,
+                             buffer.first.data());
+        for (size_t b = 0; b < count; ++b) {
+          detail::argsort_range(buffer.first.data() + b * size, size,
+                                buffer.second.data() + b * size, comp, stable);
+        }
+        detail::scatter_lanes(buffer.second.data(), out, lanes, count, axis,
+                              size);
       });
-    }
-  }
+  return out;
+}
+
+template <class Index, class Container, class T, size_t Rank>
+tensor<Index, 1> flatargsort(const expression<Container, T, Rank> &a) {
+  return flatargsort<Index>(a, less());
+}
+
+template <class Index, class Container, class T, size_t Rank, class Compare,
+          detail::RequiresCallable<Compare, T, T>>
+tensor<Index, 1> flatargsort(const expression<Container, T, Rank> &a,
+                             Compare comp, bool stable) {
+  detail::assert_index_type<Index>(a.size());
+  tensor<T, 1> values(a.self().begin(), a.size());
+  tensor<Index, 1> out(a.size());
+  detail::argsort_range(values.data(), values.size(), out.data(), comp, stable);
   return out;
 }
 
@@ -538,11 +526,7 @@ template <class Container, class T, size_t Rank, class Compare,
 tensor<T, 1> sort(const expression<Container, T, Rank> &a, Compare comp,
                   bool stable) {
   tensor<T, 1> out(a.self().begin(), a.size());
-  if (stable) {
-    std::stable_sort(out.data(), out.data() + out.size(), comp);
-  } else {
-    std::sort(out.data(), out.data() + out.size(), comp);
-  }
+  detail::sort_range(out.data(), out.data() + out.size(), comp, stable);
   return out;
 }
 
@@ -555,20 +539,8 @@ template <class Container, class T, size_t Rank, class Compare,
           detail::RequiresCallable<Compare, T, T>>
 tensor<T, Rank> sort(const expression<Container, T, Rank> &a, size_t axis,
                      Compare comp, bool stable) {
-  shape_t<Rank> shape = a.shape();
   tensor<T, Rank> out(a);
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    typedef axes_iterator<tensor<T, Rank>, T, Rank, 1> iterator;
-    iterator first(&out, index, axis, 0);
-    iterator last(&out, index, axis, size);
-    if (stable) {
-      std::stable_sort(first, last, comp);
-    } else {
-      std::sort(first, last, comp);
-    }
-  }
+  out.sort(axis, comp, stable);
   return out;
 }
 
@@ -582,13 +554,8 @@ template <class Container, class T, size_t Rank, class Compare,
           detail::RequiresCallable<Compare, T, T>>
 tensor<index_t<Rank>, 1> argpartition(const expression<Container, T, Rank> &a,
                                       size_t kth, Compare comp) {
-  index_sequence<Rank> indices(a.shape(), a.layout());
-  tensor<index_t<Rank>, 1> out(indices.begin(), a.size());
-  std::nth_element(out.data(), out.data() + kth, out.data() + out.size(),
-                   [&](const index_t<Rank> &i, const index_t<Rank> &j) {
-                     return comp(a[i], a[j]);
-                   });
-  return out;
+  return detail::unravel_indices(flatargpartition(a, kth, comp), a.shape(),
+                                 a.layout());
 }
 
 template <class Container, class T, size_t Rank>
@@ -601,23 +568,42 @@ template <class Container, class T, size_t Rank, class Compare,
           detail::RequiresCallable<Compare, T, T>>
 tensor<size_t, Rank> argpartition(const expression<Container, T, Rank> &a,
                                   size_t kth, size_t axis, Compare comp) {
-  shape_t<Rank> shape = a.shape();
-  tensor<size_t, Rank> out(shape);
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    typedef axes_iterator<tensor<size_t, Rank>, size_t, Rank, 1> iterator;
-    iterator first(&out, index, axis, 0);
-    iterator last(&out, index, axis, size);
-    std::iota(first, last, size_t(0));
-    index_t<Rank> i = index, j = index;
-    std::nth_element(first, first + kth, last,
-                     [&](size_t i_axis, size_t j_axis) {
-                       i[axis] = i_axis;
-                       j[axis] = j_axis;
-                       return comp(a[i], a[j]);
-                     });
-  }
+  typedef std::pair<std::vector<T>, std::vector<size_t>> workspace;
+  tensor<size_t, Rank> out(a.shape());
+  size_t size = a.shape(axis);
+  size_t batch = detail::lane_batch_size<T>(a.shape(), axis, a.layout());
+  detail::for_each_lane_batch<workspace>(
+      a.shape(), axis, a.layout(), batch,
+      [&](const index_t<Rank> *lanes, size_t count, workspace &buffer) {
+        buffer.first.resize(count * size);
+        buffer.second.resize(count * size);
+        detail::gather_lanes(a.self(), lanes, count, axis, size,
+                             buffer.first.data());
+        for (size_t b = 0; b < count; ++b) {
+          detail::argpartition_range(buffer.first.data() + b * size, size, kth,
+                                     buffer.second.data() + b * size, comp);
+        }
+        detail::scatter_lanes(buffer.second.data(), out, lanes, count, axis,
+                              size);
+      });
+  return out;
+}
+
+template <class Index, class Container, class T, size_t Rank>
+tensor<Index, 1> flatargpartition(const expression<Container, T, Rank> &a,
+                                  size_t kth) {
+  return flatargpartition<Index>(a, kth, less());
+}
+
+template <class Index, class Container, class T, size_t Rank, class Compare,
+          detail::RequiresCallable<Compare, T, T>>
+tensor<Index, 1> flatargpartition(const expression<Container, T, Rank> &a,
+                                  size_t kth, Compare comp) {
+  detail::assert_index_type<Index>(a.size());
+  tensor<T, 1> values(a.self().begin(), a.size());
+  tensor<Index, 1> out(a.size());
+  detail::argpartition_range(values.data(), values.size(), kth, out.data(),
+                             comp);
   return out;
 }
 
@@ -645,29 +631,80 @@ template <class Container, class T, size_t Rank, class Compare,
           detail::RequiresCallable<Compare, T, T>>
 tensor<T, Rank> partition(const expression<Container, T, Rank> &a, size_t kth,
                           size_t axis, Compare comp) {
-  shape_t<Rank> shape = a.shape();
   tensor<T, Rank> out(a);
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    typedef axes_iterator<tensor<T, Rank>, T, Rank, 1> iterator;
-    iterator first(&out, index, axis, 0);
-    iterator last(&out, index, axis, size);
-    std::nth_element(first, first + kth, last, comp);
-  }
+  out.partition(kth, axis, comp);
+  return out;
+}
+
+template <class Container, class T, size_t Rank>
+tensor<T, Rank> topk(const expression<Container, T, Rank> &a, size_t k,
+                     size_t axis, bool largest, bool sorted) {
+  shape_t<Rank> shape = a.shape();
+  shape[axis] = k;
+  tensor<T, Rank> out(shape);
+  detail::topk_over_axis(a, k, axis, largest, sorted, out.data(),
+                         (size_t *)NULL);
+  return out;
+}
+
+template <class Container, class T, size_t Rank>
+tensor<size_t, Rank> argtopk(const expression<Container, T, Rank> &a, size_t k,
+                             size_t axis, bool largest, bool sorted) {
+  shape_t<Rank> shape = a.shape();
+  shape[axis] = k;
+  tensor<size_t, Rank> out(shape);
+  detail::topk_over_axis(a, k, axis, largest, sorted, (T *)NULL, out.data());
+  return out;
+}
+
+template <class Container1, class T, class Container2, size_t Rank>
+tensor<size_t, Rank> searchsorted(const expression<Container1, T, 1> &a,
+                                  const expression<Container2, T, Rank> &v,
+                                  const std::string &side) {
+  bool right = detail::make_search_side(side);
+  tensor<T, 1> a_buffer;
+  tensor<T, Rank> v_buffer;
+  const T *a_data = detail::make_row_major(a.self(), a_buffer);
+  const T *v_data = detail::make_row_major(v.self(), v_buffer);
+  tensor<size_t, Rank> out(v.shape());
+  detail::searchsorted_strided(a_data, a.size(), v_data, v.size(), right,
+                               out.data());
   return out;
 }
 
 template <class Container, class T, size_t Rank>
 tensor<index_t<Rank>, 1> nonzero(const expression<Container, T, Rank> &a) {
-  size_t size = count_nonzero(a);
-  tensor<index_t<Rank>, 1> out(size);
-  size_t n = 0;
-  for (index_t<Rank> i : make_index_sequence_for(a)) {
-    if (a[i] != T()) {
-      out[n++] = i;
+  return detail::unravel_indices(flatnonzero(a), a.shape(), a.layout());
+}
+
+template <class Index, class Container, class T, size_t Rank>
+tensor<Index, 1> flatnonzero(const expression<Container, T, Rank> &a) {
+  detail::assert_index_type<Index>(a.size());
+  // Count the non-zero elements of each block, then each block writes its
+  // indices after those of the previous blocks.
+  size_t size = a.size();
+  size_t tasks = detail::num_tasks(size, size);
+  std::vector<size_t> offset(tasks + 1, 0);
+  detail::parallel_for(tasks, [&](size_t task) {
+    size_t first = detail::block_begin(task, tasks, size);
+    size_t last = detail::block_begin(task + 1, tasks, size);
+    offset[task + 1] =
+        std::count_if(a.self().begin() + first, a.self().begin() + last,
+                      [](const T &val) { return val != T(); });
+  });
+  std::partial_sum(offset.begin(), offset.end(), offset.begin());
+  tensor<Index, 1> out(offset[tasks]);
+  detail::parallel_for(tasks, [&](size_t task) {
+    size_t first = detail::block_begin(task, tasks, size);
+    size_t last = detail::block_begin(task + 1, tasks, size);
+    size_t n = offset[task];
+    auto it = a.self().begin() + first;
+    for (size_t i = first; i < last; ++i, ++it) {
+      if (*it != T()) {
+        out[n++] = Index(i);
+      }
     }
-  }
+  });
   return out;
 }
 
@@ -681,12 +718,33 @@ where(const expression<Container, bool, Rank> &condition) {
 
 template <class Container, class T, size_t Rank>
 tensor<T, 1> unique(const expression<Container, T, Rank> &a) {
-  std::vector<T> buffer(a.self().begin(), a.self().end());
-  if (!std::is_sorted(buffer.begin(), buffer.end())) {
-    std::sort(buffer.begin(), buffer.end());
+  tensor<T, 1> buffer;
+  const T *data = detail::make_contiguous(a.self(), buffer);
+  tensor<T, 1> values;
+  detail::unique_output<T> out = {&values, NULL, NULL, NULL};
+  detail::unique_range(data, a.size(), out);
+  return values;
+}
+
+template <class Container, class T, size_t Rank>
+std::tuple<tensor<T, 1>, tensor<size_t, 1>, tensor<size_t, Rank>,
+           tensor<size_t, 1>>
+unique(const expression<Container, T, Rank> &a, bool return_index,
+       bool return_inverse, bool return_counts) {
+  tensor<T, 1> buffer;
+  const T *data = detail::make_contiguous(a.self(), buffer);
+  tensor<T, 1> values;
+  tensor<size_t, 1> index, counts;
+  tensor<size_t, Rank> inverse;
+  if (return_inverse) {
+    inverse = tensor<size_t, Rank>(a.shape(), a.layout());
   }
-  size_t size = std::unique(buffer.begin(), buffer.end()) - buffer.begin();
-  return tensor<T, 1>(buffer.begin(), size);
+  detail::unique_output<T> out = {
+      &values, return_index ? &index : NULL,
+      return_inverse ? inverse.data() : NULL, return_counts ? &counts : NULL};
+  detail::unique_range(data, a.size(), out);
+  return std::make_tuple(std::move(values), std::move(index),
+                         std::move(inverse), std::move(counts));
 }
 
 template <class Container, class T>
@@ -698,43 +756,48 @@ bool contains(const expression<Container, T, 1> &a,
 template <class Container1, class T, class Container2>
 bool is_subset(const expression<Container1, T, 1> &a,
                const expression<Container2, T, 1> &b) {
-  return std::includes(b.self().begin(), b.self().end(), a.self().begin(),
-                       a.self().end());
+  tensor<T, 1> a_unique = unique(a), b_unique = unique(b);
+  return std::includes(b_unique.begin(), b_unique.end(), a_unique.begin(),
+                       a_unique.end());
 }
 
 template <class Container1, class T, class Container2>
 tensor<T, 1> set_union(const expression<Container1, T, 1> &a,
                        const expression<Container2, T, 1> &b) {
+  tensor<T, 1> a_unique = unique(a), b_unique = unique(b);
   std::vector<T> buffer;
-  std::set_union(a.self().begin(), a.self().end(), b.self().begin(),
-                 b.self().end(), std::back_inserter(buffer));
+  std::set_union(a_unique.begin(), a_unique.end(), b_unique.begin(),
+                 b_unique.end(), std::back_inserter(buffer));
   return tensor<T, 1>(buffer.begin(), buffer.size());
 }
 
 template <class Container1, class T, class Container2>
 tensor<T, 1> set_intersection(const expression<Container1, T, 1> &a,
                               const expression<Container2, T, 1> &b) {
+  tensor<T, 1> a_unique = unique(a), b_unique = unique(b);
   std::vector<T> buffer;
-  std::set_intersection(a.self().begin(), a.self().end(), b.self().begin(),
-                        b.self().end(), std::back_inserter(buffer));
+  std::set_intersection(a_unique.begin(), a_unique.end(), b_unique.begin(),
+                        b_unique.end(), std::back_inserter(buffer));
   return tensor<T, 1>(buffer.begin(), buffer.size());
 }
 
 template <class Container1, class T, class Container2>
 tensor<T, 1> set_difference(const expression<Container1, T, 1> &a,
                             const expression<Container2, T, 1> &b) {
+  tensor<T, 1> a_unique = unique(a), b_unique = unique(b);
   std::vector<T> buffer;
-  std::set_difference(a.self().begin(), a.self().end(), b.self().begin(),
-                      b.self().end(), std::back_inserter(buffer));
+  std::set_difference(a_unique.begin(), a_unique.end(), b_unique.begin(),
+                      b_unique.end(), std::back_inserter(buffer));
   return tensor<T, 1>(buffer.begin(), buffer.size());
 }
 
 template <class Container1, class T, class Container2>
 tensor<T, 1> set_symmetric_difference(const expression<Container1, T, 1> &a,
                                       const expression<Container2, T, 1> &b) {
+  tensor<T, 1> a_unique = unique(a), b_unique = unique(b);
   std::vector<T> buffer;
-  std::set_symmetric_difference(a.self().begin(), a.self().end(),
-                                b.self().begin(), b.self().end(),
+  std::set_symmetric_difference(a_unique.begin(), a_unique.end(),
+                                b_unique.begin(), b_unique.end(),
                                 std::back_inserter(buffer));
   return tensor<T, 1>(buffer.begin(), buffer.size());
 }
@@ -756,19 +819,44 @@ tensor<T, Rank - N> mean(const expression<Container, T, Rank> &a,
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> mean(const expression<Container, T, Rank> &a,
                      const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<T>(ranges::mean(), a, axes, keepdims);
+  tensor<T, Rank> out =
+      detail::reduce_over_axes<T>(plus(), a, axes, keepdims, T());
+  if (a.size() == 0 && out.size() > 0) {
+    throw std::invalid_argument("attempt to get mean of an empty sequence");
+  }
+  ptrdiff_t size = (out.size() > 0) ? a.size() / out.size() : 1;
+  for (size_t i = 0; i < out.size(); ++i) {
+    out.data()[i] /= size;
+  }
+  return out;
 }
 
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> mean(const expression<Container, T, Rank> &a,
                          const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<T>(ranges::mean(), a, axes, dropdims);
+  tensor<T, Rank - N> out =
+      detail::reduce_over_axes<T>(plus(), a, axes, dropdims, T());
+  if (a.size() == 0 && out.size() > 0) {
+    throw std::invalid_argument("attempt to get mean of an empty sequence");
+  }
+  ptrdiff_t size = (out.size() > 0) ? a.size() / out.size() : 1;
+  for (size_t i = 0; i < out.size(); ++i) {
+    out.data()[i] /= size;
+  }
+  return out;
 }
 
 template <class Container, class T, size_t Rank>
 T median(const expression<Container, T, Rank> &a) {
-  ranges::median pred;
-  return pred(a.self().begin(), a.self().end());
+  shape_t<Rank> axes;
+  for (size_t i = 0; i < Rank; ++i) {
+    axes[i] = i;
+  }
+  double q = 0.5;
+  T out;
+  detail::quantile_over_axes(a, &q, 1, axes, detail::quantile_midpoint, &out,
+                             "median");
+  return out;
 }
 
 template <class Container, class T, size_t Rank, size_t N>
@@ -780,13 +868,25 @@ tensor<T, Rank - N> median(const expression<Container, T, Rank> &a,
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> median(const expression<Container, T, Rank> &a,
                        const shape_t<N> &axes, keepdims_t) {
-  return detail::apply_over_axes<T>(ranges::median(), a, axes, keepdims);
+  shape_t<Rank> shape = a.shape();
+  for (size_t i = 0; i < N; ++i) {
+    shape[axes[i]] = 1;
+  }
+  tensor<T, Rank> out(shape);
+  double q = 0.5;
+  detail::quantile_over_axes(a, &q, 1, axes, detail::quantile_midpoint,
+                             out.data(), "median");
+  return out;
 }
 
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> median(const expression<Container, T, Rank> &a,
                            const shape_t<N> &axes, dropdims_t) {
-  return detail::apply_over_axes<T>(ranges::median(), a, axes, dropdims);
+  tensor<T, Rank - N> out(detail::remove_axes(a.shape(), axes));
+  double q = 0.5;
+  detail::quantile_over_axes(a, &q, 1, axes, detail::quantile_midpoint,
+                             out.data(), "median");
+  return out;
 }
 
 template <class Container, class T, size_t Rank>
@@ -837,11 +937,75 @@ tensor<T, Rank - N> stddev(const expression<Container, T, Rank> &a,
   return detail::apply_over_axes<T>(ranges::stddev(bias), a, axes, dropdims);
 }
 
+template <class Container, class T, size_t Rank>
+summary_t<T> describe(const expression<Container, T, Rank> &a) {
+  if (a.size() == 0) {
+    throw std::invalid_argument("attempt to describe an empty sequence");
+  }
+  tensor<T, Rank> buffer;
+  tensor_view<const T, Rank> view = detail::make_strided_view(a.self(), buffer);
+  summary_t<T> out;
+  if (!view.is_contiguous()) {
+    detail::reduce_strided(detail::summary_push(), view.data(), view.shape(),
+                           view.strides(), &out, shape_t<Rank>(), true);
+    return out;
+  }
+  // Blocks have a fixed size and are merged in order to get the same result
+  // regardless of the number of threads.
+  const size_t block_size = detail::parallel_grain_size;
+  size_t size = view.size();
+  std::vector<summary_t<T>> partial((size + block_size - 1) / block_size);
+  detail::parallel_for(partial.size(), [&](size_t i) {
+    size_t first = i * block_size;
+    size_t last = std::min(first + block_size, size);
+    partial[i] = detail::summarize(view.data() + first, last - first, 1);
+  });
+  for (size_t i = 0; i < partial.size(); ++i) {
+    out.merge(partial[i]);
+  }
+  return out;
+}
+
+template <class Container, class T, size_t Rank, size_t N>
+tensor<summary_t<T>, Rank - N> describe(const expression<Container, T, Rank> &a,
+                                        const shape_t<N> &axes) {
+  return describe(a, axes, dropdims);
+}
+
+template <class Container, class T, size_t Rank, size_t N>
+tensor<summary_t<T>, Rank> describe(const expression<Container, T, Rank> &a,
+                                    const shape_t<N> &axes, keepdims_t) {
+  tensor<summary_t<T>, Rank> out = detail::reduce_over_axes<summary_t<T>>(
+      detail::summary_push(), a, axes, keepdims, summary_t<T>());
+  if (a.size() == 0 && out.size() > 0) {
+    throw std::invalid_argument("attempt to describe an empty sequence");
+  }
+  return out;
+}
+
+template <class Container, class T, size_t Rank, size_t N>
+tensor<summary_t<T>, Rank - N> describe(const expression<Container, T, Rank> &a,
+                                        const shape_t<N> &axes, dropdims_t) {
+  tensor<summary_t<T>, Rank - N> out = detail::reduce_over_axes<summary_t<T>>(
+      detail::summary_push(), a, axes, dropdims, summary_t<T>());
+  if (a.size() == 0 && out.size() > 0) {
+    throw std::invalid_argument("attempt to describe an empty sequence");
+  }
+  return out;
+}
+
 template <class Container, class T, size_t Rank>
 T quantile(const expression<Container, T, Rank> &a, double q,
            const std::string &method) {
-  ranges::quantile pred(q, method);
-  return pred(a.self().begin(), a.self().end());
+  shape_t<Rank> axes;
+  for (size_t i = 0; i < Rank; ++i) {
+    axes[i] = i;
+  }
+  T out;
+  detail::quantile_over_axes(a, &q, 1, axes,
+                             detail::make_quantile_method(method), &out,
+                             "quantile");
+  return out;
 }
 
 template <class Container, class T, size_t Rank, size_t N>
@@ -855,16 +1019,123 @@ template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank> quantile(const expression<Container, T, Rank> &a, double q,
                          const shape_t<N> &axes, const std::string &method,
                          keepdims_t) {
-  return detail::apply_over_axes<T>(ranges::quantile(q, method), a, axes,
-                                    keepdims);
+  shape_t<Rank> shape = a.shape();
+  for (size_t i = 0; i < N; ++i) {
+    shape[axes[i]] = 1;
+  }
+  tensor<T, Rank> out(shape);
+  detail::quantile_over_axes(a, &q, 1, axes,
+                             detail::make_quantile_method(method), out.data(),
+                             "quantile");
+  return out;
 }
 
 template <class Container, class T, size_t Rank, size_t N>
 tensor<T, Rank - N> quantile(const expression<Container, T, Rank> &a, double q,
                              const shape_t<N> &axes, const std::string &method,
                              dropdims_t) {
-  return detail::apply_over_axes<T>(ranges::quantile(q, method), a, axes,
-                                    dropdims);
+  tensor<T, Rank - N> out(detail::remove_axes(a.shape(), axes));
+  detail::quantile_over_axes(a, &q, 1, axes,
+                             detail::make_quantile_method(method), out.data(),
+                             "quantile");
+  return out;
+}
+
+template <class Container1, class T, size_t Rank, class Container2>
+tensor<T, 1> quantile(const expression<Container1, T, Rank> &a,
+                      const expression<Container2, double, 1> &q,
+                      const std::string &method) {
+  shape_t<Rank> axes;
+  for (size_t i = 0; i < Rank; ++i) {
+    axes[i] = i;
+  }
+  tensor<double, 1> q_values(q);
+  tensor<T, 1> out(q_values.size());
+  detail::quantile_over_axes(a, q_values.data(), q_values.size(), axes,
+                             detail::make_quantile_method(method), out.data(),
+                             "quantile");
+  return out;
+}
+
+template <class Container1, class T, size_t Rank, class Container2, size_t N>
+tensor<T, Rank - N + 1> quantile(const expression<Container1, T, Rank> &a,
+                                 const expression<Container2, double, 1> &q,
+                                 const shape_t<N> &axes,
+                                 const std::string &method) {
+  return quantile(a, q, axes, method, dropdims);
+}
+
+template <class Container1, class T, size_t Rank, class Container2, size_t N>
+tensor<T, Rank + 1> quantile(const expression<Container1, T, Rank> &a,
+                             const expression<Container2, double, 1> &q,
+                             const shape_t<N> &axes, const std::string &method,
+                             keepdims_t) {
+  shape_t<Rank> shape = a.shape();
+  for (size_t i = 0; i < N; ++i) {
+    shape[axes[i]] = 1;
+  }
+  tensor<double, 1> q_values(q);
+  tensor<T, Rank + 1> out(shape_cat(q_values.shape(), shape));
+  detail::quantile_over_axes(a, q_values.data(), q_values.size(), axes,
+                             detail::make_quantile_method(method), out.data(),
+                             "quantile");
+  return out;
+}
+
+template <class Container1, class T, size_t Rank, class Container2, size_t N>
+tensor<T, Rank - N + 1> quantile(const expression<Container1, T, Rank> &a,
+                                 const expression<Container2, double, 1> &q,
+                                 const shape_t<N> &axes,
+                                 const std::string &method, dropdims_t) {
+  tensor<double, 1> q_values(q);
+  tensor<T, Rank - N + 1> out(
+      shape_cat(q_values.shape(), detail::remove_axes(a.shape(), axes)));
+  detail::quantile_over_axes(a, q_values.data(), q_values.size(), axes,
+                             detail::make_quantile_method(method), out.data(),
+                             "quantile");
+  return out;
+}
+
+template <class Container1, class Key, class Container2, class T>
+std::pair<tensor<Key, 1>, tensor<T, 1>>
+groupby_reduce(const expression<Container1, Key, 1> &keys,
+               const expression<Container2, T, 1> &values,
+               const std::string &op) {
+  detail::assert_aligned_shapes(keys.shape(), 0, values.shape(), 0);
+  tensor<Key, 1> key_buffer;
+  tensor<T, 1> value_buffer;
+  const Key *key_data = detail::make_row_major(keys.self(), key_buffer);
+  const T *value_data = detail::make_row_major(values.self(), value_buffer);
+  size_t n = keys.size();
+  std::pair<tensor<Key, 1>, tensor<T, 1>> out;
+  tensor<size_t, 1> counts;
+  if (op == "sum" || op == "mean") {
+    detail::groupby_strided(plus(), key_data, value_data, n, out.first,
+                            out.second, counts);
+  } else if (op == "min") {
+    detail::groupby_strided(ranges::minimum(), key_data, value_data, n,
+                            out.first, out.second, counts);
+  } else if (op == "max") {
+    detail::groupby_strided(ranges::maximum(), key_data, value_data, n,
+                            out.first, out.second, counts);
+  } else if (op == "count") {
+    detail::groupby_strided(plus(), key_data, (const T *)NULL, n, out.first,
+                            out.second, counts);
+    out.second.resize(counts.size());
+    for (size_t i = 0; i < counts.size(); ++i) {
+      out.second[i] = T(counts[i]);
+    }
+  } else {
+    throw std::invalid_argument(
+        "op must be one of \"sum\", \"mean\", \"min\", \"max\" or "
+        "\"count\"");
+  }
+  if (op == "mean") {
+    for (size_t i = 0; i < counts.size(); ++i) {
+      out.second[i] /= T(counts[i]);
+    }
+  }
+  return out;
 }
 
 template <class Container1, class T, class Container2>
@@ -968,6 +1239,220 @@ tensor<T, 2> corrcoef(const expression<Container, T, 2> &a, bool rowvar) {
   }
   return out;
 }
+
+/// Histograms.
+
+template <class Container, class T>
+tensor<size_t, 1> bincount(const expression<Container, T, 1> &x,
+                           size_t minlength) {
+  tensor<T, 1> buffer;
+  const T *data = detail::make_row_major(x.self(), buffer);
+  size_t size = x.size();
+  tensor<size_t, 1> out(detail::bincount_size(data, size, minlength));
+  detail::histogram_fill([&](size_t i) { return size_t(data[i]); }, size,
+                         (const size_t *)NULL, out.size(), out.data());
+  return out;
+}
+
+template <class Container1, class T, class Container2, class W>
+tensor<W, 1> bincount(const expression<Container1, T, 1> &x,
+                      const expression<Container2, W, 1> &weights,
+                      size_t minlength) {
+  if (x.size() != weights.size()) {
+    throw std::invalid_argument("all the tensors must have the same shape");
+  }
+  tensor<T, 1> x_buffer;
+  tensor<W, 1> weights_buffer;
+  const T *data = detail::make_row_major(x.self(), x_buffer);
+  const W *w = detail::make_row_major(weights.self(), weights_buffer);
+  size_t size = x.size();
+  tensor<W, 1> out(detail::bincount_size(data, size, minlength));
+  detail::histogram_fill([&](size_t i) { return size_t(data[i]); }, size, w,
+                         out.size(), out.data());
+  return out;
+}
+
+template <class Container1, class T, size_t Rank, class Container2>
+tensor<size_t, Rank> digitize(const expression<Container1, T, Rank> &x,
+                              const expression<Container2, T, 1> &bins,
+                              bool right) {
+  tensor<T, 1> bins_buffer;
+  const T *edges = detail::make_row_major(bins.self(), bins_buffer);
+  size_t n = bins.size();
+  bool increasing = true, decreasing = true;
+  for (size_t i = 1; i < n; ++i) {
+    increasing = increasing && !(edges[i] < edges[i - 1]);
+    decreasing = decreasing && !(edges[i - 1] < edges[i]);
+  }
+  if (!increasing && !decreasing) {
+    throw std::invalid_argument(
+        "bins must be monotonically increasing or decreasing");
+  }
+  tensor<T, Rank> x_buffer;
+  const T *data = detail::make_row_major(x.self(), x_buffer);
+  tensor<size_t, Rank> out(x.shape());
+  if (increasing) {
+    detail::searchsorted_strided(edges, n, data, x.size(), !right,
+                                 out.data());
+  } else {
+    // Search in the reversed bins and count from the end.
+    std::vector<T> reversed(edges, edges + n);
+    std::reverse(reversed.begin(), reversed.end());
+    detail::searchsorted_strided(reversed.data(), n, data, x.size(), !right,
+                                 out.data());
+    for (size_t i = 0; i < out.size(); ++i) {
+      out.data()[i] = n - out.data()[i];
+    }
+  }
+  return out;
+}
+
+template <class Container, class T, size_t Rank>
+tensor<size_t, 1> histogram(const expression<Container, T, Rank> &a,
+                            size_t bins) {
+  tensor<T, Rank> buffer;
+  const T *data = detail::make_row_major(a.self(), buffer);
+  double first, last;
+  detail::histogram_range(data, a.size(), first, last);
+  detail::bin_locator locate(bins, first, last);
+  tensor<size_t, 1> out(bins);
+  detail::histogram1d_fill(data, a.size(), locate, (const size_t *)NULL,
+                           out.data());
+  return out;
+}
+
+template <class Container, class T, size_t Rank>
+tensor<size_t, 1> histogram(const expression<Container, T, Rank> &a,
+                            size_t bins, double first, double last) {
+  detail::bin_locator locate(bins, first, last);
+  tensor<T, Rank> buffer;
+  const T *data = detail::make_row_major(a.self(), buffer);
+  tensor<size_t, 1> out(bins);
+  detail::histogram1d_fill(data, a.size(), locate, (const size_t *)NULL,
+                           out.data());
+  return out;
+}
+
+template <class Container1, class T, size_t Rank, class Container2, class U>
+tensor<size_t, 1> histogram(const expression<Container1, T, Rank> &a,
+                            const expression<Container2, U, 1> &edges) {
+  tensor<U, 1> edges_buffer;
+  const U *e = detail::make_row_major(edges.self(), edges_buffer);
+  detail::bin_locator locate(e, edges.size());
+  tensor<T, Rank> buffer;
+  const T *data = detail::make_row_major(a.self(), buffer);
+  tensor<size_t, 1> out(locate.size());
+  detail::histogram1d_fill(data, a.size(), locate, (const size_t *)NULL,
+                           out.data());
+  return out;
+}
+
+template <class Container1, class T, size_t Rank, class Container2, class W>
+tensor<W, 1> histogram(const expression<Container1, T, Rank> &a, size_t bins,
+                       double first, double last,
+                       const expression<Container2, W, Rank> &weights) {
+  if (a.shape() != weights.shape()) {
+    throw std::invalid_argument("all the tensors must have the same shape");
+  }
+  detail::bin_locator locate(bins, first, last);
+  tensor<T, Rank> buffer;
+  tensor<W, Rank> weights_buffer;
+  const T *data = detail::make_row_major(a.self(), buffer);
+  const W *w = detail::make_row_major(weights.self(), weights_buffer);
+  tensor<W, 1> out(bins);
+  detail::histogram1d_fill(data, a.size(), locate, w, out.data());
+  return out;
+}
+
+template <class Container1, class T, size_t Rank, class Container2, class U,
+          class Container3, class W>
+tensor<W, 1> histogram(const expression<Container1, T, Rank> &a,
+                       const expression<Container2, U, 1> &edges,
+                       const expression<Container3, W, Rank> &weights) {
+  if (a.shape() != weights.shape()) {
+    throw std::invalid_argument("all the tensors must have the same shape");
+  }
+  tensor<U, 1> edges_buffer;
+  const U *e = detail::make_row_major(edges.self(), edges_buffer);
+  detail::bin_locator locate(e, edges.size());
+  tensor<T, Rank> buffer;
+  tensor<W, Rank> weights_buffer;
+  const T *data = detail::make_row_major(a.self(), buffer);
+  const W *w = detail::make_row_major(weights.self(), weights_buffer);
+  tensor<W, 1> out(locate.size());
+  detail::histogram1d_fill(data, a.size(), locate, w, out.data());
+  return out;
+}
+
+template <class Container1, class T, class Container2>
+tensor<size_t, 2> histogram2d(const expression<Container1, T, 1> &x,
+                              const expression<Container2, T, 1> &y,
+                              size_t bins) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("all the tensors must have the same shape");
+  }
+  tensor<T, 1> x_buffer, y_buffer;
+  const T *x_data = detail::make_row_major(x.self(), x_buffer);
+  const T *y_data = detail::make_row_major(y.self(), y_buffer);
+  double first, last;
+  detail::histogram_range(x_data, x.size(), first, last);
+  detail::bin_locator xlocate(bins, first, last);
+  detail::histogram_range(y_data, y.size(), first, last);
+  detail::bin_locator ylocate(bins, first, last);
+  tensor<size_t, 2> out(bins, bins);
+  detail::histogram2d_fill(x_data, y_data, x.size(), xlocate, ylocate,
+                           (const size_t *)NULL, out.data());
+  return out;
+}
+
+template <class Container1, class T, class Container2, class Container3,
+          class U, class Container4>
+tensor<size_t, 2> histogram2d(const expression<Container1, T, 1> &x,
+                              const expression<Container2, T, 1> &y,
+                              const expression<Container3, U, 1> &xedges,
+                              const expression<Container4, U, 1> &yedges) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("all the tensors must have the same shape");
+  }
+  tensor<U, 1> xedges_buffer, yedges_buffer;
+  const U *xe = detail::make_row_major(xedges.self(), xedges_buffer);
+  const U *ye = detail::make_row_major(yedges.self(), yedges_buffer);
+  detail::bin_locator xlocate(xe, xedges.size());
+  detail::bin_locator ylocate(ye, yedges.size());
+  tensor<T, 1> x_buffer, y_buffer;
+  const T *x_data = detail::make_row_major(x.self(), x_buffer);
+  const T *y_data = detail::make_row_major(y.self(), y_buffer);
+  tensor<size_t, 2> out(xlocate.size(), ylocate.size());
+  detail::histogram2d_fill(x_data, y_data, x.size(), xlocate, ylocate,
+                           (const size_t *)NULL, out.data());
+  return out;
+}
+
+template <class Container1, class T, class Container2, class Container3,
+          class U, class Container4, class Container5, class W>
+tensor<W, 2> histogram2d(const expression<Container1, T, 1> &x,
+                         const expression<Container2, T, 1> &y,
+                         const expression<Container3, U, 1> &xedges,
+                         const expression<Container4, U, 1> &yedges,
+                         const expression<Container5, W, 1> &weights) {
+  if (x.size() != y.size() || x.size() != weights.size()) {
+    throw std::invalid_argument("all the tensors must have the same shape");
+  }
+  tensor<U, 1> xedges_buffer, yedges_buffer;
+  const U *xe = detail::make_row_major(xedges.self(), xedges_buffer);
+  const U *ye = detail::make_row_major(yedges.self(), yedges_buffer);
+  detail::bin_locator xlocate(xe, xedges.size());
+  detail::bin_locator ylocate(ye, yedges.size());
+  tensor<T, 1> x_buffer, y_buffer;
+  tensor<W, 1> weights_buffer;
+  const T *x_data = detail::make_row_major(x.self(), x_buffer);
+  const T *y_data = detail::make_row_major(y.self(), y_buffer);
+  const W *w = detail::make_row_major(weights.self(), weights_buffer);
+  tensor<W, 2> out(xlocate.size(), ylocate.size());
+  detail::histogram2d_fill(x_data, y_data, x.size(), xlocate, ylocate, w,
+                           out.data());
+  return out;
+}
 } // namespace numcpp
 
 #endif // NUMCPP_ROUTINES_TCC_INCLUDED
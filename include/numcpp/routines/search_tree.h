@@ -0,0 +1,135 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/search_tree.h
+ *  This header defines the search_tree class used to search repeatedly in the
+ *  same sorted sequence.
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SEARCH_TREE_H_INCLUDED
+#define NUMCPP_SEARCH_TREE_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+namespace numcpp {
+/**
+ * @brief A search_tree object stores a sorted sequence in a layout suited for
+ * many binary searches against the same values, e.g., bucketing a large
+ * tensor against a fixed set of breakpoints.
+ *
+ * @details The values are stored in Eytzinger order, i.e., as an implicit
+ * binary search tree where the children of the node at position k are at
+ * positions 2k and 2k + 1. The first levels of the tree, which are visited by
+ * every search, are packed together at the beginning of the array and stay in
+ * cache, and the search only needs a comparison per level to decide which
+ * child to visit next.
+ *
+ * @tparam T Type of the values. It must be a totally ordered type.
+ */
+template <class T> class search_tree {
+public:
+  /// Member types.
+  typedef T value_type;
+  typedef size_t size_type;
+
+  /// Constructors.
+
+  /**
+   * @brief Constructs an empty tree.
+   */
+  search_tree();
+
+  /**
+   * @brief Constructs a tree from a sorted sequence.
+   *
+   * @param a A 1-dimensional tensor-like object with the values sorted in
+   *          ascending order.
+   *
+   * @throw std::invalid_argument Thrown if @a a is not sorted.
+   */
+  template <class Container>
+  explicit search_tree(const expression<Container, T, 1> &a);
+
+  /// Public methods.
+
+  /**
+   * @brief Return the number of values in the tree.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Return whether the tree is empty.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Return the index of the first value in the sorted sequence that is
+   * not less than @a val, or size() if there is no such value.
+   */
+  size_t lower_bound(const T &val) const;
+
+  /**
+   * @brief Return the index of the first value in the sorted sequence that is
+   * greater than @a val, or size() if there is no such value.
+   */
+  size_t upper_bound(const T &val) const;
+
+  /**
+   * @brief Find the indices into the sorted sequence such that, if the
+   * elements of @a v were inserted before the indices, the order would be
+   * preserved. Queries are distributed among the available threads.
+   *
+   * @param v A tensor-like object with the values to insert.
+   * @param side If "left", the index of the first suitable location is
+   *             returned. If "right", return the last such index. Default is
+   *             "left".
+   *
+   * @return A new tensor of insertion points with the same shape as @a v.
+   *
+   * @throw std::invalid_argument Thrown if @a side is not "left" or "right".
+   */
+  template <class Container, size_t Rank>
+  tensor<size_t, Rank> searchsorted(const expression<Container, T, Rank> &v,
+                                    const std::string &side = "left") const;
+
+private:
+  // Values in Eytzinger order. Position 0 is unused.
+  std::vector<T> m_tree;
+
+  // Index in the sorted sequence of each node.
+  std::vector<size_t> m_rank;
+
+  // Fill the subtree rooted at node k with the sorted values, starting at
+  // index i. Return the index of the next value.
+  size_t build(const T *data, size_t i, size_t k);
+
+  // Return the insertion point of a value.
+  size_t search(const T &val, bool right) const;
+
+  // Return the insertion points of a batch of values, searched in lockstep.
+  void search_batch(const T *v, size_t m, bool right, size_t *out) const;
+
+  // Return the insertion point of a search that ended at node k.
+  size_t leaf_rank(size_t k) const;
+};
+} // namespace numcpp
+
+#include "numcpp/routines/search_tree.tcc"
+
+#endif // NUMCPP_SEARCH_TREE_H_INCLUDED
@@ -0,0 +1,146 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/search_tree.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SEARCH_TREE_TCC_INCLUDED
+#define NUMCPP_SEARCH_TREE_TCC_INCLUDED
+
+#include <algorithm>
+#include <stdexcept>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/functional/scan.h"
+#include "numcpp/routines/searching.h"
+
+namespace numcpp {
+/// Constructors.
+
+template <class T> search_tree<T>::search_tree() : m_tree(1), m_rank(1) {}
+
+template <class T>
+template <class Container>
+search_tree<T>::search_tree(const expression<Container, T, 1> &a)
+    : m_tree(a.size() + 1), m_rank(a.size() + 1) {
+  tensor<T, 1> buffer;
+  const T *data = detail::make_row_major(a.self(), buffer);
+  for (size_t i = 1; i < a.size(); ++i) {
+    if (data[i] < data[i - 1]) {
+      throw std::invalid_argument("the values must be sorted in ascending "
+                                  "order");
+    }
+  }
+  build(data, 0, 1);
+}
+
+/// Public methods.
+
+template <class T> inline size_t search_tree<T>::size() const {
+  return m_tree.size() - 1;
+}
+
+template <class T> inline bool search_tree<T>::empty() const {
+  return (m_tree.size() == 1);
+}
+
+template <class T>
+inline size_t search_tree<T>::lower_bound(const T &val) const {
+  return search(val, false);
+}
+
+template <class T>
+inline size_t search_tree<T>::upper_bound(const T &val) const {
+  return search(val, true);
+}
+
+template <class T>
+template <class Container, size_t Rank>
+tensor<size_t, Rank>
+search_tree<T>::searchsorted(const expression<Container, T, Rank> &v,
+                             const std::string &side) const {
+  bool right = detail::make_search_side(side);
+  tensor<T, Rank> buffer;
+  const T *data = detail::make_row_major(v.self(), buffer);
+  tensor<size_t, Rank> out(v.shape());
+  size_t size = v.size();
+  size_t tasks = detail::num_tasks(size, size);
+  detail::parallel_for(tasks, [&](size_t task) {
+    size_t first = detail::block_begin(task, tasks, size);
+    size_t last = detail::block_begin(task + 1, tasks, size);
+    for (size_t i = first; i < last; i += detail::search_batch_size) {
+      size_t m = std::min(detail::search_batch_size, last - i);
+      search_batch(data + i, m, right, out.data() + i);
+    }
+  });
+  return out;
+}
+
+/// Private methods.
+
+template <class T>
+size_t search_tree<T>::build(const T *data, size_t i, size_t k) {
+  if (k < m_tree.size()) {
+    i = build(data, i, 2 * k);
+    m_tree[k] = data[i];
+    m_rank[k] = i++;
+    i = build(data, i, 2 * k + 1);
+  }
+  return i;
+}
+
+template <class T>
+inline size_t search_tree<T>::search(const T &val, bool right) const {
+  size_t n = m_tree.size() - 1;
+  size_t k = 1;
+  while (k <= n) {
+    k = 2 * k + detail::search_before(m_tree[k], val, right);
+  }
+  return leaf_rank(k);
+}
+
+template <class T>
+void search_tree<T>::search_batch(const T *v, size_t m, bool right,
+                                  size_t *out) const {
+  size_t n = m_tree.size() - 1;
+  size_t k[detail::search_batch_size];
+  std::fill_n(k, m, 1);
+  // Every search visits one node per level. Only the last level may be
+  // incomplete, in which case some of the searches stop one step earlier.
+  for (size_t level = n; level > 0; level >>= 1) {
+    for (size_t q = 0; q < m; ++q) {
+      size_t node = (k[q] <= n) ? k[q] : 0;
+      size_t next = 2 * k[q] + detail::search_before(m_tree[node], v[q], right);
+      k[q] = (node != 0) ? next : k[q];
+    }
+  }
+  for (size_t q = 0; q < m; ++q) {
+    out[q] = leaf_rank(k[q]);
+  }
+}
+
+template <class T> inline size_t search_tree<T>::leaf_rank(size_t k) const {
+  // The answer is the last node where the search went left. After it, the
+  // search only went right, so drop the trailing ones and the zero before.
+  k /= 2 * ((k + 1) & ~k);
+  return (k == 0) ? m_tree.size() - 1 : m_rank[k];
+}
+} // namespace numcpp
+
+#endif // NUMCPP_SEARCH_TREE_TCC_INCLUDED
@@ -0,0 +1,124 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/searching.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SEARCHING_H_INCLUDED
+#define NUMCPP_SEARCHING_H_INCLUDED
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "numcpp/functional/parallel.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Parse the side of a search.
+ *
+ * @return true for "right" and false for "left".
+ *
+ * @throw std::invalid_argument Thrown if @a side is not "left" or "right".
+ */
+inline bool make_search_side(const std::string &side) {
+  if (side == "left") {
+    return false;
+  } else if (side == "right") {
+    return true;
+  }
+  throw std::invalid_argument("side must be one of \"left\" or \"right\"");
+}
+
+/**
+ * @brief Predicate of a search. An element goes before the insertion point of
+ * @a val if it is less than @a val (left side), or if it is less than or equal
+ * to @a val (right side).
+ */
+template <class T>
+inline bool search_before(const T &elem, const T &val, bool right) {
+  return right ? !(val < elem) : (elem < val);
+}
+
+/**
+ * @brief Number of queries searched together. The queries advance through the
+ * sorted array in lockstep, so that their memory accesses overlap.
+ */
+const size_t search_batch_size = 8;
+
+/**
+ * @brief Find the insertion points of a batch of queries in a sorted array
+ * using a branchless binary search.
+ *
+ * @param a Pointer to the sorted array.
+ * @param n Number of elements in the sorted array.
+ * @param v Pointer to the queries.
+ * @param m Number of queries. Must be at most search_batch_size.
+ * @param right Whether to search for the right side.
+ * @param out Pointer to the insertion points.
+ */
+template <class T>
+void search_batch(const T *a, size_t n, const T *v, size_t m, bool right,
+                  size_t *out) {
+  if (n == 0) {
+    std::fill_n(out, m, 0);
+    return;
+  }
+  size_t base[search_batch_size] = {};
+  for (size_t len = n; len > 1;) {
+    size_t half = len / 2;
+    for (size_t q = 0; q < m; ++q) {
+      base[q] += search_before(a[base[q] + half], v[q], right) ? half : 0;
+    }
+    len -= half;
+  }
+  for (size_t q = 0; q < m; ++q) {
+    out[q] = base[q] + search_before(a[base[q]], v[q], right);
+  }
+}
+
+/**
+ * @brief Find the insertion points of a sequence of queries in a sorted array.
+ * The queries are distributed among the available threads.
+ *
+ * @param a Pointer to the sorted array.
+ * @param n Number of elements in the sorted array.
+ * @param v Pointer to the queries.
+ * @param size Number of queries.
+ * @param right Whether to search for the right side.
+ * @param out Pointer to the insertion points.
+ */
+template <class T>
+void searchsorted_strided(const T *a, size_t n, const T *v, size_t size,
+                          bool right, size_t *out) {
+  size_t tasks = num_tasks(size, size);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, size);
+    size_t last = block_begin(task + 1, tasks, size);
+    for (size_t i = first; i < last; i += search_batch_size) {
+      size_t m = std::min(search_batch_size, last - i);
+      search_batch(a, n, v + i, m, right, out + i);
+    }
+  });
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_SEARCHING_H_INCLUDED
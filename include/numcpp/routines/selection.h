@@ -0,0 +1,510 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/selection.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SELECTION_H_INCLUDED
+#define NUMCPP_SELECTION_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "numcpp/functional/parallel.h"
+#include "numcpp/functional/reduction.h"
+#include "numcpp/functional/scan.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Methods for estimating a quantile that lies between two data points.
+ */
+enum quantile_method_t {
+  quantile_lower,
+  quantile_higher,
+  quantile_midpoint,
+  quantile_nearest,
+  quantile_linear
+};
+
+/**
+ * @brief Parse the name of a quantile method.
+ *
+ * @throw std::invalid_argument Thrown if @a method is not one of "lower",
+ *                              "higher", "midpoint", "nearest" or "linear".
+ */
+inline quantile_method_t make_quantile_method(const std::string &method) {
+  if (method == "lower") {
+    return quantile_lower;
+  } else if (method == "higher") {
+    return quantile_higher;
+  } else if (method == "midpoint") {
+    return quantile_midpoint;
+  } else if (method == "nearest") {
+    return quantile_nearest;
+  } else if (method == "linear") {
+    return quantile_linear;
+  }
+  throw std::invalid_argument(
+      "method must be one of \"lower\", \"higher\", \"midpoint\", "
+      "\"nearest\" or \"linear\"");
+}
+
+/**
+ * @brief A set of quantiles to compute from sequences of a fixed size. It
+ * holds the sorted positions of the order statistics required by the
+ * quantiles, so that they can be selected at once for each sequence.
+ */
+class quantile_plan {
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param size Number of elements in each sequence. Must be positive.
+   * @param q Pointer to the quantiles to compute, which must be between 0 and
+   *          1 (inclusive).
+   * @param nq Number of quantiles.
+   * @param method Method to use for estimating the quantiles.
+   *
+   * @throw std::invalid_argument Thrown if any quantile is not in the range
+   *                              [0, 1].
+   */
+  quantile_plan(size_t size, const double *q, size_t nq,
+                quantile_method_t method)
+      : m_size(size), m_method(method), m_pos(nq), m_lower(nq), m_higher(nq) {
+    for (size_t i = 0; i < nq; ++i) {
+      if (!(0 <= q[i] && q[i] <= 1)) {
+        throw std::invalid_argument("quantiles must be in the range [0, 1]");
+      }
+      m_pos[i] = (size - 1) * q[i];
+      m_lower[i] = std::floor(m_pos[i]);
+      m_higher[i] = std::ceil(m_pos[i]);
+      m_ranks.push_back(m_lower[i]);
+      m_ranks.push_back(m_higher[i]);
+    }
+    std::sort(m_ranks.begin(), m_ranks.end());
+    m_ranks.erase(std::unique(m_ranks.begin(), m_ranks.end()), m_ranks.end());
+  }
+
+  /**
+   * @brief Return the number of elements in each sequence.
+   */
+  size_t size() const { return m_size; }
+
+  /**
+   * @brief Return the number of quantiles.
+   */
+  size_t num_quantiles() const { return m_pos.size(); }
+
+  /**
+   * @brief Rearrange the elements of a sequence so that every order statistic
+   * required by the quantiles is at its sorted position. This is done with a
+   * single multi-selection: each call to nth_element splits the sequence and
+   * the order statistics on each side are selected recursively.
+   *
+   * @param data Pointer to the sequence. It is modified by this function.
+   */
+  template <class T> void select(T *data) const {
+    select(data, 0, m_size, 0, m_ranks.size());
+  }
+
+  /**
+   * @brief Return the i-th quantile of a sequence previously rearranged by
+   * select.
+   */
+  template <class T> T get(const T *data, size_t i) const {
+    const T &lower = data[m_lower[i]];
+    const T &higher = data[m_higher[i]];
+    if (m_lower[i] == m_higher[i]) {
+      return lower;
+    }
+    switch (m_method) {
+    case quantile_lower:
+      return lower;
+    case quantile_higher:
+      return higher;
+    case quantile_midpoint:
+      return 0.5 * (lower + higher);
+    default:
+      double t = m_pos[i] - m_lower[i];
+      if (m_method == quantile_nearest) {
+        t = std::round(t);
+      }
+      return (1 - t) * lower + t * higher;
+    }
+  }
+
+private:
+  // Number of elements in each sequence.
+  size_t m_size;
+
+  // Method to use for estimating the quantiles.
+  quantile_method_t m_method;
+
+  // Position of each quantile in the sorted sequence and its neighbors.
+  std::vector<double> m_pos;
+  std::vector<size_t> m_lower, m_higher;
+
+  // Sorted positions of the order statistics to select.
+  std::vector<size_t> m_ranks;
+
+  template <class T>
+  void select(T *data, size_t first, size_t last, size_t rfirst,
+              size_t rlast) const {
+    while (rfirst < rlast) {
+      size_t rmid = rfirst + (rlast - rfirst) / 2;
+      size_t kth = m_ranks[rmid];
+      std::nth_element(data + first, data + kth, data + last);
+      select(data, first, kth, rfirst, rmid);
+      first = kth + 1;
+      rfirst = rmid + 1;
+    }
+  }
+};
+
+/**
+ * @brief Copy a strided memory array into a contiguous buffer.
+ *
+ * @tparam Rank Maximum number of axes.
+ *
+ * @param data Pointer to the first element of the strided array.
+ * @param ndim Number of axes.
+ * @param shape Number of elements along each axis.
+ * @param strides Span of the strided array along each axis.
+ * @param out Pointer to the buffer.
+ */
+template <size_t Rank, class T>
+void gather_strided(const T *data, size_t ndim, const size_t *shape,
+                    const size_t *strides, T *out) {
+  size_t inner = ndim - 1;
+  size_t outer_size = 1;
+  for (size_t i = 0; i < inner; ++i) {
+    outer_size *= shape[i];
+  }
+  size_t index[Rank] = {};
+  for (size_t n = 0; n < outer_size; ++n) {
+    if (strides[inner] == 1) {
+      std::copy(data, data + shape[inner], out);
+    } else {
+      for (size_t j = 0; j < shape[inner]; ++j) {
+        out[j] = data[j * strides[inner]];
+      }
+    }
+    out += shape[inner];
+    for (size_t i = inner; i-- > 0;) {
+      data += strides[i];
+      if (++index[i] < shape[i]) {
+        break;
+      }
+      data -= shape[i] * strides[i];
+      index[i] = 0;
+    }
+  }
+}
+
+/**
+ * @brief Compute quantiles over multiple axes of a strided memory array.
+ *
+ * @details The lanes along the reduced axes are copied into a scratch buffer,
+ * which is allocated once per thread, and all the requested order statistics
+ * are selected at once. Lanes are distributed among the available threads.
+ *
+ * @param a A tensor_view with the elements.
+ * @param axes Axes along which the quantiles are computed.
+ * @param plan The quantiles to compute.
+ * @param out Pointer to the output array. The i-th quantile of the n-th lane,
+ *            with lanes enumerated in row-major order, is stored at
+ *            out[i*q_stride + n].
+ * @param q_stride Span of the output array between consecutive quantiles.
+ */
+template <class T, size_t Rank, size_t N>
+void quantile_over_axes(const tensor_view<const T, Rank> &a,
+                        const shape_t<N> &axes, const quantile_plan &plan,
+                        T *out, size_t q_stride) {
+  bool reduced[Rank] = {};
+  for (size_t i = 0; i < N; ++i) {
+    reduced[axes[i]] = true;
+  }
+  size_t kdims[Rank], kstrides[Rank], nk = 0, outer_size = 1;
+  size_t rdims[Rank], rstrides[Rank], rzeros[Rank] = {}, nr = 0;
+  for (size_t i = 0; i < Rank; ++i) {
+    if (reduced[i]) {
+      rdims[nr] = a.shape(i);
+      rstrides[nr++] = a.strides(i);
+    } else {
+      kdims[nk] = a.shape(i);
+      kstrides[nk++] = a.strides(i);
+      outer_size *= a.shape(i);
+    }
+  }
+  nr = sort_axes_by_stride(nr, rdims, rstrides, rzeros);
+
+  size_t tasks = num_tasks(a.size(), outer_size);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, outer_size);
+    size_t last = block_begin(task + 1, tasks, outer_size);
+    std::vector<T> buffer(plan.size());
+    size_t index[Rank] = {};
+    const T *data = a.data();
+    for (size_t i = nk, n = first; i-- > 0;) {
+      index[i] = n % kdims[i];
+      n /= kdims[i];
+      data += index[i] * kstrides[i];
+    }
+    for (size_t n = first; n < last; ++n) {
+      gather_strided<Rank>(data, nr, rdims, rstrides, buffer.data());
+      plan.select(buffer.data());
+      for (size_t i = 0; i < plan.num_quantiles(); ++i) {
+        out[i * q_stride + n] = plan.get(buffer.data(), i);
+      }
+      for (size_t i = nk; i-- > 0;) {
+        data += kstrides[i];
+        if (++index[i] < kdims[i]) {
+          break;
+        }
+        data -= kdims[i] * kstrides[i];
+        index[i] = 0;
+      }
+    }
+  });
+}
+
+/**
+ * @brief Compute quantiles over multiple axes of a tensor.
+ *
+ * @param a A tensor-like object.
+ * @param q Pointer to the quantiles to compute.
+ * @param nq Number of quantiles.
+ * @param axes Axes along which the quantiles are computed.
+ * @param method Method to use for estimating the quantiles.
+ * @param out Pointer to the output array, stored as in quantile_over_axes.
+ * @param name Name of the statistic to report if a quantile is computed over
+ *             an empty axis.
+ */
+template <class Container, class T, size_t Rank, size_t N>
+void quantile_over_axes(const expression<Container, T, Rank> &a,
+                        const double *q, size_t nq, const shape_t<N> &axes,
+                        quantile_method_t method, T *out, const char *name) {
+  shape_t<Rank> shape = a.shape();
+  size_t size = 1;
+  for (size_t i = 0; i < N; ++i) {
+    size *= shape[axes[i]];
+    shape[axes[i]] = 1;
+  }
+  quantile_plan plan(std::max<size_t>(size, 1), q, nq, method);
+  size_t outer_size = shape.prod();
+  if (outer_size == 0) {
+    return;
+  }
+  if (size == 0) {
+    throw std::invalid_argument(std::string("attempt to get ") + name +
+                                " of an empty sequence");
+  }
+  tensor<T, Rank> buffer;
+  tensor_view<const T, Rank> view = make_strided_view(a.self(), buffer);
+  quantile_over_axes(view, axes, plan, out, outer_size);
+}
+
+/**
+ * @brief Maximum ratio between k and the size of a lane for which top-k
+ * selection uses a bounded heap instead of nth_element.
+ */
+const size_t topk_heap_ratio = 32;
+
+/**
+ * @brief Number of adjacent lanes staged together when the lanes are not
+ * contiguous.
+ */
+const size_t topk_tile_size = 16;
+
+/**
+ * @brief Select the k best elements of a contiguous lane, i.e., the elements
+ * that would come first if the lane were sorted by @a comp. Ties are broken by
+ * position, so the result is the same regardless of the strategy used.
+ *
+ * @details For small @a k, the elements are streamed through a bounded heap
+ * holding the best elements seen so far, which rejects most elements with a
+ * single comparison. Otherwise, the positions are partitioned with
+ * nth_element and, if requested, the first @a k are sorted.
+ *
+ * @param comp Comparator defining the order of the elements.
+ * @param lane Pointer to the lane.
+ * @param size Number of elements in the lane.
+ * @param k Number of elements to select. Must be positive.
+ * @param sorted Whether to return the selected elements in order.
+ * @param scratch Buffer for the positions. It is resized as needed.
+ * @param out On output, the positions of the selected elements.
+ */
+template <class Compare, class T>
+void topk_lane(Compare &comp, const T *lane, size_t size, size_t k,
+               bool sorted, std::vector<size_t> &scratch, size_t *out) {
+  auto better = [&](size_t i, size_t j) {
+    return comp(lane[i], lane[j]) || (!comp(lane[j], lane[i]) && i < j);
+  };
+  if (k * topk_heap_ratio <= size) {
+    // The top of the heap is the worst of the elements selected so far. A
+    // later element replaces it only if it is strictly better.
+    size_t *heap = out;
+    for (size_t i = 0; i < k; ++i) {
+      heap[i] = i;
+    }
+    std::make_heap(heap, heap + k, better);
+    for (size_t i = k; i < size; ++i) {
+      if (comp(lane[i], lane[heap[0]])) {
+        std::pop_heap(heap, heap + k, better);
+        heap[k - 1] = i;
+        std::push_heap(heap, heap + k, better);
+      }
+    }
+    if (sorted) {
+      std::sort_heap(heap, heap + k, better);
+    }
+    return;
+  }
+  scratch.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    scratch[i] = i;
+  }
+  if (k < size) {
+    std::nth_element(scratch.begin(), scratch.begin() + k, scratch.end(),
+                     better);
+  }
+  if (sorted) {
+    std::sort(scratch.begin(), scratch.begin() + k, better);
+  }
+  std::copy(scratch.begin(), scratch.begin() + k, out);
+}
+
+/**
+ * @brief Select the k best elements along the middle axis of a contiguous
+ * row-major array, i.e., the array is viewed as having shape
+ * (outer, size, inner).
+ *
+ * @details If inner is 1, each lane is contiguous and is processed in place.
+ * Otherwise, tiles of adjacent lanes are first copied into a contiguous
+ * buffer, one row at a time. Lanes are distributed among the available
+ * threads.
+ *
+ * @param comp Comparator defining the order of the elements.
+ * @param data Pointer to the input array.
+ * @param outer Number of elements before the axis.
+ * @param size Number of elements along the axis.
+ * @param inner Number of elements after the axis.
+ * @param k Number of elements to select. Must be positive.
+ * @param sorted Whether to return the selected elements in order.
+ * @param values Pointer to the output values, with shape (outer, k, inner), or
+ *               NULL.
+ * @param indices Pointer to the output positions along the axis, with shape
+ *                (outer, k, inner), or NULL.
+ */
+template <class Compare, class T>
+void topk_strided(Compare comp, const T *data, size_t outer, size_t size,
+                  size_t inner, size_t k, bool sorted, T *values,
+                  size_t *indices) {
+  size_t tile = std::min(inner, topk_tile_size);
+  size_t tiles_per_row = (inner + tile - 1) / tile;
+  size_t ntiles = outer * tiles_per_row;
+  size_t tasks = num_tasks(outer * size * inner, ntiles);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, ntiles);
+    size_t last = block_begin(task + 1, tasks, ntiles);
+    std::vector<T> buffer((inner > 1) ? tile * size : 0);
+    std::vector<size_t> scratch, selected(k);
+    for (size_t n = first; n < last; ++n) {
+      size_t i = n / tiles_per_row;
+      size_t j0 = (n % tiles_per_row) * tile;
+      size_t width = std::min(tile, inner - j0);
+      const T *in = data + i * size * inner + j0;
+      if (inner > 1) {
+        for (size_t r = 0; r < size; ++r) {
+          for (size_t l = 0; l < width; ++l) {
+            buffer[l * size + r] = in[r * inner + l];
+          }
+        }
+      }
+      for (size_t l = 0; l < width; ++l) {
+        const T *lane = (inner > 1) ? buffer.data() + l * size : in;
+        topk_lane(comp, lane, size, k, sorted, scratch, selected.data());
+        size_t offset = i * k * inner + j0 + l;
+        for (size_t r = 0; r < k; ++r) {
+          if (values != NULL) {
+            values[offset + r * inner] = lane[selected[r]];
+          }
+          if (indices != NULL) {
+            indices[offset + r * inner] = selected[r];
+          }
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Select the k largest or smallest elements along an axis of a tensor.
+ *
+ * @param a A tensor-like object.
+ * @param k Number of elements to select.
+ * @param axis Axis along which to select.
+ * @param largest Whether to select the largest or the smallest elements.
+ * @param sorted Whether to return the selected elements in order.
+ * @param values Pointer to the output values, or NULL.
+ * @param indices Pointer to the output indices, or NULL.
+ *
+ * @throw std::invalid_argument Thrown if @a k is greater than the size of the
+ *                              axis.
+ */
+template <class Container, class T, size_t Rank>
+void topk_over_axis(const expression<Container, T, Rank> &a, size_t k,
+                    size_t axis, bool largest, bool sorted, T *values,
+                    size_t *indices) {
+  shape_t<Rank> shape = a.shape();
+  size_t outer = 1, size = shape[axis], inner = 1;
+  if (k > size) {
+    std::ostringstream error;
+    error << "k = " << k << " is out of bounds for axis " << axis
+          << " with size " << size;
+    throw std::invalid_argument(error.str());
+  }
+  for (size_t i = 0; i < axis; ++i) {
+    outer *= shape[i];
+  }
+  for (size_t i = axis + 1; i < Rank; ++i) {
+    inner *= shape[i];
+  }
+  if (k == 0 || outer * inner == 0) {
+    return;
+  }
+  tensor<T, Rank> buffer;
+  const T *data = make_row_major(a.self(), buffer);
+  if (largest) {
+    topk_strided(greater(), data, outer, size, inner, k, sorted, values,
+                 indices);
+  } else {
+    topk_strided(less(), data, outer, size, inner, k, sorted, values,
+                 indices);
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_SELECTION_H_INCLUDED
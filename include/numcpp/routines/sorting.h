@@ -0,0 +1,500 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/sorting.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SORTING_H_INCLUDED
+#define NUMCPP_SORTING_H_INCLUDED
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "numcpp/functional/operators.h"
+#include "numcpp/functional/parallel.h"
+#include "numcpp/routines/radix_sort.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Whether a sort with the given comparator can use a radix sort.
+ */
+template <class T, class Compare>
+struct use_radix_sort
+    : std::integral_constant<bool, radix_traits<T>::value &&
+                                       std::is_same<Compare, less>::value> {};
+
+/**
+ * @brief Return how many elements of @a a are among the first @a k elements of
+ * the stable merge of two sorted sequences @a a and @a b.
+ */
+template <class T, class Compare>
+size_t merge_corank(const T *a, size_t na, const T *b, size_t nb, size_t k,
+                    Compare &comp) {
+  size_t lo = (k > nb) ? k - nb : 0;
+  size_t hi = std::min(k, na);
+  while (lo < hi) {
+    size_t i = lo + (hi - lo) / 2;
+    if (!comp(b[k - i - 1], a[i])) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+  return lo;
+}
+
+/**
+ * @brief Sort a range of values with a parallel merge sort.
+ *
+ * @details The range is split into one block per thread and the blocks are
+ * sorted in parallel. Then, adjacent runs are merged pairwise until a single
+ * run remains. Each merge round splits the output into equal parts and every
+ * part finds where its inputs begin by a binary search, so all the threads
+ * take part in every round, including the last one. The merges are stable,
+ * so the sort is stable if the blocks are sorted stably.
+ *
+ * @param data Pointer to the values to sort.
+ * @param size Number of values.
+ * @param comp Comparator. It may be called concurrently from several threads.
+ * @param stable Whether to preserve the relative order of equivalent values.
+ */
+template <class T, class Compare>
+void parallel_sort(T *data, size_t size, Compare comp, bool stable) {
+  size_t nblocks = num_tasks(size, size);
+  auto sort_block = [&](T *first, T *last) {
+    if (stable) {
+      std::stable_sort(first, last, comp);
+    } else {
+      std::sort(first, last, comp);
+    }
+  };
+  if (nblocks <= 1) {
+    sort_block(data, data + size);
+    return;
+  }
+  parallel_for(nblocks, [&](size_t b) {
+    sort_block(data + block_begin(b, nblocks, size),
+               data + block_begin(b + 1, nblocks, size));
+  });
+
+  std::vector<T> buffer(size);
+  std::vector<size_t> split(nblocks);
+  T *src = data, *dst = buffer.data();
+  // Runs of width blocks are merged pairwise into runs of 2 * width blocks.
+  for (size_t width = 1; width < nblocks; width *= 2) {
+    auto bounds = [&](size_t run, size_t &lo, size_t &mid, size_t &hi) {
+      lo = block_begin(run, nblocks, size);
+      mid = block_begin(std::min(run + width, nblocks), nblocks, size);
+      hi = block_begin(std::min(run + 2 * width, nblocks), nblocks, size);
+    };
+    // The splits are found before any element is moved, since the searches
+    // read elements that other tasks merge.
+    parallel_for(nblocks, [&](size_t task) {
+      size_t k = block_begin(task, nblocks, size), lo, mid, hi;
+      size_t run = 0;
+      for (bounds(run, lo, mid, hi); hi <= k; bounds(run, lo, mid, hi)) {
+        run += 2 * width;
+      }
+      split[task] =
+          merge_corank(src + lo, mid - lo, src + mid, hi - mid, k - lo, comp);
+    });
+    parallel_for(nblocks, [&](size_t task) {
+      size_t first = block_begin(task, nblocks, size);
+      size_t last = block_begin(task + 1, nblocks, size);
+      size_t run = 0, lo, mid, hi;
+      for (bounds(run, lo, mid, hi); hi <= first; bounds(run, lo, mid, hi)) {
+        run += 2 * width;
+      }
+      size_t i1 = split[task];
+      while (first < last) {
+        size_t end = std::min(last, hi);
+        size_t i2 = (end == hi) ? mid - lo : split[task + 1];
+        size_t k1 = first - lo, k2 = end - lo;
+        std::merge(std::make_move_iterator(src + lo + i1),
+                   std::make_move_iterator(src + lo + i2),
+                   std::make_move_iterator(src + mid + k1 - i1),
+                   std::make_move_iterator(src + mid + k2 - i2), dst + first,
+                   comp);
+        first = end;
+        run += 2 * width;
+        bounds(run, lo, mid, hi);
+        i1 = 0;
+      }
+    });
+    std::swap(src, dst);
+  }
+  if (src != data) {
+    parallel_for(nblocks, [&](size_t b) {
+      size_t first = block_begin(b, nblocks, size);
+      size_t last = block_begin(b + 1, nblocks, size);
+      std::move(src + first, src + last, data + first);
+    });
+  }
+}
+
+/**
+ * @brief Sort a range of values with a comparison sort.
+ */
+template <class T, class Compare>
+inline void sort_range(T *first, T *last, Compare comp, bool stable,
+                       std::false_type) {
+  parallel_sort(first, last - first, comp, stable);
+}
+
+/**
+ * @brief Sort a range of values with a radix sort.
+ */
+template <class T, class Compare>
+inline void sort_range(T *first, T *last, Compare, bool, std::true_type) {
+  radix_sort(first, last);
+}
+
+/**
+ * @brief Sort a range of values. A radix sort is used for 32 and 64-bit
+ * integer and floating point values sorted in ascending order. Otherwise, a
+ * parallel merge sort is used.
+ */
+template <class T, class Compare>
+inline void sort_range(T *first, T *last, Compare comp, bool stable) {
+  sort_range(first, last, comp, stable, use_radix_sort<T, Compare>());
+}
+
+/**
+ * @brief Return the permutation that sorts a sequence with a comparison sort.
+ */
+template <class T, class Index, class Compare>
+void argsort_range(const T *data, size_t size, Index *out, Compare comp,
+                   bool stable, std::false_type) {
+  std::iota(out, out + size, Index(0));
+  parallel_sort(
+      out, size, [&](Index i, Index j) { return comp(data[i], data[j]); },
+      stable);
+}
+
+/**
+ * @brief Return the permutation that sorts a sequence with a radix sort.
+ */
+template <class T, class Index, class Compare>
+inline void argsort_range(const T *data, size_t size, Index *out, Compare,
+                          bool, std::true_type) {
+  radix_argsort(data, size, out);
+}
+
+/**
+ * @brief Return the permutation that sorts a sequence. A radix sort is used
+ * for 32 and 64-bit integer and floating point values sorted in ascending
+ * order. Otherwise, a parallel merge sort is used.
+ *
+ * @param data Pointer to the values.
+ * @param size Number of values.
+ * @param out Pointer to the permutation.
+ * @param comp Comparator.
+ * @param stable Whether to preserve the relative order of equivalent values.
+ */
+template <class T, class Index, class Compare>
+inline void argsort_range(const T *data, size_t size, Index *out, Compare comp,
+                          bool stable) {
+  argsort_range(data, size, out, comp, stable, use_radix_sort<T, Compare>());
+}
+
+/**
+ * @brief Return a permutation that partitions a sequence, i.e., the position
+ * of the kth element is the one it would have in a sorted sequence, the
+ * elements before it are not greater and the elements after it are not less.
+ */
+template <class T, class Index, class Compare>
+void argpartition_range(const T *data, size_t size, size_t kth, Index *out,
+                        Compare comp) {
+  std::iota(out, out + size, Index(0));
+  std::nth_element(out, out + kth, out + size, [&](Index i, Index j) {
+    return comp(data[i], data[j]);
+  });
+}
+
+/**
+ * @brief Throws a std::invalid_argument exception if the positions of a
+ * sequence of the given size can't be represented by an index type.
+ */
+template <class Index> void assert_index_type(size_t size) {
+  static_assert(std::is_integral<Index>::value, "Index must be integral");
+  if (size > 0 && size - 1 > size_t(std::numeric_limits<Index>::max())) {
+    std::ostringstream error;
+    error << "index type is too small for a tensor of size " << size;
+    throw std::invalid_argument(error.str());
+  }
+}
+
+/**
+ * @brief Convert flat indices into tuples of indices. The indices are
+ * distributed among the available threads.
+ */
+template <class Index, size_t Rank>
+tensor<index_t<Rank>, 1> unravel_indices(const tensor<Index, 1> &indices,
+                                         const shape_t<Rank> &shape,
+                                         layout_t order) {
+  tensor<index_t<Rank>, 1> out(indices.size());
+  size_t size = indices.size();
+  size_t tasks = num_tasks(size, size);
+  parallel_for(tasks, [&](size_t task) {
+    size_t first = block_begin(task, tasks, size);
+    size_t last = block_begin(task + 1, tasks, size);
+    for (size_t i = first; i < last; ++i) {
+      out[i] = unravel_index(size_t(indices[i]), shape, order);
+    }
+  });
+  return out;
+}
+
+/**
+ * @brief Maximum number of bytes of a cache line. Lanes that are not
+ * contiguous are staged in batches that span a cache line.
+ */
+const size_t lane_batch_bytes = 64;
+
+/**
+ * @brief Maximum number of bytes of the staging buffer of a thread.
+ */
+const size_t lane_staging_bytes = size_t(1) << 23;
+
+/**
+ * @brief Return the number of lanes to stage together. Lanes along the
+ * innermost axis of the given layout are contiguous and are staged one at a
+ * time. Otherwise, adjacent lanes are staged together, so that every cache
+ * line read from the tensor is used by the whole batch.
+ */
+template <class T, size_t Rank>
+size_t lane_batch_size(const shape_t<Rank> &shape, size_t axis,
+                       layout_t order) {
+  size_t innermost = (order == row_major) ? Rank - 1 : 0;
+  if (axis == innermost) {
+    return 1;
+  }
+  size_t bytes = std::max<size_t>(shape[axis], 1) * sizeof(T);
+  size_t batch = std::min(lane_batch_bytes / sizeof(T),
+                          lane_staging_bytes / bytes);
+  return std::max<size_t>(batch, 1);
+}
+
+/**
+ * @brief Call a function for each batch of lanes of a tensor along an axis.
+ * The batches are distributed among the available threads.
+ *
+ * @tparam Workspace Type of a scratch object, e.g., a buffer. Each thread
+ *                   default constructs its own and reuses it for all its
+ *                   batches.
+ *
+ * @param shape Shape of the tensor.
+ * @param axis Axis of the lanes.
+ * @param order Order in which the lanes are visited. Lanes that are adjacent
+ *              in this order are batched together.
+ * @param batch Maximum number of lanes in a batch.
+ * @param f A function taking a pointer to the indices of the first element of
+ *          each lane, the number of lanes in the batch and the scratch object.
+ * @param parallel Whether to run the batches in parallel. Otherwise, the
+ *                 batches are visited in order by the calling thread.
+ */
+template <class Workspace, size_t Rank, class Function>
+void for_each_lane_batch(shape_t<Rank> shape, size_t axis, layout_t order,
+                         size_t batch, Function &&f, bool parallel = true) {
+  size_t size = shape.prod();
+  shape[axis] = 1;
+  size_t nlanes = shape.prod();
+  size_t nbatches = (nlanes + batch - 1) / batch;
+  size_t tasks = parallel ? num_tasks(size, nbatches) : 1;
+  auto run = [&](size_t task) {
+    Workspace work;
+    std::vector<index_t<Rank>> lanes(batch);
+    size_t last = block_begin(task + 1, tasks, nbatches);
+    for (size_t i = block_begin(task, tasks, nbatches); i < last; ++i) {
+      size_t first = i * batch;
+      size_t count = std::min(batch, nlanes - first);
+      for (size_t b = 0; b < count; ++b) {
+        lanes[b] = unravel_index(first + b, shape, order);
+      }
+      f(lanes.data(), count, work);
+    }
+  };
+  if (tasks <= 1) {
+    if (nbatches > 0) {
+      run(0);
+    }
+  } else {
+    parallel_for(tasks, run);
+  }
+}
+
+/**
+ * @brief Whether the elements of a tensor type are evenly spaced along each
+ * axis, so that a lane can be accessed through a pointer and a stride.
+ */
+template <class Container> struct is_strided : std::false_type {};
+
+template <class T, size_t Rank>
+struct is_strided<tensor<T, Rank>> : std::true_type {};
+
+template <class T, size_t Rank>
+struct is_strided<tensor_view<T, Rank>> : std::true_type {};
+
+/**
+ * @brief Return the distance in memory between consecutive elements of a
+ * lane of a strided tensor.
+ */
+template <class Container, size_t Rank>
+ptrdiff_t lane_stride(const Container &a, index_t<Rank> index, size_t axis) {
+  if (a.shape(axis) < 2) {
+    return 0;
+  }
+  const auto *first = &a[index];
+  index[axis] = 1;
+  return &a[index] - first;
+}
+
+/**
+ * @brief Copy a batch of lanes of a tensor along an axis into a contiguous
+ * buffer, one lane after another.
+ */
+template <class Container, size_t Rank, class OutputIt>
+void gather_lanes(const Container &a, const index_t<Rank> *lanes,
+                  size_t count, size_t axis, size_t size, OutputIt out,
+                  std::false_type) {
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t b = 0; b < count; ++b) {
+      index_t<Rank> index = lanes[b];
+      index[axis] = i;
+      out[b * size + i] = a[index];
+    }
+  }
+}
+
+template <class Container, size_t Rank, class OutputIt>
+void gather_lanes(const Container &a, const index_t<Rank> *lanes,
+                  size_t count, size_t axis, size_t size, OutputIt out,
+                  std::true_type) {
+  typedef typename Container::value_type T;
+  const T *origin[lane_batch_bytes];
+  ptrdiff_t stride = lane_stride(a, lanes[0], axis);
+  for (size_t b = 0; b < count; ++b) {
+    origin[b] = &a[lanes[b]];
+  }
+  // The lanes of a batch are adjacent, so the i-th elements of all the lanes
+  // share a few cache lines.
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t b = 0; b < count; ++b) {
+      out[b * size + i] = origin[b][ptrdiff_t(i) * stride];
+    }
+  }
+}
+
+/**
+ * @brief Copy a batch of lanes of a tensor along an axis into a contiguous
+ * buffer, one lane after another. A batch may have at most lane_batch_bytes
+ * lanes.
+ */
+template <class Container, size_t Rank, class OutputIt>
+inline void gather_lanes(const Container &a, const index_t<Rank> *lanes,
+                         size_t count, size_t axis, size_t size,
+                         OutputIt out) {
+  if (count > 0 && size > 0) {
+    gather_lanes(a, lanes, count, axis, size, out, is_strided<Container>());
+  }
+}
+
+/**
+ * @brief Copy a contiguous buffer back into a batch of lanes of a tensor along
+ * an axis. This is the inverse of gather_lanes.
+ */
+template <class InputIt, class Container, size_t Rank>
+void scatter_lanes(InputIt in, Container &a, const index_t<Rank> *lanes,
+                   size_t count, size_t axis, size_t size, std::false_type) {
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t b = 0; b < count; ++b) {
+      index_t<Rank> index = lanes[b];
+      index[axis] = i;
+      a[index] = in[b * size + i];
+    }
+  }
+}
+
+template <class InputIt, class Container, size_t Rank>
+void scatter_lanes(InputIt in, Container &a, const index_t<Rank> *lanes,
+                   size_t count, size_t axis, size_t size, std::true_type) {
+  typedef typename Container::value_type T;
+  T *origin[lane_batch_bytes];
+  ptrdiff_t stride = lane_stride(a, lanes[0], axis);
+  for (size_t b = 0; b < count; ++b) {
+    origin[b] = &a[lanes[b]];
+  }
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t b = 0; b < count; ++b) {
+      origin[b][ptrdiff_t(i) * stride] = in[b * size + i];
+    }
+  }
+}
+
+template <class InputIt, class Container, size_t Rank>
+inline void scatter_lanes(InputIt in, Container &a, const index_t<Rank> *lanes,
+                          size_t count, size_t axis, size_t size) {
+  if (count > 0 && size > 0) {
+    scatter_lanes(in, a, lanes, count, axis, size, is_strided<Container>());
+  }
+}
+
+/**
+ * @brief Apply a function to each lane of a tensor along an axis. Each batch
+ * of lanes is staged into a contiguous buffer, so the function works with raw
+ * pointers, and then copied back. The batches are distributed among the
+ * available threads.
+ *
+ * @param a The tensor to modify.
+ * @param axis Axis of the lanes.
+ * @param f A function taking a pointer to the first and past the last element
+ *          of a lane.
+ * @param parallel Whether to run the batches in parallel. Otherwise, the lanes
+ *                 are visited in row-major order by the calling thread.
+ */
+template <class Container, class T, size_t Rank, class Function>
+void transform_lanes(dense_tensor<Container, T, Rank> &a, size_t axis,
+                     Function &&f, bool parallel = true) {
+  Container &self = a.self();
+  size_t size = self.shape(axis);
+  layout_t order = parallel ? self.layout() : row_major;
+  size_t batch = lane_batch_size<T>(self.shape(), axis, self.layout());
+  for_each_lane_batch<std::vector<T>>(
+      self.shape(), axis, order, batch,
+      [&](const index_t<Rank> *lanes, size_t count, std::vector<T> &buffer) {
+        buffer.resize(count * size);
+        gather_lanes(self, lanes, count, axis, size, buffer.data());
+        for (size_t b = 0; b < count; ++b) {
+          f(buffer.data() + b * size, buffer.data() + (b + 1) * size);
+        }
+        scatter_lanes(buffer.data(), self, lanes, count, axis, size);
+      },
+      parallel);
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_SORTING_H_INCLUDED
@@ -0,0 +1,188 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/sorting_network.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SORTING_NETWORK_H_INCLUDED
+#define NUMCPP_SORTING_NETWORK_H_INCLUDED
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "numcpp/functional/operators.h"
+#include "numcpp/routines/sorting.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Maximum length of the lanes sorted with a sorting network.
+ */
+const size_t sorting_network_max_size = 64;
+
+/**
+ * @brief Number of lanes sorted together by a sorting network. It can't be
+ * greater than lane_batch_bytes.
+ */
+const size_t sorting_network_batch = 64;
+
+/**
+ * @brief Whether lanes of the given type can be sorted with a sorting network.
+ * Only arithmetic types sorted in ascending order with the default comparator
+ * are supported, since their comparisons can be computed without branches.
+ */
+template <class T, class Compare>
+struct use_sorting_network
+    : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                       std::is_same<Compare, less>::value> {};
+
+/**
+ * @brief Return the comparators of Batcher's odd-even merge sort network for
+ * @a n elements. Each comparator is a pair of positions i < j whose elements
+ * are swapped if they are out of order.
+ */
+inline std::vector<std::pair<size_t, size_t>> sorting_network(size_t n) {
+  std::vector<std::pair<size_t, size_t>> network;
+  for (size_t p = 1; p < n; p *= 2) {
+    for (size_t k = p; k >= 1; k /= 2) {
+      for (size_t j = k % p; j + k < n; j += 2 * k) {
+        for (size_t i = 0; i < std::min(k, n - j - k); ++i) {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+            network.push_back(std::make_pair(i + j, i + j + k));
+          }
+        }
+      }
+    }
+  }
+  return network;
+}
+
+/**
+ * @brief Return whether a sequence contains a value that is not equal to
+ * itself, i.e., a NaN.
+ */
+template <class T> bool has_nan(const T *data, size_t size) {
+  bool found = false;
+  for (size_t i = 0; i < size; ++i) {
+    found |= (data[i] != data[i]);
+  }
+  return found;
+}
+
+/**
+ * @brief Sort a batch of sorting_network_batch lanes with a sorting network.
+ *
+ * @details The lanes are stored by rows, i.e., the i-th element of the b-th
+ * lane is at position i * sorting_network_batch + b. Each comparator then
+ * compares two rows element-wise. The rows have a fixed length and the
+ * results are computed into local arrays before being stored, so the compiler
+ * turns each comparator into a few vector instructions.
+ *
+ * @param rows Pointer to the elements.
+ * @param network The comparators of the network.
+ */
+template <class T>
+void sorting_network_rows(
+    T *rows, const std::vector<std::pair<size_t, size_t>> &network) {
+  const size_t width = sorting_network_batch;
+  for (size_t c = 0; c < network.size(); ++c) {
+    T *x = rows + network[c].first * width;
+    T *y = rows + network[c].second * width;
+    T lo[width], hi[width];
+    for (size_t b = 0; b < width; ++b) {
+      lo[b] = (y[b] < x[b]) ? y[b] : x[b];
+      hi[b] = (y[b] < x[b]) ? x[b] : y[b];
+    }
+    std::copy(lo, lo + width, x);
+    std::copy(hi, hi + width, y);
+  }
+}
+
+/**
+ * @brief Sort the short lanes of a tensor along an axis with a sorting
+ * network. Batches of adjacent lanes are staged by rows and sorted together.
+ * The batches are distributed among the available threads.
+ *
+ * @return Whether the lanes were sorted. Lanes of other types or longer than
+ *         sorting_network_max_size are not sorted.
+ */
+template <class Container, class T, size_t Rank, class Compare>
+inline bool sort_short_lanes(dense_tensor<Container, T, Rank> &, size_t,
+                             Compare, std::false_type) {
+  return false;
+}
+
+template <class Container, class T, size_t Rank, class Compare>
+bool sort_short_lanes(dense_tensor<Container, T, Rank> &a, size_t axis,
+                      Compare comp, std::true_type) {
+  Container &self = a.self();
+  size_t size = self.shape(axis);
+  if (size < 2 || size > sorting_network_max_size) {
+    return false;
+  }
+  std::vector<std::pair<size_t, size_t>> network = sorting_network(size);
+  for_each_lane_batch<std::vector<T>>(
+      self.shape(), axis, self.layout(), sorting_network_batch,
+      [&](const index_t<Rank> *lanes, size_t count, std::vector<T> &buffer) {
+        const size_t width = sorting_network_batch;
+        buffer.resize((count + width) * size);
+        T *data = buffer.data(), *rows = buffer.data() + count * size;
+        gather_lanes(self, lanes, count, axis, size, data);
+        if (has_nan(data, count * size)) {
+          // NaNs are not ordered, so they are left to the general sort.
+          for (size_t b = 0; b < count; ++b) {
+            sort_range(data + b * size, data + (b + 1) * size, comp, false);
+          }
+        } else {
+          // The last batch is padded with copies of its last lane.
+          for (size_t b = 0; b < width; ++b) {
+            const T *lane = data + std::min(b, count - 1) * size;
+            for (size_t i = 0; i < size; ++i) {
+              rows[i * width + b] = lane[i];
+            }
+          }
+          sorting_network_rows(rows, network);
+          for (size_t b = 0; b < count; ++b) {
+            for (size_t i = 0; i < size; ++i) {
+              data[b * size + i] = rows[i * width + b];
+            }
+          }
+        }
+        scatter_lanes(data, self, lanes, count, axis, size);
+      });
+  return true;
+}
+
+/**
+ * @brief Sort the lanes of a tensor along an axis with a sorting network if
+ * they are short enough and their type is supported.
+ *
+ * @return Whether the lanes were sorted.
+ */
+template <class Container, class T, size_t Rank, class Compare>
+inline bool sort_short_lanes(dense_tensor<Container, T, Rank> &a, size_t axis,
+                             Compare comp) {
+  return sort_short_lanes(a, axis, comp, use_sorting_network<T, Compare>());
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_SORTING_NETWORK_H_INCLUDED
@@ -0,0 +1,216 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/summary.h
+ *  This header defines the summary_t class used to compute descriptive
+ *  statistics in a single pass.
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_SUMMARY_H_INCLUDED
+#define NUMCPP_SUMMARY_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+
+namespace numcpp {
+/**
+ * @brief A summary_t object holds descriptive statistics of a sequence of
+ * values: the number of elements, the number of non-zero elements, the minimum,
+ * the maximum, the mean and the variance. A summary can be updated one value at
+ * a time and merged with the summary of another sequence, so that summaries of
+ * different parts of a tensor can be computed independently and then combined.
+ *
+ * @tparam T Type of the values. It must be an arithmetic type.
+ */
+template <class T> struct summary_t {
+  /// Member types.
+  typedef T value_type;
+  typedef typename detail::promote<T>::type float_type;
+
+  /// Number of elements.
+  size_t count;
+
+  /// Number of non-zero elements.
+  size_t nonzero;
+
+  /// Minimum and maximum values.
+  T min, max;
+
+  /// Arithmetic mean.
+  float_type mean;
+
+  /// Sum of squared deviations from the mean.
+  float_type m2;
+
+  /// Constructors.
+
+  /**
+   * @brief Default constructor. Constructs the summary of an empty sequence.
+   */
+  summary_t() : count(0), nonzero(0), min(), max(), mean(0), m2(0) {}
+
+  /// Public methods.
+
+  /**
+   * @brief Update the summary with a new value.
+   *
+   * @param val Value to add.
+   */
+  void push(const T &val) {
+    ++count;
+    if (!(val == T())) {
+      ++nonzero;
+    }
+    if (count == 1) {
+      min = max = val;
+    } else if (val < min) {
+      min = val;
+    } else if (max < val) {
+      max = val;
+    }
+    float_type delta = val - mean;
+    mean += delta / count;
+    m2 += delta * (val - mean);
+  }
+
+  /**
+   * @brief Update the summary with the values of another sequence.
+   *
+   * @param other Summary of the sequence to add.
+   */
+  void merge(const summary_t &other) {
+    if (other.count == 0) {
+      return;
+    }
+    if (count == 0) {
+      *this = other;
+      return;
+    }
+    size_t n = count + other.count;
+    float_type delta = other.mean - mean;
+    float_type weight = float_type(other.count) / n;
+    mean += delta * weight;
+    m2 += other.m2 + delta * delta * count * weight;
+    if (other.min < min) {
+      min = other.min;
+    }
+    if (max < other.max) {
+      max = other.max;
+    }
+    nonzero += other.nonzero;
+    count = n;
+  }
+
+  /**
+   * @brief Return the variance of the sequence.
+   *
+   * @param bias If @a bias is true, then normalization is by @a count.
+   *             Otherwise, normalization is by @a count - 1. Defaults to true.
+   */
+  float_type var(bool bias = true) const { return m2 / (count - 1 + bias); }
+
+  /**
+   * @brief Return the standard deviation of the sequence.
+   *
+   * @param bias If @a bias is true, then normalization is by @a count.
+   *             Otherwise, normalization is by @a count - 1. Defaults to true.
+   */
+  float_type stddev(bool bias = true) const { return std::sqrt(var(bias)); }
+};
+
+namespace detail {
+/**
+ * @brief Number of elements summarized at once. Each block is traversed twice,
+ * first for the mean and then for the squared deviations, so it should fit in
+ * the cache.
+ */
+const size_t summary_block_size = 4096;
+
+/**
+ * @brief Return the summary of a block of a strided memory array.
+ */
+template <class T>
+summary_t<T> summarize_block(const T *data, size_t size, size_t stride) {
+  typedef typename summary_t<T>::float_type float_type;
+  summary_t<T> out;
+  T min = data[0], max = data[0];
+  float_type sum = 0;
+  size_t zeros = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const T &val = data[i * stride];
+    min = (val < min) ? val : min;
+    max = (max < val) ? val : max;
+    sum += val;
+    zeros += (val == T());
+  }
+  float_type mean = sum / size;
+  float_type m2 = 0;
+  for (size_t i = 0; i < size; ++i) {
+    float_type delta = data[i * stride] - mean;
+    m2 += delta * delta;
+  }
+  out.count = size;
+  out.nonzero = size - zeros;
+  out.min = min;
+  out.max = max;
+  out.mean = mean;
+  out.m2 = m2;
+  return out;
+}
+
+/**
+ * @brief Return the summary of a strided memory array.
+ */
+template <class T>
+summary_t<T> summarize(const T *data, size_t size, size_t stride) {
+  summary_t<T> out;
+  for (size_t i = 0; i < size; i += summary_block_size) {
+    size_t n = std::min(summary_block_size, size - i);
+    out.merge(summarize_block(data + i * stride, n, stride));
+  }
+  return out;
+}
+
+/**
+ * @brief Function object implementing summary_t::push.
+ */
+struct summary_push {
+  template <class T>
+  summary_t<T> operator()(summary_t<T> summary, const T &val) const {
+    summary.push(val);
+    return summary;
+  }
+};
+
+/**
+ * @brief Lane kernel used by the reduction engine to summarize a whole lane
+ * at once.
+ */
+template <class T>
+inline void reduce_lane(summary_push &, const T *data, size_t size,
+                        size_t stride, summary_t<T> *out, bool first) {
+  if (first) {
+    *out = summarize(data, size, stride);
+  } else {
+    out->merge(summarize(data, size, stride));
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_SUMMARY_H_INCLUDED
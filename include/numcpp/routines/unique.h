@@ -0,0 +1,387 @@
+/*
+ * This file is part of the NumCpp project.
+ *
+ * NumCPP is a package for scientific computing in C++. It is a C++ library that
+ * provides support for multidimensional arrays, and defines an assortment of
+ * routines for fast operations on them, including mathematical, logical,
+ * sorting, selecting, I/O and much more.
+ *
+ * NumCPP comes from Numeric C++ and, as the name suggests, is a package
+ * inspired by the NumPy package for Python, although it is completely
+ * independent from its Python counterpart.
+ *
+ * This program is free software: you can redistribute it and/or modify it by
+ * giving enough credit to its creators.
+ */
+
+/** @file include/numcpp/routines/unique.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{numcpp/routines.h}
+ */
+
+// Written by Victor Daniel Alvarado Estrella (https://github.com/vdae2304).
+
+#ifndef NUMCPP_UNIQUE_H_INCLUDED
+#define NUMCPP_UNIQUE_H_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "numcpp/functional/operators.h"
+#include "numcpp/functional/parallel.h"
+#include "numcpp/routines/sorting.h"
+
+namespace numcpp {
+namespace detail {
+/**
+ * @brief Whether the unique values of a type can be found with a hash table.
+ * Only integer types are hashed. Other types are sorted.
+ */
+template <class T>
+struct use_hash_unique
+    : std::integral_constant<bool, std::is_integral<T>::value> {};
+
+/**
+ * @brief A hash table with open addressing and linear probing that maps each
+ * distinct key to the order in which it was inserted.
+ *
+ * @details The keys are stored inline in the slots, so a probe is a scan over
+ * contiguous memory. The table doubles its capacity when it is half full.
+ */
+template <class T> class hash_index {
+public:
+  /**
+   * @brief Constructs an empty table.
+   */
+  hash_index() : m_slots(16), m_size(0) {}
+
+  /**
+   * @brief Return the number of distinct keys.
+   */
+  size_t size() const { return m_size; }
+
+  /**
+   * @brief Return the distinct keys in insertion order.
+   */
+  const std::vector<T> &keys() const { return m_keys; }
+
+  /**
+   * @brief Return the position of a key, inserting it if it is not present
+   * yet.
+   */
+  size_t insert(const T &key, bool &inserted) {
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+      if (m_slots[i].id == 0) {
+        inserted = true;
+        m_slots[i].key = key;
+        m_slots[i].id = ++m_size;
+        m_keys.push_back(key);
+        if (2 * m_size > m_slots.size()) {
+          rehash(2 * m_slots.size());
+        }
+        return m_size - 1;
+      } else if (m_slots[i].key == key) {
+        inserted = false;
+        return m_slots[i].id - 1;
+      }
+    }
+  }
+
+private:
+  // A slot holds a key and its position plus one. Empty slots hold zero.
+  struct slot {
+    T key;
+    size_t id;
+    slot() : key(), id(0) {}
+  };
+
+  std::vector<slot> m_slots;
+  std::vector<T> m_keys;
+  size_t m_size;
+
+  // Multiplicative hashing. The high bits of the product are the best mixed,
+  // so they are folded into the low bits used to index the slots.
+  static size_t hash(const T &key) {
+    uint64_t h = uint64_t(key) * 0x9E3779B97F4A7C15ULL;
+    return size_t(h ^ (h >> 32));
+  }
+
+  void rehash(size_t capacity) {
+    std::vector<slot> slots(capacity);
+    size_t mask = capacity - 1;
+    for (size_t j = 0; j < m_slots.size(); ++j) {
+      if (m_slots[j].id != 0) {
+        size_t i = hash(m_slots[j].key) & mask;
+        while (slots[i].id != 0) {
+          i = (i + 1) & mask;
+        }
+        slots[i] = m_slots[j];
+      }
+    }
+    m_slots.swap(slots);
+  }
+};
+
+/**
+ * @brief Minimum number of elements to find the unique values with a hash
+ * table. Shorter sequences are sorted.
+ */
+const size_t hash_unique_threshold = 4096;
+
+/**
+ * @brief Number of elements sampled to estimate the number of unique values.
+ * The hash table is only faster than sorting while it fits in cache, i.e., up
+ * to a few thousand unique values, and a sample of this size tells apart such
+ * sequences from those with many unique values.
+ */
+const size_t hash_unique_sample = 16384;
+
+/**
+ * @brief Maximum number of blocks in which the elements are split to find the
+ * unique values with a hash table. Each block builds its own table. The
+ * blocks don't depend on the number of threads, so neither does the result.
+ */
+const size_t hash_unique_max_blocks = 64;
+
+/**
+ * @brief Output of unique_range. Null pointers are not computed.
+ */
+template <class T> struct unique_output {
+  tensor<T, 1> *values;
+  tensor<size_t, 1> *index;
+  size_t *inverse;
+  tensor<size_t, 1> *counts;
+};
+
+/**
+ * @brief Write the output of unique_range given the group of each element in
+ * sorted order.
+ *
+ * @param data Pointer to the elements.
+ * @param order The elements in sorted order. If NULL, the elements are
+ *              already sorted.
+ * @param n Number of elements.
+ * @param out The output.
+ */
+template <class T>
+void unique_runs(const T *data, const size_t *order, size_t n,
+                 const unique_output<T> &out) {
+  auto at = [&](size_t i) { return (order != NULL) ? order[i] : i; };
+  // Find the first element of each run of equal values.
+  size_t nblocks = std::max<size_t>(num_tasks(n, n), 1);
+  std::vector<size_t> runs(nblocks + 1, 0);
+  parallel_for(nblocks, [&](size_t b) {
+    size_t last = block_begin(b + 1, nblocks, n);
+    for (size_t i = block_begin(b, nblocks, n); i < last; ++i) {
+      runs[b + 1] += (i == 0 || !(data[at(i - 1)] == data[at(i)]));
+    }
+  });
+  std::partial_sum(runs.begin(), runs.end(), runs.begin());
+  size_t groups = runs[nblocks];
+  std::vector<size_t> starts(groups + 1, n);
+  parallel_for(nblocks, [&](size_t b) {
+    size_t g = runs[b];
+    size_t last = block_begin(b + 1, nblocks, n);
+    for (size_t i = block_begin(b, nblocks, n); i < last; ++i) {
+      if (i == 0 || !(data[at(i - 1)] == data[at(i)])) {
+        starts[g++] = i;
+      }
+    }
+  });
+
+  out.values->resize(groups);
+  if (out.index != NULL) {
+    out.index->resize(groups);
+  }
+  if (out.counts != NULL) {
+    out.counts->resize(groups);
+  }
+  size_t tasks = num_tasks(n, groups);
+  parallel_for(tasks, [&](size_t task) {
+    size_t last = block_begin(task + 1, tasks, groups);
+    for (size_t g = block_begin(task, tasks, groups); g < last; ++g) {
+      (*out.values)[g] = data[at(starts[g])];
+      if (out.index != NULL) {
+        (*out.index)[g] = at(starts[g]);
+      }
+      if (out.counts != NULL) {
+        (*out.counts)[g] = starts[g + 1] - starts[g];
+      }
+      if (out.inverse != NULL) {
+        for (size_t i = starts[g]; i < starts[g + 1]; ++i) {
+          out.inverse[at(i)] = g;
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Find the unique values of a sequence by sorting.
+ */
+template <class T>
+void unique_sort(const T *data, size_t n, const unique_output<T> &out) {
+  if (out.index == NULL && out.inverse == NULL && out.counts == NULL) {
+    std::vector<T> buffer(data, data + n);
+    sort_range(buffer.data(), buffer.data() + n, less(), false);
+    unique_runs(buffer.data(), (const size_t *)NULL, n, out);
+  } else {
+    // A stable sort keeps the first occurrence of each value at the front of
+    // its run.
+    std::vector<size_t> order(n);
+    argsort_range(data, n, order.data(), less(), true);
+    unique_runs(data, order.data(), n, out);
+  }
+}
+
+/**
+ * @brief Return whether a sequence seems to have few unique values compared to
+ * its size, judging by an evenly spaced sample.
+ */
+template <class T> bool has_few_unique(const T *data, size_t n) {
+  size_t m = std::min(n, hash_unique_sample);
+  hash_index<T> table;
+  for (size_t i = 0; i < m; ++i) {
+    bool inserted;
+    table.insert(data[i * (n / m)], inserted);
+  }
+  return 2 * table.size() <= m;
+}
+
+/**
+ * @brief Find the unique values of a sequence with a hash table.
+ *
+ * @details The elements are split into blocks and each block finds its
+ * distinct values in parallel. The tables are merged in block order, so the
+ * first occurrence of each value is the first one to be merged. Finally, the
+ * distinct values are sorted and the position of each element is mapped to
+ * the position of its value in sorted order.
+ */
+template <class T>
+void unique_hash(const T *data, size_t n, const unique_output<T> &out) {
+  struct block_table {
+    hash_index<T> table;
+    std::vector<size_t> first;
+    std::vector<size_t> counts;
+  };
+  size_t nblocks =
+      std::min(hash_unique_max_blocks, n / parallel_grain_size + 1);
+  std::vector<block_table> tables(nblocks);
+  parallel_for(nblocks, [&](size_t b) {
+    block_table &block = tables[b];
+    size_t last = block_begin(b + 1, nblocks, n);
+    for (size_t i = block_begin(b, nblocks, n); i < last; ++i) {
+      bool inserted;
+      size_t g = block.table.insert(data[i], inserted);
+      if (inserted) {
+        block.first.push_back(i);
+        block.counts.push_back(0);
+      }
+      ++block.counts[g];
+      if (out.inverse != NULL) {
+        out.inverse[i] = g;
+      }
+    }
+  });
+
+  // Merge the tables in block order. The position of each local value in the
+  // merged table overwrites its count, which is no longer needed.
+  hash_index<T> total;
+  std::vector<size_t> first, counts;
+  for (size_t b = 0; b < nblocks; ++b) {
+    block_table &block = tables[b];
+    const std::vector<T> &keys = block.table.keys();
+    for (size_t g = 0; g < keys.size(); ++g) {
+      bool inserted;
+      size_t h = total.insert(keys[g], inserted);
+      if (inserted) {
+        first.push_back(block.first[g]);
+        counts.push_back(0);
+      }
+      counts[h] += block.counts[g];
+      block.counts[g] = h;
+    }
+    block.table = hash_index<T>();
+  }
+
+  // Sort the distinct values.
+  size_t groups = total.size();
+  std::vector<size_t> order(groups), rank(groups);
+  argsort_range(total.keys().data(), groups, order.data(), less(), false);
+  out.values->resize(groups);
+  if (out.index != NULL) {
+    out.index->resize(groups);
+  }
+  if (out.counts != NULL) {
+    out.counts->resize(groups);
+  }
+  for (size_t g = 0; g < groups; ++g) {
+    rank[order[g]] = g;
+    (*out.values)[g] = total.keys()[order[g]];
+    if (out.index != NULL) {
+      (*out.index)[g] = first[order[g]];
+    }
+    if (out.counts != NULL) {
+      (*out.counts)[g] = counts[order[g]];
+    }
+  }
+  if (out.inverse != NULL) {
+    parallel_for(nblocks, [&](size_t b) {
+      const std::vector<size_t> &global = tables[b].counts;
+      size_t last = block_begin(b + 1, nblocks, n);
+      for (size_t i = block_begin(b, nblocks, n); i < last; ++i) {
+        out.inverse[i] = rank[global[out.inverse[i]]];
+      }
+    });
+  }
+}
+
+/**
+ * @brief Find the unique values of a sequence by sorting or hashing.
+ */
+template <class T>
+inline void unique_range(const T *data, size_t n, const unique_output<T> &out,
+                         std::false_type) {
+  unique_sort(data, n, out);
+}
+
+template <class T>
+inline void unique_range(const T *data, size_t n, const unique_output<T> &out,
+                         std::true_type) {
+  if (n >= hash_unique_threshold && has_few_unique(data, n)) {
+    unique_hash(data, n, out);
+  } else {
+    unique_sort(data, n, out);
+  }
+}
+
+/**
+ * @brief Find the sorted unique values of a sequence.
+ *
+ * @details If the sequence is already sorted, the runs of equal values are
+ * found in a single pass. Otherwise, integer sequences with few unique values
+ * compared to their size are hashed, and every other sequence is sorted.
+ *
+ * @param data Pointer to the elements.
+ * @param n Number of elements.
+ * @param out The output. On output, values contains the unique values in
+ *            ascending order. If not null, index contains the position of the
+ *            first occurrence of each unique value, inverse the position in
+ *            values of each element and counts the number of times each
+ *            unique value appears.
+ */
+template <class T>
+void unique_range(const T *data, size_t n, const unique_output<T> &out) {
+  if (std::is_sorted(data, data + n)) {
+    unique_runs(data, (const size_t *)NULL, n, out);
+  } else {
+    unique_range(data, n, out, use_hash_unique<T>());
+  }
+}
+} // namespace detail
+} // namespace numcpp
+
+#endif // NUMCPP_UNIQUE_H_INCLUDED
@@ -328,6 +328,11 @@ public:
   /**
    * @brief Partition the elements in-place.
    *
+   * @details The lanes along the axis are distributed among the available
+   * threads, so the comparator may be called concurrently from several
+   * threads. If T is an arithmetic type and no comparator is given, lanes of
+   * at most 64 elements are fully sorted with a sorting network.
+   *
    * @param kth Element index to partition by. The element at the @a kth
    *            position is the element that would be in that position in the
    *            sorted tensor. The other elements are left without any specific
@@ -373,6 +378,14 @@ public:
   /**
    * @brief Sort the elements in-place.
    *
+   * @details If T is a 32 or 64-bit integer or floating point type and the
+   * elements are sorted in ascending order with the default comparator, a
+   * radix sort is used instead of a comparison sort. The lanes along the axis
+   * are distributed among the available threads, so the comparator may be
+   * called concurrently from several threads. If the sort is not stable, lanes
+   * of at most 64 arithmetic elements sorted with the default comparator are
+   * sorted many at once with a sorting network.
+   *
    * @param axis Axis along which to sort. Defaults to Rank - 1, which means
    *             sort along the last axis.
    * @param comp Custom comparator. A binary function that accepts two elements
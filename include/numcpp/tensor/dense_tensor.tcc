@@ -25,9 +25,12 @@
 #define NUMCPP_DENSE_TENSOR_TCC_INCLUDED
 
 #include <algorithm>
+#include <vector>
 #include "numcpp/broadcasting/assert.h"
 #include "numcpp/iterators/axes_iterator.h"
 #include "numcpp/iterators/index_sequence.h"
+#include "numcpp/routines/sorting.h"
+#include "numcpp/routines/sorting_network.h"
 #include "numcpp/routines/ranges.h"
 
 namespace numcpp {
@@ -369,41 +372,26 @@ template <class Container, class T, size_t Rank>
 template <class Compare, detail::RequiresCallable<Compare, T, T>>
 void dense_tensor<Container, T, Rank>::partition(size_t kth, size_t axis,
                                                  Compare comp) {
-  Container &self = this->self();
-  shape_t<Rank> shape = self.shape();
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    axes_iterator<Container, T, Rank, 1> first(&self, index, axis, 0);
-    axes_iterator<Container, T, Rank, 1> last(&self, index, axis, size);
-    std::nth_element(first, first + kth, last, comp);
+  // Short lanes are cheaper to sort than to partition one by one.
+  if (detail::sort_short_lanes(*this, axis, comp)) {
+    return;
   }
+  detail::transform_lanes(*this, axis, [&](T *first, T *last) {
+    std::nth_element(first, first + kth, last, comp);
+  });
 }
 
 template <class Container, class T, size_t Rank>
 void dense_tensor<Container, T, Rank>::reverse(size_t axis) {
-  Container &self = this->self();
-  shape_t<Rank> shape = self.shape();
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    axes_iterator<Container, T, Rank, 1> first(&self, index, axis, 0);
-    axes_iterator<Container, T, Rank, 1> last(&self, index, axis, size);
-    std::reverse(first, last);
-  }
+  detail::transform_lanes(*this, axis,
+                          [](T *first, T *last) { std::reverse(first, last); });
 }
 
 template <class Container, class T, size_t Rank>
 void dense_tensor<Container, T, Rank>::rotate(size_t shift, size_t axis) {
-  Container &self = this->self();
-  shape_t<Rank> shape = self.shape();
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    axes_iterator<Container, T, Rank, 1> first(&self, index, axis, 0);
-    axes_iterator<Container, T, Rank, 1> last(&self, index, axis, size);
+  detail::transform_lanes(*this, axis, [&](T *first, T *last) {
     std::rotate(first, first + shift, last);
-  }
+  });
 }
 
 template <class Container, class T, size_t Rank>
@@ -415,19 +403,12 @@ template <class Container, class T, size_t Rank>
 template <class Compare, detail::RequiresCallable<Compare, T, T>>
 void dense_tensor<Container, T, Rank>::sort(size_t axis, Compare comp,
                                             bool stable) {
-  Container &self = this->self();
-  shape_t<Rank> shape = self.shape();
-  size_t size = shape[axis];
-  shape[axis] = 1;
-  for (index_t<Rank> index : make_index_sequence(shape)) {
-    axes_iterator<Container, T, Rank, 1> first(&self, index, axis, 0);
-    axes_iterator<Container, T, Rank, 1> last(&self, index, axis, size);
-    if (stable) {
-      std::stable_sort(first, last, comp);
-    } else {
-      std::sort(first, last, comp);
-    }
+  if (!stable && detail::sort_short_lanes(*this, axis, comp)) {
+    return;
   }
+  detail::transform_lanes(*this, axis, [&](T *first, T *last) {
+    detail::sort_range(first, last, comp, stable);
+  });
 }
 
 /// Reductions.
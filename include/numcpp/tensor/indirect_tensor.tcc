@@ -212,8 +212,11 @@ inline bool indirect_tensor<T, Rank>::is_contiguous() const {
 template <class T, size_t Rank>
 indirect_tensor<T, Rank> &
 indirect_tensor<T, Rank>::operator=(const indirect_tensor &other) {
+  // Call the expression overload. Passing other directly would resolve to the
+  // implicit copy assignment of the base class, which copies nothing.
+  const expression<indirect_tensor, value_type, Rank> &expr = other;
   dense_tensor<indirect_tensor<T, Rank>, typename std::remove_cv<T>::type,
-               Rank>::operator=(other);
+               Rank>::operator=(expr);
   return *this;
 }
 
@@ -424,8 +424,17 @@ inline bool tensor<T, Rank>::is_contiguous() const {
 
 template <class T, size_t Rank>
 tensor<T, Rank> &tensor<T, Rank>::operator=(const tensor &other) {
-  this->resize(other.m_shape);
-  dense_tensor<tensor<T, Rank>, T, Rank>::operator=(other);
+  if (this != &other) {
+    this->resize(other.m_shape);
+    if (m_order == other.m_order) {
+      std::copy_n(other.m_data, m_size, m_data);
+    } else {
+      // Call the expression overload. Passing other directly would resolve to
+      // the implicit copy assignment of the base class, which copies nothing.
+      const expression<tensor, T, Rank> &expr = other;
+      dense_tensor<tensor<T, Rank>, T, Rank>::operator=(expr);
+    }
+  }
   return *this;
 }
 
@@ -434,7 +443,12 @@ template <class Container, class U>
 tensor<T, Rank> &
 tensor<T, Rank>::operator=(const expression<Container, U, Rank> &other) {
   this->resize(other.shape());
-  dense_tensor<tensor<T, Rank>, T, Rank>::operator=(other);
+  // The shapes match, so there is nothing to broadcast and the elements are
+  // written in memory order.
+  size_t n = 0;
+  for (index_t<Rank> index : make_index_sequence(m_shape, m_order)) {
+    m_data[n++] = other[index];
+  }
   return *this;
 }
 
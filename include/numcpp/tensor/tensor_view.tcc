@@ -180,8 +180,11 @@ inline bool tensor_view<T, Rank>::is_contiguous() const {
 template <class T, size_t Rank>
 tensor_view<T, Rank> &
 tensor_view<T, Rank>::operator=(const tensor_view &other) {
+  // Call the expression overload. Passing other directly would resolve to the
+  // implicit copy assignment of the base class, which copies nothing.
+  const expression<tensor_view, value_type, Rank> &expr = other;
   dense_tensor<tensor_view<T, Rank>, typename std::remove_cv<T>::type,
-               Rank>::operator=(other);
+               Rank>::operator=(expr);
   return *this;
 }
 